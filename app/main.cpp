@@ -1,6 +1,7 @@
 #ifdef USE_LEGACY_HEADERS
 #include <exception>
 #include <iostream>
+#include <filesystem>
 #include <fstream>
 #include <vector>
 #include <span>
@@ -15,6 +16,7 @@
 #ifndef USE_LEGACY_HEADERS
 import <exception>;
 import <iostream>;
+import <filesystem>;
 import <fstream>;
 import <vector>;
 import <span>;
@@ -27,11 +29,16 @@ import <locale>;
 #endif
 
 import archive;
+import checkpoint;
 import threadpool;
+import tracing;
+import hardware_counters;
 import input_reader;
 import monte_carlo;
 import monte_carlo_transition_matrix;
 import molecular_dynamics;
+import minimization;
+import screening;
 import breakthrough;
 import breakthrough_simulation;
 import mixture_prediction_simulation;
@@ -49,6 +56,17 @@ int main()
     auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type>::instance();
     pool.init(inputReader.numberOfThreads, inputReader.threadingType);
 
+    if (inputReader.tracing)
+    {
+      Tracing::enable(inputReader.tracingBufferSize);
+    }
+
+    if (inputReader.hardwareCounters && !HardwareCounters::enable())
+    {
+      std::cerr << "Warning: hardware counters are not available (no perf_event support or access), "
+                   "continuing without them\n";
+    }
+
     switch (inputReader.simulationType)
     {
       case InputReader::SimulationType::MonteCarlo:
@@ -56,11 +74,7 @@ int main()
         MonteCarlo mc(inputReader);
         if(inputReader.restartFromBinary)
         {
-          std::ifstream ifile("restart_data.bin", std::ios::binary);
-          if(!ifile.is_open())
-          {
-            throw std::runtime_error("Restart file doesn't exist..\n");
-          }
+          std::ifstream ifile = Checkpoint::open("restart_data.bin", inputReader.numberOfBinaryRestartFiles);
           Archive<std::ifstream> archive(ifile);
           archive >> mc;
           mc.createOutputFiles();
@@ -93,6 +107,18 @@ int main()
         md.run();
         break;
       }
+      case InputReader::SimulationType::Minimization:
+      {
+        Minimization minimization(inputReader);
+        minimization.run();
+        break;
+      }
+      case InputReader::SimulationType::Screening:
+      {
+        Screening screening(inputReader);
+        screening.run();
+        break;
+      }
       case InputReader::SimulationType::Breakthrough:
       {
         BreakthroughSimulation breakthrough(inputReader);
@@ -114,6 +140,12 @@ int main()
       default:
         break;
     }
+
+    if (inputReader.tracing)
+    {
+      std::filesystem::create_directories("output");
+      Tracing::writeChromeTrace("output/trace.json");
+    }
   }
   catch (std::exception const& e)
   {
@@ -1,11 +0,0 @@
-#include <benchmark/benchmark.h>
-
-#include <string>
-
-static void BM_StringCreation(benchmark::State& state) {
-  for (auto _ : state)
-    std::string empty_string;
-}
-// Register the function as a benchmark
-BENCHMARK(BM_StringCreation);
-
@@ -0,0 +1,177 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#endif
+
+export module benchmark_systems;
+
+#ifndef USE_LEGACY_HEADERS
+import <cstddef>;
+import <cstdint>;
+import <optional>;
+import <vector>;
+#endif
+
+import int3;
+import double3;
+import atom;
+import pseudo_atom;
+import vdwparameters;
+import forcefield;
+import framework;
+import component;
+import system;
+import simulationbox;
+
+/**
+ * \brief Systems shared by the benchmarks: CO2 and methane adsorbed in MFI or Cu-BTC, or in an empty box.
+ *
+ * All systems use one force field, with the pseudo-atoms of both frameworks and both adsorbates, so that the benchmarks
+ * only differ in the structure and the number of molecules.
+ */
+export namespace BenchmarkSystems
+{
+enum class Host : size_t
+{
+  Box = 0,
+  MFI = 1,
+  CuBTC = 2
+};
+
+// pseudo-atom types of the force field
+constexpr uint16_t CH4 = 8;
+constexpr uint16_t C_co2 = 9;
+constexpr uint16_t O_co2 = 10;
+
+inline ForceField forceField()
+{
+  return ForceField({PseudoAtom("Si", true, 28.0855, 2.05, 0.0, 14, false),
+                     PseudoAtom("O", true, 15.999, -1.025, 0.0, 8, false),
+                     PseudoAtom("Cu1", true, 63.546039732, 1.248, 0.0, 29, false),
+                     PseudoAtom("O1", true, 15.999404927, -0.624, 0.0, 8, false),
+                     PseudoAtom("C1", true, 12.010735897, 0.494, 0.0, 6, false),
+                     PseudoAtom("C2", true, 12.010735897, 0.13, 0.0, 6, false),
+                     PseudoAtom("C3", true, 12.010735897, -0.156, 0.0, 6, false),
+                     PseudoAtom("H1", true, 1.007940754, 0.156, 0.0, 1, false),
+                     PseudoAtom("CH4", false, 16.04246, 0.0, 0.0, 6, false),
+                     PseudoAtom("C_co2", false, 12.0, 0.6512, 0.0, 6, false),
+                     PseudoAtom("O_co2", false, 15.9994, -0.3256, 0.0, 8, false)},
+                    {VDWParameters(22.0, 2.30), VDWParameters(53.0, 3.3), VDWParameters(2.5161, 3.11369),
+                     VDWParameters(48.1581, 3.03315), VDWParameters(47.8562, 3.47299), VDWParameters(47.8562, 3.47299),
+                     VDWParameters(47.8562, 3.47299), VDWParameters(7.64893, 2.84642), VDWParameters(158.5, 3.72),
+                     VDWParameters(29.933, 2.745), VDWParameters(85.671, 3.017)},
+                    ForceField::MixingRule::Lorentz_Berthelot, 12.0, 12.0, 12.0, true, false, true);
+}
+
+// MFI (silicalite-1), Pnma, with 2n x 2n x 2n unit cells
+inline Framework mfi(const ForceField &forceField, size_t n)
+{
+  int size = 2 * static_cast<int>(n);
+  return Framework(0, forceField, "MFI_SI", SimulationBox(20.022, 19.899, 13.383), 292,
+                   {// double3 position, double charge, double lambda, uint32_t moleculeId, uint16_t type,
+                    // uint8_t componentId, uint8_t groupId
+                    Atom(double3(0.42238, 0.0565, -0.33598), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.30716, 0.02772, -0.1893), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.27911, 0.06127, 0.0312), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.12215, 0.06298, 0.0267), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.07128, 0.02722, -0.18551), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.18641, 0.05896, -0.32818), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.42265, -0.1725, -0.32718), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.30778, -0.13016, -0.18548), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.27554, -0.17279, 0.03109), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.12058, -0.1731, 0.02979), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.07044, -0.13037, -0.182), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.18706, -0.17327, -0.31933), 2.05, 1.0, 0, 0, 0, 0),
+                    Atom(double3(0.3726, 0.0534, -0.2442), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.3084, 0.0587, -0.0789), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.2007, 0.0592, 0.0289), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.0969, 0.0611, -0.0856), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.1149, 0.0541, -0.2763), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.2435, 0.0553, -0.246), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.3742, -0.1561, -0.2372), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.3085, -0.1552, -0.0728), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.198, -0.1554, 0.0288), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.091, -0.1614, -0.0777), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.1169, -0.1578, -0.2694), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.2448, -0.1594, -0.2422), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.3047, -0.051, -0.1866), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.0768, -0.0519, -0.1769), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.4161, 0.1276, -0.3896), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.4086, -0.0017, -0.4136), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.402, -0.1314, -0.4239), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.1886, 0.1298, -0.3836), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.194, 0.0007, -0.4082), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.1951, -0.1291, -0.419), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(-0.0037, 0.0502, -0.208), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(-0.004, -0.1528, -0.2078), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.4192, -0.25, -0.354), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.1884, -0.25, -0.3538), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.2883, -0.25, 0.0579), -1.025, 1.0, 0, 1, 0, 0),
+                    Atom(double3(0.1085, -0.25, 0.0611), -1.025, 1.0, 0, 1, 0, 0)},
+                   int3(size, size, size));
+}
+
+// Cu-BTC (HKUST-1), Fm-3m, with n x n x n unit cells
+inline Framework cuBTC(const ForceField &forceField, size_t n)
+{
+  int size = static_cast<int>(n);
+  return Framework(0, forceField, "Cu-BTC", SimulationBox(26.343, 26.343, 26.343), 523,
+                   {// double3 position, double charge, double lambda, uint32_t moleculeId, uint16_t type,
+                    // uint8_t componentId, uint8_t groupId
+                    Atom(double3(0.2853, 0.2853, 0.0), 1.248, 1.0, 0, 2, 0, 0),
+                    Atom(double3(0.3166, 0.2431, 0.9478), -0.624, 1.0, 0, 3, 0, 0),
+                    Atom(double3(0.2968, 0.2032, 0.9313), 0.494, 1.0, 0, 4, 0, 0),
+                    Atom(double3(0.322, 0.178, 0.887), 0.13, 1.0, 0, 5, 0, 0),
+                    Atom(double3(0.3655, 0.1994, 0.8655), -0.156, 1.0, 0, 6, 0, 0),
+                    Atom(double3(0.3802, 0.228, 0.8802), 0.156, 1.0, 0, 7, 0, 0)},
+                   int3(size, size, size));
+}
+
+inline Component co2(const ForceField &forceField, size_t componentId)
+{
+  return Component(componentId, forceField, "CO2", 304.1282, 7377300.0, 0.22394,
+                   {// double3 position, double charge, double lambda, uint32_t moleculeId, uint16_t type,
+                    // uint8_t componentId, uint8_t groupId
+                    Atom(double3(0.0, 0.0, 1.149), -0.3256, 1.0, 0, O_co2, static_cast<uint8_t>(componentId), 0),
+                    Atom(double3(0.0, 0.0, 0.0), 0.6512, 1.0, 0, C_co2, static_cast<uint8_t>(componentId), 0),
+                    Atom(double3(0.0, 0.0, -1.149), -0.3256, 1.0, 0, O_co2, static_cast<uint8_t>(componentId), 0)},
+                   5, 21);
+}
+
+inline Component methane(const ForceField &forceField, size_t componentId)
+{
+  return Component(componentId, forceField, "methane", 190.564, 45599200, 0.01142,
+                   {// double3 position, double charge, double lambda, uint32_t moleculeId, uint16_t type,
+                    // uint8_t componentId, uint8_t groupId
+                    Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, CH4, static_cast<uint8_t>(componentId), 0)},
+                   5, 21);
+}
+
+/**
+ * \brief CO2 in the host, with 'n' the size of the host (the number of unit cells in each direction for Cu-BTC,
+ * half of it for MFI, and a box of n times 25 Angstrom without a framework).
+ */
+inline System co2System(Host host, size_t n, size_t numberOfMolecules)
+{
+  ForceField field = forceField();
+  std::vector<Framework> frameworks{};
+  std::optional<SimulationBox> box{};
+  switch (host)
+  {
+    case Host::Box:
+      box = SimulationBox(25.0 * static_cast<double>(n), 25.0 * static_cast<double>(n), 25.0 * static_cast<double>(n));
+      break;
+    case Host::MFI:
+      frameworks.push_back(mfi(field, n));
+      break;
+    case Host::CuBTC:
+      frameworks.push_back(cuBTC(field, n));
+      break;
+  }
+  return System(0, field, box, 300.0, 1e4, 1.0, frameworks, {co2(field, 0)}, {numberOfMolecules}, 5);
+}
+}  // namespace BenchmarkSystems
@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+import double3;
+import atom;
+import running_energy;
+import system;
+import interactions_ewald;
+import benchmark_systems;
+
+// Fourier part of the Ewald energy difference of a CO2 molecule for a trial translation, with the structure factors
+// of all other molecules stored. Arguments: the host, its size and the number of CO2 molecules.
+
+static void BM_energyDifferenceEwaldFourier(benchmark::State &state)
+{
+  System system = BenchmarkSystems::co2System(static_cast<BenchmarkSystems::Host>(state.range(0)),
+                                              static_cast<size_t>(state.range(1)), static_cast<size_t>(state.range(2)));
+
+  Interactions::computeEwaldFourierEnergy(system.eik_x, system.eik_y, system.eik_z, system.eik_xy,
+                                          system.fixedFrameworkStoredEik, system.storedEik, system.forceField,
+                                          system.simulationBox, system.components,
+                                          system.numberOfMoleculesPerComponent, system.spanOfMoleculeAtoms());
+
+  std::span<const Atom> oldMolecule = system.spanOfMolecule(0, 0);
+  std::vector<Atom> newMolecule(oldMolecule.begin(), oldMolecule.end());
+  for (Atom &atom : newMolecule)
+  {
+    atom.position += double3(0.1, 0.05, -0.1);
+  }
+
+  for (auto _ : state)
+  {
+    RunningEnergy energy = Interactions::energyDifferenceEwaldFourier(
+        system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik,
+        system.forceField, system.simulationBox, newMolecule, oldMolecule);
+    benchmark::DoNotOptimize(energy);
+  }
+  state.counters["waveVectors"] = static_cast<double>(system.storedEik.size());
+}
+BENCHMARK(BM_energyDifferenceEwaldFourier)
+    ->ArgNames({"host", "size", "molecules"})
+    ->ArgsProduct({{static_cast<int64_t>(BenchmarkSystems::Host::MFI),
+                    static_cast<int64_t>(BenchmarkSystems::Host::CuBTC)},
+                   {1, 2},
+                   {1, 32}})
+    ->ThreadRange(1, 8)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+import double3;
+import atom;
+import running_energy;
+import system;
+import interactions_framework_molecule;
+import benchmark_systems;
+
+// Energy difference of a CO2 molecule with the framework for a trial translation, as in a translation move.
+// Arguments: the host (MFI or Cu-BTC) and its size (see BenchmarkSystems::co2System).
+
+static void BM_computeFrameworkMoleculeEnergyDifference(benchmark::State &state)
+{
+  System system = BenchmarkSystems::co2System(static_cast<BenchmarkSystems::Host>(state.range(0)),
+                                              static_cast<size_t>(state.range(1)), 1);
+
+  std::span<const Atom> oldMolecule = system.spanOfMolecule(0, 0);
+  std::vector<Atom> newMolecule(oldMolecule.begin(), oldMolecule.end());
+  for (Atom &atom : newMolecule)
+  {
+    atom.position += double3(0.1, 0.05, -0.1);
+  }
+
+  for (auto _ : state)
+  {
+    std::optional<RunningEnergy> energy = Interactions::computeFrameworkMoleculeEnergyDifference(
+        system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), newMolecule, oldMolecule);
+    benchmark::DoNotOptimize(energy);
+  }
+  state.counters["frameworkAtoms"] = static_cast<double>(system.spanOfFrameworkAtoms().size());
+}
+BENCHMARK(BM_computeFrameworkMoleculeEnergyDifference)
+    ->ArgNames({"host", "size"})
+    ->Args({static_cast<int64_t>(BenchmarkSystems::Host::MFI), 1})
+    ->Args({static_cast<int64_t>(BenchmarkSystems::Host::MFI), 2})
+    ->Args({static_cast<int64_t>(BenchmarkSystems::Host::CuBTC), 1})
+    ->Args({static_cast<int64_t>(BenchmarkSystems::Host::CuBTC), 2})
+    ->ThreadRange(1, 8)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+import running_energy;
+import system;
+import integrators;
+import benchmark_systems;
+
+// One velocity-Verlet step of rigid CO2 molecules, including the computation of all forces.
+// Arguments: the host, its size and the number of CO2 molecules.
+static void BM_velocityVerlet(benchmark::State &state)
+{
+  System system = BenchmarkSystems::co2System(static_cast<BenchmarkSystems::Host>(state.range(0)),
+                                              static_cast<size_t>(state.range(1)), static_cast<size_t>(state.range(2)));
+  system.precomputeTotalGradients();
+
+  for (auto _ : state)
+  {
+    RunningEnergy energy = Integrators::velocityVerlet(
+        system.moleculePositions, system.spanOfMoleculeAtoms(), system.components, system.timeStep,
+        system.thermostat, system.spanOfFrameworkAtoms(), system.forceField, system.simulationBox, system.eik_x,
+        system.eik_y, system.eik_z, system.eik_xy, system.totalEik, system.fixedFrameworkStoredEik,
+        system.numberOfMoleculesPerComponent);
+    benchmark::DoNotOptimize(energy);
+  }
+}
+BENCHMARK(BM_velocityVerlet)
+    ->ArgNames({"host", "size", "molecules"})
+    ->Args({static_cast<int64_t>(BenchmarkSystems::Host::Box), 1, 32})
+    ->Args({static_cast<int64_t>(BenchmarkSystems::Host::Box), 2, 256})
+    ->Args({static_cast<int64_t>(BenchmarkSystems::Host::MFI), 1, 32})
+    ->Args({static_cast<int64_t>(BenchmarkSystems::Host::CuBTC), 1, 32})
+    ->ThreadRange(1, 8)
+    ->Unit(benchmark::kMillisecond);
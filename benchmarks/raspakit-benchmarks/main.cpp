@@ -1,7 +1,41 @@
-#include <benchmark/benchmark.h>
-
-int main(int argc, char** argv)
-{
-  ::benchmark::Initialize(&argc, argv);
-  ::benchmark::RunSpecifiedBenchmarks();
-}
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+import threadpool;
+
+// Besides the Google Benchmark flags, '--raspa_threads=N' runs the kernels that use the RASPA thread pool with N
+// threads (the default is serial). The flag '--benchmark_filter' selects kernels, and the thread counts of the
+// benchmarks themselves ('threads:N' in the names) run independent systems concurrently.
+int main(int argc, char** argv)
+{
+  const std::string_view threadsFlag = "--raspa_threads=";
+  size_t numberOfThreads = 1;
+  int remaining = 1;
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string_view argument(argv[i]);
+    if (argument.starts_with(threadsFlag))
+    {
+      numberOfThreads = std::stoul(std::string(argument.substr(threadsFlag.size())));
+      continue;
+    }
+    argv[remaining++] = argv[i];
+  }
+  argc = remaining;
+
+  if (numberOfThreads > 1)
+  {
+    auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type>::instance();
+    pool.init(numberOfThreads, ThreadPool::ThreadingType::ThreadPool);
+  }
+  benchmark::AddCustomContext("raspa_threads", std::to_string(numberOfThreads));
+
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+}
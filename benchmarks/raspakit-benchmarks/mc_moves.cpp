@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+import atom;
+import molecule;
+import randomnumbers;
+import running_energy;
+import system;
+import cbmc_chain_data;
+import cbmc_rigid_insertion;
+import mc_moves_volume;
+import benchmark_systems;
+
+// Growth of a rigid CO2 molecule with configurational-bias Monte Carlo for a swap insertion (without the Ewald
+// Fourier part and the acceptance). Arguments: the host, its size and the number of adsorbed CO2 molecules.
+static void BM_growRigidMoleculeSwapInsertion(benchmark::State &state)
+{
+  System system = BenchmarkSystems::co2System(static_cast<BenchmarkSystems::Host>(state.range(0)),
+                                              static_cast<size_t>(state.range(1)), static_cast<size_t>(state.range(2)));
+  RandomNumber random(1234);
+
+  for (auto _ : state)
+  {
+    std::optional<ChainData> growData = CBMC::growRigidMoleculeSwapInsertion(
+        random, system.frameworkComponents, system.components[0], system.hasExternalField, system.components,
+        system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), system.spanOfMoleculeAtoms(),
+        system.beta, system.forceField.cutOffFrameworkVDW, system.forceField.cutOffMoleculeVDW,
+        system.forceField.cutOffCoulomb, 0, system.numberOfMoleculesPerComponent[0], 1.0, 0,
+        system.numberOfTrialDirections);
+    benchmark::DoNotOptimize(growData);
+  }
+}
+BENCHMARK(BM_growRigidMoleculeSwapInsertion)
+    ->ArgNames({"host", "size", "molecules"})
+    ->ArgsProduct({{static_cast<int64_t>(BenchmarkSystems::Host::MFI),
+                    static_cast<int64_t>(BenchmarkSystems::Host::CuBTC)},
+                   {1, 2},
+                   {0, 32}})
+    ->ThreadRange(1, 8)
+    ->Unit(benchmark::kMicrosecond);
+
+// Bookkeeping of inserting a CO2 molecule into the system and deleting it again.
+// Arguments: the number of CO2 molecules already present.
+static void BM_insertDeleteMolecule(benchmark::State &state)
+{
+  System system = BenchmarkSystems::co2System(BenchmarkSystems::Host::Box, 2, static_cast<size_t>(state.range(0)));
+  std::span<const Atom> molecule = system.spanOfMolecule(0, 0);
+  std::vector<Atom> atoms(molecule.begin(), molecule.end());
+
+  for (auto _ : state)
+  {
+    system.insertMolecule(0, Molecule(), atoms);
+    size_t last = system.numberOfMoleculesPerComponent[0] - 1;
+    system.deleteMolecule(0, last, system.spanOfMolecule(0, last));
+  }
+  benchmark::DoNotOptimize(system.numberOfMoleculesPerComponent);
+}
+BENCHMARK(BM_insertDeleteMolecule)->RangeMultiplier(8)->Range(8, 512)->ThreadRange(1, 8);
+
+// A complete volume move, including the recomputation of all energies and the acceptance.
+// Arguments: the size of the box (in multiples of 25 Angstrom) and the number of CO2 molecules.
+static void BM_volumeMove(benchmark::State &state)
+{
+  System system = BenchmarkSystems::co2System(BenchmarkSystems::Host::Box, static_cast<size_t>(state.range(0)),
+                                              static_cast<size_t>(state.range(1)));
+  RandomNumber random(1234);
+
+  for (auto _ : state)
+  {
+    std::optional<RunningEnergy> energy = MC_Moves::volumeMove(random, system);
+    benchmark::DoNotOptimize(energy);
+  }
+}
+BENCHMARK(BM_volumeMove)
+    ->ArgNames({"size", "molecules"})
+    ->Args({1, 16})
+    ->Args({2, 128})
+    ->ThreadRange(1, 8)
+    ->Unit(benchmark::kMillisecond);
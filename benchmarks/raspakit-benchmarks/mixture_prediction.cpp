@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+import forcefield;
+import component;
+import system;
+import isotherm;
+import multi_site_isotherm;
+import mixture_prediction;
+import benchmark_systems;
+
+// IAST prediction of an equimolar mixture of dual-site Langmuir components at 16 pressures between 1 kPa and 10 MPa,
+// warm-started from the previous pressure as in a breakthrough column.
+// Arguments: the number of components, and whether the spreading pressures are tabulated.
+static void BM_predictMixture(benchmark::State &state)
+{
+  const size_t numberOfComponents = static_cast<size_t>(state.range(0));
+  const size_t numberOfPressures = 16;
+
+  ForceField forceField = BenchmarkSystems::forceField();
+  std::vector<Component> components{};
+  for (size_t i = 0; i < numberOfComponents; ++i)
+  {
+    Component component = BenchmarkSystems::methane(forceField, i);
+    double scale = 1.0 + static_cast<double>(i);
+    component.isotherm.add(Isotherm(Isotherm::Type::Langmuir, {2.0 + 0.5 * scale, 1.0e-5 * scale * scale}, 2));
+    component.isotherm.add(Isotherm(Isotherm::Type::Langmuir, {1.0 + 0.2 * scale, 4.0e-4 / scale}, 2));
+    component.isotherm.numberOfSites = 2;
+    component.molFraction = 1.0 / static_cast<double>(numberOfComponents);
+    components.push_back(std::move(component));
+  }
+  System system(0, 300.0, 1e5, 1.0, {}, components);
+  system.maxIsothermTerms = 2;
+  system.useSpreadingPressureTables = state.range(1) != 0;
+
+  MixturePrediction mixture(system);
+  MixturePrediction::Workspace workspace = mixture.createWorkspace();
+  std::vector<double> Yi(numberOfComponents, 1.0 / static_cast<double>(numberOfComponents));
+  std::vector<double> Xi(numberOfComponents);
+  std::vector<double> Ni(numberOfComponents);
+  std::vector<double> cachedP0(numberOfComponents * system.maxIsothermTerms);
+  std::vector<double> cachedPsi(system.maxIsothermTerms);
+  std::vector<double> pressures(numberOfPressures);
+  for (size_t i = 0; i < numberOfPressures; ++i)
+  {
+    pressures[i] = 1e3 * std::pow(1e4, static_cast<double>(i) / static_cast<double>(numberOfPressures - 1));
+  }
+
+  size_t numberOfSteps = 0;
+  for (auto _ : state)
+  {
+    for (double pressure : pressures)
+    {
+      numberOfSteps += mixture
+                           .predictMixture(Yi, pressure, Xi, Ni, cachedP0.data(), cachedPsi.data(), workspace)
+                           .first;
+    }
+    benchmark::DoNotOptimize(Ni.data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(numberOfPressures));
+  state.counters["steps"] =
+      benchmark::Counter(static_cast<double>(numberOfSteps), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_predictMixture)
+    ->ArgNames({"components", "tables"})
+    ->ArgsProduct({{2, 4, 8}, {0, 1}})
+    ->ThreadRange(1, 8)
+    ->Unit(benchmark::kMicrosecond);
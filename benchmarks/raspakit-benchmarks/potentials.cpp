@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+import randomnumbers;
+import forcefield;
+import energy_factor;
+import potential_energy_vdw;
+import potential_energy_coulomb;
+import benchmark_systems;
+
+// Pair kernels evaluated over 'state.range(0)' random distances within the cutoff, for the CO2 oxygen-framework
+// oxygen pair.
+
+static std::vector<double> randomDistances(size_t numberOfPairs, bool squared)
+{
+  RandomNumber random(1234);
+  std::vector<double> distances(numberOfPairs);
+  for (double &distance : distances)
+  {
+    double r = 2.5 + 9.5 * random.uniform();
+    distance = squared ? r * r : r;
+  }
+  return distances;
+}
+
+static void BM_potentialVDWEnergy(benchmark::State &state)
+{
+  ForceField forceField = BenchmarkSystems::forceField();
+  std::vector<double> rr = randomDistances(static_cast<size_t>(state.range(0)), true);
+  const size_t typeA = BenchmarkSystems::O_co2;
+  const size_t typeB = 1;
+  const bool groupId = false;
+  const double scaling = 1.0;
+
+  for (auto _ : state)
+  {
+    EnergyFactor energy(0.0, 0.0);
+    for (double distance : rr)
+    {
+      energy += potentialVDWEnergy(forceField, groupId, groupId, scaling, scaling, distance, typeA, typeB);
+    }
+    benchmark::DoNotOptimize(energy);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_potentialVDWEnergy)->RangeMultiplier(8)->Range(64, 32768)->ThreadRange(1, 8);
+
+static void BM_potentialCoulombEnergy(benchmark::State &state)
+{
+  ForceField forceField = BenchmarkSystems::forceField();
+  std::vector<double> r = randomDistances(static_cast<size_t>(state.range(0)), false);
+  const bool groupId = false;
+  const double scaling = 1.0;
+  const double chargeA = -0.3256;
+  const double chargeB = -1.025;
+
+  for (auto _ : state)
+  {
+    EnergyFactor energy(0.0, 0.0);
+    for (double distance : r)
+    {
+      energy += potentialCoulombEnergy(forceField, groupId, groupId, scaling, scaling, distance, chargeA, chargeB);
+    }
+    benchmark::DoNotOptimize(energy);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_potentialCoulombEnergy)->RangeMultiplier(8)->Range(64, 32768)->ThreadRange(1, 8);
@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+import double3;
+import simd_quatd;
+import randomnumbers;
+
+// Rotation of 'state.range(0)' body-fixed positions by a quaternion, as in the creation of the Cartesian positions
+// of rigid molecules.
+static void BM_simd_quatd_rotation(benchmark::State &state)
+{
+  RandomNumber random(1234);
+  std::vector<double3> positions(static_cast<size_t>(state.range(0)));
+  for (double3 &position : positions)
+  {
+    position = double3(random.uniform() - 0.5, random.uniform() - 0.5, random.uniform() - 0.5);
+  }
+  std::vector<double3> rotated(positions.size());
+  simd_quatd q = simd_quatd::fromAxisAngle(0.7, random.randomVectorOnUnitSphere());
+
+  for (auto _ : state)
+  {
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+      rotated[i] = q * positions[i];
+    }
+    benchmark::DoNotOptimize(rotated.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_simd_quatd_rotation)->RangeMultiplier(8)->Range(64, 32768)->ThreadRange(1, 8);
@@ -0,0 +1,274 @@
+"""End-to-end throughput benchmarks on shortened versions of the examples.
+
+Every case copies an example to a scratch directory, shortens the run, fixes the random seed and the number of
+threads, runs the 'raspa3' executable and collects:
+
+  - MC steps per second of the production run (Monte Carlo and TMMC),
+  - ns/day of the production run (molecular dynamics),
+  - the production CPU time per move type, taken from the 'cpuTimings' of the json output (MCMoveCpuTime),
+  - the peak resident set size of the run.
+
+The results are written as json. When a baseline is given, the results are compared against it and the script exits
+with a non-zero status if a case is slower (or uses more memory) than the baseline allows for.
+"""
+
+import argparse
+import json
+import os
+import pathlib
+import platform
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+# name: (example directory, simulation type, cycle settings)
+CASES = {
+    "mc_methane_in_mfi": (
+        "basic/7_mc_adsorption_of_methane_in_mfi",
+        "MonteCarlo",
+        {"NumberOfCycles": 2000, "NumberOfInitializationCycles": 500, "NumberOfEquilibrationCycles": 0},
+    ),
+    "mc_co2_in_cu-btc": (
+        "basic/8_mc_adsorption_of_co2_in_cu-btc",
+        "MonteCarlo",
+        {"NumberOfCycles": 1000, "NumberOfInitializationCycles": 500, "NumberOfEquilibrationCycles": 0},
+    ),
+    "md_water_box": (
+        "basic/11_md_rdf_water_box",
+        "MolecularDynamics",
+        {"NumberOfCycles": 2000, "NumberOfInitializationCycles": 200, "NumberOfEquilibrationCycles": 500},
+    ),
+    "tmmc_methane_in_tobacco-667": (
+        "non-basic/10_tmmc_methane_in_tobacco-667/0",
+        "MonteCarloTransitionMatrix",
+        {"NumberOfCycles": 5000, "NumberOfInitializationCycles": 1000, "NumberOfEquilibrationCycles": 0},
+    ),
+}
+
+MD_TIME_STEP = 0.0005  # [ps]
+
+# metrics where a larger value is better, and metrics where a smaller value is better
+HIGHER_IS_BETTER = ("stepsPerSecond", "nsPerDay")
+LOWER_IS_BETTER = ("peakRSS",)
+
+
+def prepare_case(examples_dir, work_dir, name, seed, threads):
+    example, simulation_type, cycles = CASES[name]
+    source = examples_dir / example
+    target = work_dir / name
+    if target.exists():
+        shutil.rmtree(target)
+    shutil.copytree(source, target, ignore=shutil.ignore_patterns("output", "out", "movies", "run", "run.*"))
+
+    with open(target / "simulation.json", "r") as file:
+        simulation = json.load(file)
+
+    if simulation.get("SimulationType") != simulation_type:
+        raise ValueError(f"Example '{example}' is not a {simulation_type} simulation")
+
+    simulation.update(cycles)
+    simulation["PrintEvery"] = cycles["NumberOfCycles"]
+    simulation["RandomSeed"] = seed
+    simulation["NumberOfThreads"] = threads
+    simulation["ThreadingType"] = "ThreadPool" if threads > 1 else "Serial"
+    if simulation_type == "MolecularDynamics":
+        for system in simulation["Systems"]:
+            system["TimeStep"] = MD_TIME_STEP
+
+    with open(target / "simulation.json", "w") as file:
+        json.dump(simulation, file, indent=2)
+    return target, simulation_type
+
+
+def run_raspa(raspa, directory, raspa_dir):
+    """Runs raspa3 in 'directory', returns the wall time [s] and the peak RSS [MiB] (None if unavailable)."""
+    environment = dict(os.environ)
+    if raspa_dir is not None:
+        environment["RASPA_DIR"] = str(raspa_dir)
+
+    with open(directory / "stdout.txt", "w") as log:
+        start = time.perf_counter()
+        process = subprocess.Popen([str(raspa)], cwd=directory, env=environment, stdout=log, stderr=subprocess.STDOUT)
+        if hasattr(os, "wait4"):
+            _, status, usage = os.wait4(process.pid, 0)
+            process.returncode = os.waitstatus_to_exitcode(status)
+            # ru_maxrss is in kilobytes on Linux and in bytes on macOS
+            scale = 1024.0 * 1024.0 if sys.platform == "darwin" else 1024.0
+            peak_rss = usage.ru_maxrss / scale
+        else:
+            process.wait()
+            peak_rss = None
+        wall_time = time.perf_counter() - start
+
+    if process.returncode != 0:
+        raise RuntimeError(f"raspa3 failed in '{directory}' (exit code {process.returncode}), see stdout.txt")
+    return wall_time, peak_rss
+
+
+def move_times(cpu_timings):
+    """Production CPU time per move type, summed over systems and components."""
+    summed = cpu_timings["summedSystemsAndComponents"]
+    return {move: value["total"] for move, value in summed.items() if isinstance(value, dict) and "total" in value}
+
+
+def collect_monte_carlo(directory):
+    outputs = sorted((directory / "output").glob("output_*.json"))
+    if not outputs:
+        raise RuntimeError(f"No json output found in '{directory / 'output'}'")
+
+    # the production time and steps are per run; the moves are summed over the systems already
+    with open(outputs[0], "r") as file:
+        data = json.load(file)
+    cpu_timings = data["output"]["cpuTimings"]
+    production_time = cpu_timings["production"]
+    steps = data["output"]["numberOfProductionSteps"]
+    return {
+        "version": data.get("version"),
+        "productionTime": production_time,
+        "numberOfProductionSteps": steps,
+        "stepsPerSecond": steps / production_time if production_time > 0.0 else 0.0,
+        "moveTimes": move_times(cpu_timings),
+    }
+
+
+def collect_molecular_dynamics(directory):
+    outputs = sorted((directory / "output").glob("output_*.txt"))
+    if not outputs:
+        raise RuntimeError(f"No output found in '{directory / 'output'}'")
+
+    with open(outputs[0], "r") as file:
+        content = file.read()
+    time_match = re.search(r"Production simulation time:\s+([0-9.eE+-]+)", content)
+    steps_match = re.search(r"Production number of steps:\s+([0-9]+)", content)
+    if time_match is None or steps_match is None:
+        raise RuntimeError(f"No production timings found in '{outputs[0]}'")
+
+    production_time = float(time_match.group(1))
+    steps = int(steps_match.group(1))
+    simulated_ns = steps * MD_TIME_STEP * 1e-3
+    return {
+        "productionTime": production_time,
+        "numberOfProductionSteps": steps,
+        "stepsPerSecond": steps / production_time if production_time > 0.0 else 0.0,
+        "nsPerDay": simulated_ns * 86400.0 / production_time if production_time > 0.0 else 0.0,
+    }
+
+
+def run_case(args, name):
+    best = None
+    for _ in range(args.repeat):
+        directory, simulation_type = prepare_case(args.examples, args.work_dir, name, args.seed, args.threads)
+        wall_time, peak_rss = run_raspa(args.raspa, directory, args.raspa_dir)
+        if simulation_type == "MolecularDynamics":
+            result = collect_molecular_dynamics(directory)
+        else:
+            result = collect_monte_carlo(directory)
+        result["simulationType"] = simulation_type
+        result["wallTime"] = wall_time
+        result["peakRSS"] = peak_rss
+
+        # keep the fastest repeat, the others are dominated by noise from the machine
+        if best is None or result["stepsPerSecond"] > best["stepsPerSecond"]:
+            best = result
+    return best
+
+
+def compare(results, baseline, tolerance, memory_tolerance, minimum_move_time):
+    """Returns the list of regressions of 'results' with respect to 'baseline'."""
+    regressions = []
+    for name, result in results["cases"].items():
+        reference = baseline.get("cases", {}).get(name)
+        if reference is None:
+            print(f"{name}: no baseline")
+            continue
+
+        def check(metric, current, expected, higher_is_better, allowed):
+            if current is None or expected is None or expected <= 0.0:
+                return
+            change = (current - expected) / expected
+            worse = change < -allowed if higher_is_better else change > allowed
+            print(f"{name:32s} {metric:40s} {expected:14.6g} -> {current:14.6g} ({100.0 * change:+7.2f}%)"
+                  f"{'  REGRESSION' if worse else ''}")
+            if worse:
+                regressions.append(f"{name}: {metric} {expected:g} -> {current:g}")
+
+        for metric in HIGHER_IS_BETTER:
+            check(metric, result.get(metric), reference.get(metric), True, tolerance)
+        for metric in LOWER_IS_BETTER:
+            check(metric, result.get(metric), reference.get(metric), False, memory_tolerance)
+        for move, expected in reference.get("moveTimes", {}).items():
+            if expected >= minimum_move_time:
+                check(f"moveTimes/{move}", result.get("moveTimes", {}).get(move), expected, False, tolerance)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Throughput benchmarks of raspa3 on shortened examples")
+    parser.add_argument("--raspa", type=pathlib.Path, required=True, help="path to the raspa3 executable")
+    parser.add_argument("--examples", type=pathlib.Path, required=True, help="path to the examples directory")
+    parser.add_argument("--raspa-dir", type=pathlib.Path, default=None, help="value of RASPA_DIR for the runs")
+    parser.add_argument("--work-dir", type=pathlib.Path, default=pathlib.Path("throughput-runs"))
+    parser.add_argument("--output", type=pathlib.Path, default=pathlib.Path("throughput.json"))
+    parser.add_argument("--baseline", type=pathlib.Path, default=None, help="baseline json to compare against")
+    parser.add_argument("--update-baseline", action="store_true", help="write the results as the new baseline")
+    parser.add_argument("--tolerance", type=float, default=0.10, help="allowed relative slow-down")
+    parser.add_argument("--memory-tolerance", type=float, default=0.10, help="allowed relative growth of peak RSS")
+    parser.add_argument("--minimum-move-time", type=float, default=0.1,
+                        help="move types with less baseline CPU time [s] are reported but not compared")
+    parser.add_argument("--cases", nargs="+", choices=sorted(CASES), default=sorted(CASES))
+    parser.add_argument("--seed", type=int, default=12345)
+    parser.add_argument("--threads", type=int, default=1)
+    parser.add_argument("--repeat", type=int, default=1, help="number of runs per case, the fastest is kept")
+    args = parser.parse_args()
+
+    # the runs change the working directory, so the paths given are made absolute
+    args.raspa = args.raspa.resolve()
+    args.examples = args.examples.resolve()
+    args.work_dir = args.work_dir.resolve()
+
+    args.work_dir.mkdir(parents=True, exist_ok=True)
+
+    results = {
+        "machine": {"platform": platform.platform(), "processor": platform.processor(), "cpus": os.cpu_count()},
+        "settings": {"seed": args.seed, "threads": args.threads, "repeat": args.repeat},
+        "cases": {},
+    }
+    for name in args.cases:
+        print(f"running {name}", flush=True)
+        results["cases"][name] = run_case(args, name)
+
+    with open(args.output, "w") as file:
+        json.dump(results, file, indent=2)
+    print(f"results written to '{args.output}'")
+
+    if args.baseline is None:
+        return 0
+
+    if args.update_baseline:
+        shutil.copyfile(args.output, args.baseline)
+        print(f"baseline written to '{args.baseline}'")
+        return 0
+
+    if not args.baseline.exists():
+        print(f"baseline '{args.baseline}' not found, create it with --update-baseline")
+        return 0
+
+    with open(args.baseline, "r") as file:
+        baseline = json.load(file)
+    if baseline.get("settings") != results["settings"]:
+        print(f"warning: baseline settings {baseline.get('settings')} differ from {results['settings']}")
+
+    regressions = compare(results, baseline, args.tolerance, args.memory_tolerance, args.minimum_move_time)
+    if regressions:
+        print(f"\n{len(regressions)} performance regression(s) beyond the tolerance:")
+        for regression in regressions:
+            print(f"  {regression}")
+        return 1
+    print("\nno performance regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,3 +1,6 @@
+import queue
+import threading
+
 import raspa.raspalib as raspalib
 
 from .base import RaspaBase
@@ -113,3 +116,70 @@ class MonteCarlo(RaspaBase):
         Runs just the production.
         """
         self._cpp_obj.production()
+
+    def setReportCallback(self, callback, every: int = 1000):
+        """
+        Calls a function with the status report every `every` production cycles, without writing files.
+
+        The callback runs on the simulation thread. The simulation releases the GIL, so several MonteCarlo objects
+        can run concurrently from Python threads.
+
+        Args:
+            callback: A function taking the report dict, or None to remove the callback.
+            every (int, optional): The number of production cycles between reports. Defaults to 1000.
+        """
+        self._cpp_obj.setReportCallback(callback, every)
+
+    def statusReport(self):
+        """
+        Returns the current status report: per system the loadings, energies (in K) and pressure (in bar), each with
+        the current value, block average and error, and the move statistics.
+
+        While the simulation runs in another thread, this is the report taken at its last print or report point.
+        """
+        return self._cpp_obj.statusReport()
+
+    def requestStop(self):
+        """
+        Ends the production run after the current cycle. The simulation still writes its final output and restart
+        file. Can be called from any thread.
+        """
+        self._cpp_obj.requestStop()
+
+    def reports(self, every: int = 1000):
+        """
+        Runs the simulation in a background thread and yields the status reports as they are produced.
+
+        Exceptions raised by the simulation are re-raised here once the reports up to that point have been yielded.
+
+        Leaving the loop early (break, or closing the generator) stops the simulation after its current production
+        cycle. The stopped simulation writes its final output over the cycles run.
+
+        Args:
+            every (int, optional): The number of production cycles between reports. Defaults to 1000.
+        """
+        finished = object()
+        pending = queue.Queue()
+        failure = []
+
+        def simulate():
+            try:
+                self._cpp_obj.run()
+            except Exception as error:
+                failure.append(error)
+            finally:
+                pending.put(finished)
+
+        self.setReportCallback(pending.put, every)
+        thread = threading.Thread(target=simulate, daemon=True)
+        thread.start()
+        try:
+            while (report := pending.get()) is not finished:
+                yield report
+        finally:
+            if thread.is_alive():
+                self.requestStop()
+            thread.join()
+            self.setReportCallback(None)
+        if failure:
+            raise failure[0]
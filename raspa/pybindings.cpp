@@ -8,17 +8,34 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <cstddef>
 #include <exception>
 
 #pragma clang diagnostic pop
 
 #ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <format>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 #endif
 
 #ifndef USE_LEGACY_HEADERS
+import <algorithm>;
+import <format>;
+import <limits>;
+import <memory>;
+import <mutex>;
+import <optional>;
 import <span>;
+import <stdexcept>;
+import <utility>;
 import <vector>;
 #endif
 
@@ -39,6 +56,262 @@ import system;
 import randomnumbers;
 import monte_carlo;
 import input_reader;
+import json;
+import interactions_framework_molecule;
+import interactions_intermolecular;
+import interactions_ewald;
+import interactions_external_field;
+import integrators_update;
+
+namespace
+{
+using Configurations = pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>;
+
+/**
+ * \brief A numpy view on one field of every atom of the system, without copying.
+ *
+ * The view strides over 'System::atomPositions' (framework atoms first, then the adsorbate atoms) and keeps the
+ * Python system object alive. It dangles once the atom vector is reallocated, which bumps
+ * 'System::atomPositionsVersion'; the Python 'AtomArrayView' checks that version before every access.
+ */
+template <typename T>
+pybind11::array_t<T> atomView(pybind11::object owner, std::vector<Atom> &atoms, size_t offset, size_t columns,
+                              bool writeable)
+{
+  T *data = atoms.empty() ? nullptr : reinterpret_cast<T *>(reinterpret_cast<char *>(atoms.data()) + offset);
+  std::vector<pybind11::ssize_t> shape{static_cast<pybind11::ssize_t>(atoms.size())};
+  std::vector<pybind11::ssize_t> strides{static_cast<pybind11::ssize_t>(sizeof(Atom))};
+  if (columns > 1)
+  {
+    shape.push_back(static_cast<pybind11::ssize_t>(columns));
+    strides.push_back(static_cast<pybind11::ssize_t>(sizeof(T)));
+  }
+
+  pybind11::array_t<T> view(shape, strides, data, owner);
+  if (!writeable)
+  {
+    view.attr("setflags")(pybind11::arg("write") = false);
+  }
+  return view;
+}
+
+/**
+ * \brief Computes the total energy, and optionally the gradients, of a batch of adsorbate configurations.
+ *
+ * 'configurations' has shape (n, number of adsorbate atoms, 3). The positions of the adsorbate atoms are replaced by
+ * each configuration in turn with the GIL released; afterwards the original atoms are restored. Energies and
+ * gradients are in internal units, like 'computeTotalEnergies'.
+ */
+std::pair<pybind11::array_t<double>, std::optional<pybind11::array_t<double>>> computeEnergies(
+    System &system, Configurations configurations, bool computeGradients)
+{
+  std::span<Atom> moleculeAtoms = system.spanOfMoleculeAtoms();
+  if (configurations.ndim() != 3 || static_cast<size_t>(configurations.shape(1)) != moleculeAtoms.size() ||
+      configurations.shape(2) != 3)
+  {
+    throw std::runtime_error(
+        std::format("[computeEnergies]: configurations must have shape (n, {}, 3)\n", moleculeAtoms.size()));
+  }
+
+  size_t numberOfConfigurations = static_cast<size_t>(configurations.shape(0));
+  size_t numberOfAtoms = moleculeAtoms.size();
+  pybind11::array_t<double> energies(static_cast<pybind11::ssize_t>(numberOfConfigurations));
+  std::optional<pybind11::array_t<double>> gradients{};
+  if (computeGradients)
+  {
+    gradients = pybind11::array_t<double>(std::vector<pybind11::ssize_t>{
+        static_cast<pybind11::ssize_t>(numberOfConfigurations), static_cast<pybind11::ssize_t>(numberOfAtoms), 3});
+  }
+
+  const double *positions = configurations.data();
+  double *energyData = energies.mutable_data();
+  double *gradientData = computeGradients ? gradients->mutable_data() : nullptr;
+  {
+    pybind11::gil_scoped_release release;
+
+    std::vector<Atom> storedAtoms(moleculeAtoms.begin(), moleculeAtoms.end());
+    for (size_t i = 0; i != numberOfConfigurations; ++i)
+    {
+      const double *configuration = positions + 3 * numberOfAtoms * i;
+      for (size_t j = 0; j != numberOfAtoms; ++j)
+      {
+        moleculeAtoms[j].position =
+            double3(configuration[3 * j], configuration[3 * j + 1], configuration[3 * j + 2]);
+      }
+
+      if (computeGradients)
+      {
+        // the gradient kernels leave out the tail corrections, which only depend on the number of atoms per type
+        RunningEnergy energy =
+            Integrators::updateGradients(moleculeAtoms, system.spanOfFrameworkAtoms(), system.forceField,
+                                         system.simulationBox, system.components, system.eik_x, system.eik_y,
+                                         system.eik_z, system.eik_xy, system.totalEik, system.fixedFrameworkStoredEik,
+                                         system.numberOfMoleculesPerComponent) +
+            Interactions::computeFrameworkMoleculeTailEnergy(system.forceField, system.simulationBox,
+                                                             system.spanOfFrameworkAtoms(), moleculeAtoms) +
+            Interactions::computeInterMolecularTailEnergy(system.forceField, system.simulationBox, moleculeAtoms);
+        energyData[i] = energy.potentialEnergy();
+
+        double *gradient = gradientData + 3 * numberOfAtoms * i;
+        for (size_t j = 0; j != numberOfAtoms; ++j)
+        {
+          gradient[3 * j] = moleculeAtoms[j].gradient.x;
+          gradient[3 * j + 1] = moleculeAtoms[j].gradient.y;
+          gradient[3 * j + 2] = moleculeAtoms[j].gradient.z;
+        }
+      }
+      else
+      {
+        energyData[i] = system.computeTotalEnergies().potentialEnergy();
+      }
+    }
+
+    // restore the atoms and the stored Fourier components of the original configuration
+    std::copy(storedAtoms.begin(), storedAtoms.end(), moleculeAtoms.begin());
+    if (numberOfConfigurations > 0)
+    {
+      [[maybe_unused]] RunningEnergy energy = system.computeTotalEnergies();
+    }
+  }
+
+  return {energies, gradients};
+}
+
+/**
+ * \brief Computes the insertion energy of a single pseudo atom at every point of 'points' (shape (n, 3)).
+ *
+ * The probe interacts with the framework, the adsorbates, the external field, and (when charged) the Fourier part of
+ * the Ewald sum, as in an insertion move. Points that overlap give an infinite energy. The GIL is released during
+ * the computation. Energies are in internal units.
+ */
+pybind11::array_t<double> computeInsertionEnergies(System &system, size_t pseudoAtomType, Configurations points)
+{
+  if (pseudoAtomType >= system.forceField.pseudoAtoms.size())
+  {
+    throw std::runtime_error(std::format("[computeInsertionEnergies]: pseudo atom type {} does not exist\n",
+                                         pseudoAtomType));
+  }
+  if (points.ndim() != 2 || points.shape(1) != 3)
+  {
+    throw std::runtime_error("[computeInsertionEnergies]: points must have shape (n, 3)\n");
+  }
+
+  size_t numberOfPoints = static_cast<size_t>(points.shape(0));
+  pybind11::array_t<double> energies(static_cast<pybind11::ssize_t>(numberOfPoints));
+
+  const double *positions = points.data();
+  double *energyData = energies.mutable_data();
+  {
+    pybind11::gil_scoped_release release;
+
+    // the insertion kernels expect the stored Fourier components of the current configuration
+    [[maybe_unused]] RunningEnergy current = system.computeTotalEnergies();
+
+    // a component id that matches no adsorbate, so the probe interacts with every molecule
+    Atom probe(double3(0.0, 0.0, 0.0), system.forceField.pseudoAtoms[pseudoAtomType].charge, 1.0, 0,
+               static_cast<uint16_t>(pseudoAtomType), static_cast<uint8_t>(system.components.size()), 0);
+    std::span<const Atom> trial(&probe, 1);
+    for (size_t i = 0; i != numberOfPoints; ++i)
+    {
+      probe.position = double3(positions[3 * i], positions[3 * i + 1], positions[3 * i + 2]);
+
+      std::optional<RunningEnergy> externalField = Interactions::computeExternalFieldEnergyDifference(
+          system.hasExternalField, system.forceField, system.simulationBox, trial, {});
+      std::optional<RunningEnergy> frameworkMolecule = Interactions::computeFrameworkMoleculeEnergyDifference(
+          system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trial, {});
+      std::optional<RunningEnergy> interMolecule = Interactions::computeInterMolecularEnergyDifference(
+          system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trial, {});
+      if (!externalField.has_value() || !frameworkMolecule.has_value() || !interMolecule.has_value())
+      {
+        energyData[i] = std::numeric_limits<double>::infinity();
+        continue;
+      }
+
+      RunningEnergy fourier = Interactions::energyDifferenceEwaldFourier(
+          system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik,
+          system.forceField, system.simulationBox, trial, {});
+      RunningEnergy tail = Interactions::computeInterMolecularTailEnergyDifference(
+                               system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trial, {}) +
+                           Interactions::computeFrameworkMoleculeTailEnergyDifference(
+                               system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trial, {});
+
+      energyData[i] =
+          (externalField.value() + frameworkMolecule.value() + interMolecule.value() + fourier + tail)
+              .potentialEnergy();
+    }
+  }
+
+  return energies;
+}
+
+pybind11::object toPython(const nlohmann::json &json)
+{
+  return pybind11::module_::import("json").attr("loads")(json.dump());
+}
+
+/**
+ * \brief Calls 'callback' with the status report (as a dict) every 'every' production cycles; None removes it.
+ *
+ * The simulation runs without the GIL, so the callback acquires it for the duration of the call only. The Python
+ * function is released under the GIL as well, whichever thread drops the last copy of the callback.
+ */
+void setReportCallback(MonteCarlo &monteCarlo, std::optional<pybind11::function> callback, size_t every)
+{
+  monteCarlo.reportEvery = every;
+  if (!callback.has_value())
+  {
+    monteCarlo.reportCallback = nullptr;
+    return;
+  }
+
+  std::shared_ptr<pybind11::function> function(new pybind11::function(std::move(callback.value())),
+                                               [](pybind11::function *f)
+                                               {
+                                                 pybind11::gil_scoped_acquire acquire;
+                                                 delete f;
+                                               });
+  monteCarlo.reportCallback = [function](const nlohmann::json &report)
+  {
+    pybind11::gil_scoped_acquire acquire;
+    (*function)(toPython(report));
+  };
+}
+
+/**
+ * \brief Runs a simulation stage without the GIL, marking the simulation as running while it does.
+ *
+ * The flag is set before the GIL is released, so a 'statusReport' from another Python thread either sees it set and
+ * returns the snapshot of the last report point, or runs before the stage starts writing the systems.
+ */
+template <void (MonteCarlo::*stage)()>
+void runStage(MonteCarlo &monteCarlo)
+{
+  if (monteCarlo.running.exchange(true))
+  {
+    throw std::runtime_error("MonteCarlo is already running");
+  }
+  {
+    std::scoped_lock lock(monteCarlo.statusReportMutex);
+    monteCarlo.latestStatusReport = monteCarlo.jsonStatusReport();
+  }
+  try
+  {
+    pybind11::gil_scoped_release release;
+    (monteCarlo.*stage)();
+  }
+  catch (...)
+  {
+    monteCarlo.running = false;
+    throw;
+  }
+  monteCarlo.running = false;
+}
+
+pybind11::object statusReport(const MonteCarlo &monteCarlo)
+{
+  return toPython(monteCarlo.running ? monteCarlo.lastStatusReport() : monteCarlo.jsonStatusReport());
+}
+}  // namespace
 
 PYBIND11_MODULE(raspalib, m)
 {
@@ -194,7 +467,42 @@ PYBIND11_MODULE(raspalib, m)
            pybind11::arg("frameworkComponents"), pybind11::arg("components"), pybind11::arg("initialNumberOfMolecules"),
            pybind11::arg("numberOfBlocks"), pybind11::arg("systemProbabilities"), pybind11::arg("sampleMoviesEvery"))
       .def("computeTotalEnergies", &System::computeTotalEnergies)
-      .def_readwrite("atomPositions", &System::atomPositions)
+      .def("computeEnergies", &computeEnergies, pybind11::arg("configurations"), pybind11::arg("gradients") = false)
+      .def("computeInsertionEnergies", &computeInsertionEnergies, pybind11::arg("pseudoAtomType"),
+           pybind11::arg("points"))
+      .def_property(
+          "atomPositions", [](const System &system) { return system.atomPositions; },
+          [](System &system, std::vector<Atom> atoms)
+          {
+            system.atomPositions = std::move(atoms);
+            ++system.atomPositionsVersion;
+          })
+      .def_readonly("atomPositionsVersion", &System::atomPositionsVersion)
+      .def_readonly("numberOfFrameworkAtoms", &System::numberOfFrameworkAtoms)
+      .def_property_readonly("positionsView",
+                             [](pybind11::object self)
+                             {
+                               System &system = self.cast<System &>();
+                               return atomView<double>(self, system.atomPositions, offsetof(Atom, position), 3, true);
+                             })
+      .def_property_readonly("chargesView",
+                             [](pybind11::object self)
+                             {
+                               System &system = self.cast<System &>();
+                               return atomView<double>(self, system.atomPositions, offsetof(Atom, charge), 1, true);
+                             })
+      .def_property_readonly("typesView",
+                             [](pybind11::object self)
+                             {
+                               System &system = self.cast<System &>();
+                               return atomView<uint16_t>(self, system.atomPositions, offsetof(Atom, type), 1, false);
+                             })
+      .def_property_readonly("gradientsView",
+                             [](pybind11::object self)
+                             {
+                               System &system = self.cast<System &>();
+                               return atomView<double>(self, system.atomPositions, offsetof(Atom, gradient), 3, false);
+                             })
       .def("__repr__", &System::repr);
 
   pybind11::class_<InputReader> inputReader(m, "InputReader");
@@ -221,6 +529,7 @@ PYBIND11_MODULE(raspalib, m)
       .value("MixturePrediction", InputReader::SimulationType::MixturePrediction)
       .value("Fitting", InputReader::SimulationType::Fitting)
       .value("ParallelTempering", InputReader::SimulationType::ParallelTempering)
+      .value("Screening", InputReader::SimulationType::Screening)
       .export_values();
 
   pybind11::class_<MonteCarlo> mc(m, "MonteCarlo");
@@ -232,11 +541,14 @@ PYBIND11_MODULE(raspalib, m)
          pybind11::arg("optimizeMCMovesEvery"), pybind11::arg("systems"), pybind11::arg("randomSeed"),
          pybind11::arg("numberOfBlocks"))
       .def(pybind11::init<InputReader &>(), pybind11::arg("inputReader"))
-      .def("run", &MonteCarlo::run)
-      .def("initialize", &MonteCarlo::initialize)
-      .def("equilibrate", &MonteCarlo::equilibrate)
-      .def("production", &MonteCarlo::production)
-      .def("cycle", &MonteCarlo::performCycle)
+      .def("run", &runStage<&MonteCarlo::run>)
+      .def("initialize", &runStage<&MonteCarlo::initialize>)
+      .def("equilibrate", &runStage<&MonteCarlo::equilibrate>)
+      .def("production", &runStage<&MonteCarlo::production>)
+      .def("cycle", &runStage<&MonteCarlo::performCycle>)
+      .def("requestStop", &MonteCarlo::requestStop, pybind11::call_guard<pybind11::gil_scoped_release>())
+      .def("setReportCallback", &setReportCallback, pybind11::arg("callback"), pybind11::arg("every") = 1000)
+      .def("statusReport", &statusReport)
       .def_readwrite("simulationStage", &MonteCarlo::simulationStage);
 
   pybind11::enum_<MonteCarlo::SimulationStage>(mc, "SimulationStage")
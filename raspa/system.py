@@ -10,6 +10,52 @@ from .mcmoveprobabilities import MCMoveProbabilitiesSystem
 import numpy as np
 
 
+class AtomArrayView:
+    """
+    A numpy view on one field of the atoms of a system, sharing memory with the system.
+
+    Inserting or removing molecules may reallocate the atoms, after which the memory of the view is no longer owned
+    by the system. Every access therefore first checks that the atoms are unchanged, and raises otherwise. Arrays
+    taken from the view (np.asarray, slices) share its memory but are not checked, so use them right away.
+    """
+
+    def __init__(self, cpp_system, field: str):
+        self._system = cpp_system
+        self._version = cpp_system.atomPositionsVersion
+        self._array = getattr(cpp_system, field)
+
+    @property
+    def valid(self) -> bool:
+        """
+        Whether the atoms of the system are still the ones the view was taken from.
+        """
+        return self._system.atomPositionsVersion == self._version
+
+    def _checked(self) -> np.ndarray:
+        if not self.valid:
+            raise RuntimeError("the atoms of the system were reallocated, take a new view")
+        return self._array
+
+    @property
+    def shape(self):
+        return self._checked().shape
+
+    def __len__(self):
+        return len(self._checked())
+
+    def __array__(self, dtype=None, copy=None):
+        array = self._checked()
+        if copy:
+            return np.array(array, dtype=dtype)
+        return array if dtype is None else array.astype(dtype, copy=False)
+
+    def __getitem__(self, index):
+        return self._checked()[index]
+
+    def __setitem__(self, index, value):
+        self._checked()[index] = value
+
+
 class System(RaspaBase):
     """
     A class representing a system in RASPA.
@@ -57,12 +103,12 @@ class System(RaspaBase):
     @property
     def atomPositions(self):
         """
-        Get the positions of the atoms in the system.
+        Get the positions of the atoms in the system (framework atoms first, then the adsorbate atoms).
 
         Returns:
-            np.ndarray: An array of atom positions.
+            np.ndarray: An (n, 3) copy of the atom positions.
         """
-        return np.array([[atom.position.x, atom.position.y, atom.position.z] for atom in self._cpp_obj.atomPositions])
+        return np.array(self._cpp_obj.positionsView)
 
     @atomPositions.setter
     def atomPositions(self, index_position_tuple: tuple[np.ndarray, np.ndarray]):
@@ -73,8 +119,62 @@ class System(RaspaBase):
             index_position_tuple (tuple[np.ndarray, np.ndarray]): A tuple containing an array of indices and an array of positions.
         """
         indices, position = index_position_tuple
-        for i, idx in enumerate(indices):
-            setattr(self.atomPositions[idx], "position", raspalib.double3(*position[i]))
+        self._cpp_obj.positionsView[np.asarray(indices)] = np.asarray(position, dtype=np.float64)
+
+    def atomPositionsView(self):
+        """
+        Get a writable (n, 3) view on the atom positions that shares memory with the system, without copying.
+
+        Returns:
+            AtomArrayView: The view; it raises once molecules are inserted or removed.
+        """
+        return AtomArrayView(self._cpp_obj, "positionsView")
+
+    def atomChargesView(self):
+        """
+        Get a writable (n,) view on the atom charges that shares memory with the system, without copying.
+
+        Returns:
+            AtomArrayView: The view; it raises once molecules are inserted or removed.
+        """
+        return AtomArrayView(self._cpp_obj, "chargesView")
+
+    @property
+    def charges(self):
+        """
+        Get the charges of the atoms in the system.
+
+        Returns:
+            np.ndarray: An (n,) copy of the atom charges.
+        """
+        return np.array(self._cpp_obj.chargesView)
+
+    @property
+    def types(self):
+        """
+        Get the pseudo-atom types of the atoms in the system.
+
+        Returns:
+            np.ndarray: An (n,) copy of the atom types.
+        """
+        return np.array(self._cpp_obj.typesView)
+
+    @property
+    def gradients(self):
+        """
+        Get the gradients of the atoms in the system, as left by the last gradient computation.
+
+        Returns:
+            np.ndarray: An (n, 3) copy of the atom gradients.
+        """
+        return np.array(self._cpp_obj.gradientsView)
+
+    @property
+    def numberOfFrameworkAtoms(self):
+        """
+        Get the number of framework atoms, which precede the adsorbate atoms in the atom arrays.
+        """
+        return self._cpp_obj.numberOfFrameworkAtoms
 
     def computeTotalEnergies(self):
         """
@@ -84,3 +184,34 @@ class System(RaspaBase):
             The total energies of the system.
         """
         return self._cpp_obj.computeTotalEnergies()
+
+    def computeEnergies(self, configurations: np.ndarray, gradients: bool = False):
+        """
+        Compute the total energy of a batch of adsorbate configurations in one call.
+
+        The GIL is released during the computation and the system is restored to its configuration afterwards.
+
+        Args:
+            configurations (np.ndarray): Adsorbate atom positions of shape (n, number of adsorbate atoms, 3).
+            gradients (bool, optional): Also compute the gradients on the adsorbate atoms. Default is False.
+
+        Returns:
+            tuple[np.ndarray, np.ndarray | None]: The energies of shape (n,) and, when requested, the gradients of
+                shape (n, number of adsorbate atoms, 3), in internal units.
+        """
+        return self._cpp_obj.computeEnergies(configurations, gradients)
+
+    def computeInsertionEnergies(self, pseudoAtomType: int, points: np.ndarray):
+        """
+        Compute the energy of inserting a single pseudo atom at each of the given points.
+
+        The GIL is released during the computation.
+
+        Args:
+            pseudoAtomType (int): The index of the pseudo atom in the force field.
+            points (np.ndarray): Insertion points of shape (n, 3).
+
+        Returns:
+            np.ndarray: The insertion energies of shape (n,) in internal units; overlapping points give infinity.
+        """
+        return self._cpp_obj.computeInsertionEnergies(pseudoAtomType, points)
@@ -0,0 +1,205 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <utility>
+#endif
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+module checkpoint;
+
+#ifndef USE_LEGACY_HEADERS
+import <algorithm>;
+import <bit>;
+import <cstddef>;
+import <cstdint>;
+import <exception>;
+import <filesystem>;
+import <format>;
+import <fstream>;
+import <future>;
+import <iostream>;
+import <optional>;
+import <print>;
+import <string>;
+import <string_view>;
+import <utility>;
+#endif
+
+// flushes a file (or directory) to disk, so a rename never exposes a partially written checkpoint after a crash
+static void synchronizeToDisk([[maybe_unused]] const std::filesystem::path &path)
+{
+#if !defined(_WIN32)
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0)
+  {
+    ::fsync(fd);
+    ::close(fd);
+  }
+#endif
+}
+
+Checkpoint::~Checkpoint()
+{
+  if (pendingWrite.valid())
+  {
+    pendingWrite.wait();
+  }
+}
+
+void Checkpoint::writeAsync(std::string data)
+{
+  wait();
+
+  pendingWrite = std::async(std::launch::async, [fileName = fileName, numberOfCheckpoints = numberOfCheckpoints,
+                                                 data = std::move(data)]()
+                            { writeFile(fileName, numberOfCheckpoints, data); });
+}
+
+void Checkpoint::wait()
+{
+  if (pendingWrite.valid())
+  {
+    pendingWrite.get();
+  }
+}
+
+uint64_t Checkpoint::checksum(std::string_view data)
+{
+  // 64-bit FNV-1a
+  uint64_t hash{14695981039346656037ull};
+  for (char c : data)
+  {
+    hash ^= static_cast<uint64_t>(static_cast<unsigned char>(c));
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+std::string Checkpoint::rotatedFileName(const std::string &fileName, size_t index)
+{
+  return index == 0 ? fileName : std::format("{}.{}", fileName, index);
+}
+
+void Checkpoint::writeFile(const std::string &fileName, size_t numberOfCheckpoints, const std::string &data)
+{
+  std::string temporaryFileName = fileName + "_temp";
+
+  std::ofstream ofile(temporaryFileName, std::ios::binary);
+  if (!ofile)
+  {
+    throw std::runtime_error(std::format("[Checkpoint]: cannot open '{}' for writing\n", temporaryFileName));
+  }
+
+  uint64_t size = data.size();
+  uint64_t hash = checksum(data);
+  ofile.write(magic.data(), static_cast<std::streamsize>(magic.size()));
+  ofile.write(std::bit_cast<const char *>(&formatVersion), sizeof(uint64_t));
+  ofile.write(std::bit_cast<const char *>(&size), sizeof(uint64_t));
+  ofile.write(std::bit_cast<const char *>(&hash), sizeof(uint64_t));
+  ofile.write(data.data(), static_cast<std::streamsize>(data.size()));
+  ofile.close();
+  if (!ofile)
+  {
+    throw std::runtime_error(std::format("[Checkpoint]: error writing '{}'\n", temporaryFileName));
+  }
+  synchronizeToDisk(temporaryFileName);
+
+  // shift the older checkpoints, dropping the oldest
+  for (size_t index = numberOfCheckpoints - 1; index > 0; --index)
+  {
+    std::string olderFileName = rotatedFileName(fileName, index - 1);
+    if (std::filesystem::exists(olderFileName))
+    {
+      std::filesystem::rename(olderFileName, rotatedFileName(fileName, index));
+    }
+  }
+  std::filesystem::rename(temporaryFileName, fileName);
+
+  std::filesystem::path directory = std::filesystem::absolute(fileName).parent_path();
+  synchronizeToDisk(directory);
+}
+
+std::ifstream Checkpoint::open(const std::string &fileName, size_t numberOfCheckpoints)
+{
+  // the newest file without a header, read only when none of the checkpoints has a valid header
+  std::optional<std::string> legacyFileName{};
+
+  for (size_t index = 0; index < std::max(numberOfCheckpoints, size_t{1}); ++index)
+  {
+    std::string name = rotatedFileName(fileName, index);
+    std::ifstream ifile(name, std::ios::binary);
+    if (!ifile.is_open()) continue;
+
+    // a file shorter than the header is an interrupted write, not a checkpoint of an older version
+    std::uintmax_t fileSize = std::filesystem::file_size(name);
+    if (fileSize < static_cast<std::uintmax_t>(headerSize))
+    {
+      std::print(std::cerr, "[Checkpoint]: '{}' is incomplete, trying an older checkpoint\n", name);
+      continue;
+    }
+
+    std::string header(magic.size(), '\0');
+    ifile.read(header.data(), static_cast<std::streamsize>(header.size()));
+    if (header != magic)
+    {
+      if (!legacyFileName.has_value())
+      {
+        legacyFileName = name;
+      }
+      continue;
+    }
+
+    uint64_t version{};
+    uint64_t size{};
+    uint64_t hash{};
+    ifile.read(std::bit_cast<char *>(&version), sizeof(uint64_t));
+    ifile.read(std::bit_cast<char *>(&size), sizeof(uint64_t));
+    ifile.read(std::bit_cast<char *>(&hash), sizeof(uint64_t));
+
+    // a truncated file is detected before allocating the buffer
+    if (!ifile || size != fileSize - static_cast<std::uintmax_t>(headerSize))
+    {
+      std::print(std::cerr, "[Checkpoint]: '{}' is incomplete, trying an older checkpoint\n", name);
+      continue;
+    }
+
+    std::string data(size, '\0');
+    ifile.read(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!ifile || version > formatVersion || checksum(data) != hash)
+    {
+      std::print(std::cerr, "[Checkpoint]: '{}' is corrupt, trying an older checkpoint\n", name);
+      continue;
+    }
+
+    ifile.clear();
+    ifile.seekg(headerSize);
+    return ifile;
+  }
+
+  // checkpoint without header, written by an older version
+  if (legacyFileName.has_value())
+  {
+    std::print(std::cerr, "[Checkpoint]: reading '{}' as a restart file without header\n", legacyFileName.value());
+    return std::ifstream(legacyFileName.value(), std::ios::binary);
+  }
+
+  throw std::runtime_error(std::format("[Checkpoint]: no valid restart file '{}' found\n", fileName));
+}
@@ -0,0 +1,104 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#endif
+
+export module checkpoint;
+
+#ifndef USE_LEGACY_HEADERS
+import <algorithm>;
+import <cstddef>;
+import <cstdint>;
+import <string>;
+import <string_view>;
+import <fstream>;
+import <ostream>;
+import <sstream>;
+import <future>;
+import <utility>;
+#endif
+
+import archive;
+
+/**
+ * \brief Asynchronous, checksummed and rotated binary checkpoints.
+ *
+ * The object is serialized on the calling thread into an in-memory buffer, which is a consistent snapshot of the
+ * state. The buffer is then handed to a background thread that writes it to a temporary file, flushes it to disk
+ * (fsync), rotates the previous checkpoints ('restart_data.bin' -> 'restart_data.bin.1' -> ...) and renames the
+ * temporary file into place. At most one write is in flight: a new checkpoint first waits for the previous one, so
+ * at most two buffers exist at any time (double buffering).
+ *
+ * Each file starts with a header holding a magic string, the format version, the payload size and a 64-bit FNV-1a
+ * checksum of the payload. On reading, the newest checkpoint that passes the checksum is used. A file without a
+ * header (written by an older version) is read as is, but only when no checkpoint with a valid header exists.
+ */
+export class Checkpoint
+{
+ public:
+  static constexpr std::string_view magic{"RASPACKP"};
+  static constexpr uint64_t formatVersion{1};
+  static constexpr std::streamoff headerSize{static_cast<std::streamoff>(magic.size() + 3 * sizeof(uint64_t))};
+
+  Checkpoint(std::string fileName = "restart_data.bin", size_t numberOfCheckpoints = 1)
+      : fileName(std::move(fileName)), numberOfCheckpoints(std::max(numberOfCheckpoints, size_t{1}))
+  {
+  }
+  Checkpoint(Checkpoint &&) = default;
+  Checkpoint &operator=(Checkpoint &&) = default;
+  ~Checkpoint();
+
+  /**
+   * \brief Snapshots the object into memory and writes it to disk in the background.
+   */
+  template <typename T>
+  void write(const T &object)
+  {
+    // an unopened ofstream redirected to a string buffer, so all existing 'Archive<std::ofstream>' operators apply
+    std::stringbuf buffer(std::ios::out | std::ios::binary);
+    std::ofstream stream;
+    static_cast<std::ostream &>(stream).rdbuf(&buffer);
+    Archive<std::ofstream> archive(stream);
+    archive << object;
+
+    writeAsync(std::move(buffer).str());
+  }
+
+  /**
+   * \brief Writes a serialized snapshot to disk in the background, after the previous write has finished.
+   */
+  void writeAsync(std::string data);
+
+  /**
+   * \brief Waits for the pending write, rethrowing any error that occurred in the background.
+   */
+  void wait();
+
+  /**
+   * \brief Opens the newest valid checkpoint, positioned at the start of the serialized data.
+   *
+   * \param fileName The name of the newest checkpoint; older ones have the suffixes '.1', '.2', ...
+   * \param numberOfCheckpoints The number of rotated checkpoints to consider.
+   */
+  static std::ifstream open(const std::string &fileName = "restart_data.bin", size_t numberOfCheckpoints = 1);
+
+  static uint64_t checksum(std::string_view data);
+  static std::string rotatedFileName(const std::string &fileName, size_t index);
+
+ private:
+  std::string fileName;
+  size_t numberOfCheckpoints;
+  std::future<void> pendingWrite{};
+
+  static void writeFile(const std::string &fileName, size_t numberOfCheckpoints, const std::string &data);
+};
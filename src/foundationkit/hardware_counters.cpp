@@ -0,0 +1,282 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <print>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+module hardware_counters;
+
+#ifndef USE_LEGACY_HEADERS
+import <array>;
+import <atomic>;
+import <cstddef>;
+import <cstdint>;
+import <cstring>;
+import <format>;
+import <map>;
+import <memory>;
+import <mutex>;
+import <print>;
+import <sstream>;
+import <string>;
+import <unordered_map>;
+import <vector>;
+#endif
+
+import json;
+
+namespace
+{
+constexpr std::array<const char *, HardwareCounters::numberOfCounters> counterNames{"cycles", "instructions",
+                                                                                     "cacheMisses", "branchMisses"};
+
+// the totals of one thread; kept alive in the registry after the thread exits
+struct ThreadTotals
+{
+  std::mutex mutex;
+  std::unordered_map<std::string, HardwareCounters::Totals> zones;
+};
+
+std::mutex registryMutex;
+std::vector<std::shared_ptr<ThreadTotals>> registry;
+std::array<bool, HardwareCounters::numberOfCounters> availableCounters{};
+
+// the open counter group of one thread, closed when the thread exits
+struct ThreadCounters
+{
+  bool opened{false};
+  int leader{-1};
+  std::array<int, HardwareCounters::numberOfCounters> fds{-1, -1, -1, -1};
+  std::shared_ptr<ThreadTotals> totals;
+
+  ~ThreadCounters()
+  {
+#if defined(__linux__)
+    for (int fd : fds)
+    {
+      if (fd >= 0) close(fd);
+    }
+#endif
+  }
+
+  void open()
+  {
+    opened = true;
+#if defined(__linux__)
+    const std::array<uint64_t, HardwareCounters::numberOfCounters> configs{
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (size_t i = 0; i != configs.size(); ++i)
+    {
+      perf_event_attr attribute;
+      std::memset(&attribute, 0, sizeof(attribute));
+      attribute.type = PERF_TYPE_HARDWARE;
+      attribute.size = sizeof(attribute);
+      attribute.config = configs[i];
+      attribute.disabled = leader < 0 ? 1 : 0;
+      attribute.exclude_kernel = 1;
+      attribute.exclude_hv = 1;
+      attribute.read_format =
+          PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      // counters that cannot be opened are left out of the group
+      int fd = static_cast<int>(syscall(SYS_perf_event_open, &attribute, 0, -1, leader, 0));
+      if (fd < 0) continue;
+      fds[i] = fd;
+      if (leader < 0) leader = fd;
+    }
+    if (leader >= 0)
+    {
+      ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  HardwareCounters::Values read()
+  {
+    if (!opened) open();
+    HardwareCounters::Values values{};
+#if defined(__linux__)
+    if (leader < 0) return values;
+
+    // layout: nr, time_enabled, time_running, followed by (value, id) pairs in group order; the counters of a group
+    // are scheduled together, so they share the enabled and running times
+    std::array<uint64_t, 3 + 2 * HardwareCounters::numberOfCounters> buffer{};
+    if (::read(leader, buffer.data(), sizeof(buffer)) <= 0) return values;
+    values.timeEnabled = buffer[1];
+    values.timeRunning = buffer[2];
+    size_t slot = 0;
+    for (size_t i = 0; i != fds.size() && slot < buffer[0]; ++i)
+    {
+      if (fds[i] < 0) continue;
+      values.value[i] = buffer[3 + 2 * slot];
+      ++slot;
+    }
+#endif
+    return values;
+  }
+};
+
+thread_local ThreadCounters threadCounters;
+
+// the fraction of the enabled time the counters were counting, below one when the kernel multiplexed them
+double runningFraction(const HardwareCounters::Totals &zone)
+{
+  if (zone.counters.timeEnabled == 0) return 1.0;
+  return static_cast<double>(zone.counters.timeRunning) / static_cast<double>(zone.counters.timeEnabled);
+}
+
+ThreadTotals &threadTotals()
+{
+  if (!threadCounters.totals)
+  {
+    threadCounters.totals = std::make_shared<ThreadTotals>();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.push_back(threadCounters.totals);
+  }
+  return *threadCounters.totals;
+}
+}  // namespace
+
+bool HardwareCounters::enable()
+{
+  threadCounters.read();
+  bool any = false;
+  for (size_t i = 0; i != numberOfCounters; ++i)
+  {
+    availableCounters[i] = threadCounters.fds[i] >= 0;
+    any = any || availableCounters[i];
+  }
+  detail::active.store(any);
+  return any;
+}
+
+void HardwareCounters::disable() { detail::active.store(false); }
+
+bool HardwareCounters::available(Counter counter) { return availableCounters[static_cast<size_t>(counter)]; }
+
+HardwareCounters::Values HardwareCounters::read() { return threadCounters.read(); }
+
+void HardwareCounters::accumulate(const char *name, double time, const Values &counters)
+{
+  ThreadTotals &totals = threadTotals();
+  std::lock_guard<std::mutex> lock(totals.mutex);
+  totals.zones[name] += Totals{1, time, counters.scaled()};
+}
+
+std::map<std::string, HardwareCounters::Totals> HardwareCounters::totals()
+{
+  std::map<std::string, Totals> result;
+  std::lock_guard<std::mutex> registryLock(registryMutex);
+  for (const std::shared_ptr<ThreadTotals> &thread : registry)
+  {
+    std::lock_guard<std::mutex> lock(thread->mutex);
+    for (const auto &[name, zone] : thread->zones)
+    {
+      result[name] += zone;
+    }
+  }
+  return result;
+}
+
+void HardwareCounters::clear()
+{
+  std::lock_guard<std::mutex> registryLock(registryMutex);
+  for (const std::shared_ptr<ThreadTotals> &thread : registry)
+  {
+    std::lock_guard<std::mutex> lock(thread->mutex);
+    thread->zones.clear();
+  }
+}
+
+std::string HardwareCounters::writeStatistics()
+{
+  std::ostringstream stream;
+
+  std::print(stream, "Hardware counters of the timed zones\n");
+  std::print(stream, "===============================================================================\n\n");
+
+  if (!enabled())
+  {
+    std::print(stream, "Hardware counters are not available\n\n");
+    return stream.str();
+  }
+
+  std::print(stream, "Process-wide: summed over all threads, and thereby over all systems and jobs of the run.\n");
+  std::print(stream, "Counts of multiplexed counters are extrapolated to the whole zone ('running' < 100%).\n\n");
+
+  // per instruction rates are only meaningful when both counters are present
+  bool ipc = available(Counter::Cycles) && available(Counter::Instructions);
+  bool cacheRate = available(Counter::CacheMisses) && available(Counter::Instructions);
+  bool branchRate = available(Counter::BranchMisses) && available(Counter::Instructions);
+  for (size_t i = 0; i != numberOfCounters; ++i)
+  {
+    if (!availableCounters[i]) std::print(stream, "Counter '{}' is not available\n", counterNames[i]);
+  }
+
+  std::print(stream, "{:44s} {:>10s} {:>12s} {:>8s} {:>12s} {:>12s} {:>8s}\n", "zone", "calls", "time [s]", "IPC",
+             "cache-m/kI", "branch-m/kI", "running");
+  for (const auto &[name, zone] : totals())
+  {
+    double instructions = static_cast<double>(zone.counters[Counter::Instructions]);
+    double perKilo = instructions > 0.0 ? 1000.0 / instructions : 0.0;
+    std::print(stream, "{:44s} {:10d} {:12.6f} {:>8s} {:>12s} {:>12s} {:>7.1f}%\n", name, zone.calls, zone.time,
+               ipc && zone.counters[Counter::Cycles] > 0
+                   ? std::format("{:.3f}", instructions / static_cast<double>(zone.counters[Counter::Cycles]))
+                   : "-",
+               cacheRate ? std::format("{:.3f}", perKilo * static_cast<double>(zone.counters[Counter::CacheMisses]))
+                         : "-",
+               branchRate ? std::format("{:.3f}", perKilo * static_cast<double>(zone.counters[Counter::BranchMisses]))
+                          : "-",
+               100.0 * runningFraction(zone));
+  }
+  std::print(stream, "\n\n");
+
+  return stream.str();
+}
+
+nlohmann::json HardwareCounters::jsonStatistics()
+{
+  nlohmann::json status;
+  status["available"] = enabled();
+  if (!enabled()) return status;
+
+  // the same process-wide totals are written for every system
+  status["scope"] = "process";
+
+  for (size_t i = 0; i != numberOfCounters; ++i)
+  {
+    status["counters"][counterNames[i]] = availableCounters[i];
+  }
+  for (const auto &[name, zone] : totals())
+  {
+    status["zones"][name]["calls"] = zone.calls;
+    status["zones"][name]["time"] = zone.time;
+    status["zones"][name]["runningFraction"] = runningFraction(zone);
+    for (size_t i = 0; i != numberOfCounters; ++i)
+    {
+      if (availableCounters[i]) status["zones"][name][counterNames[i]] = zone.counters.value[i];
+    }
+  }
+  return status;
+}
@@ -0,0 +1,144 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#endif
+
+export module hardware_counters;
+
+#ifndef USE_LEGACY_HEADERS
+import <atomic>;
+import <cmath>;
+import <cstddef>;
+import <cstdint>;
+import <map>;
+import <string>;
+#endif
+
+import json;
+
+/**
+ * \brief Hardware performance counters (cycles, instructions, cache misses, branch misses) per timing zone.
+ *
+ * On Linux the counters of the calling thread are read with 'perf_event_open' (user space only, so the default
+ * 'perf_event_paranoid' setting of 2 suffices). Every 'Tracing::Zone' reads them at its begin and end while the
+ * counters are enabled, and the differences are summed per zone name, next to the wall time of the zone. Counters
+ * that the kernel, the CPU or a virtual machine does not provide are reported as unavailable; on other platforms
+ * 'enable' returns false and nothing is recorded. When the kernel multiplexes the counters with other events, the
+ * counts of a zone are extrapolated by the ratio of the time the counters were enabled to the time they were running.
+ *
+ * The counters are process-wide: the totals are summed over all threads, and therefore over all systems and
+ * screening jobs that run in the process.
+ *
+ * Reading the counters costs a system call, so they are switched off by default.
+ */
+export namespace HardwareCounters
+{
+enum class Counter : size_t
+{
+  Cycles = 0,
+  Instructions = 1,
+  CacheMisses = 2,
+  BranchMisses = 3
+};
+constexpr size_t numberOfCounters = 4;
+
+struct Values
+{
+  uint64_t value[numberOfCounters]{};
+  uint64_t timeEnabled{0};  ///< Time [ns] the counter group was enabled.
+  uint64_t timeRunning{0};  ///< Time [ns] the counter group was actually counting (less when multiplexed).
+
+  uint64_t operator[](Counter counter) const { return value[static_cast<size_t>(counter)]; }
+  Values operator-(const Values &b) const
+  {
+    Values result;
+    for (size_t i = 0; i != numberOfCounters; ++i)
+    {
+      result.value[i] = value[i] >= b.value[i] ? value[i] - b.value[i] : 0;
+    }
+    result.timeEnabled = timeEnabled >= b.timeEnabled ? timeEnabled - b.timeEnabled : 0;
+    result.timeRunning = timeRunning >= b.timeRunning ? timeRunning - b.timeRunning : 0;
+    return result;
+  }
+
+  /**
+   * \brief The counts extrapolated to the whole time the counters were enabled (as 'perf stat' does).
+   */
+  Values scaled() const
+  {
+    Values result = *this;
+    if (timeRunning > 0 && timeRunning < timeEnabled)
+    {
+      double factor = static_cast<double>(timeEnabled) / static_cast<double>(timeRunning);
+      for (size_t i = 0; i != numberOfCounters; ++i)
+      {
+        result.value[i] = static_cast<uint64_t>(std::llround(static_cast<double>(value[i]) * factor));
+      }
+    }
+    return result;
+  }
+};
+
+struct Totals
+{
+  size_t calls{0};
+  double time{0.0};
+  Values counters{};
+
+  Totals &operator+=(const Totals &b)
+  {
+    calls += b.calls;
+    time += b.time;
+    for (size_t i = 0; i != numberOfCounters; ++i)
+    {
+      counters.value[i] += b.counters.value[i];
+    }
+    counters.timeEnabled += b.counters.timeEnabled;
+    counters.timeRunning += b.counters.timeRunning;
+    return *this;
+  }
+};
+
+namespace detail
+{
+inline std::atomic<bool> active{false};
+}
+
+/**
+ * \brief Opens the counters on the calling thread; returns false (and stays disabled) when they are unavailable.
+ */
+bool enable();
+void disable();
+inline bool enabled() noexcept { return detail::active.load(std::memory_order_relaxed); }
+
+/**
+ * \brief Whether the counter could be opened (on the thread that called 'enable').
+ */
+bool available(Counter counter);
+
+/**
+ * \brief Current counts of the calling thread, opening its counters on first use.
+ */
+Values read();
+
+/**
+ * \brief Adds one call of zone 'name' with its wall time [s] and counter differences to the calling thread's totals,
+ * scaling the differences when the counters were multiplexed.
+ */
+void accumulate(const char *name, double time, const Values &counters);
+
+/**
+ * \brief The totals per zone name, summed over all threads.
+ */
+std::map<std::string, Totals> totals();
+void clear();
+
+std::string writeStatistics();
+nlohmann::json jsonStatistics();
+}  // namespace HardwareCounters
@@ -48,15 +48,90 @@ export class HDF5Writer
     H5::DataSpace dataspace(static_cast<int>(vec_hsize_t.size()), vec_hsize_t.data());
     H5::DataSet dataset = group.createDataSet(datasetName, getH5Type<T>(), dataspace);
 
-    // metadata
-    H5::StrType strType(H5::PredType::C_S1, H5T_VARIABLE);
-    H5::DataSpace attrSpace(H5S_SCALAR);
+    writeDatasetMetadata(dataset, metadata);
+  }
 
-    for (auto pair : metadata)
+  // Chunked datasets are stored in blocks of 'chunkDimensions' that are shuffled and deflate-compressed
+  // (compressionLevel 0-9), which is well suited for large and sparse volumetric data like density grids.
+  template <typename T>
+  void createChunkedDataset(const std::string& groupName, const std::string& datasetName,
+                            const std::vector<size_t>& dimensions, const std::vector<size_t>& chunkDimensions,
+                            int compressionLevel, const std::vector<std::pair<std::string, std::string>>& metadata)
+  {
+    H5::Group group = file.openGroup(groupName);
+    std::vector<hsize_t> vec_hsize_t(dimensions.begin(), dimensions.end());
+    std::vector<hsize_t> chunk_hsize_t(chunkDimensions.begin(), chunkDimensions.end());
+    H5::DataSpace dataspace(static_cast<int>(vec_hsize_t.size()), vec_hsize_t.data());
+
+    H5::DSetCreatPropList properties;
+    properties.setChunk(static_cast<int>(chunk_hsize_t.size()), chunk_hsize_t.data());
+    properties.setShuffle();
+    properties.setDeflate(compressionLevel);
+    H5::DataSet dataset = group.createDataSet(datasetName, getH5Type<T>(), dataspace, properties);
+
+    writeDatasetMetadata(dataset, metadata);
+  }
+
+  // Extendable datasets have an unlimited first dimension (for example time) and grow by appending slices of
+  // 'sliceDimensions' along it. They are chunked per 'chunkSlices' slices, and shuffled and deflate-compressed.
+  template <typename T>
+  void createExtendableDataset(const std::string& groupName, const std::string& datasetName,
+                               const std::vector<size_t>& sliceDimensions, size_t chunkSlices, int compressionLevel,
+                               const std::vector<std::pair<std::string, std::string>>& metadata)
+  {
+    H5::Group group = file.openGroup(groupName);
+    std::vector<hsize_t> vec_hsize_t{0};
+    std::vector<hsize_t> max_hsize_t{H5S_UNLIMITED};
+    std::vector<hsize_t> chunk_hsize_t{std::max(chunkSlices, size_t{1})};
+    for (size_t dimension : sliceDimensions)
     {
-      H5::Attribute about = dataset.createAttribute(pair.first, strType, attrSpace);
-      about.write(strType, pair.second);
+      vec_hsize_t.push_back(dimension);
+      max_hsize_t.push_back(dimension);
+      chunk_hsize_t.push_back(std::max(dimension, size_t{1}));
     }
+    H5::DataSpace dataspace(static_cast<int>(vec_hsize_t.size()), vec_hsize_t.data(), max_hsize_t.data());
+
+    H5::DSetCreatPropList properties;
+    properties.setChunk(static_cast<int>(chunk_hsize_t.size()), chunk_hsize_t.data());
+    properties.setShuffle();
+    properties.setDeflate(compressionLevel);
+    H5::DataSet dataset = group.createDataSet(datasetName, getH5Type<T>(), dataspace, properties);
+
+    writeDatasetMetadata(dataset, metadata);
+  }
+
+  // Appends a block of one or more consecutive slices (stored contiguously) to an extendable dataset.
+  template <typename T>
+  void appendSlices(const std::string& groupName, const std::string& datasetName, const std::vector<T>& data)
+  {
+    H5::Group group = file.openGroup(groupName);
+    H5::DataSet dataset = group.openDataSet(datasetName);
+    H5::DataSpace dataspace = dataset.getSpace();
+    std::vector<hsize_t> dimensions(static_cast<size_t>(dataspace.getSimpleExtentNdims()));
+    dataspace.getSimpleExtentDims(dimensions.data());
+
+    hsize_t sliceSize = 1;
+    for (size_t i = 1; i < dimensions.size(); ++i)
+    {
+      sliceSize *= dimensions[i];
+    }
+    if (sliceSize == 0 || data.size() % sliceSize != 0)
+    {
+      throw std::runtime_error("HDF5Writer: data is not a whole number of slices");
+    }
+    if (data.empty()) return;
+
+    std::vector<hsize_t> offset(dimensions.size(), 0);
+    offset[0] = dimensions[0];
+    std::vector<hsize_t> count(dimensions);
+    count[0] = data.size() / sliceSize;
+    dimensions[0] += count[0];
+    dataset.extend(dimensions.data());
+
+    H5::DataSpace filespace = dataset.getSpace();
+    filespace.selectHyperslab(H5S_SELECT_SET, count.data(), offset.data());
+    H5::DataSpace memspace(static_cast<int>(count.size()), count.data());
+    dataset.write(data.data(), getH5Type<T>(), memspace, filespace);
   }
 
   void createStringDataset(const std::string& groupName, const std::string& datasetName,
@@ -157,6 +232,18 @@ export class HDF5Writer
  private:
   H5::H5File file;
 
+  void writeDatasetMetadata(H5::DataSet& dataset, const std::vector<std::pair<std::string, std::string>>& metadata)
+  {
+    H5::StrType strType(H5::PredType::C_S1, H5T_VARIABLE);
+    H5::DataSpace attrSpace(H5S_SCALAR);
+
+    for (auto pair : metadata)
+    {
+      H5::Attribute about = dataset.createAttribute(pair.first, strType, attrSpace);
+      about.write(strType, pair.second);
+    }
+  }
+
   template <typename T>
   H5::PredType getH5Type()
   {
@@ -172,6 +259,10 @@ export class HDF5Writer
     {
       return H5::PredType::NATIVE_DOUBLE;
     }
+    else if (std::is_same<T, uint32_t>::value)
+    {
+      return H5::PredType::NATIVE_UINT32;
+    }
     else if (std::is_same<T, bool>::value)
     {
       return H5::PredType::NATIVE_HBOOL;
@@ -196,11 +196,23 @@ class ThreadPool
              std::is_same_v<void, std::invoke_result_t<InitializationFunction, std::size_t>>
   void init(const size_t nthreads, ThreadingType threading_type)
   {
+    // later calls only switch between serial and pooled execution, unless they ask for a different number of threads
+    const size_t requested_threads = nthreads > 0 ? nthreads - 1 : std::thread::hardware_concurrency() - 1;
+    if (!threads_.empty())
+    {
+      threadingType = threading_type;
+      if (threading_type != ThreadingType::ThreadPool || requested_threads == number_of_threads)
+      {
+        return;
+      }
+      stop_threads();
+    }
+
+    threadingType = threading_type;
     if (threading_type == ThreadingType::ThreadPool)
     {
-      number_of_threads = nthreads > 0 ? nthreads - 1 : std::thread::hardware_concurrency() - 1;
+      number_of_threads = requested_threads;
       // number_of_threads =  nthreads > 0 ? nthreads:  std::thread::hardware_concurrency();
-      threadingType = threading_type;
       tasks_ = std::deque<task_item>(number_of_threads);
       InitializationFunction init = [](std::size_t) {};
       std::size_t current_id = 0;
@@ -279,18 +291,7 @@ class ThreadPool
     }
   }
 
-  ~ThreadPool()
-  {
-    wait_for_tasks();
-
-    // stop all threads
-    for (std::size_t i = 0; i < threads_.size(); ++i)
-    {
-      threads_[i].request_stop();
-      tasks_[i].signal.release();
-      threads_[i].join();
-    }
-  }
+  ~ThreadPool() { stop_threads(); }
 
   /// thread pool is non-copyable
   ThreadPool(const ThreadPool &) = delete;
@@ -421,6 +422,26 @@ class ThreadPool
   size_t number_of_threads;
   ThreadingType threadingType;
 
+  // finishes the queued tasks and joins the worker threads, leaving an empty pool that 'init' can restart
+  void stop_threads()
+  {
+    wait_for_tasks();
+
+    // stop all threads
+    for (std::size_t i = 0; i < threads_.size(); ++i)
+    {
+      threads_[i].request_stop();
+      tasks_[i].signal.release();
+      threads_[i].join();
+    }
+
+    threads_.clear();
+    tasks_.clear();
+    while (priority_queue_.pop_back())
+    {
+    }
+  }
+
   template <typename Function>
   void enqueue_task(Function &&f)
   {
@@ -0,0 +1,172 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <print>
+#include <string>
+#include <vector>
+#endif
+
+module tracing;
+
+#ifndef USE_LEGACY_HEADERS
+import <algorithm>;
+import <atomic>;
+import <chrono>;
+import <cstddef>;
+import <exception>;
+import <format>;
+import <fstream>;
+import <memory>;
+import <mutex>;
+import <print>;
+import <string>;
+import <vector>;
+#endif
+
+namespace
+{
+// the ring buffer of one thread; the mutex is only contended while the events are being exported
+struct ThreadBuffer
+{
+  std::mutex mutex;
+  size_t threadIndex{0};
+  std::vector<Tracing::Event> events{};
+  size_t next{0};
+  size_t count{0};
+};
+
+std::mutex registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> registry;
+std::atomic<size_t> capacity{65536uz};
+
+thread_local std::shared_ptr<ThreadBuffer> localBuffer;
+
+ThreadBuffer &threadBuffer()
+{
+  if (!localBuffer)
+  {
+    localBuffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    localBuffer->threadIndex = registry.size();
+    registry.push_back(localBuffer);
+  }
+  return *localBuffer;
+}
+
+std::string escape(const char *text)
+{
+  std::string escaped;
+  for (const char *c = text; *c != '\0'; ++c)
+  {
+    if (*c == '"' || *c == '\\') escaped.push_back('\\');
+    escaped.push_back(*c);
+  }
+  return escaped;
+}
+}  // namespace
+
+void Tracing::enable(size_t eventsPerThread)
+{
+  capacity.store(std::max(eventsPerThread, 1uz));
+  detail::active.store(true);
+}
+
+void Tracing::disable() { detail::active.store(false); }
+
+void Tracing::record(const char *name, const char *category, Clock::time_point begin, Clock::time_point end)
+{
+  ThreadBuffer &buffer = threadBuffer();
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+
+  size_t size = capacity.load(std::memory_order_relaxed);
+  if (buffer.events.size() != size)
+  {
+    buffer.events.assign(size, Event{});
+    buffer.next = 0;
+    buffer.count = 0;
+  }
+  buffer.events[buffer.next] = Event{name, category, begin, end};
+  buffer.next = (buffer.next + 1) % size;
+  buffer.count = std::min(buffer.count + 1, size);
+}
+
+std::vector<Tracing::ThreadEvents> Tracing::events()
+{
+  std::vector<ThreadEvents> result;
+  std::lock_guard<std::mutex> registryLock(registryMutex);
+  for (const std::shared_ptr<ThreadBuffer> &buffer : registry)
+  {
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    ThreadEvents thread{buffer->threadIndex, {}};
+    thread.events.reserve(buffer->count);
+
+    // the oldest event is at 'next' once the buffer has wrapped around
+    size_t size = buffer->events.size();
+    size_t first = buffer->count == size ? buffer->next : 0uz;
+    for (size_t i = 0; i != buffer->count; ++i)
+    {
+      thread.events.push_back(buffer->events[(first + i) % size]);
+    }
+    result.push_back(std::move(thread));
+  }
+  return result;
+}
+
+void Tracing::clear()
+{
+  std::lock_guard<std::mutex> registryLock(registryMutex);
+  for (const std::shared_ptr<ThreadBuffer> &buffer : registry)
+  {
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->next = 0;
+    buffer->count = 0;
+  }
+}
+
+void Tracing::writeChromeTrace(const std::string &fileName)
+{
+  std::vector<ThreadEvents> threads = events();
+
+  Clock::time_point origin = Clock::time_point::max();
+  for (const ThreadEvents &thread : threads)
+  {
+    for (const Event &event : thread.events)
+    {
+      origin = std::min(origin, event.begin);
+    }
+  }
+
+  std::ofstream stream(fileName);
+  if (!stream)
+  {
+    throw std::runtime_error(std::format("[Tracing]: cannot open '{}' for writing\n", fileName));
+  }
+
+  std::print(stream, "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  bool first = true;
+  for (const ThreadEvents &thread : threads)
+  {
+    std::print(stream, "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},", first ? "" : ",\n",
+               thread.threadIndex);
+    std::print(stream, "\"args\":{{\"name\":\"thread {}\"}}}}", thread.threadIndex);
+    first = false;
+    for (const Event &event : thread.events)
+    {
+      double timeStamp = std::chrono::duration<double, std::micro>(event.begin - origin).count();
+      double duration = std::chrono::duration<double, std::micro>(event.end - event.begin).count();
+      std::print(stream,
+                 ",\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+                 escape(event.name), escape(event.category), timeStamp, duration, thread.threadIndex);
+    }
+  }
+  std::print(stream, "\n]}}\n");
+}
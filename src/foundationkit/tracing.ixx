@@ -0,0 +1,157 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#endif
+
+export module tracing;
+
+#ifndef USE_LEGACY_HEADERS
+import <atomic>;
+import <chrono>;
+import <cstddef>;
+import <cstdint>;
+import <string>;
+import <vector>;
+#endif
+
+import hardware_counters;
+
+/**
+ * \brief Scoped timing zones that feed the CPU-time tables and, when enabled, a per-thread trace.
+ *
+ * A zone measures an interval with the monotonic steady clock and adds it to any number of accumulators (the fields
+ * of 'MCMoveCpuTime' or 'IntegratorsCPUTime'), so the tables and the trace see the same interval. When tracing is
+ * enabled at runtime, the zone is also recorded as an event in a ring buffer owned by the calling thread; the oldest
+ * events are overwritten when the buffer is full. The recorded events are written in the Chrome trace-event format,
+ * which can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing to show the timeline of moves and kernels
+ * on every thread.
+ *
+ * Building with 'RASPA_DISABLE_TRACING' defined removes the recording altogether, leaving only the accumulation.
+ *
+ * When the hardware counters are enabled, they are read at the begin and end of every zone and summed per zone name.
+ */
+export namespace Tracing
+{
+#ifdef RASPA_DISABLE_TRACING
+constexpr bool compiledIn = false;
+#else
+constexpr bool compiledIn = true;
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+struct Event
+{
+  const char *name;
+  const char *category;
+  Clock::time_point begin;
+  Clock::time_point end;
+};
+
+struct ThreadEvents
+{
+  size_t threadIndex;
+  std::vector<Event> events;
+};
+
+namespace detail
+{
+inline std::atomic<bool> active{false};
+}
+
+/**
+ * \brief Starts recording zones, keeping at most 'eventsPerThread' of the most recent events per thread.
+ */
+void enable(size_t eventsPerThread = 65536uz);
+void disable();
+inline bool enabled() noexcept { return compiledIn && detail::active.load(std::memory_order_relaxed); }
+
+/**
+ * \brief Appends an event to the ring buffer of the calling thread.
+ */
+void record(const char *name, const char *category, Clock::time_point begin, Clock::time_point end);
+
+/**
+ * \brief Copies the recorded events of all threads, in chronological order per thread.
+ */
+std::vector<ThreadEvents> events();
+void clear();
+
+/**
+ * \brief Writes the recorded events as Chrome trace-event json (complete events, timestamps in microseconds).
+ */
+void writeChromeTrace(const std::string &fileName);
+
+/**
+ * \brief A timing zone, either opened at construction or reused for consecutive intervals with begin/end.
+ *
+ * 'name' and 'category' must be string literals (or otherwise outlive the trace), as only the pointers are stored.
+ * A zone that is still open when it goes out of scope (e.g. at an early return) is recorded in the trace and the
+ * hardware counters, but not added to any accumulator.
+ */
+class Zone
+{
+ public:
+  Zone() noexcept = default;
+  explicit Zone(const char *name, const char *category = "raspa") noexcept { begin(name, category); }
+  Zone(const Zone &) = delete;
+  Zone &operator=(const Zone &) = delete;
+  ~Zone()
+  {
+    if (!open) return;
+    Clock::time_point stop = Clock::now();
+    if (HardwareCounters::enabled())
+    {
+      HardwareCounters::accumulate(name, std::chrono::duration<double>(stop - start).count(),
+                                   HardwareCounters::read() - startCounters);
+    }
+    if constexpr (compiledIn)
+    {
+      if (enabled()) record(name, category, start, stop);
+    }
+  }
+
+  void begin(const char *zoneName, const char *zoneCategory = "raspa") noexcept
+  {
+    name = zoneName;
+    category = zoneCategory;
+    open = true;
+    if (HardwareCounters::enabled()) startCounters = HardwareCounters::read();
+    start = Clock::now();
+  }
+
+  /**
+   * \brief Closes the zone, adds its duration to every accumulator and returns it.
+   */
+  template <typename... Accumulators>
+  std::chrono::duration<double> end(Accumulators &...accumulators)
+  {
+    Clock::time_point stop = Clock::now();
+    std::chrono::duration<double> elapsed = stop - start;
+    ((accumulators += elapsed), ...);
+    if (HardwareCounters::enabled())
+    {
+      HardwareCounters::accumulate(name, elapsed.count(), HardwareCounters::read() - startCounters);
+    }
+    if constexpr (compiledIn)
+    {
+      if (enabled()) record(name, category, start, stop);
+    }
+    open = false;
+    return elapsed;
+  }
+
+ private:
+  const char *name{""};
+  const char *category{""};
+  Clock::time_point start{};
+  HardwareCounters::Values startCounters{};
+  bool open{false};
+};
+}  // namespace Tracing
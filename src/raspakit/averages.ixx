@@ -130,12 +130,91 @@ export struct BlockErrorEstimation
       : numberOfBins(size), numberOfSamples(numberOfSamples), nextBin(size)
   {
     binSize = static_cast<double>(numberOfSamples) / static_cast<double>(numberOfBins);
+    computeBinBoundaries();
+  }
+
+  /**
+   * \brief Computes the indices of the next bin boundaries from the bin size.
+   */
+  void computeBinBoundaries()
+  {
+    nextBin.resize(numberOfBins);
     for (size_t i = 0; i != numberOfBins; ++i)
     {
       nextBin[i] = static_cast<size_t>(static_cast<double>(i + 1) * binSize);
     }
   }
 
+  /**
+   * \brief Halves the bin size as long as the bins keep at least 'minimumBinSize' samples.
+   *
+   * Used for runs that may stop before 'numberOfSamples': the bins cover the start of the run, and 'mergeBins'
+   * doubles them whenever they are all filled. The bin size is divided by powers of two only, so after the last merge
+   * the layout equals that of the full run.
+   *
+   * \param minimumBinSize The smallest number of samples per bin.
+   */
+  void shrinkBins(double minimumBinSize)
+  {
+    while (0.5 * binSize >= minimumBinSize)
+    {
+      binSize *= 0.5;
+    }
+    computeBinBoundaries();
+  }
+
+  /**
+   * \brief Returns whether the (shrunk) bins are all filled once 'sample' is reached, and must be merged first.
+   */
+  bool binsAreFilled(size_t sample) const
+  {
+    return sample == nextBin[numberOfBins - 1] &&
+           binSize < static_cast<double>(numberOfSamples) / static_cast<double>(numberOfBins);
+  }
+
+  /**
+   * \brief Doubles the bin size, the new bin j holds the samples of the old bins 2j and 2j+1.
+   *
+   * \return The bin boundaries to rebin the properties with, see 'rebinBlocks'.
+   */
+  std::vector<size_t> mergeBins()
+  {
+    std::vector<size_t> boundaries(numberOfBins + 1);
+    for (size_t i = 0; i != numberOfBins + 1; ++i)
+    {
+      boundaries[i] = std::min(2 * i, numberOfBins);
+    }
+    binSize *= 2.0;
+    computeBinBoundaries();
+    currentBin /= 2;
+    return boundaries;
+  }
+
+  /**
+   * \brief Drops the bins after the current one, for a run that stops before 'numberOfSamples'.
+   *
+   * A current bin that is less than half filled is added to the bin before it, so that no bin is empty and the last
+   * bin counts in the error estimate.
+   *
+   * \return The bin boundaries to rebin the properties with, see 'rebinBlocks'.
+   */
+  std::vector<size_t> dropEmptyBins()
+  {
+    size_t firstSample = currentBin == 0 ? 0 : nextBin[currentBin - 1];
+    bool halfFilled = static_cast<double>(currentSample + 1 - firstSample) >= 0.5 * binSize;
+    size_t numberOfUsedBins = (halfFilled || currentBin == 0) ? currentBin + 1 : currentBin;
+
+    std::vector<size_t> boundaries(numberOfUsedBins + 1);
+    std::iota(boundaries.begin(), boundaries.end(), size_t{0});
+    boundaries.back() = currentBin + 1;
+
+    numberOfBins = numberOfUsedBins;
+    currentBin = numberOfUsedBins - 1;
+    nextBin.resize(numberOfBins);
+    nextBin.back() = currentSample + 1;
+    return boundaries;
+  }
+
   /**
    * \brief Updates the current sample and bin index.
    *
@@ -154,3 +233,30 @@ export struct BlockErrorEstimation
   friend Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const BlockErrorEstimation &blockerror);
   friend Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, BlockErrorEstimation &blockerror);
 };
+
+/**
+ * \brief Combines consecutive blocks of a property after the bins of a BlockErrorEstimation changed.
+ *
+ * Block j of the result is the sum of the blocks in [boundaries[j], boundaries[j + 1]); an empty range gives an empty
+ * block.
+ *
+ * \param blocks The accumulated sums per block.
+ * \param boundaries The first old block of every new block, followed by the end.
+ * \param empty The value of an empty block.
+ * \param sum Adds two blocks.
+ * \return The rebinned blocks.
+ */
+export template <typename T, typename BinaryOperation>
+std::vector<T> rebinBlocks(const std::vector<T> &blocks, const std::vector<size_t> &boundaries, const T &empty,
+                           BinaryOperation sum)
+{
+  std::vector<T> rebinned(boundaries.size() - 1, empty);
+  for (size_t j = 0; j + 1 < boundaries.size(); ++j)
+  {
+    for (size_t i = boundaries[j]; i != boundaries[j + 1]; ++i)
+    {
+      rebinned[j] = sum(rebinned[j], blocks[i]);
+    }
+  }
+  return rebinned;
+}
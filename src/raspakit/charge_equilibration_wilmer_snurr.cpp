@@ -1,13 +1,24 @@
 module;
 
 #ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <complex>
 #include <cstdint>
 #include <exception>
+#include <format>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <limits>
 #include <mdspan>
 #include <numbers>
+#include <numeric>
 #include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 #endif
 
@@ -26,6 +37,17 @@ import <cmath>;
 import <iostream>;
 import <numbers>;
 import <exception>;
+import <algorithm>;
+import <array>;
+import <complex>;
+import <format>;
+import <functional>;
+import <future>;
+import <limits>;
+import <numeric>;
+import <stdexcept>;
+import <thread>;
+import <utility>;
 #endif
 
 import double3;
@@ -33,6 +55,8 @@ import double3x3;
 import skelement;
 import atom;
 import simulationbox;
+import forcefield;
+import threadpool;
 
 extern "C"
 {
@@ -356,8 +380,418 @@ static double getJ(const SimulationBox& simulationBox, std::span<Atom> framework
   return 0.0;
 }
 
+namespace
+{
+// smallest number of rows of a matrix-vector product handled by one thread
+constexpr size_t minimumNumberOfRowsPerThread = 64;
+
+// convergence criterion on the residual, relative to the initial residual, and iteration limit of the iterative solver
+constexpr double iterativeTolerance = 1e-8;
+constexpr size_t maximumNumberOfIterations = 1000;
+
+// the orbital-overlap term of a pair is neglected when a * r exceeds this value (exp(-36) ~ 2e-16)
+constexpr double orbitalOverlapRange = 6.0;
+
+size_t numberOfRowBlocks(size_t size)
+{
+  auto& pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+  const size_t numberOfHelperThreads =
+      pool.getThreadingType() == ThreadPool::ThreadingType::ThreadPool ? pool.getThreadCount() : 0uz;
+  return std::clamp(size / minimumNumberOfRowsPerThread, 1uz, numberOfHelperThreads + 1uz);
+}
+
+// calls 'rows(block, begin, end)' for contiguous blocks of rows, all but the last block on the helper threads of the
+// thread pool and the last block on the calling thread
+void forEachRowBlock(size_t size, size_t numberOfBlocks, const std::function<void(size_t, size_t, size_t)>& rows)
+{
+  auto& pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+  const size_t blockSize = size / numberOfBlocks;
+
+  std::vector<std::future<void>> threads(numberOfBlocks - 1uz);
+  for (size_t i = 0; i != numberOfBlocks - 1uz; ++i)
+  {
+    threads[i] = pool.enqueue([&rows, i, blockSize]() { rows(i, i * blockSize, (i + 1uz) * blockSize); });
+  }
+  rows(numberOfBlocks - 1uz, (numberOfBlocks - 1uz) * blockSize, size);
+
+  for (std::future<void>& thread : threads)
+  {
+    thread.get();
+  }
+}
+
+long long floorDivide(long long a, long long b) { return a >= 0 ? a / b : -((b - 1 - a) / b); }
+
+double orbitalOverlap(double a, double r)
+{
+  return std::exp(-(a * a * r * r)) * (2.0 * a - a * a * r - 1.0 / r);
+}
+
+// the hardness matrix evaluated element by element with 'getJ', for the non-periodic and minimum-image types
+struct DirectHardness
+{
+  const SimulationBox& simulationBox;
+  std::span<Atom> atoms;
+  const std::vector<double>& J;
+  ChargeEquilibration::Type type;
+
+  double diagonal(size_t i) const { return getJ(simulationBox, atoms, J, i, i, type); }
+
+  void apply(const std::vector<double>& q, std::vector<double>& result) const
+  {
+    forEachRowBlock(atoms.size(), numberOfRowBlocks(atoms.size()),
+                    [&](size_t, size_t begin, size_t end)
+                    {
+                      for (size_t i = begin; i != end; ++i)
+                      {
+                        double sum = 0.0;
+                        for (size_t j = 0; j != atoms.size(); ++j)
+                        {
+                          sum += getJ(simulationBox, atoms, J, i, j, type) * q[j];
+                        }
+                        result[i] = sum;
+                      }
+                    });
+  }
+};
+
+// the periodic hardness matrix with the Coulomb interaction split by Ewald summation:
+//   H_ij = J_i delta_ij + lambda k/2 [ sum_n erfc(alpha r)/r + orbital(r) + (4 pi/V) sum_k exp(-k^2/4alpha^2)/k^2
+//          cos(k.r_ij) - delta_ij 2 alpha/sqrt(pi) ]
+// The short-ranged terms are kept in a neighbour list (including the periodic images of an atom itself, which add to
+// the diagonal), the reciprocal-space term is applied through the structure factors of the charges.
+class EwaldHardness
+{
+ public:
+  EwaldHardness(const ForceField& forceField, const SimulationBox& simulationBox, std::span<const Atom> atoms,
+                const std::vector<double>& J)
+      : size(atoms.size()), fractionalPositions(atoms.size()), neighbours(atoms.size()), selfTerms(atoms.size())
+  {
+    const double k = 14.4;      // [Angstroms * electron volts]
+    const double lambda = 1.2;  // Global hardness scaling parameter
+    const double prefactor = lambda * (k / 2.0);
+
+    // splitting parameter and wave vectors from the relative precision, as in 'ForceField::initializeEwaldParameters'
+    double cutOff = forceField.cutOffCoulomb;
+    double eps = std::min(std::abs(forceField.EwaldPrecision), 0.5);
+    double tol = std::sqrt(std::abs(std::log(eps * cutOff)));
+    double alpha = std::sqrt(std::abs(std::log(eps * cutOff * tol))) / cutOff;
+    double tol1 = std::sqrt(-std::log(eps * cutOff * (2.0 * tol * alpha) * (2.0 * tol * alpha)));
+
+    double minimumJ = std::ranges::min(J);
+    if (minimumJ <= 0.0)
+    {
+      throw std::runtime_error(std::format("[charge equilibration]: non-positive hardness {}\n", minimumJ));
+    }
+    double listCutOff = std::max(cutOff, orbitalOverlapRange * k / minimumJ);
+
+    for (size_t i = 0; i != size; ++i)
+    {
+      fractionalPositions[i] = (simulationBox.inverseCell * atoms[i].position).fract();
+    }
+
+    // bin the atoms in a grid of cells at least 'listCutOff' wide, or a single cell along short box directions
+    double3 widths = simulationBox.perpendicularWidths();
+    std::array<long long, 3> numberOfCells{std::max(1ll, static_cast<long long>(widths.x / listCutOff)),
+                                           std::max(1ll, static_cast<long long>(widths.y / listCutOff)),
+                                           std::max(1ll, static_cast<long long>(widths.z / listCutOff))};
+    std::array<long long, 3> reach{
+        static_cast<long long>(std::ceil(listCutOff * static_cast<double>(numberOfCells[0]) / widths.x)),
+        static_cast<long long>(std::ceil(listCutOff * static_cast<double>(numberOfCells[1]) / widths.y)),
+        static_cast<long long>(std::ceil(listCutOff * static_cast<double>(numberOfCells[2]) / widths.z))};
+    auto cellIndex = [&](const double3& s)
+    {
+      return std::array<long long, 3>{
+          std::min(numberOfCells[0] - 1, static_cast<long long>(s.x * static_cast<double>(numberOfCells[0]))),
+          std::min(numberOfCells[1] - 1, static_cast<long long>(s.y * static_cast<double>(numberOfCells[1]))),
+          std::min(numberOfCells[2] - 1, static_cast<long long>(s.z * static_cast<double>(numberOfCells[2])))};
+    };
+    auto flatten = [&](const std::array<long long, 3>& c)
+    { return static_cast<size_t>((c[0] * numberOfCells[1] + c[1]) * numberOfCells[2] + c[2]); };
+    std::vector<std::vector<size_t>> cells(static_cast<size_t>(numberOfCells[0] * numberOfCells[1] * numberOfCells[2]));
+    for (size_t i = 0; i != size; ++i)
+    {
+      cells[flatten(cellIndex(fractionalPositions[i]))].push_back(i);
+    }
+
+    // every offset of the cell of an atom is a distinct pair of neighbouring cell and periodic image
+    forEachRowBlock(
+        size, numberOfRowBlocks(size),
+        [&](size_t, size_t begin, size_t end)
+        {
+          for (size_t i = begin; i != end; ++i)
+          {
+            std::array<long long, 3> c = cellIndex(fractionalPositions[i]);
+            double self = -2.0 * alpha / std::sqrt(std::numbers::pi);
+            for (long long du = -reach[0]; du <= reach[0]; ++du)
+            {
+              for (long long dv = -reach[1]; dv <= reach[1]; ++dv)
+              {
+                for (long long dw = -reach[2]; dw <= reach[2]; ++dw)
+                {
+                  std::array<long long, 3> t{c[0] + du, c[1] + dv, c[2] + dw};
+                  std::array<long long, 3> image{};
+                  for (size_t d = 0; d != 3; ++d)
+                  {
+                    image[d] = floorDivide(t[d], numberOfCells[d]);
+                    t[d] -= image[d] * numberOfCells[d];
+                  }
+                  double3 shift(static_cast<double>(image[0]), static_cast<double>(image[1]),
+                                static_cast<double>(image[2]));
+                  for (size_t j : cells[flatten(t)])
+                  {
+                    if (i == j && image == std::array<long long, 3>{}) continue;
+
+                    double3 dr = simulationBox.cell * (fractionalPositions[j] + shift - fractionalPositions[i]);
+                    double r = std::sqrt(double3::dot(dr, dr));
+                    if (r > listCutOff) continue;
+
+                    double a = std::sqrt(J[i] * J[j]) / k;
+                    double weight = 0.0;
+                    if (r <= cutOff) weight += std::erfc(alpha * r) / r;
+                    if (a * r <= orbitalOverlapRange) weight += orbitalOverlap(a, r);
+                    if (weight == 0.0) continue;
+
+                    if (i == j)
+                    {
+                      self += weight;
+                    }
+                    else
+                    {
+                      neighbours[i].emplace_back(j, prefactor * weight);
+                    }
+                  }
+                }
+              }
+            }
+            selfTerms[i] = J[i] + prefactor * self;
+          }
+        });
+
+    // wave vectors of half of reciprocal space; each stands for the pair k and -k
+    double kCutOffSquared = (2.0 * alpha * tol1) * (2.0 * alpha * tol1);
+    maximumWaveVector = {
+        static_cast<long long>(std::rint(0.25 + widths.x * alpha * tol1 / std::numbers::pi)),
+        static_cast<long long>(std::rint(0.25 + widths.y * alpha * tol1 / std::numbers::pi)),
+        static_cast<long long>(std::rint(0.25 + widths.z * alpha * tol1 / std::numbers::pi))};
+    for (long long h = 0; h <= maximumWaveVector[0]; ++h)
+    {
+      for (long long l = -maximumWaveVector[1]; l <= maximumWaveVector[1]; ++l)
+      {
+        for (long long m = -maximumWaveVector[2]; m <= maximumWaveVector[2]; ++m)
+        {
+          if (h == 0 && (l < 0 || (l == 0 && m <= 0))) continue;
+
+          double3 kv = 2.0 * std::numbers::pi *
+                       transposedMultiply(simulationBox.inverseCell,
+                                          double3(static_cast<double>(h), static_cast<double>(l),
+                                                  static_cast<double>(m)));
+          double ksq = double3::dot(kv, kv);
+          if (ksq > kCutOffSquared) continue;
+
+          double factor = prefactor * 2.0 * (4.0 * std::numbers::pi / simulationBox.volume) *
+                          std::exp(-ksq / (4.0 * alpha * alpha)) / ksq;
+          waveVectors.push_back({{h, l, m}, factor});
+          reciprocalDiagonal += factor;
+        }
+      }
+    }
+  }
+
+  double diagonal(size_t i) const { return selfTerms[i] + reciprocalDiagonal; }
+
+  void apply(const std::vector<double>& q, std::vector<double>& result) const
+  {
+    size_t numberOfBlocks = numberOfRowBlocks(size);
+    size_t numberOfWaveVectors = waveVectors.size();
+
+    // structure factors S(k) = sum_j q_j exp(i k.r_j), summed per block of atoms
+    std::vector<std::complex<double>> partialStructureFactors(numberOfBlocks * numberOfWaveVectors);
+    forEachRowBlock(size, numberOfBlocks,
+                    [&](size_t block, size_t begin, size_t end)
+                    {
+                      std::vector<std::complex<double>> phases(numberOfWaveVectors);
+                      std::complex<double>* structureFactors = &partialStructureFactors[block * numberOfWaveVectors];
+                      for (size_t j = begin; j != end; ++j)
+                      {
+                        phaseFactors(j, phases);
+                        for (size_t n = 0; n != numberOfWaveVectors; ++n)
+                        {
+                          structureFactors[n] += q[j] * phases[n];
+                        }
+                      }
+                    });
+    std::vector<std::complex<double>> structureFactors(numberOfWaveVectors);
+    for (size_t block = 0; block != numberOfBlocks; ++block)
+    {
+      for (size_t n = 0; n != numberOfWaveVectors; ++n)
+      {
+        structureFactors[n] += partialStructureFactors[block * numberOfWaveVectors + n];
+      }
+    }
+
+    forEachRowBlock(size, numberOfBlocks,
+                    [&](size_t, size_t begin, size_t end)
+                    {
+                      std::vector<std::complex<double>> phases(numberOfWaveVectors);
+                      for (size_t i = begin; i != end; ++i)
+                      {
+                        double sum = selfTerms[i] * q[i];
+                        for (const auto& [j, weight] : neighbours[i])
+                        {
+                          sum += weight * q[j];
+                        }
+                        phaseFactors(i, phases);
+                        for (size_t n = 0; n != numberOfWaveVectors; ++n)
+                        {
+                          sum += waveVectors[n].factor * (phases[n].real() * structureFactors[n].real() +
+                                                          phases[n].imag() * structureFactors[n].imag());
+                        }
+                        result[i] = sum;
+                      }
+                    });
+  }
+
+ private:
+  struct WaveVector
+  {
+    std::array<long long, 3> index;
+    double factor;
+  };
+
+  size_t size;
+  std::vector<double3> fractionalPositions;
+  std::vector<std::vector<std::pair<size_t, double>>> neighbours;
+  std::vector<double> selfTerms;
+  std::array<long long, 3> maximumWaveVector{};
+  std::vector<WaveVector> waveVectors{};
+  double reciprocalDiagonal{0.0};
+
+  // exp(i k.r) for all wave vectors, built from the powers of exp(2 pi i s) along the three fractional coordinates
+  void phaseFactors(size_t i, std::vector<std::complex<double>>& phases) const
+  {
+    std::array<std::vector<std::complex<double>>, 3> powers{};
+    std::array<double, 3> s{fractionalPositions[i].x, fractionalPositions[i].y, fractionalPositions[i].z};
+    for (size_t d = 0; d != 3; ++d)
+    {
+      long long n = maximumWaveVector[d];
+      powers[d].resize(static_cast<size_t>(2 * n + 1));
+      std::complex<double> step = std::polar(1.0, 2.0 * std::numbers::pi * s[d]);
+      powers[d][static_cast<size_t>(n)] = 1.0;
+      for (long long m = 1; m <= n; ++m)
+      {
+        powers[d][static_cast<size_t>(n + m)] = powers[d][static_cast<size_t>(n + m - 1)] * step;
+        powers[d][static_cast<size_t>(n - m)] = std::conj(powers[d][static_cast<size_t>(n + m)]);
+      }
+    }
+    for (size_t n = 0; n != waveVectors.size(); ++n)
+    {
+      const std::array<long long, 3>& index = waveVectors[n].index;
+      phases[n] = powers[0][static_cast<size_t>(index[0] + maximumWaveVector[0])] *
+                  powers[1][static_cast<size_t>(index[1] + maximumWaveVector[1])] *
+                  powers[2][static_cast<size_t>(index[2] + maximumWaveVector[2])];
+    }
+  }
+};
+
+// Solves X_i - Xc_i + (H q)_i = mu for all atoms with zero total charge, using the MINRES method of Paige and Saunders
+// (SIAM J. Numer. Anal. 12, 617 (1975)), which unlike conjugate gradients also handles a hardness matrix that is not
+// positive definite. The Jacobi preconditioner is projected onto neutral charges, so all iterates stay neutral and
+// the chemical potential mu, the constant left in the residual, never appears.
+template <typename Hardness>
+std::vector<double> solveIteratively(const Hardness& hardness, const std::vector<double>& electronegativity)
+{
+  size_t size = electronegativity.size();
+  std::vector<double> inverseDiagonal(size);
+  for (size_t i = 0; i != size; ++i)
+  {
+    double diagonal = hardness.diagonal(i);
+    inverseDiagonal[i] = diagonal > 0.0 ? 1.0 / diagonal : 1.0;
+  }
+  double sumInverseDiagonal = std::accumulate(inverseDiagonal.begin(), inverseDiagonal.end(), 0.0);
+  auto dot = [](const std::vector<double>& a, const std::vector<double>& b)
+  { return std::inner_product(a.begin(), a.end(), b.begin(), 0.0); };
+  auto precondition = [&](const std::vector<double>& r, std::vector<double>& z)
+  {
+    double shift = dot(r, inverseDiagonal) / sumInverseDiagonal;
+    for (size_t i = 0; i != size; ++i) z[i] = inverseDiagonal[i] * (r[i] - shift);
+  };
+
+  std::vector<double> q(size, 0.0);
+  std::vector<double> r1(size);
+  std::transform(electronegativity.begin(), electronegativity.end(), r1.begin(), std::negate<double>());
+  std::vector<double> r2 = r1;
+  std::vector<double> y(size);
+  precondition(r1, y);
+  double initialBeta = std::sqrt(std::max(dot(r1, y), 0.0));
+  if (initialBeta == 0.0) return q;
+
+  std::vector<double> v(size);
+  std::vector<double> w(size, 0.0);
+  std::vector<double> w1(size, 0.0);
+  std::vector<double> w2(size, 0.0);
+  double beta = initialBeta;
+  double oldBeta = 0.0;
+  double dbar = 0.0;
+  double epsilon = 0.0;
+  double phibar = initialBeta;
+  double cs = -1.0;
+  double sn = 0.0;
+
+  for (size_t iteration = 0; iteration != maximumNumberOfIterations; ++iteration)
+  {
+    // Lanczos step in the inner product of the preconditioner
+    for (size_t i = 0; i != size; ++i) v[i] = y[i] / beta;
+    hardness.apply(v, y);
+    if (iteration > 0)
+    {
+      for (size_t i = 0; i != size; ++i) y[i] -= (beta / oldBeta) * r1[i];
+    }
+    double alpha = dot(v, y);
+    for (size_t i = 0; i != size; ++i) y[i] -= (alpha / beta) * r2[i];
+    std::swap(r1, r2);
+    r2 = y;
+    precondition(r2, y);
+    oldBeta = beta;
+    double betaSquared = dot(r2, y);
+    if (betaSquared < 0.0)
+    {
+      throw std::runtime_error(std::format("[charge equilibration]: preconditioner not positive definite\n"));
+    }
+    beta = std::sqrt(betaSquared);
+
+    // apply the previous rotation, and compute and apply the new one to the tridiagonal system
+    double oldEpsilon = epsilon;
+    double delta = cs * dbar + sn * alpha;
+    double gbar = sn * dbar - cs * alpha;
+    epsilon = sn * beta;
+    dbar = -cs * beta;
+    double gamma = std::max(std::hypot(gbar, beta), std::numeric_limits<double>::epsilon());
+    cs = gbar / gamma;
+    sn = beta / gamma;
+    double phi = cs * phibar;
+    phibar = sn * phibar;
+
+    std::swap(w1, w2);
+    std::swap(w2, w);
+    for (size_t i = 0; i != size; ++i)
+    {
+      w[i] = (v[i] - oldEpsilon * w1[i] - delta * w2[i]) / gamma;
+      q[i] += phi * w[i];
+    }
+
+    // 'phibar' is the norm of the preconditioned residual
+    if (phibar <= iterativeTolerance * initialBeta) return q;
+  }
+
+  throw std::runtime_error(
+      std::format("[charge equilibration]: no convergence after {} iterations\n", maximumNumberOfIterations));
+}
+}  // namespace
+
 void ChargeEquilibration::computeChargeEquilibration(const ForceField& forceField, const SimulationBox& simulationBox,
-                                                     std::span<Atom> frameworkAtoms, ChargeEquilibration::Type type)
+                                                     std::span<Atom> frameworkAtoms, ChargeEquilibration::Type type,
+                                                     ChargeEquilibration::Solver solver)
 {
   const double k = 14.4;      // [Angstroms * electron volts]
   const double gamma2 = 0.5;  // Global atomic radii scaling parameter
@@ -395,6 +829,39 @@ void ChargeEquilibration::computeChargeEquilibration(const ForceField& forceFiel
     J[i] = 13.598 + 2.0;
   }
 
+  if (solver == Solver::Automatic)
+  {
+    solver = size <= maximumDenseSize ? Solver::Dense : Solver::Iterative;
+  }
+
+  if (solver == Solver::Iterative)
+  {
+    std::vector<double> electronegativity(size);
+    for (size_t i = 0; i != size; ++i)
+    {
+      electronegativity[i] = X[i] - Xc[i];
+    }
+
+    std::vector<double> charges{};
+    switch (type)
+    {
+      case Type::NonPeriodic:
+      case Type::Periodic:
+        charges = solveIteratively(DirectHardness{simulationBox, frameworkAtoms, J, type}, electronegativity);
+        break;
+      case Type::PeriodicDirectSum:
+      case Type::PeriodicEwaldSum:
+        charges = solveIteratively(EwaldHardness(forceField, simulationBox, frameworkAtoms, J), electronegativity);
+        break;
+    }
+
+    for (size_t i = 0; i < size; ++i)
+    {
+      frameworkAtoms[i].charge = charges[i];
+    }
+    return;
+  }
+
   std::vector<double> A(size * size);
   std::mdspan<double, std::dextents<size_t, 2>, std::layout_left> As(A.data(), size, size);
   std::vector<double> b(size);
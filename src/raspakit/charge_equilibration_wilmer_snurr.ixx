@@ -43,8 +43,30 @@ enum class Type : size_t
   PeriodicEwaldSum = 3
 };
 
+/**
+ * \brief The solver of the linear charge-equilibration equations.
+ *
+ * The dense solver assembles the full matrix of lattice sums and solves it with LAPACK, which takes O(N^2) memory and
+ * O(N^3) time. The iterative solver never stores the matrix: it applies it to a vector in every step of the MINRES
+ * method (the hardness matrix need not be positive definite) with a Jacobi preconditioner projected onto charges with
+ * zero total charge. For the periodic types it uses an Ewald split of the shielded Coulomb interaction into a
+ * short-ranged sum over a neighbour list and a reciprocal-space sum over structure factors, with the splitting
+ * parameter and wave vectors chosen from 'cutOffCoulomb' and 'EwaldPrecision' of the force field ('PeriodicDirectSum'
+ * converges to the same sum). The matrix-vector products are spread over the threads of the thread pool when it is
+ * running.
+ */
+enum class Solver : size_t
+{
+  Automatic = 0,  ///< Dense up to 'maximumDenseSize' atoms, iterative above.
+  Dense = 1,
+  Iterative = 2
+};
+
+constexpr size_t maximumDenseSize = 1000;
+
 void computeChargeEquilibration(const ForceField &forceField, const SimulationBox &box, std::span<Atom> frameworkAtoms,
-                                ChargeEquilibration::Type type);
+                                ChargeEquilibration::Type type,
+                                ChargeEquilibration::Solver solver = ChargeEquilibration::Solver::Automatic);
 }  // namespace ChargeEquilibration
 
 struct ChargeEquilbrationElementData
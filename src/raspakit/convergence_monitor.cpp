@@ -0,0 +1,441 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <print>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <vector>
+#endif
+
+module convergence_monitor;
+
+#ifndef USE_LEGACY_HEADERS
+import <vector>;
+import <optional>;
+import <cmath>;
+import <string>;
+import <sstream>;
+import <algorithm>;
+import <numeric>;
+import <limits>;
+import <fstream>;
+import <format>;
+import <exception>;
+import <source_location>;
+import <print>;
+#endif
+
+import archive;
+import averages;
+import loadings;
+import enthalpy_of_adsorption;
+import component;
+import units;
+import json;
+
+ConvergenceMonitor::Block &ConvergenceMonitor::Block::operator+=(const Block &b)
+{
+  weight += b.weight;
+  numberOfSamples += b.numberOfSamples;
+  for (size_t i = 0; i < loadings.size(); ++i)
+  {
+    loadings[i] += b.loadings[i];
+  }
+  energy += b.energy;
+  enthalpyTerms += b.enthalpyTerms;
+  return *this;
+}
+
+ConvergenceMonitor::ConvergenceMonitor(size_t numberOfComponents, const std::vector<size_t> &swappableComponents,
+                                       std::optional<double> targetRelativeErrorLoading,
+                                       std::optional<double> targetRelativeErrorEnergy,
+                                       std::optional<double> targetRelativeErrorEnthalpy,
+                                       size_t minimumNumberOfSamples, size_t numberOfBlocks)
+    : numberOfComponents(numberOfComponents),
+      swappableComponents(swappableComponents),
+      targetRelativeErrorLoading(targetRelativeErrorLoading),
+      targetRelativeErrorEnergy(targetRelativeErrorEnergy),
+      targetRelativeErrorEnthalpy(targetRelativeErrorEnthalpy),
+      minimumNumberOfSamples(minimumNumberOfSamples),
+      maximumNumberOfBlocks(std::max(4uz, numberOfBlocks + (numberOfBlocks % 2uz))),
+      currentBlock(numberOfComponents, swappableComponents.size()),
+      sumOfLoadings(numberOfComponents),
+      sumOfLoadingsSquared(numberOfComponents)
+{
+  blocks.reserve(maximumNumberOfBlocks);
+}
+
+void ConvergenceMonitor::addSample(const Loadings &loadings, double potentialEnergy,
+                                   const EnthalpyOfAdsorptionTerms &enthalpyTerms, double weight)
+{
+  currentBlock.weight += weight;
+  currentBlock.numberOfSamples++;
+  for (size_t i = 0; i < numberOfComponents; ++i)
+  {
+    double value = loadings.numberOfMolecules[i];
+    currentBlock.loadings[i] += weight * value;
+    sumOfLoadings[i] += weight * value;
+    sumOfLoadingsSquared[i] += weight * value * value;
+  }
+  currentBlock.energy += weight * potentialEnergy;
+  currentBlock.enthalpyTerms += weight * enthalpyTerms;
+
+  sumOfWeights += weight;
+  sumOfEnergies += weight * potentialEnergy;
+  sumOfEnergiesSquared += weight * potentialEnergy * potentialEnergy;
+
+  ++numberOfSamples;
+
+  if (currentBlock.numberOfSamples == blockSize)
+  {
+    blocks.push_back(currentBlock);
+    currentBlock = Block(numberOfComponents, swappableComponents.size());
+
+    if (blocks.size() == maximumNumberOfBlocks)
+    {
+      mergeBlocks();
+    }
+  }
+}
+
+void ConvergenceMonitor::mergeBlocks()
+{
+  // merge neighbouring blocks pairwise; the number of blocks halves and the block size doubles
+  for (size_t i = 0; i < blocks.size() / 2uz; ++i)
+  {
+    blocks[i] = blocks[2uz * i];
+    blocks[i] += blocks[2uz * i + 1uz];
+  }
+  blocks.resize(blocks.size() / 2uz);
+  blockSize *= 2uz;
+}
+
+ConvergenceMonitor::Estimate ConvergenceMonitor::estimateFromBlocks(const std::vector<double> &blockAverages,
+                                                                    double mean,
+                                                                    std::optional<double> sampleVariance) const
+{
+  Estimate estimate{};
+  estimate.mean = mean;
+  estimate.relativeError = std::numeric_limits<double>::infinity();
+
+  size_t n = blockAverages.size();
+  if (n < 2uz) return estimate;
+
+  double sumOfSquares = std::accumulate(blockAverages.begin(), blockAverages.end(), 0.0,
+                                        [mean](double acc, double x) { return acc + (x - mean) * (x - mean); });
+  double blockVariance = sumOfSquares / static_cast<double>(n - 1uz);
+  double standardError = std::sqrt(blockVariance / static_cast<double>(n));
+  size_t degreesOfFreedom = std::min(n - 1uz, standardNormalDeviates.size() - 1uz);
+  estimate.confidence = standardNormalDeviates[degreesOfFreedom][chosenConfidenceLevel] * standardError;
+
+  if (estimate.confidence == 0.0)
+  {
+    estimate.relativeError = 0.0;
+  }
+  else if (mean != 0.0)
+  {
+    estimate.relativeError = estimate.confidence / std::abs(mean);
+  }
+
+  // statistical inefficiency s = n_b * var(block averages) / var(samples); the block error is only trustworthy when
+  // the block size is well beyond the correlation length
+  bool enoughBlocks = n >= maximumNumberOfBlocks / 2uz;
+  if (sampleVariance.has_value())
+  {
+    if (sampleVariance.value() > 0.0)
+    {
+      estimate.statisticalInefficiency = static_cast<double>(blockSize) * blockVariance / sampleVariance.value();
+    }
+    estimate.reliable = enoughBlocks && static_cast<double>(blockSize) >= 2.0 * estimate.statisticalInefficiency;
+  }
+  else
+  {
+    estimate.reliable = enoughBlocks;
+  }
+
+  return estimate;
+}
+
+ConvergenceMonitor::Estimate ConvergenceMonitor::loadingEstimate(size_t component) const
+{
+  if (sumOfWeights <= 0.0) return Estimate{};
+
+  double mean = sumOfLoadings[component] / sumOfWeights;
+  double sampleVariance = std::max(0.0, sumOfLoadingsSquared[component] / sumOfWeights - mean * mean);
+
+  std::vector<double> blockAverages{};
+  for (const Block &block : blocks)
+  {
+    if (block.weight > 0.0) blockAverages.push_back(block.loadings[component] / block.weight);
+  }
+  return estimateFromBlocks(blockAverages, mean, sampleVariance);
+}
+
+ConvergenceMonitor::Estimate ConvergenceMonitor::energyEstimate() const
+{
+  if (sumOfWeights <= 0.0) return Estimate{};
+
+  double mean = sumOfEnergies / sumOfWeights;
+  double sampleVariance = std::max(0.0, sumOfEnergiesSquared / sumOfWeights - mean * mean);
+
+  std::vector<double> blockAverages{};
+  for (const Block &block : blocks)
+  {
+    if (block.weight > 0.0) blockAverages.push_back(block.energy / block.weight);
+  }
+  return estimateFromBlocks(blockAverages, mean, sampleVariance);
+}
+
+ConvergenceMonitor::Estimate ConvergenceMonitor::enthalpyEstimate(size_t k) const
+{
+  // the enthalpy of adsorption is a fluctuation property; like 'PropertyEnthalpy' the average is taken over the
+  // block values, and no per-sample variance (and hence no statistical inefficiency) exists
+  std::vector<double> blockAverages{};
+  for (const Block &block : blocks)
+  {
+    if (block.weight > 0.0)
+    {
+      double value = (block.enthalpyTerms / block.weight).compositeProperty().values[k];
+      if (std::isfinite(value)) blockAverages.push_back(value);
+    }
+  }
+  if (blockAverages.empty()) return Estimate{};
+
+  double mean =
+      std::accumulate(blockAverages.begin(), blockAverages.end(), 0.0) / static_cast<double>(blockAverages.size());
+  return estimateFromBlocks(blockAverages, mean, std::nullopt);
+}
+
+bool ConvergenceMonitor::isConverged() const
+{
+  if (!targetRelativeErrorLoading && !targetRelativeErrorEnergy && !targetRelativeErrorEnthalpy) return false;
+  if (numberOfSamples < minimumNumberOfSamples) return false;
+
+  if (targetRelativeErrorLoading.has_value())
+  {
+    for (size_t i = 0; i < numberOfComponents; ++i)
+    {
+      Estimate estimate = loadingEstimate(i);
+      if (!estimate.reliable || estimate.relativeError > targetRelativeErrorLoading.value()) return false;
+    }
+  }
+
+  if (targetRelativeErrorEnergy.has_value())
+  {
+    Estimate estimate = energyEstimate();
+    if (!estimate.reliable || estimate.relativeError > targetRelativeErrorEnergy.value()) return false;
+  }
+
+  if (targetRelativeErrorEnthalpy.has_value())
+  {
+    for (size_t k = 0; k < swappableComponents.size(); ++k)
+    {
+      Estimate estimate = enthalpyEstimate(k);
+      if (!estimate.reliable || estimate.relativeError > targetRelativeErrorEnthalpy.value()) return false;
+    }
+  }
+
+  return true;
+}
+
+std::string ConvergenceMonitor::writeStatus(const std::vector<Component> &components) const
+{
+  std::ostringstream stream;
+
+  auto target = [](std::optional<double> value) { return value.has_value() ? std::format("{:g}", *value) : "-"; };
+
+  std::print(stream, "Convergence monitor\n");
+  std::print(stream, "===============================================================================\n\n");
+  std::print(stream, "Number of samples:   {}\n", numberOfSamples);
+  std::print(stream, "Block size:          {} ({} blocks)\n", blockSize, blocks.size());
+  if (convergedAtCycle.has_value())
+  {
+    std::print(stream, "Converged at cycle:  {}\n", convergedAtCycle.value());
+  }
+  else
+  {
+    std::print(stream, "Converged:           no\n");
+  }
+  std::print(stream, "\n");
+
+  for (size_t i = 0; i < numberOfComponents; ++i)
+  {
+    Estimate estimate = loadingEstimate(i);
+    std::print(stream, "Loading component {} [{}]\n", i, components[i].name);
+    std::print(stream, "    Average:                  {: .6e} +/- {: .6e} [molecules/cell]\n", estimate.mean,
+               estimate.confidence);
+    std::print(stream, "    Relative error:           {: .6e} (target {})\n", estimate.relativeError,
+               target(targetRelativeErrorLoading));
+    std::print(stream, "    Statistical inefficiency: {: .6e} (reliable: {})\n", estimate.statisticalInefficiency,
+               estimate.reliable);
+  }
+
+  Estimate energy = energyEstimate();
+  std::print(stream, "Potential energy\n");
+  std::print(stream, "    Average:                  {: .6e} +/- {: .6e} [K]\n", Units::EnergyToKelvin * energy.mean,
+             Units::EnergyToKelvin * energy.confidence);
+  std::print(stream, "    Relative error:           {: .6e} (target {})\n", energy.relativeError,
+             target(targetRelativeErrorEnergy));
+  std::print(stream, "    Statistical inefficiency: {: .6e} (reliable: {})\n", energy.statisticalInefficiency,
+             energy.reliable);
+
+  for (size_t k = 0; k < swappableComponents.size(); ++k)
+  {
+    Estimate estimate = enthalpyEstimate(k);
+    std::print(stream, "Enthalpy of adsorption component {} [{}]\n", swappableComponents[k],
+               components[swappableComponents[k]].name);
+    std::print(stream, "    Average:                  {: .6e} +/- {: .6e} [K]\n", Units::EnergyToKelvin * estimate.mean,
+               Units::EnergyToKelvin * estimate.confidence);
+    std::print(stream, "    Relative error:           {: .6e} (target {})\n", estimate.relativeError,
+               target(targetRelativeErrorEnthalpy));
+  }
+  std::print(stream, "\n\n");
+
+  return stream.str();
+}
+
+nlohmann::json ConvergenceMonitor::jsonStatus(const std::vector<Component> &components) const
+{
+  nlohmann::json status;
+
+  status["numberOfSamples"] = numberOfSamples;
+  status["blockSize"] = blockSize;
+  status["numberOfBlocks"] = blocks.size();
+  status["converged"] = convergedAtCycle.has_value();
+  if (convergedAtCycle.has_value())
+  {
+    status["convergedAtCycle"] = convergedAtCycle.value();
+  }
+
+  for (size_t i = 0; i < numberOfComponents; ++i)
+  {
+    Estimate estimate = loadingEstimate(i);
+    status["loading"][components[i].name]["mean"] = estimate.mean;
+    status["loading"][components[i].name]["confidence"] = estimate.confidence;
+    status["loading"][components[i].name]["relativeError"] = estimate.relativeError;
+    status["loading"][components[i].name]["statisticalInefficiency"] = estimate.statisticalInefficiency;
+  }
+  if (targetRelativeErrorLoading.has_value())
+  {
+    status["loading"]["target"] = targetRelativeErrorLoading.value();
+  }
+
+  Estimate energy = energyEstimate();
+  status["energy"]["mean"]["[K]"] = Units::EnergyToKelvin * energy.mean;
+  status["energy"]["confidence"]["[K]"] = Units::EnergyToKelvin * energy.confidence;
+  status["energy"]["relativeError"] = energy.relativeError;
+  status["energy"]["statisticalInefficiency"] = energy.statisticalInefficiency;
+  if (targetRelativeErrorEnergy.has_value())
+  {
+    status["energy"]["target"] = targetRelativeErrorEnergy.value();
+  }
+
+  for (size_t k = 0; k < swappableComponents.size(); ++k)
+  {
+    Estimate estimate = enthalpyEstimate(k);
+    const std::string &name = components[swappableComponents[k]].name;
+    status["enthalpy"][name]["mean"]["[K]"] = Units::EnergyToKelvin * estimate.mean;
+    status["enthalpy"][name]["confidence"]["[K]"] = Units::EnergyToKelvin * estimate.confidence;
+    status["enthalpy"][name]["relativeError"] = estimate.relativeError;
+  }
+  if (targetRelativeErrorEnthalpy.has_value())
+  {
+    status["enthalpy"]["target"] = targetRelativeErrorEnthalpy.value();
+  }
+
+  return status;
+}
+
+Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const ConvergenceMonitor::Block &b)
+{
+  archive << b.weight;
+  archive << b.numberOfSamples;
+  archive << b.loadings;
+  archive << b.energy;
+  archive << b.enthalpyTerms;
+
+  return archive;
+}
+
+Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, ConvergenceMonitor::Block &b)
+{
+  archive >> b.weight;
+  archive >> b.numberOfSamples;
+  archive >> b.loadings;
+  archive >> b.energy;
+  archive >> b.enthalpyTerms;
+
+  return archive;
+}
+
+Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const ConvergenceMonitor &m)
+{
+  archive << m.versionNumber;
+
+  archive << m.numberOfComponents;
+  archive << m.swappableComponents;
+  archive << m.targetRelativeErrorLoading;
+  archive << m.targetRelativeErrorEnergy;
+  archive << m.targetRelativeErrorEnthalpy;
+  archive << m.minimumNumberOfSamples;
+
+  archive << m.maximumNumberOfBlocks;
+  archive << m.blockSize;
+  archive << m.numberOfSamples;
+  archive << m.blocks;
+  archive << m.currentBlock;
+
+  archive << m.sumOfWeights;
+  archive << m.sumOfLoadings;
+  archive << m.sumOfLoadingsSquared;
+  archive << m.sumOfEnergies;
+  archive << m.sumOfEnergiesSquared;
+
+  archive << m.convergedAtCycle;
+
+  return archive;
+}
+
+Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, ConvergenceMonitor &m)
+{
+  uint64_t versionNumber;
+  archive >> versionNumber;
+  if (versionNumber > m.versionNumber)
+  {
+    const std::source_location &location = std::source_location::current();
+    throw std::runtime_error(std::format("Invalid version reading 'ConvergenceMonitor' at line {} in file {}\n",
+                                         location.line(), location.file_name()));
+  }
+
+  archive >> m.numberOfComponents;
+  archive >> m.swappableComponents;
+  archive >> m.targetRelativeErrorLoading;
+  archive >> m.targetRelativeErrorEnergy;
+  archive >> m.targetRelativeErrorEnthalpy;
+  archive >> m.minimumNumberOfSamples;
+
+  archive >> m.maximumNumberOfBlocks;
+  archive >> m.blockSize;
+  archive >> m.numberOfSamples;
+  archive >> m.blocks;
+  archive >> m.currentBlock;
+
+  archive >> m.sumOfWeights;
+  archive >> m.sumOfLoadings;
+  archive >> m.sumOfLoadingsSquared;
+  archive >> m.sumOfEnergies;
+  archive >> m.sumOfEnergiesSquared;
+
+  archive >> m.convergedAtCycle;
+
+  return archive;
+}
@@ -0,0 +1,165 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+#endif
+
+export module convergence_monitor;
+
+#ifndef USE_LEGACY_HEADERS
+import <vector>;
+import <optional>;
+import <cmath>;
+import <string>;
+import <algorithm>;
+import <fstream>;
+#endif
+
+import archive;
+import averages;
+import loadings;
+import enthalpy_of_adsorption;
+import component;
+import json;
+
+/**
+ * \brief Online estimation of statistical errors used to terminate a production run on convergence.
+ *
+ * The monitor accumulates the loading per component, the potential energy and the enthalpy-of-adsorption terms in a
+ * fixed number of blocks. When all blocks are filled, neighbouring blocks are merged pairwise and the block size is
+ * doubled (Flyvbjerg-Petersen blocking), so memory stays constant and the block size always grows with the length of
+ * the run. The spread of the block averages gives the error bars, and the ratio of block variance to sample variance
+ * gives the statistical inefficiency. The error estimate is only trusted once the block size exceeds twice the
+ * statistical inefficiency.
+ */
+export struct ConvergenceMonitor
+{
+  /**
+   * \brief Accumulated (weighted) sums of all monitored observables over a block of samples.
+   */
+  struct Block
+  {
+    Block() : enthalpyTerms(0) {};
+    Block(size_t numberOfComponents, size_t numberOfSwappableComponents)
+        : loadings(numberOfComponents), enthalpyTerms(numberOfSwappableComponents)
+    {
+    }
+
+    bool operator==(Block const &) const = default;
+
+    double weight{0.0};
+    size_t numberOfSamples{0};
+    std::vector<double> loadings;
+    double energy{0.0};
+    EnthalpyOfAdsorptionTerms enthalpyTerms;
+
+    Block &operator+=(const Block &b);
+
+    friend Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const Block &b);
+    friend Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, Block &b);
+  };
+
+  /**
+   * \brief Mean, confidence interval, relative error and statistical inefficiency of an observable.
+   */
+  struct Estimate
+  {
+    double mean{0.0};
+    double confidence{0.0};
+    double relativeError{0.0};
+    double statisticalInefficiency{1.0};
+    bool reliable{false};
+  };
+
+  ConvergenceMonitor() {};
+
+  /**
+   * \brief Constructs a monitor for the given components and relative-error targets.
+   *
+   * Observables without a target are still tracked and reported, but do not take part in the convergence test.
+   *
+   * \param numberOfComponents Number of components of which the loading is monitored.
+   * \param swappableComponents Indices of the components for which the enthalpy of adsorption is monitored.
+   * \param targetRelativeErrorLoading Target relative error of the loading of each component.
+   * \param targetRelativeErrorEnergy Target relative error of the potential energy.
+   * \param targetRelativeErrorEnthalpy Target relative error of the enthalpy of adsorption of each component.
+   * \param minimumNumberOfSamples Minimum number of samples before the run may be declared converged.
+   * \param numberOfBlocks Maximum number of blocks (must be even).
+   */
+  ConvergenceMonitor(size_t numberOfComponents, const std::vector<size_t> &swappableComponents,
+                     std::optional<double> targetRelativeErrorLoading, std::optional<double> targetRelativeErrorEnergy,
+                     std::optional<double> targetRelativeErrorEnthalpy, size_t minimumNumberOfSamples = 0,
+                     size_t numberOfBlocks = 32);
+
+  bool operator==(ConvergenceMonitor const &) const = default;
+
+  uint64_t versionNumber{1};
+
+  size_t numberOfComponents{0};
+  std::vector<size_t> swappableComponents{};
+  std::optional<double> targetRelativeErrorLoading{};
+  std::optional<double> targetRelativeErrorEnergy{};
+  std::optional<double> targetRelativeErrorEnthalpy{};
+  size_t minimumNumberOfSamples{0};
+
+  size_t maximumNumberOfBlocks{32};
+  size_t blockSize{1};
+  size_t numberOfSamples{0};
+  std::vector<Block> blocks{};
+  Block currentBlock{};
+
+  // running sums of the individual samples, needed for the statistical inefficiency
+  double sumOfWeights{0.0};
+  std::vector<double> sumOfLoadings{};
+  std::vector<double> sumOfLoadingsSquared{};
+  double sumOfEnergies{0.0};
+  double sumOfEnergiesSquared{0.0};
+
+  std::optional<size_t> convergedAtCycle{};
+
+  /**
+   * \brief Adds a sample of the monitored observables.
+   *
+   * \param loadings The current loadings.
+   * \param potentialEnergy The current potential energy.
+   * \param enthalpyTerms The current enthalpy-of-adsorption terms.
+   * \param weight The weight of the sample (CFCMC biasing).
+   */
+  void addSample(const Loadings &loadings, double potentialEnergy, const EnthalpyOfAdsorptionTerms &enthalpyTerms,
+                 double weight);
+
+  /**
+   * \brief Estimates the statistics of the loading of a component.
+   */
+  Estimate loadingEstimate(size_t component) const;
+
+  /**
+   * \brief Estimates the statistics of the potential energy.
+   */
+  Estimate energyEstimate() const;
+
+  /**
+   * \brief Estimates the statistics of the enthalpy of adsorption of the k-th swappable component.
+   */
+  Estimate enthalpyEstimate(size_t k) const;
+
+  /**
+   * \brief Returns whether all observables with a target have reached it with a reliable error estimate.
+   */
+  bool isConverged() const;
+
+  std::string writeStatus(const std::vector<Component> &components) const;
+  nlohmann::json jsonStatus(const std::vector<Component> &components) const;
+
+  Estimate estimateFromBlocks(const std::vector<double> &blockAverages, double mean,
+                              std::optional<double> sampleVariance) const;
+  void mergeBlocks();
+
+  friend Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const ConvergenceMonitor &m);
+  friend Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, ConvergenceMonitor &m);
+};
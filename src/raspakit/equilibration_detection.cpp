@@ -0,0 +1,238 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <source_location>
+#include <span>
+#include <string>
+#include <vector>
+#endif
+
+module equilibration_detection;
+
+#ifndef USE_LEGACY_HEADERS
+import <cstddef>;
+import <vector>;
+import <optional>;
+import <span>;
+import <string>;
+import <algorithm>;
+import <numeric>;
+import <functional>;
+import <cmath>;
+import <limits>;
+import <fstream>;
+import <format>;
+import <exception>;
+import <source_location>;
+#endif
+
+import archive;
+import json;
+
+EquilibrationDetector::EquilibrationDetector(Method method, size_t numberOfObservables, size_t checkEvery,
+                                             size_t minimumNumberOfCycles)
+    : method(method),
+      checkEvery(checkEvery),
+      minimumNumberOfCycles(minimumNumberOfCycles),
+      timeSeries(numberOfObservables)
+{
+}
+
+void EquilibrationDetector::clear()
+{
+  for (std::vector<double> &series : timeSeries)
+  {
+    series.clear();
+  }
+  equilibratedAtCycle = std::nullopt;
+}
+
+void EquilibrationDetector::addSample(std::span<const double> observables)
+{
+  for (size_t i = 0; i < timeSeries.size(); ++i)
+  {
+    timeSeries[i].push_back(observables[i]);
+  }
+}
+
+double EquilibrationDetector::statisticalInefficiency(std::span<const double> series)
+{
+  size_t n = series.size();
+  if (n < 2uz) return 1.0;
+
+  double mean = std::accumulate(series.begin(), series.end(), 0.0) / static_cast<double>(n);
+  double variance = std::transform_reduce(series.begin(), series.end(), 0.0, std::plus<>(),
+                                          [mean](double x) { return (x - mean) * (x - mean); }) /
+                    static_cast<double>(n);
+  if (variance <= 0.0) return 1.0;
+
+  double g = 1.0;
+  size_t t = 1uz;
+  size_t increment = 1uz;
+  while (t < n - 1uz)
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < n - t; ++i)
+    {
+      sum += (series[i] - mean) * (series[i + t] - mean);
+    }
+    double correlation = sum / (static_cast<double>(n - t) * variance);
+
+    if (correlation <= 0.0 && t > 3uz) break;
+
+    g += 2.0 * correlation * (1.0 - static_cast<double>(t) / static_cast<double>(n)) * static_cast<double>(increment);
+    t += increment;
+    ++increment;
+  }
+
+  return std::max(g, 1.0);
+}
+
+size_t EquilibrationDetector::stationaryStart(std::span<const double> series) const
+{
+  size_t n = series.size();
+
+  switch (method)
+  {
+    case Method::MaximumEffectiveSamples:
+    {
+      // scan about a hundred candidate origins; the last few points are excluded to keep g(t0) meaningful
+      size_t stride = std::max(1uz, n / 100uz);
+      size_t bestStart = 0uz;
+      double maximumEffectiveSamples = 0.0;
+      for (size_t t0 = 0uz; t0 + 10uz < n; t0 += stride)
+      {
+        double g = statisticalInefficiency(series.subspan(t0));
+        double effectiveSamples = static_cast<double>(n - t0) / g;
+        if (effectiveSamples > maximumEffectiveSamples)
+        {
+          maximumEffectiveSamples = effectiveSamples;
+          bestStart = t0;
+        }
+      }
+      return bestStart;
+    }
+    case Method::MSER:
+    {
+      // suffix sums give the mean and sum of squared deviations of every remainder in O(n)
+      std::vector<double> suffixSum(n + 1uz, 0.0);
+      std::vector<double> suffixSumSquared(n + 1uz, 0.0);
+      for (size_t i = n; i-- > 0uz;)
+      {
+        suffixSum[i] = suffixSum[i + 1uz] + series[i];
+        suffixSumSquared[i] = suffixSumSquared[i + 1uz] + series[i] * series[i];
+      }
+
+      size_t bestStart = 0uz;
+      double minimumStandardError = std::numeric_limits<double>::max();
+      for (size_t d = 0uz; d + 10uz < n; ++d)
+      {
+        double m = static_cast<double>(n - d);
+        double sumOfSquares = suffixSumSquared[d] - suffixSum[d] * suffixSum[d] / m;
+        double standardError = sumOfSquares / (m * m);
+        if (standardError < minimumStandardError)
+        {
+          minimumStandardError = standardError;
+          bestStart = d;
+        }
+      }
+      return bestStart;
+    }
+    default:
+      return 0uz;
+  }
+}
+
+std::optional<size_t> EquilibrationDetector::detect() const
+{
+  if (timeSeries.empty()) return std::nullopt;
+
+  size_t numberOfCycles = timeSeries.front().size();
+  if (numberOfCycles < std::max(minimumNumberOfCycles, 20uz)) return std::nullopt;
+
+  // reduce to batch means to bound the cost of the analysis
+  size_t batchSize = (numberOfCycles + maximumSeriesLength - 1uz) / maximumSeriesLength;
+  size_t numberOfBatches = numberOfCycles / batchSize;
+
+  size_t start = 0uz;
+  for (const std::vector<double> &series : timeSeries)
+  {
+    std::vector<double> batches(numberOfBatches);
+    for (size_t i = 0; i < numberOfBatches; ++i)
+    {
+      batches[i] = std::accumulate(series.begin() + static_cast<std::ptrdiff_t>(i * batchSize),
+                                   series.begin() + static_cast<std::ptrdiff_t>((i + 1uz) * batchSize), 0.0) /
+                   static_cast<double>(batchSize);
+    }
+
+    size_t t0 = stationaryStart(batches);
+
+    // a start in the second half means the series is still drifting
+    if (2uz * t0 > numberOfBatches) return std::nullopt;
+
+    start = std::max(start, t0 * batchSize);
+  }
+
+  return start;
+}
+
+nlohmann::json EquilibrationDetector::jsonStatus(size_t numberOfCyclesPerformed, size_t maximumNumberOfCycles) const
+{
+  nlohmann::json status;
+
+  status["method"] = method == Method::MSER ? "MSER" : "MaximumEffectiveSamples";
+  status["stationary"] = equilibratedAtCycle.has_value();
+  if (equilibratedAtCycle.has_value())
+  {
+    status["equilibratedAtCycle"] = equilibratedAtCycle.value();
+  }
+  status["numberOfCycles"] = numberOfCyclesPerformed;
+  status["maximumNumberOfCycles"] = maximumNumberOfCycles;
+
+  return status;
+}
+
+Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const EquilibrationDetector &d)
+{
+  archive << d.versionNumber;
+
+  archive << d.method;
+  archive << d.checkEvery;
+  archive << d.minimumNumberOfCycles;
+  archive << d.maximumSeriesLength;
+  archive << d.timeSeries;
+  archive << d.equilibratedAtCycle;
+
+  return archive;
+}
+
+Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, EquilibrationDetector &d)
+{
+  uint64_t versionNumber;
+  archive >> versionNumber;
+  if (versionNumber > d.versionNumber)
+  {
+    const std::source_location &location = std::source_location::current();
+    throw std::runtime_error(std::format("Invalid version reading 'EquilibrationDetector' at line {} in file {}\n",
+                                         location.line(), location.file_name()));
+  }
+
+  archive >> d.method;
+  archive >> d.checkEvery;
+  archive >> d.minimumNumberOfCycles;
+  archive >> d.maximumSeriesLength;
+  archive >> d.timeSeries;
+  archive >> d.equilibratedAtCycle;
+
+  return archive;
+}
@@ -0,0 +1,109 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <cstddef>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#endif
+
+export module equilibration_detection;
+
+#ifndef USE_LEGACY_HEADERS
+import <cstddef>;
+import <vector>;
+import <optional>;
+import <span>;
+import <string>;
+import <fstream>;
+#endif
+
+import archive;
+import json;
+
+/**
+ * \brief Detects when the loading and energy time series of a system have become stationary.
+ *
+ * The detector stores the time series of the monitored observables (the loading per component and the potential
+ * energy) during the initialization and equilibration stages. At regular intervals it determines the start of the
+ * stationary region of each series with either
+ *  - the maximum-effective-samples criterion of Chodera (J. Chem. Theory Comput. 12, 1799-1805, 2016): the start t0
+ *    maximizes the number of uncorrelated samples (T - t0) / g(t0), with g the statistical inefficiency of the
+ *    remainder of the series, or
+ *  - MSER (White, Simulation 69, 323-334, 1997): the start t0 minimizes the marginal standard error of the remainder.
+ * The system is stationary when, for all observables, the detected start lies in the first half of the series.
+ * Long series are reduced to at most 'maximumSeriesLength' batch means to bound the cost of the analysis.
+ */
+export struct EquilibrationDetector
+{
+  /**
+   * \brief Enumeration of the methods to detect the start of the stationary region.
+   */
+  enum class Method : size_t
+  {
+    MaximumEffectiveSamples = 0,  ///< Maximum number of uncorrelated samples (Chodera).
+    MSER = 1                      ///< Marginal standard error rule (White).
+  };
+
+  EquilibrationDetector() {};
+
+  /**
+   * \brief Constructs an equilibration detector.
+   *
+   * \param method The method used to detect the start of the stationary region.
+   * \param numberOfObservables The number of monitored observables.
+   * \param checkEvery Interval (in cycles) at which stationarity is tested.
+   * \param minimumNumberOfCycles Minimum number of cycles in a stage before it may be declared stationary.
+   */
+  EquilibrationDetector(Method method, size_t numberOfObservables, size_t checkEvery, size_t minimumNumberOfCycles);
+
+  bool operator==(EquilibrationDetector const &) const = default;
+
+  uint64_t versionNumber{1};
+
+  Method method{Method::MaximumEffectiveSamples};
+  size_t checkEvery{1000};
+  size_t minimumNumberOfCycles{1000};
+  size_t maximumSeriesLength{1000};
+
+  std::vector<std::vector<double>> timeSeries{};
+  std::optional<size_t> equilibratedAtCycle{};
+
+  /**
+   * \brief Clears the time series at the start of a new stage.
+   */
+  void clear();
+
+  /**
+   * \brief Appends the current value of each observable to its time series.
+   */
+  void addSample(std::span<const double> observables);
+
+  /**
+   * \brief Tests whether all time series have become stationary.
+   *
+   * \return The cycle (relative to the start of the stage) at which the stationary region starts, or std::nullopt if
+   *         the system is not yet stationary.
+   */
+  std::optional<size_t> detect() const;
+
+  /**
+   * \brief Computes the statistical inefficiency of a time series.
+   *
+   * Integrates the normalized autocorrelation function until it first crosses zero, using a lag increment that grows
+   * by one each step (as in pymbar).
+   */
+  static double statisticalInefficiency(std::span<const double> series);
+
+  /**
+   * \brief Returns the start of the stationary region of a time series using the selected method.
+   */
+  size_t stationaryStart(std::span<const double> series) const;
+
+  nlohmann::json jsonStatus(size_t numberOfCyclesPerformed, size_t maximumNumberOfCycles) const;
+
+  friend Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const EquilibrationDetector &d);
+  friend Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, EquilibrationDetector &d);
+};
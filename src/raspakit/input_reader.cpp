@@ -66,6 +66,7 @@ import multi_site_isotherm;
 import pressure_range;
 import mc_moves_probabilities_system;
 import mc_moves_probabilities_particles;
+import mc_moves_probability_tuning;
 import reaction;
 import reactions;
 import transition_matrix;
@@ -77,6 +78,8 @@ import property_number_of_molecules_histogram;
 import property_msd;
 import property_vacf;
 import thermostat;
+import convergence_monitor;
+import equilibration_detection;
 
 int3 parseInt3(const std::string& item, auto json)
 {
@@ -222,6 +225,12 @@ InputReader::InputReader(const std::string inputFile)  // : inputStream(inputFil
       simulationType = SimulationType::ParallelTempering;
       parseMolecularSimulations(parsed_data);
     }
+    else if (caseInSensStringCompare(simulationTypeString, "Screening"))
+    {
+      simulationType = SimulationType::Screening;
+      parseMolecularSimulations(parsed_data);
+      parseScreening(parsed_data);
+    }
     else
     {
       throw std::runtime_error(
@@ -230,6 +239,139 @@ InputReader::InputReader(const std::string inputFile)  // : inputStream(inputFil
   }
 }
 
+std::vector<InputReader::ScreeningJob> InputReader::parseScreeningJobs(
+    const nlohmann::basic_json<nlohmann::raspa_map>& screening, const std::vector<System>& systems)
+{
+  std::vector<ScreeningJob> jobs{};
+
+  for (auto& [key, _] : screening.items())
+  {
+    if (!caseInSensStringCompare(key, "Jobs") && !caseInSensStringCompare(key, "ExternalTemperatures") &&
+        !caseInSensStringCompare(key, "ExternalPressures"))
+    {
+      throw std::runtime_error(std::format("Error: Unknown screening input '{}'\n", key));
+    }
+  }
+
+  // a system is referred to by its index or by the name of its framework
+  auto systemIndex = [&systems](const nlohmann::basic_json<nlohmann::raspa_map>& value) -> size_t
+  {
+    if (value.is_number_unsigned() && value.get<size_t>() < systems.size())
+    {
+      return value.get<size_t>();
+    }
+    if (value.is_string())
+    {
+      std::string name = value.get<std::string>();
+      for (size_t i = 0; i != systems.size(); ++i)
+      {
+        if (!systems[i].frameworkComponents.empty() &&
+            caseInSensStringCompare(systems[i].frameworkComponents.front().name, name))
+        {
+          return i;
+        }
+      }
+    }
+    throw std::runtime_error(std::format("[Input reader]: screening job refers to unknown system {}\n", value.dump()));
+  };
+
+  auto parseValues = [&screening](const std::string& key) -> std::optional<std::vector<double>>
+  {
+    if (!screening.contains(key)) return std::nullopt;
+    if (!screening[key].is_array() || screening[key].empty())
+    {
+      throw std::runtime_error(
+          std::format("[Input reader]: key '{}', value {} should be a non-empty array of numbers\n", key,
+                      screening[key].dump()));
+    }
+    return screening[key].get<std::vector<double>>();
+  };
+
+  if (screening.contains("Jobs"))
+  {
+    for (auto& [_, job] : screening["Jobs"].items())
+    {
+      if (!job.contains("System"))
+      {
+        throw std::runtime_error(
+            std::format("[Input reader]: screening job must have a key 'System' with an index or framework name\n"));
+      }
+      size_t systemId = systemIndex(job["System"]);
+
+      double T = systems[systemId].temperature;
+      if (job.contains("ExternalTemperature"))
+      {
+        T = job["ExternalTemperature"].get<double>();
+      }
+      std::optional<double> P = systems[systemId].input_pressure;
+      if (job.contains("ExternalPressure"))
+      {
+        P = job["ExternalPressure"].get<double>();
+      }
+      jobs.push_back(ScreeningJob{systemId, T, P});
+    }
+  }
+  else
+  {
+    // all combinations, ordered by system so that consecutive jobs share the same framework
+    std::optional<std::vector<double>> temperatures = parseValues("ExternalTemperatures");
+    std::optional<std::vector<double>> pressures = parseValues("ExternalPressures");
+    for (size_t systemId = 0; systemId != systems.size(); ++systemId)
+    {
+      for (double T : temperatures.value_or(std::vector<double>{systems[systemId].temperature}))
+      {
+        for (double P : pressures.value_or(std::vector<double>{systems[systemId].input_pressure}))
+        {
+          jobs.push_back(ScreeningJob{systemId, T, P});
+        }
+      }
+    }
+  }
+
+  return jobs;
+}
+
+void InputReader::parseScreening(const nlohmann::basic_json<nlohmann::raspa_map>& parsed_data)
+{
+  if (!parsed_data.contains("Screening") || !parsed_data["Screening"].is_object())
+  {
+    throw std::runtime_error(
+        std::format("[Input reader]: screening requires a key 'Screening' with the jobs or the state points\n"));
+  }
+  screeningJobs = parseScreeningJobs(parsed_data["Screening"], systems);
+
+  if (screeningJobs.empty())
+  {
+    throw std::runtime_error(std::format("[Input reader]: screening has no jobs\n"));
+  }
+
+  // fugacity coefficients not given in the input follow from the equation of state at the state point of each job
+  if (parsed_data.contains("Components"))
+  {
+    for (size_t componentId = 0; auto& [_, item] : parsed_data["Components"].items())
+    {
+      if (!item.contains("FugacityCoefficient"))
+      {
+        for (System& system : systems)
+        {
+          system.components[componentId].fugacityCoefficient = std::nullopt;
+        }
+      }
+      ++componentId;
+    }
+  }
+
+  // the jobs run concurrently, one per thread, so the energies within a job are computed serially
+  if (parsed_data.contains("ThreadingType") && parsed_data["ThreadingType"].is_string() &&
+      !caseInSensStringCompare(parsed_data["ThreadingType"].get<std::string>(), "Serial"))
+  {
+    throw std::runtime_error(
+        std::format("[Input reader]: screening runs 'NumberOfThreads' jobs concurrently and computes the energies "
+                    "within a job serially, 'ThreadingType' must be 'Serial' or left out\n"));
+  }
+  threadingType = ThreadPool::ThreadingType::Serial;
+}
+
 void InputReader::parseFitting([[maybe_unused]] const nlohmann::basic_json<nlohmann::raspa_map>& parsed_data) {}
 
 void InputReader::parseMixturePrediction([[maybe_unused]] const nlohmann::basic_json<nlohmann::raspa_map>& parsed_data)
@@ -330,6 +472,89 @@ void InputReader::parseBreakthrough(const nlohmann::basic_json<nlohmann::raspa_m
       systems[systemId] = System(systemId, T, P, heliumVoidFraction, {framework}, jsonComponents[systemId]);
     }
 
+    if (value.contains("ColumnIntegrator") && value["ColumnIntegrator"].is_string())
+    {
+      std::string integratorString = value["ColumnIntegrator"].get<std::string>();
+      if (caseInSensStringCompare(integratorString, "SSP-RK"))
+      {
+        systems[systemId].columnIntegrator = System::ColumnIntegrator::SSP_RK;
+      }
+      else if (caseInSensStringCompare(integratorString, "AdaptiveSSP-RK"))
+      {
+        systems[systemId].columnIntegrator = System::ColumnIntegrator::AdaptiveSSP_RK;
+      }
+      else if (caseInSensStringCompare(integratorString, "Rosenbrock"))
+      {
+        systems[systemId].columnIntegrator = System::ColumnIntegrator::Rosenbrock;
+      }
+      else
+      {
+        throw std::runtime_error(std::format(
+            "[Input reader]: {} not a valid column integrator (SSP-RK, AdaptiveSSP-RK, or Rosenbrock)\n",
+            integratorString));
+      }
+    }
+
+    if (value.contains("ColumnRelativeTolerance") && value["ColumnRelativeTolerance"].is_number_float())
+    {
+      systems[systemId].columnRelativeTolerance = value["ColumnRelativeTolerance"].get<double>();
+    }
+
+    if (value.contains("ColumnAbsoluteTolerance") && value["ColumnAbsoluteTolerance"].is_number_float())
+    {
+      systems[systemId].columnAbsoluteTolerance = value["ColumnAbsoluteTolerance"].get<double>();
+    }
+
+    if (value.contains("ColumnMaximumTimeStep") && value["ColumnMaximumTimeStep"].is_number_float())
+    {
+      systems[systemId].columnMaximumTimeStep = value["ColumnMaximumTimeStep"].get<double>();
+    }
+
+    if (value.contains("ColumnConvectionScheme") && value["ColumnConvectionScheme"].is_string())
+    {
+      std::string schemeString = value["ColumnConvectionScheme"].get<std::string>();
+      if (caseInSensStringCompare(schemeString, "Upwind"))
+      {
+        systems[systemId].columnConvectionScheme = System::ColumnConvectionScheme::Upwind;
+      }
+      else if (caseInSensStringCompare(schemeString, "VanLeer"))
+      {
+        systems[systemId].columnConvectionScheme = System::ColumnConvectionScheme::VanLeer;
+      }
+      else if (caseInSensStringCompare(schemeString, "WENO3"))
+      {
+        systems[systemId].columnConvectionScheme = System::ColumnConvectionScheme::WENO3;
+      }
+      else
+      {
+        throw std::runtime_error(std::format(
+            "[Input reader]: {} not a valid column convection scheme (Upwind, VanLeer, or WENO3)\n", schemeString));
+      }
+    }
+
+    if (value.contains("ColumnOutputFormat") && value["ColumnOutputFormat"].is_string())
+    {
+      std::string formatString = value["ColumnOutputFormat"].get<std::string>();
+      if (caseInSensStringCompare(formatString, "Text"))
+      {
+        systems[systemId].columnOutputFormat = System::ColumnOutputFormat::Text;
+      }
+      else if (caseInSensStringCompare(formatString, "HDF5"))
+      {
+        systems[systemId].columnOutputFormat = System::ColumnOutputFormat::HDF5;
+      }
+      else
+      {
+        throw std::runtime_error(
+            std::format("[Input reader]: {} not a valid column output format (Text or HDF5)\n", formatString));
+      }
+    }
+
+    if (value.contains("SpreadingPressureTables") && value["SpreadingPressureTables"].is_boolean())
+    {
+      systems[systemId].useSpreadingPressureTables = value["SpreadingPressureTables"].get<bool>();
+    }
+
     systemId++;
   }
 }
@@ -409,6 +634,12 @@ void InputReader::parseMolecularSimulations(const nlohmann::basic_json<nlohmann:
     writeBinaryRestartEvery = parsed_data["WriteBinaryRestartEvery"].get<size_t>();
   }
 
+  if (parsed_data.contains("NumberOfBinaryRestartFiles") &&
+      parsed_data["NumberOfBinaryRestartFiles"].is_number_unsigned())
+  {
+    numberOfBinaryRestartFiles = std::max(1uz, parsed_data["NumberOfBinaryRestartFiles"].get<size_t>());
+  }
+
   if (parsed_data.contains("RescaleWangLandauEvery") && parsed_data["RescaleWangLandauEvery"].is_number_unsigned())
   {
     rescaleWangLandauEvery = parsed_data["RescaleWangLandauEvery"].get<size_t>();
@@ -419,6 +650,103 @@ void InputReader::parseMolecularSimulations(const nlohmann::basic_json<nlohmann:
     optimizeMCMovesEvery = parsed_data["OptimizeMCMovesEvery"].get<size_t>();
   }
 
+  if (parsed_data.contains("ConvergenceRelativeErrorLoading") &&
+      parsed_data["ConvergenceRelativeErrorLoading"].is_number_float())
+  {
+    convergenceRelativeErrorLoading = parsed_data["ConvergenceRelativeErrorLoading"].get<double>();
+  }
+
+  if (parsed_data.contains("ConvergenceRelativeErrorEnergy") &&
+      parsed_data["ConvergenceRelativeErrorEnergy"].is_number_float())
+  {
+    convergenceRelativeErrorEnergy = parsed_data["ConvergenceRelativeErrorEnergy"].get<double>();
+  }
+
+  if (parsed_data.contains("ConvergenceRelativeErrorEnthalpy") &&
+      parsed_data["ConvergenceRelativeErrorEnthalpy"].is_number_float())
+  {
+    convergenceRelativeErrorEnthalpy = parsed_data["ConvergenceRelativeErrorEnthalpy"].get<double>();
+  }
+
+  if (parsed_data.contains("ConvergenceMinimumNumberOfCycles") &&
+      parsed_data["ConvergenceMinimumNumberOfCycles"].is_number_unsigned())
+  {
+    convergenceMinimumNumberOfCycles = parsed_data["ConvergenceMinimumNumberOfCycles"].get<size_t>();
+  }
+
+  if (parsed_data.contains("CheckConvergenceEvery") && parsed_data["CheckConvergenceEvery"].is_number_unsigned())
+  {
+    checkConvergenceEvery = parsed_data["CheckConvergenceEvery"].get<size_t>();
+  }
+
+  if (parsed_data.contains("EquilibrationDetection") && parsed_data["EquilibrationDetection"].is_string())
+  {
+    std::string methodString = parsed_data["EquilibrationDetection"].get<std::string>();
+    if (caseInSensStringCompare(methodString, "MaximumEffectiveSamples"))
+    {
+      equilibrationDetection = EquilibrationDetector::Method::MaximumEffectiveSamples;
+    }
+    else if (caseInSensStringCompare(methodString, "MSER"))
+    {
+      equilibrationDetection = EquilibrationDetector::Method::MSER;
+    }
+    else if (!caseInSensStringCompare(methodString, "None"))
+    {
+      throw std::runtime_error(
+          std::format("[Input reader]: {} not a valid equilibration detection method (MaximumEffectiveSamples, "
+                      "MSER, or None)\n",
+                      methodString));
+    }
+  }
+
+  if (parsed_data.contains("EquilibrationDetectionMinimumNumberOfCycles") &&
+      parsed_data["EquilibrationDetectionMinimumNumberOfCycles"].is_number_unsigned())
+  {
+    equilibrationDetectionMinimumNumberOfCycles =
+        parsed_data["EquilibrationDetectionMinimumNumberOfCycles"].get<size_t>();
+  }
+
+  if (parsed_data.contains("CheckEquilibrationEvery") && parsed_data["CheckEquilibrationEvery"].is_number_unsigned())
+  {
+    checkEquilibrationEvery = parsed_data["CheckEquilibrationEvery"].get<size_t>();
+  }
+
+  if (parsed_data.contains("ConcurrentSystems") && parsed_data["ConcurrentSystems"].is_boolean())
+  {
+    concurrentSystems = parsed_data["ConcurrentSystems"].get<bool>();
+  }
+
+  if (parsed_data.contains("Tracing") && parsed_data["Tracing"].is_boolean())
+  {
+    tracing = parsed_data["Tracing"].get<bool>();
+  }
+
+  if (parsed_data.contains("TracingBufferSize") && parsed_data["TracingBufferSize"].is_number_unsigned())
+  {
+    tracingBufferSize = std::max(1uz, parsed_data["TracingBufferSize"].get<size_t>());
+  }
+
+  if (parsed_data.contains("HardwareCounters") && parsed_data["HardwareCounters"].is_boolean())
+  {
+    hardwareCounters = parsed_data["HardwareCounters"].get<bool>();
+  }
+
+  if (parsed_data.contains("TuneMoveProbabilities") && parsed_data["TuneMoveProbabilities"].is_boolean())
+  {
+    tuneMoveProbabilities = parsed_data["TuneMoveProbabilities"].get<bool>();
+  }
+
+  if (parsed_data.contains("MoveProbabilityTuningMaximumScaling") &&
+      parsed_data["MoveProbabilityTuningMaximumScaling"].is_number_float())
+  {
+    moveProbabilityTuningMaximumScaling = parsed_data["MoveProbabilityTuningMaximumScaling"].get<double>();
+    if (moveProbabilityTuningMaximumScaling < 1.0)
+    {
+      throw std::runtime_error(
+          std::format("[Input reader]: MoveProbabilityTuningMaximumScaling must be at least 1.0\n"));
+    }
+  }
+
   if (parsed_data.contains("ThreadingType") && parsed_data["ThreadingType"].is_string())
   {
     std::string threadingTypeString = parsed_data["ThreadingType"].get<std::string>();
@@ -440,6 +768,47 @@ void InputReader::parseMolecularSimulations(const nlohmann::basic_json<nlohmann:
     }
   }
 
+  if (parsed_data.contains("MinimizationMethod") && parsed_data["MinimizationMethod"].is_string())
+  {
+    std::string methodString = parsed_data["MinimizationMethod"].get<std::string>();
+    if (caseInSensStringCompare(methodString, "FIRE"))
+    {
+      minimizer.method = Minimizer::Method::FIRE;
+    }
+    else if (caseInSensStringCompare(methodString, "LBFGS") || caseInSensStringCompare(methodString, "L-BFGS"))
+    {
+      minimizer.method = Minimizer::Method::LBFGS;
+    }
+    else
+    {
+      throw std::runtime_error(
+          std::format("[Input reader]: unknown MinimizationMethod '{}' (choose FIRE or L-BFGS)\n", methodString));
+    }
+  }
+
+  if (parsed_data.contains("MinimizationGradientTolerance") &&
+      parsed_data["MinimizationGradientTolerance"].is_number_float())
+  {
+    minimizer.gradientTolerance = parsed_data["MinimizationGradientTolerance"].get<double>();
+  }
+
+  if (parsed_data.contains("MinimizationMaximumStepSize") &&
+      parsed_data["MinimizationMaximumStepSize"].is_number_float())
+  {
+    minimizer.maximumStepSize = parsed_data["MinimizationMaximumStepSize"].get<double>();
+  }
+
+  if (parsed_data.contains("MinimizationHistorySize") && parsed_data["MinimizationHistorySize"].is_number_unsigned())
+  {
+    minimizer.historySize = parsed_data["MinimizationHistorySize"].get<size_t>();
+  }
+
+  if (parsed_data.contains("NumberOfMinimizationSteps") &&
+      parsed_data["NumberOfMinimizationSteps"].is_number_unsigned())
+  {
+    numberOfMinimizationSteps = parsed_data["NumberOfMinimizationSteps"].get<size_t>();
+  }
+
   if (parsed_data.contains("NumberOfThreads") && parsed_data["NumberOfThreads"].is_number_unsigned())
   {
     numberOfThreads = parsed_data["NumberOfThreads"].get<size_t>();
@@ -1020,6 +1389,16 @@ void InputReader::parseMolecularSimulations(const nlohmann::basic_json<nlohmann:
         systems[systemId].tmmc.maxMacrostate = value["MacroStateMaximumNumberOfMolecules"].get<size_t>();
       }
 
+      if (value.contains("MacroStateNumberOfWindows") && value["MacroStateNumberOfWindows"].is_number_unsigned())
+      {
+        systems[systemId].tmmc.numberOfWindows = value["MacroStateNumberOfWindows"].get<size_t>();
+      }
+
+      if (value.contains("MacroStateWindowOverlap") && value["MacroStateWindowOverlap"].is_number_unsigned())
+      {
+        systems[systemId].tmmc.windowOverlap = value["MacroStateWindowOverlap"].get<size_t>();
+      }
+
       if (value.contains("ExternalField") && value["ExternalField"].is_boolean())
       {
         systems[systemId].hasExternalField = value["ExternalField"].get<bool>();
@@ -1274,9 +1653,28 @@ void InputReader::parseMolecularSimulations(const nlohmann::basic_json<nlohmann:
             }
           }
 
+          PropertyDensityGrid::OutputFormat densityGridFormat{PropertyDensityGrid::OutputFormat::Cube};
+          if (value.contains("DensityGridFormat") && value["DensityGridFormat"].is_string())
+          {
+            std::string densityGridFormatString = value["DensityGridFormat"].get<std::string>();
+            if (caseInSensStringCompare(densityGridFormatString, "Cube"))
+            {
+              densityGridFormat = PropertyDensityGrid::OutputFormat::Cube;
+            }
+            else if (caseInSensStringCompare(densityGridFormatString, "HDF5"))
+            {
+              densityGridFormat = PropertyDensityGrid::OutputFormat::HDF5;
+            }
+            else
+            {
+              throw std::runtime_error(std::format(
+                  "[Input reader]: {} not a valid density grid format (Cube or HDF5)\n", densityGridFormatString));
+            }
+          }
+
           systems[systemId].propertyDensityGrid = PropertyDensityGrid(
               systems[systemId].frameworkComponents.size(), systems[systemId].components.size(), densityGridSize,
-              sampleDensityGridEvery, writeDensityGridEvery, densityGridPseudoAtomsList);
+              sampleDensityGridEvery, writeDensityGridEvery, densityGridPseudoAtomsList, densityGridFormat);
         }
       }
 
@@ -1341,6 +1739,36 @@ void InputReader::parseMolecularSimulations(const nlohmann::basic_json<nlohmann:
     }
   }
 
+  if (convergenceRelativeErrorLoading || convergenceRelativeErrorEnergy || convergenceRelativeErrorEnthalpy)
+  {
+    for (size_t i = 0uz; i < systems.size(); ++i)
+    {
+      systems[i].convergenceMonitor = ConvergenceMonitor(
+          systems[i].components.size(), systems[i].swappableComponents, convergenceRelativeErrorLoading,
+          convergenceRelativeErrorEnergy, convergenceRelativeErrorEnthalpy, convergenceMinimumNumberOfCycles);
+    }
+  }
+
+  if (equilibrationDetection.has_value())
+  {
+    for (size_t i = 0uz; i < systems.size(); ++i)
+    {
+      // monitored observables: the loading of each component and the potential energy
+      systems[i].equilibrationDetector =
+          EquilibrationDetector(equilibrationDetection.value(), systems[i].components.size() + 1uz,
+                                checkEquilibrationEvery, equilibrationDetectionMinimumNumberOfCycles);
+    }
+  }
+
+  if (tuneMoveProbabilities)
+  {
+    for (size_t i = 0uz; i < systems.size(); ++i)
+    {
+      systems[i].moveProbabilityTuning =
+          MCMoveProbabilityTuning(systems[i].components, moveProbabilityTuningMaximumScaling);
+    }
+  }
+
   if (simulationType == SimulationType::MonteCarloTransitionMatrix)
   {
     for (size_t i = 0uz; i < systems.size(); ++i)
@@ -1348,6 +1776,12 @@ void InputReader::parseMolecularSimulations(const nlohmann::basic_json<nlohmann:
       systems[i].tmmc.doTMMC = true;
       systems[i].tmmc.useBias = true;
       systems[i].tmmc.useTMBias = true;
+
+      // the windows run concurrently, one per thread, so the energies within a window are computed serially
+      if (systems[i].tmmc.numberOfWindows > 1)
+      {
+        threadingType = ThreadPool::ThreadingType::Serial;
+      }
     }
   }
 
@@ -1454,6 +1888,25 @@ void InputReader::parseMolecularSimulations(const nlohmann::basic_json<nlohmann:
         throw std::runtime_error("Error: Multiple components for TMMC not yet implemented.\n");
       }
 
+      if (systems[i].tmmc.numberOfWindows > 1 && systems.size() > 1)
+      {
+        throw std::runtime_error("Error: TMMC windows are only implemented for a single system.\n");
+      }
+
+      // every window writes its own restart file to 'output/window_k', there is no combined restart file to read
+      if (systems[i].tmmc.numberOfWindows > 1 && restartFromBinary)
+      {
+        throw std::runtime_error("Error: TMMC windows cannot be restarted from a binary restart file.\n");
+      }
+
+      if (systems[i].tmmc.numberOfWindows == 0 ||
+          systems[i].tmmc.numberOfWindows > systems[i].tmmc.maxMacrostate - systems[i].tmmc.minMacrostate + 1)
+      {
+        throw std::runtime_error(
+            std::format("Error: the TMMC macrostate range ({}-{}) cannot be split into {} windows\n",
+                        systems[i].tmmc.minMacrostate, systems[i].tmmc.maxMacrostate, systems[i].tmmc.numberOfWindows));
+      }
+
       // check initial number of molecules is in the range of the TMMC macrostates
       for (size_t j = 0uz; j < systems[i].components.size(); ++j)
       {
@@ -1484,10 +1937,31 @@ const std::set<std::string, InputReader::InsensitiveCompare> InputReader::genera
     "NumberOfEquilibrationCycles",
     "PrintEvery",
     "WriteBinaryRestartEvery",
+    "NumberOfBinaryRestartFiles",
     "RescaleWangLandauEvery",
     "OptimizeMCMovesEvery",
+    "ConvergenceRelativeErrorLoading",
+    "ConvergenceRelativeErrorEnergy",
+    "ConvergenceRelativeErrorEnthalpy",
+    "ConvergenceMinimumNumberOfCycles",
+    "CheckConvergenceEvery",
+    "EquilibrationDetection",
+    "EquilibrationDetectionMinimumNumberOfCycles",
+    "CheckEquilibrationEvery",
+    "TuneMoveProbabilities",
+    "MoveProbabilityTuningMaximumScaling",
     "ThreadingType",
     "NumberOfThreads",
+    "ConcurrentSystems",
+    "Tracing",
+    "TracingBufferSize",
+    "HardwareCounters",
+    "MinimizationMethod",
+    "MinimizationGradientTolerance",
+    "MinimizationMaximumStepSize",
+    "MinimizationHistorySize",
+    "NumberOfMinimizationSteps",
+    "Screening",
     "Components",
     "Systems"};
 
@@ -1550,13 +2024,23 @@ const std::set<std::string, InputReader::InsensitiveCompare> InputReader::system
     "WriteDensityGridEvery",
     "DensityGridSize",
     "DensityGridPseudoAtomsList",
+    "DensityGridFormat",
     "OutputPDBMovie",
     "SampleMovieEvery",
     "Ensemble",
     "TimeStep",
     "MacroStateUseBias",
     "MacroStateMinimumNumberOfMolecules",
-    "MacroStateMaximumNumberOfMolecules"};
+    "MacroStateMaximumNumberOfMolecules",
+    "MacroStateNumberOfWindows",
+    "MacroStateWindowOverlap",
+    "ColumnIntegrator",
+    "ColumnRelativeTolerance",
+    "ColumnAbsoluteTolerance",
+    "ColumnMaximumTimeStep",
+    "ColumnConvectionScheme",
+    "ColumnOutputFormat",
+    "SpreadingPressureTables"};
 
 const std::set<std::string, InputReader::InsensitiveCompare> InputReader::componentOptions = {
     "Name",
@@ -52,6 +52,8 @@ import loadings;
 import enthalpy_of_adsorption;
 import energy_status;
 import averages;
+import equilibration_detection;
+import minimizer;
 
 /**
  * \struct InputDataSystem
@@ -113,7 +115,18 @@ export struct InputReader
     Breakthrough = 5,                ///< Breakthrough simulation for adsorption studies.
     MixturePrediction = 6,           ///< Simulation for predicting mixtures.
     Fitting = 7,                     ///< Simulation type for fitting parameters.
-    ParallelTempering = 8            ///< Parallel Tempering simulation for enhanced sampling.
+    ParallelTempering = 8,           ///< Parallel Tempering simulation for enhanced sampling.
+    Screening = 9                    ///< Monte Carlo runs of every framework at a list of state points.
+  };
+
+  /**
+   * \brief A job of a screening run: one of the systems at a given external temperature and pressure.
+   */
+  struct ScreeningJob
+  {
+    size_t systemId;                 ///< Index of the system (framework) in 'systems'.
+    double temperature;              ///< External temperature [K].
+    std::optional<double> pressure;  ///< External pressure [Pa].
   };
 
   /**
@@ -142,16 +155,40 @@ export struct InputReader
   size_t numberOfEquilibrationCycles{0};   ///< Number of equilibration cycles.
   std::size_t printEvery{5000};            ///< Interval for printing simulation progress.
   size_t writeBinaryRestartEvery{5000};    ///< Interval for writing binary restart files.
+  size_t numberOfBinaryRestartFiles{1};    ///< Number of rotated binary restart files to keep.
   size_t rescaleWangLandauEvery{5000};     ///< Interval for rescaling in Wang-Landau sampling.
   size_t optimizeMCMovesEvery{5000};       ///< Interval for optimizing Monte Carlo moves.
   size_t writeEvery{100};                  ///< Interval for writing simulation data.
   bool restartFromBinary{false};           ///< Flag to indicate if the simulation should restart from a binary file.
 
+  std::optional<double> convergenceRelativeErrorLoading{};   ///< Target relative error of the loadings.
+  std::optional<double> convergenceRelativeErrorEnergy{};    ///< Target relative error of the potential energy.
+  std::optional<double> convergenceRelativeErrorEnthalpy{};  ///< Target relative error of the enthalpies of adsorption.
+  size_t convergenceMinimumNumberOfCycles{0};  ///< Minimum number of production cycles before terminating.
+  size_t checkConvergenceEvery{1000};          ///< Interval for checking the convergence of the production run.
+
+  std::optional<EquilibrationDetector::Method> equilibrationDetection{};  ///< Method for adaptive equilibration.
+  size_t equilibrationDetectionMinimumNumberOfCycles{1000};  ///< Minimum number of cycles of an adaptive stage.
+  size_t checkEquilibrationEvery{1000};                      ///< Interval for testing stationarity.
+
+  bool tuneMoveProbabilities{false};                ///< Flag to adapt the move probabilities during equilibration.
+  double moveProbabilityTuningMaximumScaling{4.0};  ///< Maximum deviation from the user move probabilities.
+
   std::optional<unsigned long long> randomSeed{std::nullopt};  ///< Optional random seed for reproducibility.
 
   size_t numberOfThreads{1};  ///< Number of threads to be used in the simulation.
+  bool concurrentSystems{false};  ///< Run the independent breakthrough/mixture-prediction systems concurrently.
   ThreadPool::ThreadingType threadingType{ThreadPool::ThreadingType::Serial};  ///< Type of threading to be used.
 
+  bool tracing{false};              ///< Record the timing zones and write them as a Chrome trace.
+  size_t tracingBufferSize{65536};  ///< Number of most recent zones kept per thread.
+  bool hardwareCounters{false};     ///< Read the hardware performance counters in every timing zone.
+
+  Minimizer minimizer{};                 ///< Settings of the energy minimization.
+  size_t numberOfMinimizationSteps{0};  ///< Minimization steps before the MD equilibration (0: none).
+
+  std::vector<ScreeningJob> screeningJobs{};  ///< Jobs of a screening run, in the order they are scheduled.
+
   ForceField forceField;          ///< Force field used for defining interactions in the simulation.
   std::vector<System> systems{};  ///< Vector of simulation systems configured for the simulation.
 
@@ -200,6 +237,27 @@ export struct InputReader
    */
   void parseBreakthrough(const nlohmann::basic_json<nlohmann::raspa_map> &parsed_data);
 
+  /**
+   * \brief Parses the jobs of a screening run from the 'Screening' object of the JSON data.
+   *
+   * Either an explicit list 'Jobs' of systems with their external temperature and pressure, or all combinations of
+   * the systems with 'ExternalTemperatures' and 'ExternalPressures' (by default those of the systems themselves).
+   * Must be called after the systems have been parsed.
+   *
+   * \param parsed_data The JSON object containing the parsed input data.
+   *
+   * \throws std::runtime_error If the 'Screening' object is missing or refers to an unknown system.
+   */
+  void parseScreening(const nlohmann::basic_json<nlohmann::raspa_map> &parsed_data);
+
+  /**
+   * \brief Returns the jobs listed in the 'Screening' object for the given systems.
+   *
+   * \throws std::runtime_error If the object has an unknown key or a job refers to an unknown system.
+   */
+  static std::vector<ScreeningJob> parseScreeningJobs(const nlohmann::basic_json<nlohmann::raspa_map> &screening,
+                                                      const std::vector<System> &systems);
+
   /**
    * \brief Validates the parsed input data to ensure correctness and completeness.
    *
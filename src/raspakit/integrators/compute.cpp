@@ -14,6 +14,7 @@ import <optional>;
 import <chrono>;
 #endif
 
+import tracing;
 import molecule;
 import atom;
 import double3;
@@ -28,23 +29,22 @@ import integrators_cputime;
 
 double Integrators::computeTranslationalKineticEnergy(std::span<const Molecule> moleculePositions)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("computeTranslationalKineticEnergy", "md");
   double energy{};
   for (const Molecule& molecule : moleculePositions)
   {
     // Accumulate kinetic energy: 0.5 * mass * velocity squared
     energy += 0.5 * molecule.mass * double3::dot(molecule.velocity, molecule.velocity);
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
   // Update CPU time tracking for this function
-  integratorsCPUTime.computeTranslationalKineticEnergy += end - begin;
+  zone.end(integratorsCPUTime.computeTranslationalKineticEnergy);
   return energy;
 }
 
 double Integrators::computeRotationalKineticEnergy(std::span<const Molecule> moleculePositions,
                                                    const std::vector<Component> components)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("computeRotationalKineticEnergy", "md");
   double3 ang_vel;
   double energy{};
 
@@ -65,15 +65,14 @@ double Integrators::computeRotationalKineticEnergy(std::span<const Molecule> mol
     // Accumulate rotational kinetic energy: 0.5 * inertia * angular velocity squared
     energy += 0.5 * double3::dot(inertiaVector, ang_vel * ang_vel);
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
   // Update CPU time tracking for this function
-  integratorsCPUTime.computeRotationalKineticEnergy += end - begin;
+  zone.end(integratorsCPUTime.computeRotationalKineticEnergy);
   return energy;
 }
 
 double3 Integrators::computeCenterOfMass(std::span<const Molecule> moleculePositions)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("computeCenterOfMass", "md");
   double3 com{};
   double totalMass{};
 
@@ -83,9 +82,8 @@ double3 Integrators::computeCenterOfMass(std::span<const Molecule> moleculePosit
     totalMass += molecule.mass;
     com += molecule.mass * molecule.centerOfMassPosition;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
   // Update CPU time tracking for this function
-  integratorsCPUTime.computeCenterOfMass += end - begin;
+  zone.end(integratorsCPUTime.computeCenterOfMass);
 
   // Return the center of mass position
   return com / totalMass;
@@ -94,7 +92,7 @@ double3 Integrators::computeCenterOfMass(std::span<const Molecule> moleculePosit
 // The velocity of the center of mass is the average velocity of all objects in the system weighted by their masses
 double3 Integrators::computeCenterOfMassVelocity(std::span<const Molecule> moleculePositions)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("computeCenterOfMassVelocity", "md");
   double3 com_velocity{};
   double totalMass{};
 
@@ -104,16 +102,15 @@ double3 Integrators::computeCenterOfMassVelocity(std::span<const Molecule> molec
     totalMass += molecule.mass;
     com_velocity += molecule.mass * molecule.velocity;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
   // Update CPU time tracking for this function
-  integratorsCPUTime.computeCenterOfMassVelocity += end - begin;
+  zone.end(integratorsCPUTime.computeCenterOfMassVelocity);
   // Return the center of mass velocity
   return com_velocity / totalMass;
 }
 
 double3 Integrators::computeLinearMomentum(std::span<const Molecule> moleculePositions)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("computeLinearMomentum", "md");
 
   double3 com_momentum{};
   for (const Molecule& molecule : moleculePositions)
@@ -121,8 +118,7 @@ double3 Integrators::computeLinearMomentum(std::span<const Molecule> moleculePos
     // Accumulate linear momentum: mass * velocity
     com_momentum += molecule.mass * molecule.velocity;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
   // Update CPU time tracking for this function
-  integratorsCPUTime.computeLinearMomentum += end - begin;
+  zone.end(integratorsCPUTime.computeLinearMomentum);
   return com_momentum;
 }
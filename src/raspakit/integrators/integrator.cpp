@@ -18,6 +18,7 @@ import <complex>;
 import <chrono>;
 #endif
 
+import tracing;
 import molecule;
 import atom;
 import component;
@@ -38,7 +39,7 @@ RunningEnergy Integrators::velocityVerlet(
     const std::vector<size_t> numberOfMoleculesPerComponent)
 {
   // Start timing the integration step
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("velocityVerlet", "md");
 
   // apply thermo for temperature control
   if (thermostat.has_value())
@@ -92,7 +93,6 @@ RunningEnergy Integrators::velocityVerlet(
   }
 
   // Update the CPU time spent in the integrator
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-  integratorsCPUTime.velocityVerlet += end - begin;
+  zone.end(integratorsCPUTime.velocityVerlet);
   return runningEnergies;
 }
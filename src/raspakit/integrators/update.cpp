@@ -18,6 +18,7 @@ import <chrono>;
 import <iostream>;
 #endif
 
+import tracing;
 import molecule;
 import double3;
 import atom;
@@ -39,20 +40,19 @@ import units;
 
 void Integrators::scaleVelocities(std::span<Molecule> moleculePositions, std::pair<double, double> scaling)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("scaleVelocities", "md");
   // Scale velocities and orientation momenta of each molecule
   for (Molecule& molecule : moleculePositions)
   {
     molecule.velocity = scaling.first * molecule.velocity;
     molecule.orientationMomentum = scaling.second * molecule.orientationMomentum;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-  integratorsCPUTime.scaleVelocities += end - begin;
+  zone.end(integratorsCPUTime.scaleVelocities);
 }
 
 void Integrators::removeCenterOfMassVelocityDrift(std::span<Molecule> moleculePositions)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("removeCenterOfMassVelocity", "md");
 
   double3 totalVelocity = computeCenterOfMassVelocity(moleculePositions);
   // Scale velocities and orientation momenta of each molecule
@@ -60,25 +60,23 @@ void Integrators::removeCenterOfMassVelocityDrift(std::span<Molecule> moleculePo
   {
     molecule.velocity -= totalVelocity;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-  integratorsCPUTime.removeCenterOfMassVelocity += end - begin;
+  zone.end(integratorsCPUTime.removeCenterOfMassVelocity);
 }
 
 void Integrators::updatePositions(std::span<Molecule> moleculePositions, double dt)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("updatePositions", "md");
   // Update the center of mass positions for each molecule
   for (Molecule& molecule : moleculePositions)
   {
     molecule.centerOfMassPosition += dt * molecule.velocity;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-  integratorsCPUTime.updatePositions += end - begin;
+  zone.end(integratorsCPUTime.updatePositions);
 }
 
 void Integrators::updateVelocities(std::span<Molecule> moleculePositions, double dt)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("updateVelocities", "md");
 
   // Update velocities and orientation momenta based on gradients
   for (Molecule& molecule : moleculePositions)
@@ -86,8 +84,7 @@ void Integrators::updateVelocities(std::span<Molecule> moleculePositions, double
     molecule.velocity -= 0.5 * dt * molecule.gradient * molecule.invMass;
     molecule.orientationMomentum -= 0.5 * dt * molecule.orientationGradient;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-  integratorsCPUTime.updateVelocities += end - begin;
+  zone.end(integratorsCPUTime.updateVelocities);
 }
 
 void Integrators::initializeVelocities(RandomNumber& random, std::span<Molecule> moleculePositions,
@@ -116,7 +113,7 @@ void Integrators::initializeVelocities(RandomNumber& random, std::span<Molecule>
 void Integrators::createCartesianPositions(std::span<const Molecule> moleculePositions,
                                            std::span<Atom> moleculeAtomPositions, std::vector<Component> components)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("createCartesianPositions", "md");
   size_t index{};
   // Convert molecule positions and orientations to atom positions
   for (const Molecule& molecule : moleculePositions)
@@ -131,14 +128,13 @@ void Integrators::createCartesianPositions(std::span<const Molecule> moleculePos
     }
     index += molecule.numberOfAtoms;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-  integratorsCPUTime.createCartesianPositions += end - begin;
+  zone.end(integratorsCPUTime.createCartesianPositions);
 }
 
 void Integrators::noSquishFreeRotorOrderTwo(std::span<Molecule> moleculePositions,
                                             const std::vector<Component> components, double dt)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("noSquishFreeRotorOrderTwo", "md");
   for (Molecule& molecule : moleculePositions)
   {
     double3 inverseInertiaVector = components[molecule.componentId].inverseInertiaVector;
@@ -147,15 +143,14 @@ void Integrators::noSquishFreeRotorOrderTwo(std::span<Molecule> moleculePosition
     molecule.orientationMomentum = pq.first;
     molecule.orientation = pq.second;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-  integratorsCPUTime.noSquishFreeRotorOrderTwo += end - begin;
+  zone.end(integratorsCPUTime.noSquishFreeRotorOrderTwo);
 }
 
 void Integrators::updateCenterOfMassAndQuaternionVelocities(std::span<Molecule> moleculePositions,
                                                             std::span<Atom> moleculeAtomPositions,
                                                             std::vector<Component> components)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("updateCenterOfMassAndQuaternionVelocities", "md");
   size_t index{};
   // Update center of mass velocities and orientation momenta for each molecule
   for (Molecule& molecule : moleculePositions)
@@ -189,15 +184,14 @@ void Integrators::updateCenterOfMassAndQuaternionVelocities(std::span<Molecule>
 
     index += molecule.numberOfAtoms;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-  integratorsCPUTime.updateCenterOfMassAndQuaternionVelocities += end - begin;
+  zone.end(integratorsCPUTime.updateCenterOfMassAndQuaternionVelocities);
 }
 
 void Integrators::updateCenterOfMassAndQuaternionGradients(std::span<Molecule> moleculePositions,
                                                            std::span<Atom> moleculeAtomPositions,
                                                            std::vector<Component> components)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("updateCenterOfMassAndQuaternionGradients", "md");
   size_t index{};
   // Update gradients of center of mass and orientation for each molecule
   for (Molecule& molecule : moleculePositions)
@@ -226,8 +220,7 @@ void Integrators::updateCenterOfMassAndQuaternionGradients(std::span<Molecule> m
 
     index += molecule.numberOfAtoms;
   }
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-  integratorsCPUTime.updateCenterOfMassAndQuaternionGradients += end - begin;
+  zone.end(integratorsCPUTime.updateCenterOfMassAndQuaternionGradients);
 }
 
 RunningEnergy Integrators::updateGradients(
@@ -239,7 +232,7 @@ RunningEnergy Integrators::updateGradients(
     const std::vector<std::pair<std::complex<double>, std::complex<double>>>& fixedFrameworkStoredEik,
     const std::vector<size_t> numberOfMoleculesPerComponent)
 {
-  std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+  Tracing::Zone zone("updateGradients", "md");
 
   // Initialize gradients to zero
   for (Atom& atom : moleculeAtomPositions)
@@ -256,7 +249,6 @@ RunningEnergy Integrators::updateGradients(
       eik_x, eik_y, eik_z, eik_xy, totalEik, fixedFrameworkStoredEik, forceField, simulationBox, components,
       numberOfMoleculesPerComponent, moleculeAtomPositions);
 
-  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-  integratorsCPUTime.updateGradients += end - begin;
+  zone.end(integratorsCPUTime.updateGradients);
   return frameworkMoleculeEnergy + intermolecularEnergy + ewaldEnergy;
 }
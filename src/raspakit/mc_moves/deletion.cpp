@@ -32,6 +32,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import double3;
 import double3x3;
 import simd_quatd;
@@ -62,7 +63,7 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::deletionMove(RandomNu
                                                                         size_t selectedComponent,
                                                                         size_t selectedMolecule)
 {
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   // Increment swap deletion move counts for the selected component
   system.components[selectedComponent].mc_moves_statistics.swapDeletionMove.counts += 1;
@@ -92,28 +93,26 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::deletionMove(RandomNu
     if (!interMolecule.has_value()) return {std::nullopt, double3(0.0, 1.0, 0.0)};
 
     // Compute Ewald Fourier energy difference
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapDeletionMoveEwald", "mc");
     RunningEnergy energyFourierDifference = Interactions::energyDifferenceEwaldFourier(
         system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
         system.simulationBox, {}, molecule);
-    time_end = std::chrono::system_clock::now();
 
     // Update CPU time statistics for Ewald calculations
-    system.components[selectedComponent].mc_moves_cputime.swapDeletionMoveEwald += (time_end - time_begin);
-    system.mc_moves_cputime.swapDeletionMoveEwald += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapDeletionMoveEwald,
+             system.mc_moves_cputime.swapDeletionMoveEwald);
 
     // Compute tail correction energy difference
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapDeletionMoveTail", "mc");
     [[maybe_unused]] RunningEnergy tailEnergyDifference =
         Interactions::computeInterMolecularTailEnergyDifference(system.forceField, system.simulationBox,
                                                                 system.spanOfMoleculeAtoms(), {}, molecule) +
         Interactions::computeFrameworkMoleculeTailEnergyDifference(system.forceField, system.simulationBox,
                                                                    system.spanOfFrameworkAtoms(), {}, molecule);
-    time_end = std::chrono::system_clock::now();
 
     // Update CPU time statistics for tail corrections
-    system.components[selectedComponent].mc_moves_cputime.swapDeletionMoveTail += (time_end - time_begin);
-    system.mc_moves_cputime.swapDeletionMoveTail += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapDeletionMoveTail,
+             system.mc_moves_cputime.swapDeletionMoveTail);
 
     // Get the total difference in energy
     RunningEnergy energyDifference = externalFieldMolecule.value() + frameworkMolecule.value() + interMolecule.value() +
@@ -32,6 +32,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import double3;
 import double3x3;
 import simd_quatd;
@@ -62,7 +63,7 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::deletionMoveCBMC(Rand
                                                                             size_t selectedComponent,
                                                                             size_t selectedMolecule)
 {
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   // Increment the count of swap deletion moves for the selected component
   system.components[selectedComponent].mc_moves_statistics.swapDeletionMove_CBMC.counts += 1;
@@ -84,38 +85,35 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::deletionMoveCBMC(Rand
     double cutOffCoulomb = system.forceField.cutOffCoulomb;
 
     // Retrace the molecule for the swap deletion using CBMC algorithm
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapDeletionMoveCBMCNonEwald", "mc");
     ChainData retraceData = CBMC::retraceMoleculeSwapDeletion(
         random, system.frameworkComponents, system.components[selectedComponent], system.hasExternalField,
         system.components, system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
         system.spanOfMoleculeAtoms(), system.beta, cutOffFrameworkVDW, cutOffMoleculeVDW, cutOffCoulomb,
         selectedComponent, selectedMolecule, molecule, 1.0, system.numberOfTrialDirections);
-    time_end = std::chrono::system_clock::now();
     // Update the CPU time statistics for the non-Ewald part of the move
-    system.components[selectedComponent].mc_moves_cputime.swapDeletionMoveCBMCNonEwald += (time_end - time_begin);
-    system.mc_moves_cputime.swapDeletionMoveCBMCNonEwald += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapDeletionMoveCBMCNonEwald,
+             system.mc_moves_cputime.swapDeletionMoveCBMCNonEwald);
 
     // Compute the energy difference in Fourier space due to the deletion
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapDeletionMoveCBMCEwald", "mc");
     RunningEnergy energyFourierDifference = Interactions::energyDifferenceEwaldFourier(
         system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
         system.simulationBox, {}, molecule);
-    time_end = std::chrono::system_clock::now();
     // Update the CPU time statistics for the Ewald part of the move
-    system.components[selectedComponent].mc_moves_cputime.swapDeletionMoveCBMCEwald += (time_end - time_begin);
-    system.mc_moves_cputime.swapDeletionMoveCBMCEwald += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapDeletionMoveCBMCEwald,
+             system.mc_moves_cputime.swapDeletionMoveCBMCEwald);
 
     // Compute the tail energy difference due to the deletion
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapDeletionMoveCBMCTail", "mc");
     [[maybe_unused]] RunningEnergy tailEnergyDifference =
         Interactions::computeInterMolecularTailEnergyDifference(system.forceField, system.simulationBox,
                                                                 system.spanOfMoleculeAtoms(), {}, molecule) +
         Interactions::computeFrameworkMoleculeTailEnergyDifference(system.forceField, system.simulationBox,
                                                                    system.spanOfFrameworkAtoms(), {}, molecule);
-    time_end = std::chrono::system_clock::now();
     // Update the CPU time statistics for the tail corrections
-    system.components[selectedComponent].mc_moves_cputime.swapDeletionMoveCBMCTail += (time_end - time_begin);
-    system.mc_moves_cputime.swapDeletionMoveCBMCTail += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapDeletionMoveCBMCTail,
+             system.mc_moves_cputime.swapDeletionMoveCBMCTail);
 
     // Calculate the correction factor for Ewald summation
     double correctionFactorEwald =
@@ -20,6 +20,7 @@ import <cmath>;
 import <tuple>;
 #endif
 
+import tracing;
 import randomnumbers;
 import running_energy;
 import system;
@@ -47,6 +48,8 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
                                                                                     System& systemA, System& systemB,
                                                                                     size_t selectedComponent)
 {
+  Tracing::Zone zone;
+
   // Return if there are no molecules of the selected component in system B
   if (systemB.numberOfIntegerMoleculesPerComponent[selectedComponent] == 0) return std::nullopt;
 
@@ -67,7 +70,7 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
 
   // std::vector<Atom> atoms = systemA.components[selectedComponent].recenteredCopy(1.0,
   //                                                         systemA.numberOfMoleculesPerComponent[selectedComponent]);
-  std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();  // Start timing CBMC insertion
+  zone.begin("GibbsSwapMoveCBMCNonEwald", "mc");  // Start timing CBMC insertion
 
   // Attempt to grow a new molecule in system A using CBMC insertion
   std::optional<ChainData> growData = CBMC::growMoleculeSwapInsertion(
@@ -76,11 +79,9 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       systemA.spanOfMoleculeAtoms(), systemA.beta, growType, cutOffFrameworkVDW, cutOffMoleculeVDW, cutOffCoulomb,
       selectedComponent, newMoleculeIndex, 1.0, 0uz, systemA.numberOfTrialDirections);
 
-  std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();  // End timing CBMC insertion
-
   // Update CPU time statistics for CBMC insertion (non-Ewald part)
-  systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCNonEwald += (t2 - t1);
-  systemA.mc_moves_cputime.GibbsSwapMoveCBMCNonEwald += (t2 - t1);
+  zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCNonEwald,
+           systemA.mc_moves_cputime.GibbsSwapMoveCBMCNonEwald);
 
   if (!growData) return std::nullopt;  // Insertion failed, return
 
@@ -91,21 +92,18 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
   systemA.components[selectedComponent].mc_moves_statistics.GibbsSwapMove_CBMC.constructed += 1;
   systemA.components[selectedComponent].mc_moves_statistics.GibbsSwapMove_CBMC.totalConstructed += 1;
 
-  std::chrono::system_clock::time_point u1 =
-      std::chrono::system_clock::now();  // Start timing Ewald Fourier computation
+  zone.begin("GibbsSwapMoveCBMCEwald", "mc");  // Start timing Ewald Fourier computation
 
   // Compute Ewald Fourier energy difference for system A
   RunningEnergy energyFourierDifferenceA = Interactions::energyDifferenceEwaldFourier(
       systemA.eik_x, systemA.eik_y, systemA.eik_z, systemA.eik_xy, systemA.storedEik, systemA.totalEik,
       systemA.forceField, systemA.simulationBox, newMolecule, {});
 
-  std::chrono::system_clock::time_point u2 = std::chrono::system_clock::now();  // End timing Ewald Fourier computation
-
   // Update CPU time statistics for Ewald Fourier computation
-  systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCEwald += (u2 - u1);
-  systemA.mc_moves_cputime.GibbsSwapMoveCBMCEwald += (u2 - u1);
+  zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCEwald,
+           systemA.mc_moves_cputime.GibbsSwapMoveCBMCEwald);
 
-  std::chrono::system_clock::time_point v1 = std::chrono::system_clock::now();  // Start timing tail energy computation
+  zone.begin("GibbsSwapMoveCBMCTail", "mc");  // Start timing tail energy computation
 
   // Compute tail energy difference for system A
   [[maybe_unused]] RunningEnergy tailEnergyDifferenceA =
@@ -114,11 +112,9 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       Interactions::computeFrameworkMoleculeTailEnergyDifference(systemA.forceField, systemA.simulationBox,
                                                                  systemA.spanOfFrameworkAtoms(), newMolecule, {});
 
-  std::chrono::system_clock::time_point v2 = std::chrono::system_clock::now();  // End timing tail energy computation
-
   // Update CPU time statistics for tail energy computation
-  systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCTail += (v2 - v1);
-  systemA.mc_moves_cputime.GibbsSwapMoveCBMCTail += (v2 - v1);
+  zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCTail,
+           systemA.mc_moves_cputime.GibbsSwapMoveCBMCTail);
 
   // Compute correction factor for Ewald energies in system A
   double correctionFactorEwaldA =
@@ -128,7 +124,7 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
   size_t selectedMolecule = systemB.randomMoleculeOfComponent(random, selectedComponent);
   std::span<Atom> molecule = systemB.spanOfMolecule(selectedComponent, selectedMolecule);
 
-  std::chrono::system_clock::time_point tB1 = std::chrono::system_clock::now();  // Start timing CBMC deletion
+  zone.begin("GibbsSwapMoveCBMCNonEwald", "mc");  // Start timing CBMC deletion
 
   // Retrace the selected molecule in system B for deletion using CBMC
   ChainData retraceData = CBMC::retraceMoleculeSwapDeletion(
@@ -137,29 +133,22 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       systemB.spanOfMoleculeAtoms(), systemB.beta, cutOffFrameworkVDW, cutOffMoleculeVDW, cutOffCoulomb,
       selectedComponent, selectedMolecule, molecule, 1.0, systemB.numberOfTrialDirections);
 
-  std::chrono::system_clock::time_point tB2 = std::chrono::system_clock::now();  // End timing CBMC deletion
-
   // Update CPU time statistics for CBMC deletion (non-Ewald part)
-  systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCNonEwald += (tB2 - tB1);
-  systemA.mc_moves_cputime.GibbsSwapMoveCBMCNonEwald += (tB2 - tB1);
+  zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCNonEwald,
+           systemA.mc_moves_cputime.GibbsSwapMoveCBMCNonEwald);
 
-  std::chrono::system_clock::time_point uB1 =
-      std::chrono::system_clock::now();  // Start timing Ewald Fourier computation for system B
+  zone.begin("GibbsSwapMoveCBMCEwald", "mc");  // Start timing Ewald Fourier computation for system B
 
   // Compute Ewald Fourier energy difference for system B
   RunningEnergy energyFourierDifferenceB = Interactions::energyDifferenceEwaldFourier(
       systemB.eik_x, systemB.eik_y, systemB.eik_z, systemB.eik_xy, systemB.storedEik, systemB.totalEik,
       systemB.forceField, systemB.simulationBox, {}, molecule);
 
-  std::chrono::system_clock::time_point uB2 =
-      std::chrono::system_clock::now();  // End timing Ewald Fourier computation for system B
-
   // Update CPU time statistics for Ewald Fourier computation
-  systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCEwald += (uB2 - uB1);
-  systemA.mc_moves_cputime.GibbsSwapMoveCBMCEwald += (uB2 - uB1);
+  zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCEwald,
+           systemA.mc_moves_cputime.GibbsSwapMoveCBMCEwald);
 
-  std::chrono::system_clock::time_point w1 =
-      std::chrono::system_clock::now();  // Start timing tail energy computation for system B
+  zone.begin("GibbsSwapMoveCBMCTail", "mc");  // Start timing tail energy computation for system B
 
   // Compute tail energy difference for system B
   [[maybe_unused]] RunningEnergy tailEnergyDifferenceB =
@@ -168,12 +157,9 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       Interactions::computeFrameworkMoleculeTailEnergyDifference(systemB.forceField, systemB.simulationBox,
                                                                  systemB.spanOfFrameworkAtoms(), {}, molecule);
 
-  std::chrono::system_clock::time_point w2 =
-      std::chrono::system_clock::now();  // End timing tail energy computation for system B
-
   // Update CPU time statistics for tail energy computation
-  systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCTail += (w2 - w1);
-  systemA.mc_moves_cputime.GibbsSwapMoveCBMCTail += (w2 - w1);
+  zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMCTail,
+           systemA.mc_moves_cputime.GibbsSwapMoveCBMCTail);
 
   // Update statistics for retraced molecules in system B
   systemB.components[selectedComponent].mc_moves_statistics.GibbsSwapMove_CBMC.constructed += 1;
@@ -26,6 +26,7 @@ import <utility>;
 import <type_traits>;
 #endif
 
+import tracing;
 import randomnumbers;
 import running_energy;
 import system;
@@ -57,6 +58,8 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
     RandomNumber& random, System& systemA, System& systemB, size_t selectedComponent,
     [[maybe_unused]] size_t& fractionalMoleculeSystem)
 {
+  Tracing::Zone zone;
+
   PropertyLambdaProbabilityHistogram& lambdaA = systemA.components[selectedComponent].lambdaGC;
   PropertyLambdaProbabilityHistogram& lambdaB = systemB.components[selectedComponent].lambdaGC;
   size_t oldBin = lambdaA.currentBin;
@@ -110,13 +113,12 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       atom.moleculeId = static_cast<uint32_t>(indexFractionalMoleculeA);
     }
 
-    std::chrono::system_clock::time_point t1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> frameworkDifferenceA = Interactions::computeFrameworkMoleculeEnergyDifference(
         systemA.forceField, systemA.simulationBox, systemA.spanOfFrameworkAtoms(), fractionalMoleculeA,
         oldFractionalMoleculeA);
-    std::chrono::system_clock::time_point t2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (t2A - t1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (t2A - t1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald);
 
     if (!frameworkDifferenceA.has_value())
     {
@@ -125,13 +127,12 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point u1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> moleculeDifferenceA = Interactions::computeInterMolecularEnergyDifference(
         systemA.forceField, systemA.simulationBox, systemA.spanOfMoleculeAtoms(), fractionalMoleculeA,
         oldFractionalMoleculeA);
-    std::chrono::system_clock::time_point u2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (u2A - u1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (u2A - u1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald);
 
     if (!moleculeDifferenceA.has_value())
     {
@@ -140,24 +141,22 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point v1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCEwald", "mc");
     RunningEnergy EwaldFourierDifferenceA = Interactions::energyDifferenceEwaldFourier(
         systemA.eik_x, systemA.eik_y, systemA.eik_z, systemA.eik_xy, systemA.storedEik, systemA.totalEik,
         systemA.forceField, systemA.simulationBox, fractionalMoleculeA, oldFractionalMoleculeA);
-    std::chrono::system_clock::time_point v2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald += (v2A - v1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald += (v2A - v1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald);
 
-    std::chrono::system_clock::time_point m1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCTail", "mc");
     RunningEnergy tailEnergyDifferenceA = Interactions::computeInterMolecularTailEnergyDifference(
                                               systemA.forceField, systemA.simulationBox, systemA.spanOfMoleculeAtoms(),
                                               fractionalMoleculeA, oldFractionalMoleculeA) +
                                           Interactions::computeFrameworkMoleculeTailEnergyDifference(
                                               systemA.forceField, systemA.simulationBox, systemA.spanOfFrameworkAtoms(),
                                               fractionalMoleculeA, oldFractionalMoleculeA);
-    std::chrono::system_clock::time_point m2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail += (m2A - m1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail += (m2A - m1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail);
 
     // step 2
 
@@ -168,12 +167,11 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       atom.moleculeId = static_cast<uint32_t>(systemA.numberOfMoleculesPerComponent[selectedComponent]);
     }
 
-    std::chrono::system_clock::time_point w1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> frameworkDifferenceA2 = Interactions::computeFrameworkMoleculeEnergyDifference(
         systemA.forceField, systemA.simulationBox, systemA.spanOfFrameworkAtoms(), newMolecule, {});
-    std::chrono::system_clock::time_point w2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (w2A - w1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (w2A - w1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald);
 
     if (!frameworkDifferenceA.has_value())
     {
@@ -182,12 +180,11 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point x1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> moleculeDifferenceA2 = Interactions::computeInterMolecularEnergyDifference(
         systemA.forceField, systemA.simulationBox, systemA.spanOfMoleculeAtoms(), newMolecule, {});
-    std::chrono::system_clock::time_point x2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (x2A - x1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (x2A - x1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald);
 
     if (!moleculeDifferenceA2.has_value())
     {
@@ -196,23 +193,21 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point y1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCEwald", "mc");
     RunningEnergy EwaldFourierDifferenceA2 = Interactions::energyDifferenceEwaldFourier(
         systemA.eik_x, systemA.eik_y, systemA.eik_z, systemA.eik_xy, systemA.totalEik, systemA.totalEik,
         systemA.forceField, systemA.simulationBox, newMolecule, {});
-    std::chrono::system_clock::time_point y2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald += (y2A - y1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald += (y2A - y1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald);
 
-    std::chrono::system_clock::time_point z1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCTail", "mc");
     RunningEnergy tailEnergyDifferenceA2 =
         Interactions::computeInterMolecularTailEnergyDifference(systemA.forceField, systemA.simulationBox,
                                                                 systemA.spanOfMoleculeAtoms(), newMolecule, {}) +
         Interactions::computeFrameworkMoleculeTailEnergyDifference(systemA.forceField, systemA.simulationBox,
                                                                    systemA.spanOfFrameworkAtoms(), newMolecule, {});
-    std::chrono::system_clock::time_point z2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail += (z2A - z1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail += (z2A - z1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail);
 
     RunningEnergy energyDifferenceA = frameworkDifferenceA.value() + moleculeDifferenceA.value() +
                                       EwaldFourierDifferenceA + tailEnergyDifferenceA + frameworkDifferenceA2.value() +
@@ -235,13 +230,12 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       atom.groupId = uint8_t{0};
     }
 
-    std::chrono::system_clock::time_point t1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> frameworkDifferenceB = Interactions::computeFrameworkMoleculeEnergyDifference(
         systemB.forceField, systemB.simulationBox, systemB.spanOfFrameworkAtoms(), selectedIntegerMoleculeB,
         oldSelectedIntegerMoleculeB);
-    std::chrono::system_clock::time_point t2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (t2B - t1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (t2B - t1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald);
     if (!frameworkDifferenceB.has_value())
     {
       // reject, set fractional molecule back to old state
@@ -252,13 +246,12 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point u1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> moleculeDifferenceB = Interactions::computeInterMolecularEnergyDifference(
         systemB.forceField, systemB.simulationBox, systemB.spanOfMoleculeAtoms(), selectedIntegerMoleculeB,
         oldSelectedIntegerMoleculeB);
-    std::chrono::system_clock::time_point u2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (u2B - u1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (u2B - u1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald);
     if (!moleculeDifferenceB.has_value())
     {
       // reject, set fractional molecule back to old state
@@ -269,24 +262,22 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point v1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCEwald", "mc");
     RunningEnergy EwaldFourierDifferenceB = Interactions::energyDifferenceEwaldFourier(
         systemB.eik_x, systemB.eik_y, systemB.eik_z, systemB.eik_xy, systemB.storedEik, systemB.totalEik,
         systemB.forceField, systemB.simulationBox, selectedIntegerMoleculeB, oldSelectedIntegerMoleculeB);
-    std::chrono::system_clock::time_point v2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald += (v2B - v1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald += (v2B - v1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald);
 
-    std::chrono::system_clock::time_point m1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCTail", "mc");
     RunningEnergy tailEnergyDifferenceB = Interactions::computeInterMolecularTailEnergyDifference(
                                               systemB.forceField, systemB.simulationBox, systemB.spanOfMoleculeAtoms(),
                                               selectedIntegerMoleculeB, oldSelectedIntegerMoleculeB) +
                                           Interactions::computeFrameworkMoleculeTailEnergyDifference(
                                               systemB.forceField, systemB.simulationBox, systemB.spanOfFrameworkAtoms(),
                                               selectedIntegerMoleculeB, oldSelectedIntegerMoleculeB);
-    std::chrono::system_clock::time_point m2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail += (m2B - m1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail += (m2B - m1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail);
 
     std::copy(oldSelectedIntegerMoleculeB.begin(), oldSelectedIntegerMoleculeB.end(), fractionalMoleculeB.begin());
     for (Atom& atom : fractionalMoleculeB)
@@ -303,13 +294,12 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       atom.position = systemA.simulationBox.randomPosition(random);
     }
 
-    std::chrono::system_clock::time_point w1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> frameworkDifferenceB2 = Interactions::computeFrameworkMoleculeEnergyDifference(
         systemB.forceField, systemB.simulationBox, systemB.spanOfFrameworkAtoms(), fractionalMoleculeB,
         oldFractionalMoleculeB);
-    std::chrono::system_clock::time_point w2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (w2B - w1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (w2B - w1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald);
     if (!frameworkDifferenceB2.has_value())
     {
       // reject, set fractional molecule back to old state
@@ -320,13 +310,12 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point x1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> moleculeDifferenceB2 = Interactions::computeInterMolecularEnergyDifference(
         systemB.forceField, systemB.simulationBox, systemB.spanOfMoleculeAtoms(), fractionalMoleculeB,
         oldFractionalMoleculeB);
-    std::chrono::system_clock::time_point x2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (x2B - x1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald += (x2B - x1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCNonEwald);
     if (!moleculeDifferenceB2.has_value())
     {
       // reject, set fractional molecule back to old state
@@ -337,15 +326,14 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point y1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCEwald", "mc");
     RunningEnergy EwaldFourierDifferenceB2 = Interactions::energyDifferenceEwaldFourier(
         systemB.eik_x, systemB.eik_y, systemB.eik_z, systemB.eik_xy, systemB.totalEik, systemB.totalEik,
         systemB.forceField, systemB.simulationBox, fractionalMoleculeB, oldFractionalMoleculeB);
-    std::chrono::system_clock::time_point y2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald += (y2B - y1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald += (y2B - y1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCEwald);
 
-    std::chrono::system_clock::time_point z1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaInterChangeMoveCFCMCTail", "mc");
     RunningEnergy tailEnergyDifferenceB2 =
         Interactions::computeInterMolecularTailEnergyDifference(systemB.forceField, systemB.simulationBox,
                                                                 systemB.spanOfMoleculeAtoms(), fractionalMoleculeB,
@@ -353,9 +341,8 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
         Interactions::computeFrameworkMoleculeTailEnergyDifference(systemB.forceField, systemB.simulationBox,
                                                                    systemB.spanOfFrameworkAtoms(), fractionalMoleculeB,
                                                                    oldFractionalMoleculeB);
-    std::chrono::system_clock::time_point z2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail += (z2B - z1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail += (z2B - z1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail,
+             systemA.mc_moves_cputime.GibbsSwapLambdaInterChangeMoveCFCMCTail);
 
     RunningEnergy energyDifferenceB = frameworkDifferenceB.value() + moleculeDifferenceB.value() +
                                       EwaldFourierDifferenceB + tailEnergyDifferenceB + frameworkDifferenceB2.value() +
@@ -466,13 +453,12 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
                                  a.componentId, a.groupId);
                    });
 
-    std::chrono::system_clock::time_point t1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaShuffleMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> frameworkDifferenceA = Interactions::computeFrameworkMoleculeEnergyDifference(
         systemA.forceField, systemA.simulationBox, systemA.spanOfFrameworkAtoms(), fractionalMoleculeA,
         oldFractionalMoleculeA);
-    std::chrono::system_clock::time_point t2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald += (t2A - t1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald += (t2A - t1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald);
 
     if (!frameworkDifferenceA.has_value())
     {
@@ -482,13 +468,12 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point u1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaShuffleMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> moleculeDifferenceA = Interactions::computeInterMolecularEnergyDifference(
         systemA.forceField, systemA.simulationBox, systemA.spanOfMoleculeAtoms(), fractionalMoleculeA,
         oldFractionalMoleculeA);
-    std::chrono::system_clock::time_point u2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald += (u2A - u1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald += (u2A - u1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald);
 
     if (!moleculeDifferenceA.has_value())
     {
@@ -498,35 +483,32 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point v1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaShuffleMoveCFCMCEwald", "mc");
     RunningEnergy EwaldEnergyDifferenceA = Interactions::energyDifferenceEwaldFourier(
         systemA.eik_x, systemA.eik_y, systemA.eik_z, systemA.eik_xy, systemA.storedEik, systemA.totalEik,
         systemA.forceField, systemA.simulationBox, fractionalMoleculeA, oldFractionalMoleculeA);
-    std::chrono::system_clock::time_point v2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCEwald += (v2A - v1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCEwald += (v2A - v1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCEwald);
 
-    std::chrono::system_clock::time_point w1A = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaShuffleMoveCFCMCTail", "mc");
     RunningEnergy tailEnergyDifferenceA = Interactions::computeInterMolecularTailEnergyDifference(
                                               systemA.forceField, systemA.simulationBox, systemA.spanOfMoleculeAtoms(),
                                               fractionalMoleculeA, oldFractionalMoleculeA) +
                                           Interactions::computeFrameworkMoleculeTailEnergyDifference(
                                               systemA.forceField, systemA.simulationBox, systemA.spanOfFrameworkAtoms(),
                                               fractionalMoleculeA, oldFractionalMoleculeA);
-    std::chrono::system_clock::time_point w2A = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCTail += (w2A - w1A);
-    systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCTail += (w2A - w1A);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCTail,
+             systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCTail);
 
     RunningEnergy energyDifferenceA =
         frameworkDifferenceA.value() + moleculeDifferenceA.value() + EwaldEnergyDifferenceA + tailEnergyDifferenceA;
 
-    std::chrono::system_clock::time_point t1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaShuffleMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> frameworkDifferenceB = Interactions::computeFrameworkMoleculeEnergyDifference(
         systemB.forceField, systemB.simulationBox, systemB.spanOfFrameworkAtoms(), fractionalMoleculeB,
         oldFractionalMoleculeB);
-    std::chrono::system_clock::time_point t2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald += (t2B - t1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald += (t2B - t1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald);
 
     if (!frameworkDifferenceB.has_value())
     {
@@ -536,13 +518,12 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point u1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaShuffleMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> moleculeDifferenceB = Interactions::computeInterMolecularEnergyDifference(
         systemB.forceField, systemB.simulationBox, systemB.spanOfMoleculeAtoms(), fractionalMoleculeB,
         oldFractionalMoleculeB);
-    std::chrono::system_clock::time_point u2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald += (u2B - u1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald += (u2B - u1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCNonEwald);
 
     if (!moleculeDifferenceB.has_value())
     {
@@ -552,24 +533,22 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
       return std::nullopt;
     }
 
-    std::chrono::system_clock::time_point v1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaShuffleMoveCFCMCEwald", "mc");
     RunningEnergy EwaldEnergyDifferenceB = Interactions::energyDifferenceEwaldFourier(
         systemB.eik_x, systemB.eik_y, systemB.eik_z, systemB.eik_xy, systemB.storedEik, systemB.totalEik,
         systemB.forceField, systemB.simulationBox, fractionalMoleculeB, oldFractionalMoleculeB);
-    std::chrono::system_clock::time_point v2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCEwald += (v2B - v1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCEwald += (v2B - v1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCEwald);
 
-    std::chrono::system_clock::time_point w1B = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaShuffleMoveCFCMCTail", "mc");
     RunningEnergy tailEnergyDifferenceB = Interactions::computeInterMolecularTailEnergyDifference(
                                               systemB.forceField, systemB.simulationBox, systemB.spanOfMoleculeAtoms(),
                                               fractionalMoleculeB, oldFractionalMoleculeB) +
                                           Interactions::computeFrameworkMoleculeTailEnergyDifference(
                                               systemB.forceField, systemB.simulationBox, systemB.spanOfFrameworkAtoms(),
                                               fractionalMoleculeB, oldFractionalMoleculeB);
-    std::chrono::system_clock::time_point w2B = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCTail += (w2B - w1B);
-    systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCTail += (w2B - w1B);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCTail,
+             systemA.mc_moves_cputime.GibbsSwapLambdaShuffleMoveCFCMCTail);
 
     RunningEnergy energyDifferenceB =
         frameworkDifferenceB.value() + moleculeDifferenceB.value() + EwaldEnergyDifferenceB + tailEnergyDifferenceB;
@@ -633,42 +612,38 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsSwapMove_C
                      return a;
                    });
 
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaChangeMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> frameworkEnergyDifference = Interactions::computeFrameworkMoleculeEnergyDifference(
         systemA.forceField, systemA.simulationBox, systemA.spanOfFrameworkAtoms(), trialPositions, fractionalMoleculeA);
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCNonEwald += (t2 - t1);
-    systemA.mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCNonEwald += (t2 - t1);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCNonEwald);
 
     if (!frameworkEnergyDifference.has_value()) return std::nullopt;
 
-    std::chrono::system_clock::time_point u1 = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaChangeMoveCFCMCNonEwald", "mc");
     std::optional<RunningEnergy> interEnergyDifference = Interactions::computeInterMolecularEnergyDifference(
         systemA.forceField, systemA.simulationBox, systemA.spanOfMoleculeAtoms(), trialPositions, fractionalMoleculeA);
-    std::chrono::system_clock::time_point u2 = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCNonEwald += (u2 - u1);
-    systemA.mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCNonEwald += (u2 - u1);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCNonEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCNonEwald);
 
     if (!interEnergyDifference.has_value()) return std::nullopt;
 
-    std::chrono::system_clock::time_point v1 = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaChangeMoveCFCMCEwald", "mc");
     RunningEnergy EwaldFourierDifference = Interactions::energyDifferenceEwaldFourier(
         systemA.eik_x, systemA.eik_y, systemA.eik_z, systemA.eik_xy, systemA.storedEik, systemA.totalEik,
         systemA.forceField, systemA.simulationBox, trialPositions, fractionalMoleculeA);
-    std::chrono::system_clock::time_point v2 = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCEwald += (v2 - v1);
-    systemA.mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCEwald += (v2 - v1);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCEwald,
+             systemA.mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCEwald);
 
-    std::chrono::system_clock::time_point w1 = std::chrono::system_clock::now();
+    zone.begin("GibbsSwapLambdaChangeMoveCFCMCTail", "mc");
     RunningEnergy tailEnergyDifference = Interactions::computeInterMolecularTailEnergyDifference(
                                              systemA.forceField, systemA.simulationBox, systemA.spanOfMoleculeAtoms(),
                                              trialPositions, fractionalMoleculeA) +
                                          Interactions::computeFrameworkMoleculeTailEnergyDifference(
                                              systemA.forceField, systemA.simulationBox, systemA.spanOfFrameworkAtoms(),
                                              trialPositions, fractionalMoleculeA);
-    std::chrono::system_clock::time_point w2 = std::chrono::system_clock::now();
-    systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCTail += (w2 - w1);
-    systemA.mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCTail += (w2 - w1);
+    zone.end(systemA.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCTail,
+             systemA.mc_moves_cputime.GibbsSwapLambdaChangeMoveCFCMCTail);
 
     RunningEnergy energyDifference = frameworkEnergyDifference.value() + interEnergyDifference.value() +
                                      EwaldFourierDifference + tailEnergyDifference;
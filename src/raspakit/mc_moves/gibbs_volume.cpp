@@ -34,6 +34,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import atom;
 import molecule;
@@ -62,7 +63,7 @@ import interactions_external_field;
 std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsVolumeMove(RandomNumber &random, System &systemA,
                                                                                  System &systemB)
 {
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   systemA.mc_moves_statistics.GibbsVolumeMove.counts += 1;
   systemA.mc_moves_statistics.GibbsVolumeMove.totalCounts += 1;
@@ -87,26 +88,23 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsVolumeMove
   std::pair<std::vector<Molecule>, std::vector<Atom>> newPositionsA = systemA.scaledCenterOfMassPositions(scaleA);
 
   // Compute new intermolecular energy for systemA
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("GibbsVolumeMoveNonEwald", "mc");
   RunningEnergy newTotalInterEnergyA =
       Interactions::computeInterMolecularEnergy(systemA.forceField, newBoxA, newPositionsA.second);
-  time_end = std::chrono::system_clock::now();
-  systemA.mc_moves_cputime.GibbsVolumeMoveNonEwald += (time_end - time_begin);
+  zone.end(systemA.mc_moves_cputime.GibbsVolumeMoveNonEwald);
 
   // Compute new tail corrections for systemA
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("GibbsVolumeMoveTail", "mc");
   RunningEnergy newTotalTailEnergyA =
       Interactions::computeInterMolecularTailEnergy(systemA.forceField, newBoxA, newPositionsA.second);
-  time_end = std::chrono::system_clock::now();
-  systemA.mc_moves_cputime.GibbsVolumeMoveTail += (time_end - time_begin);
+  zone.end(systemA.mc_moves_cputime.GibbsVolumeMoveTail);
 
   // Compute new Ewald Fourier energy for systemA
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("GibbsVolumeMoveEwald", "mc");
   RunningEnergy newTotalEwaldEnergyA = Interactions::computeEwaldFourierEnergy(
       systemA.eik_x, systemA.eik_y, systemA.eik_z, systemA.eik_xy, systemA.fixedFrameworkStoredEik, systemA.totalEik,
       systemA.forceField, newBoxA, systemA.components, systemA.numberOfMoleculesPerComponent, newPositionsA.second);
-  time_end = std::chrono::system_clock::now();
-  systemA.mc_moves_cputime.GibbsVolumeMoveEwald += (time_end - time_begin);
+  zone.end(systemA.mc_moves_cputime.GibbsVolumeMoveEwald);
 
   // Update energy and statistics for systemA
   RunningEnergy newTotalEnergyA = newTotalInterEnergyA + newTotalTailEnergyA + newTotalEwaldEnergyA;
@@ -123,26 +121,23 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::GibbsVolumeMove
   std::pair<std::vector<Molecule>, std::vector<Atom>> newPositionsB = systemB.scaledCenterOfMassPositions(scaleB);
 
   // Compute new intermolecular energy for systemB
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("GibbsVolumeMoveNonEwald", "mc");
   RunningEnergy newTotalInterEnergyB =
       Interactions::computeInterMolecularEnergy(systemB.forceField, newBoxB, newPositionsB.second);
-  time_end = std::chrono::system_clock::now();
-  systemA.mc_moves_cputime.GibbsVolumeMoveNonEwald += (time_end - time_begin);
+  zone.end(systemA.mc_moves_cputime.GibbsVolumeMoveNonEwald);
 
   // Compute new tail corrections for systemB
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("GibbsVolumeMoveTail", "mc");
   RunningEnergy newTotalTailEnergyB =
       Interactions::computeInterMolecularTailEnergy(systemB.forceField, newBoxB, newPositionsB.second);
-  time_end = std::chrono::system_clock::now();
-  systemA.mc_moves_cputime.GibbsVolumeMoveTail += (time_end - time_begin);
+  zone.end(systemA.mc_moves_cputime.GibbsVolumeMoveTail);
 
   // Compute new Ewald Fourier energy for systemB
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("GibbsVolumeMoveEwald", "mc");
   RunningEnergy newTotalEwaldEnergyB = Interactions::computeEwaldFourierEnergy(
       systemB.eik_x, systemB.eik_y, systemB.eik_z, systemB.eik_xy, systemB.fixedFrameworkStoredEik, systemB.totalEik,
       systemB.forceField, newBoxB, systemB.components, systemB.numberOfMoleculesPerComponent, newPositionsB.second);
-  time_end = std::chrono::system_clock::now();
-  systemA.mc_moves_cputime.GibbsVolumeMoveEwald += (time_end - time_begin);
+  zone.end(systemA.mc_moves_cputime.GibbsVolumeMoveEwald);
 
   // Update energy and statistics for systemB
   RunningEnergy newTotalEnergyB = newTotalInterEnergyB + newTotalTailEnergyB + newTotalEwaldEnergyB;
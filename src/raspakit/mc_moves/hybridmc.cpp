@@ -16,6 +16,7 @@ import <optional>;
 import <iostream>;
 #endif
 
+import tracing;
 import double3;
 import running_energy;
 import randomnumbers;
@@ -31,7 +32,7 @@ import interactions_ewald;
 
 std::optional<RunningEnergy> MC_Moves::hybridMCMove(RandomNumber& random, System& system)
 {
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   system.mc_moves_statistics.hybridMC.counts += 1;
   system.mc_moves_statistics.hybridMC.totalCounts += 1;
@@ -81,7 +82,7 @@ std::optional<RunningEnergy> MC_Moves::hybridMCMove(RandomNumber& random, System
   RunningEnergy currentEnergy = referenceEnergy;
 
   // integrate for N steps
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("hybridMCIntegration", "mc");
   for (size_t step = 0; step < system.numberOfHybridMCSteps; ++step)
   {
     currentEnergy = Integrators::velocityVerlet(
@@ -89,9 +90,8 @@ std::optional<RunningEnergy> MC_Moves::hybridMCMove(RandomNumber& random, System
         system.forceField, system.simulationBox, system.eik_x, system.eik_y, system.eik_z, system.eik_xy,
         system.totalEik, system.fixedFrameworkStoredEik, system.numberOfMoleculesPerComponent);
   }
-  time_end = std::chrono::system_clock::now();
 
-  system.mc_moves_cputime.hybridMCIntegration += (time_end - time_begin);
+  zone.end(system.mc_moves_cputime.hybridMCIntegration);
   system.mc_moves_statistics.hybridMC.constructed += 1;
   system.mc_moves_statistics.hybridMC.totalConstructed += 1;
 
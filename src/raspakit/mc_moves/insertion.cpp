@@ -33,6 +33,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import molecule;
 import atom;
@@ -63,7 +64,7 @@ import interactions_external_field;
 std::pair<std::optional<RunningEnergy>, double3> MC_Moves::insertionMove(RandomNumber& random, System& system,
                                                                          size_t selectedComponent)
 {
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   size_t selectedMolecule = system.numberOfMoleculesPerComponent[selectedComponent];
   system.components[selectedComponent].mc_moves_statistics.swapInsertionMove.counts += 1;
@@ -109,24 +110,22 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::insertionMove(RandomN
       system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialMolecule.second, {});
   if (!interMolecule.has_value()) return {std::nullopt, double3(0.0, 1.0, 0.0)};
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("swapInsertionMoveEwald", "mc");
   RunningEnergy energyFourierDifference = Interactions::energyDifferenceEwaldFourier(
       system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
       system.simulationBox, trialMolecule.second, {});
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.swapInsertionMoveEwald += (time_end - time_begin);
-  system.mc_moves_cputime.swapInsertionMoveEwald += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.swapInsertionMoveEwald,
+           system.mc_moves_cputime.swapInsertionMoveEwald);
   // Compute Ewald Fourier energy difference and update CPU time statistics.
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("swapInsertionMoveTail", "mc");
   RunningEnergy tailEnergyDifference =
       Interactions::computeInterMolecularTailEnergyDifference(system.forceField, system.simulationBox,
                                                               system.spanOfMoleculeAtoms(), trialMolecule.second, {}) +
       Interactions::computeFrameworkMoleculeTailEnergyDifference(
           system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialMolecule.second, {});
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.swapInsertionMoveTail += (time_end - time_begin);
-  system.mc_moves_cputime.swapInsertionMoveTail += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.swapInsertionMoveTail,
+           system.mc_moves_cputime.swapInsertionMoveTail);
   // Compute tail energy difference and update CPU time statistics.
 
   // get the total difference in energy
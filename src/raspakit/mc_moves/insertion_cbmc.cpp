@@ -32,6 +32,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import molecule;
 import atom;
@@ -62,7 +63,7 @@ import interactions_external_field;
 std::pair<std::optional<RunningEnergy>, double3> MC_Moves::insertionMoveCBMC(RandomNumber& random, System& system,
                                                                              size_t selectedComponent)
 {
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   // Update move counts statistics for swap insertion move
   size_t selectedMolecule = system.numberOfMoleculesPerComponent[selectedComponent];
@@ -75,7 +76,7 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::insertionMoveCBMC(Ran
   double cutOffCoulomb = system.forceField.cutOffCoulomb;
   Component::GrowType growType = system.components[selectedComponent].growType;
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("swapInsertionMoveCBMCNonEwald", "mc");
 
   // Attempt to grow a new molecule using CBMC
   std::optional<ChainData> growData = CBMC::growMoleculeSwapInsertion(
@@ -84,11 +85,9 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::insertionMoveCBMC(Ran
       system.spanOfMoleculeAtoms(), system.beta, growType, cutOffFrameworkVDW, cutOffMoleculeVDW, cutOffCoulomb,
       selectedComponent, selectedMolecule, 1.0, 0uz, system.numberOfTrialDirections);
 
-  time_end = std::chrono::system_clock::now();
-
   // Update CPU time statistics for the non-Ewald part of the move
-  system.components[selectedComponent].mc_moves_cputime.swapInsertionMoveCBMCNonEwald += (time_end - time_begin);
-  system.mc_moves_cputime.swapInsertionMoveCBMCNonEwald += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.swapInsertionMoveCBMCNonEwald,
+           system.mc_moves_cputime.swapInsertionMoveCBMCNonEwald);
 
   // If growth failed, reject the move
   if (!growData) return {std::nullopt, double3(0.0, 1.0, 0.0)};
@@ -105,20 +104,18 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::insertionMoveCBMC(Ran
   system.components[selectedComponent].mc_moves_statistics.swapInsertionMove_CBMC.constructed += 1;
   system.components[selectedComponent].mc_moves_statistics.swapInsertionMove_CBMC.totalConstructed += 1;
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("swapInsertionMoveCBMCEwald", "mc");
 
   // Compute energy difference due to Ewald Fourier components
   RunningEnergy energyFourierDifference = Interactions::energyDifferenceEwaldFourier(
       system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
       system.simulationBox, newMolecule, {});
 
-  time_end = std::chrono::system_clock::now();
-
   // Update CPU time statistics for the Ewald part of the move
-  system.components[selectedComponent].mc_moves_cputime.swapInsertionMoveCBMCEwald += (time_end - time_begin);
-  system.mc_moves_cputime.swapInsertionMoveCBMCEwald += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.swapInsertionMoveCBMCEwald,
+           system.mc_moves_cputime.swapInsertionMoveCBMCEwald);
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("swapInsertionMoveCBMCTail", "mc");
 
   // Compute tail energy difference due to long-range corrections
   RunningEnergy tailEnergyDifference =
@@ -127,11 +124,9 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::insertionMoveCBMC(Ran
       Interactions::computeFrameworkMoleculeTailEnergyDifference(system.forceField, system.simulationBox,
                                                                  system.spanOfFrameworkAtoms(), newMolecule, {});
 
-  time_end = std::chrono::system_clock::now();
-
   // Update CPU time statistics for the tail corrections
-  system.components[selectedComponent].mc_moves_cputime.swapInsertionMoveCBMCTail += (time_end - time_begin);
-  system.mc_moves_cputime.swapInsertionMoveCBMCTail += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.swapInsertionMoveCBMCTail,
+           system.mc_moves_cputime.swapInsertionMoveCBMCTail);
 
   // Calculate correction factor for Ewald energy difference
   double correctionFactorEwald =
@@ -42,6 +42,7 @@ import <complex>;
 import <print>;
 #endif
 
+import tracing;
 import archive;
 import double3;
 import double3x3;
@@ -88,6 +89,18 @@ import mc_moves_reaction_cfcmc_cbmc;
 import mc_moves_widom;
 import mc_moves_parallel_tempering_swap;
 import mc_moves_hybridmc;
+import mc_moves_probability_tuning;
+
+// the move-probability tuning weights the accepted moves by the energy change they produce, in units of kT
+static void recordEnergyChange(System &system, size_t selectedComponent, size_t move,
+                               const RunningEnergy &energyDifference)
+{
+  if (system.moveProbabilityTuning.has_value())
+  {
+    system.moveProbabilityTuning->addEnergyChange(selectedComponent, move,
+                                                  system.beta * std::abs(energyDifference.potentialEnergy()));
+  }
+}
 
 void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, System &selectedSecondSystem,
                                  size_t selectedComponent, size_t &fractionalMoleculeSystem)
@@ -99,8 +112,10 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
 
   size_t oldN = selectedSystem.numberOfIntegerMoleculesPerComponent[selectedComponent];
 
+  // the particle moves are timed per component, which is used by the move-probability tuning
   if (randomNumber < mc_moves_probabilities.accumulatedTranslationProbability)
   {
+    Tracing::Zone zone("translationMove", "mc");
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
 
     if (selectedSystem.numberOfMoleculesPerComponent[selectedComponent] > 0)
@@ -114,12 +129,16 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
       if (energyDifference)
       {
         selectedSystem.runningEnergies += energyDifference.value();
+        recordEnergyChange(selectedSystem, selectedComponent, 0, energyDifference.value());
       }
       selectedSystem.tmmc.updateMatrix(double3(0.0, 1.0, 0.0), oldN);
     }
+
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.translationMove);
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedRandomTranslationProbability)
   {
+    Tracing::Zone zone("randomTranslationMove", "mc");
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
 
     if (selectedSystem.numberOfMoleculesPerComponent[selectedComponent] > 0)
@@ -132,12 +151,16 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
       if (energyDifference)
       {
         selectedSystem.runningEnergies += energyDifference.value();
+        recordEnergyChange(selectedSystem, selectedComponent, 1, energyDifference.value());
       }
       selectedSystem.tmmc.updateMatrix(double3(0.0, 1.0, 0.0), oldN);
     }
+
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.randomTranslationMove);
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedRotationProbability)
   {
+    Tracing::Zone zone("rotationMove", "mc");
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
 
     if (selectedSystem.numberOfMoleculesPerComponent[selectedComponent] > 0)
@@ -150,12 +173,16 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
       if (energyDifference)
       {
         selectedSystem.runningEnergies += energyDifference.value();
+        recordEnergyChange(selectedSystem, selectedComponent, 2, energyDifference.value());
       }
       selectedSystem.tmmc.updateMatrix(double3(0.0, 1.0, 0.0), oldN);
     }
+
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.rotationMove);
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedRandomRotationProbability)
   {
+    Tracing::Zone zone("randomRotationMove", "mc");
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
 
     if (selectedSystem.numberOfMoleculesPerComponent[selectedComponent] > 0)
@@ -168,9 +195,12 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
       if (energyDifference)
       {
         selectedSystem.runningEnergies += energyDifference.value();
+        recordEnergyChange(selectedSystem, selectedComponent, 3, energyDifference.value());
       }
       selectedSystem.tmmc.updateMatrix(double3(0.0, 1.0, 0.0), oldN);
     }
+
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.randomRotationMove);
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedVolumeChangeProbability)
   {
@@ -182,6 +212,7 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedReinsertionCBMCProbability)
   {
+    Tracing::Zone zone("reinsertionMoveCBMC", "mc");
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
 
     if (selectedSystem.numberOfMoleculesPerComponent[selectedComponent] > 0)
@@ -195,10 +226,13 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
       if (energyDifference)
       {
         selectedSystem.runningEnergies += energyDifference.value();
+        recordEnergyChange(selectedSystem, selectedComponent, 4, energyDifference.value());
       }
 
       selectedSystem.tmmc.updateMatrix(double3(0.0, 1.0, 0.0), oldN);
     }
+
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.reinsertionMoveCBMC);
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedIdentityChangeCBMCProbability)
   {
@@ -207,16 +241,21 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
   {
     if (random.uniform() < 0.5)
     {
+      Tracing::Zone zone("swapInsertionMove", "mc");
       const auto [energyDifference, Pacc] = MC_Moves::insertionMove(random, selectedSystem, selectedComponent);
 
       if (energyDifference)
       {
         selectedSystem.runningEnergies += energyDifference.value();
+        recordEnergyChange(selectedSystem, selectedComponent, 5, energyDifference.value());
       }
       selectedSystem.tmmc.updateMatrix(Pacc, oldN);
+
+      zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapInsertionMove);
     }
     else
     {
+      Tracing::Zone zone("swapDeletionMove", "mc");
       size_t selectedMolecule = selectedSystem.randomIntegerMoleculeOfComponent(random, selectedComponent);
 
       const auto [energyDifference, Pacc] =
@@ -225,24 +264,32 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
       if (energyDifference)
       {
         selectedSystem.runningEnergies -= energyDifference.value();
+        recordEnergyChange(selectedSystem, selectedComponent, 5, energyDifference.value());
       }
       selectedSystem.tmmc.updateMatrix(Pacc, oldN);
+
+      zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapDeletionMove);
     }
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedSwapCBMCProbability)
   {
     if (random.uniform() < 0.5)
     {
+      Tracing::Zone zone("swapInsertionMoveCBMC", "mc");
       const auto [energyDifference, Pacc] = MC_Moves::insertionMoveCBMC(random, selectedSystem, selectedComponent);
 
       if (energyDifference)
       {
         selectedSystem.runningEnergies += energyDifference.value();
+        recordEnergyChange(selectedSystem, selectedComponent, 6, energyDifference.value());
       }
       selectedSystem.tmmc.updateMatrix(Pacc, oldN);
+
+      zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapInsertionMoveCBMC);
     }
     else
     {
+      Tracing::Zone zone("swapDeletionMoveCBMC", "mc");
       size_t selectedMolecule = selectedSystem.randomIntegerMoleculeOfComponent(random, selectedComponent);
 
       const auto [energyDifference, Pacc] =
@@ -251,12 +298,16 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
       if (energyDifference)
       {
         selectedSystem.runningEnergies -= energyDifference.value();
+        recordEnergyChange(selectedSystem, selectedComponent, 6, energyDifference.value());
       }
       selectedSystem.tmmc.updateMatrix(Pacc, oldN);
+
+      zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapDeletionMoveCBMC);
     }
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedSwapCFCMCProbability)
   {
+    Tracing::Zone zone("swapLambdaMoveCFCMC", "mc");
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
 
     const auto [energyDifference, Pacc] =
@@ -264,11 +315,15 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
     if (energyDifference)
     {
       selectedSystem.runningEnergies += energyDifference.value();
+      recordEnergyChange(selectedSystem, selectedComponent, 7, energyDifference.value());
     }
     selectedSystem.tmmc.updateMatrix(Pacc, oldN);
+
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapLambdaMoveCFCMC);
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedSwapCBCFCMCProbability)
   {
+    Tracing::Zone zone("swapLambdaMoveCBCFCMC", "mc");
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
 
     const auto [energyDifference, Pacc] =
@@ -276,8 +331,11 @@ void MC_Moves::performRandomMove(RandomNumber &random, System &selectedSystem, S
     if (energyDifference)
     {
       selectedSystem.runningEnergies += energyDifference.value();
+      recordEnergyChange(selectedSystem, selectedComponent, 8, energyDifference.value());
     }
     selectedSystem.tmmc.updateMatrix(Pacc, oldN);
+
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapLambdaMoveCBCFCMC);
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedGibbsVolumeChangeProbability)
   {
@@ -385,7 +443,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     selectedSystem.components[selectedComponent].mc_moves_statistics.translationMove.allCounts += 1uz;
 
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("translationMove", "mc");
 
     if (selectedSystem.numberOfMoleculesPerComponent[selectedComponent] > 0)
     {
@@ -401,10 +459,9 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       }
       selectedSystem.tmmc.updateMatrix(double3(0.0, 1.0, 0.0), oldN);
     }
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-    selectedSystem.components[selectedComponent].mc_moves_cputime.translationMove += (t2 - t1);
-    selectedSystem.mc_moves_cputime.translationMove += (t2 - t1);
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.translationMove,
+             selectedSystem.mc_moves_cputime.translationMove);
 
     selectedSystem.components[selectedComponent].mc_moves_count.translationMove++;
     selectedSystem.mc_moves_count.translationMove++;
@@ -414,7 +471,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     selectedSystem.components[selectedComponent].mc_moves_statistics.randomTranslationMove.allCounts += 1uz;
 
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("randomTranslationMove", "mc");
 
     if (selectedSystem.numberOfMoleculesPerComponent[selectedComponent] > 0)
     {
@@ -429,10 +486,9 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       }
       selectedSystem.tmmc.updateMatrix(double3(0.0, 1.0, 0.0), oldN);
     }
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-    selectedSystem.components[selectedComponent].mc_moves_cputime.randomTranslationMove += (t2 - t1);
-    selectedSystem.mc_moves_cputime.randomTranslationMove += (t2 - t1);
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.randomTranslationMove,
+             selectedSystem.mc_moves_cputime.randomTranslationMove);
 
     selectedSystem.components[selectedComponent].mc_moves_count.randomTranslationMove++;
     selectedSystem.mc_moves_count.randomTranslationMove++;
@@ -442,7 +498,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     selectedSystem.components[selectedComponent].mc_moves_statistics.rotationMove.allCounts += 1uz;
 
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("rotationMove", "mc");
 
     if (selectedSystem.numberOfMoleculesPerComponent[selectedComponent] > 0)
     {
@@ -457,10 +513,9 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       }
       selectedSystem.tmmc.updateMatrix(double3(0.0, 1.0, 0.0), oldN);
     }
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-    selectedSystem.components[selectedComponent].mc_moves_cputime.rotationMove += (t2 - t1);
-    selectedSystem.mc_moves_cputime.rotationMove += (t2 - t1);
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.rotationMove,
+             selectedSystem.mc_moves_cputime.rotationMove);
 
     selectedSystem.components[selectedComponent].mc_moves_count.rotationMove++;
     selectedSystem.mc_moves_count.rotationMove++;
@@ -470,7 +525,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     selectedSystem.components[selectedComponent].mc_moves_statistics.randomRotationMove.allCounts += 1uz;
 
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("randomRotationMove", "mc");
 
     if (selectedSystem.numberOfMoleculesPerComponent[selectedComponent] > 0)
     {
@@ -485,10 +540,9 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       }
       selectedSystem.tmmc.updateMatrix(double3(0.0, 1.0, 0.0), oldN);
     }
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-    selectedSystem.components[selectedComponent].mc_moves_cputime.randomRotationMove += (t2 - t1);
-    selectedSystem.mc_moves_cputime.randomRotationMove += (t2 - t1);
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.randomRotationMove,
+             selectedSystem.mc_moves_cputime.randomRotationMove);
 
     selectedSystem.components[selectedComponent].mc_moves_count.randomRotationMove++;
     selectedSystem.mc_moves_count.randomRotationMove++;
@@ -497,15 +551,14 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
   {
     selectedSystem.mc_moves_statistics.volumeMove.allCounts += 1uz;
 
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("volumeMove", "mc");
     std::optional<RunningEnergy> energy = MC_Moves::volumeMove(random, selectedSystem);
     if (energy)
     {
       selectedSystem.runningEnergies = energy.value();
     }
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-    selectedSystem.mc_moves_cputime.volumeMove += (t2 - t1);
+    zone.end(selectedSystem.mc_moves_cputime.volumeMove);
     selectedSystem.mc_moves_count.volumeMove++;
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedReinsertionCBMCProbability)
@@ -513,7 +566,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     selectedSystem.components[selectedComponent].mc_moves_statistics.reinsertionMove_CBMC.allCounts += 1uz;
 
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("reinsertionMoveCBMC", "mc");
 
     if (selectedSystem.numberOfMoleculesPerComponent[selectedComponent] > 0)
     {
@@ -529,10 +582,9 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       }
       selectedSystem.tmmc.updateMatrix(double3(0.0, 1.0, 0.0), oldN);
     }
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-    selectedSystem.components[selectedComponent].mc_moves_cputime.reinsertionMoveCBMC += (t2 - t1);
-    selectedSystem.mc_moves_cputime.reinsertionMoveCBMC += (t2 - t1);
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.reinsertionMoveCBMC,
+             selectedSystem.mc_moves_cputime.reinsertionMoveCBMC);
 
     selectedSystem.components[selectedComponent].mc_moves_count.reinsertionMoveCBMC++;
     selectedSystem.mc_moves_count.reinsertionMoveCBMC++;
@@ -547,7 +599,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     {
       selectedSystem.components[selectedComponent].mc_moves_statistics.swapInsertionMove.allCounts += 1uz;
 
-      std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+      Tracing::Zone zone("swapInsertionMove", "mc");
 
       const auto [energyDifference, Pacc] = MC_Moves::insertionMove(random, selectedSystem, selectedComponent);
 
@@ -557,10 +609,8 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       }
       selectedSystem.tmmc.updateMatrix(Pacc, oldN);
 
-      std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
-
-      selectedSystem.components[selectedComponent].mc_moves_cputime.swapInsertionMove += (t2 - t1);
-      selectedSystem.mc_moves_cputime.swapInsertionMove += (t2 - t1);
+      zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapInsertionMove,
+               selectedSystem.mc_moves_cputime.swapInsertionMove);
 
       selectedSystem.components[selectedComponent].mc_moves_count.swapInsertionMove++;
       selectedSystem.mc_moves_count.swapInsertionMove++;
@@ -570,7 +620,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       selectedSystem.components[selectedComponent].mc_moves_statistics.swapDeletionMove.allCounts += 1uz;
 
       size_t selectedMolecule = selectedSystem.randomIntegerMoleculeOfComponent(random, selectedComponent);
-      std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+      Tracing::Zone zone("swapDeletionMove", "mc");
 
       const auto [energyDifference, Pacc] =
           MC_Moves::deletionMove(random, selectedSystem, selectedComponent, selectedMolecule);
@@ -581,10 +631,8 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       }
       selectedSystem.tmmc.updateMatrix(Pacc, oldN);
 
-      std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
-
-      selectedSystem.components[selectedComponent].mc_moves_cputime.swapDeletionMove += (t2 - t1);
-      selectedSystem.mc_moves_cputime.swapDeletionMove += (t2 - t1);
+      zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapDeletionMove,
+               selectedSystem.mc_moves_cputime.swapDeletionMove);
 
       selectedSystem.components[selectedComponent].mc_moves_count.swapDeletionMove++;
       selectedSystem.mc_moves_count.swapDeletionMove++;
@@ -596,7 +644,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     {
       selectedSystem.components[selectedComponent].mc_moves_statistics.swapInsertionMove_CBMC.allCounts += 1uz;
 
-      std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+      Tracing::Zone zone("swapInsertionMoveCBMC", "mc");
 
       const auto [energyDifference, Pacc] = MC_Moves::insertionMoveCBMC(random, selectedSystem, selectedComponent);
 
@@ -606,10 +654,8 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       }
       selectedSystem.tmmc.updateMatrix(Pacc, oldN);
 
-      std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
-
-      selectedSystem.components[selectedComponent].mc_moves_cputime.swapInsertionMoveCBMC += (t2 - t1);
-      selectedSystem.mc_moves_cputime.swapInsertionMoveCBMC += (t2 - t1);
+      zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapInsertionMoveCBMC,
+               selectedSystem.mc_moves_cputime.swapInsertionMoveCBMC);
 
       selectedSystem.components[selectedComponent].mc_moves_count.swapInsertionMoveCBMC++;
       selectedSystem.mc_moves_count.swapInsertionMoveCBMC++;
@@ -619,7 +665,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       selectedSystem.components[selectedComponent].mc_moves_statistics.swapDeletionMove_CBMC.allCounts += 1uz;
 
       size_t selectedMolecule = selectedSystem.randomIntegerMoleculeOfComponent(random, selectedComponent);
-      std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+      Tracing::Zone zone("swapDeletionMoveCBMC", "mc");
 
       const auto [energyDifference, Pacc] =
           MC_Moves::deletionMoveCBMC(random, selectedSystem, selectedComponent, selectedMolecule);
@@ -630,10 +676,8 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       }
       selectedSystem.tmmc.updateMatrix(Pacc, oldN);
 
-      std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
-
-      selectedSystem.components[selectedComponent].mc_moves_cputime.swapDeletionMoveCBMC += (t2 - t1);
-      selectedSystem.mc_moves_cputime.swapDeletionMoveCBMC += (t2 - t1);
+      zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapDeletionMoveCBMC,
+               selectedSystem.mc_moves_cputime.swapDeletionMoveCBMC);
 
       selectedSystem.components[selectedComponent].mc_moves_count.swapDeletionMoveCBMC++;
       selectedSystem.mc_moves_count.swapDeletionMoveCBMC++;
@@ -644,7 +688,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     selectedSystem.components[selectedComponent].mc_moves_statistics.swapMove_CFCMC.allCounts += 1uz;
 
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("swapLambdaMoveCFCMC", "mc");
 
     const auto [energyDifference, Pacc] =
         MC_Moves::swapMove_CFCMC(random, selectedSystem, selectedComponent, selectedMolecule);
@@ -654,10 +698,8 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     }
     selectedSystem.tmmc.updateMatrix(Pacc, oldN);
 
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
-
-    selectedSystem.components[selectedComponent].mc_moves_cputime.swapLambdaMoveCFCMC += (t2 - t1);
-    selectedSystem.mc_moves_cputime.swapLambdaMoveCFCMC += (t2 - t1);
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapLambdaMoveCFCMC,
+             selectedSystem.mc_moves_cputime.swapLambdaMoveCFCMC);
 
     selectedSystem.components[selectedComponent].mc_moves_count.swapLambdaMoveCFCMC++;
     selectedSystem.mc_moves_count.swapLambdaMoveCFCMC++;
@@ -667,7 +709,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     selectedSystem.components[selectedComponent].mc_moves_statistics.swapMove_CFCMC_CBMC.allCounts += 1uz;
 
     size_t selectedMolecule = selectedSystem.randomMoleculeOfComponent(random, selectedComponent);
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("swapLambdaMoveCBCFCMC", "mc");
 
     const auto [energyDifference, Pacc] =
         MC_Moves::swapMove_CFCMC_CBMC(random, selectedSystem, selectedComponent, selectedMolecule);
@@ -677,10 +719,8 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     }
     selectedSystem.tmmc.updateMatrix(Pacc, oldN);
 
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
-
-    selectedSystem.components[selectedComponent].mc_moves_cputime.swapLambdaMoveCBCFCMC += (t2 - t1);
-    selectedSystem.mc_moves_cputime.swapLambdaMoveCBCFCMC += (t2 - t1);
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.swapLambdaMoveCBCFCMC,
+             selectedSystem.mc_moves_cputime.swapLambdaMoveCBCFCMC);
 
     selectedSystem.components[selectedComponent].mc_moves_count.swapLambdaMoveCBCFCMC++;
     selectedSystem.mc_moves_count.swapLambdaMoveCBCFCMC++;
@@ -689,7 +729,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
   {
     selectedSystem.mc_moves_statistics.GibbsVolumeMove.allCounts += 1uz;
 
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("GibbsVolumeMove", "mc");
     std::optional<std::pair<RunningEnergy, RunningEnergy>> energy =
         MC_Moves::GibbsVolumeMove(random, selectedSystem, selectedSecondSystem);
     if (energy)
@@ -697,9 +737,8 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       selectedSystem.runningEnergies = energy.value().first;
       selectedSecondSystem.runningEnergies = energy.value().second;
     }
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-    selectedSystem.mc_moves_cputime.GibbsVolumeMove += (t2 - t1);
+    zone.end(selectedSystem.mc_moves_cputime.GibbsVolumeMove);
     selectedSystem.mc_moves_count.GibbsVolumeMove++;
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedGibbsSwapCBMCProbability)
@@ -708,7 +747,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     {
       selectedSystem.components[selectedComponent].mc_moves_statistics.GibbsSwapMove_CBMC.allCounts += 1uz;
 
-      std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+      Tracing::Zone zone("GibbsSwapMoveCBMC", "mc");
       std::optional<std::pair<RunningEnergy, RunningEnergy>> energy =
           MC_Moves::GibbsSwapMove_CBMC(random, selectedSystem, selectedSecondSystem, selectedComponent);
       if (energy)
@@ -716,10 +755,9 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
         selectedSystem.runningEnergies += energy.value().first;
         selectedSecondSystem.runningEnergies += energy.value().second;
       }
-      std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-      selectedSystem.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMC += (t2 - t1);
-      selectedSystem.mc_moves_cputime.GibbsSwapMoveCBMC += (t2 - t1);
+      zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMC,
+               selectedSystem.mc_moves_cputime.GibbsSwapMoveCBMC);
 
       selectedSystem.components[selectedComponent].mc_moves_count.GibbsSwapMoveCBMC++;
       selectedSystem.mc_moves_count.GibbsSwapMoveCBMC++;
@@ -728,7 +766,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     {
       selectedSecondSystem.components[selectedComponent].mc_moves_statistics.GibbsSwapMove_CBMC.allCounts += 1uz;
 
-      std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+      Tracing::Zone zone("GibbsSwapMoveCBMC", "mc");
       std::optional<std::pair<RunningEnergy, RunningEnergy>> energy =
           MC_Moves::GibbsSwapMove_CBMC(random, selectedSecondSystem, selectedSystem, selectedComponent);
       if (energy)
@@ -736,10 +774,9 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
         selectedSecondSystem.runningEnergies += energy.value().first;
         selectedSystem.runningEnergies += energy.value().second;
       }
-      std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-      selectedSecondSystem.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMC += (t2 - t1);
-      selectedSecondSystem.mc_moves_cputime.GibbsSwapMoveCBMC += (t2 - t1);
+      zone.end(selectedSecondSystem.components[selectedComponent].mc_moves_cputime.GibbsSwapMoveCBMC,
+               selectedSecondSystem.mc_moves_cputime.GibbsSwapMoveCBMC);
 
       selectedSecondSystem.components[selectedComponent].mc_moves_count.GibbsSwapMoveCBMC++;
       selectedSecondSystem.mc_moves_count.GibbsSwapMoveCBMC++;
@@ -751,7 +788,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     {
       selectedSystem.components[selectedComponent].mc_moves_statistics.GibbsSwapMove_CFCMC.allCounts += 1uz;
 
-      std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+      Tracing::Zone zone("GibbsSwapLambdaMoveCFCMC", "mc");
       std::optional<std::pair<RunningEnergy, RunningEnergy>> energy = MC_Moves::GibbsSwapMove_CFCMC(
           random, selectedSystem, selectedSecondSystem, selectedComponent, fractionalMoleculeSystem);
       if (energy)
@@ -759,10 +796,9 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
         selectedSystem.runningEnergies += energy.value().first;
         selectedSecondSystem.runningEnergies += energy.value().second;
       }
-      std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-      selectedSystem.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaMoveCFCMC += (t2 - t1);
-      selectedSystem.mc_moves_cputime.GibbsSwapLambdaMoveCFCMC += (t2 - t1);
+      zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaMoveCFCMC,
+               selectedSystem.mc_moves_cputime.GibbsSwapLambdaMoveCFCMC);
 
       selectedSystem.components[selectedComponent].mc_moves_count.GibbsSwapLambdaMoveCFCMC++;
       selectedSystem.mc_moves_count.GibbsSwapLambdaMoveCFCMC++;
@@ -770,7 +806,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     else if (selectedSecondSystem.containsTheFractionalMolecule)
     {
       selectedSecondSystem.components[selectedComponent].mc_moves_statistics.GibbsSwapMove_CFCMC.allCounts += 1uz;
-      std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+      Tracing::Zone zone("GibbsSwapLambdaMoveCFCMC", "mc");
       std::optional<std::pair<RunningEnergy, RunningEnergy>> energy = MC_Moves::GibbsSwapMove_CFCMC(
           random, selectedSecondSystem, selectedSystem, selectedComponent, fractionalMoleculeSystem);
       if (energy)
@@ -778,10 +814,9 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
         selectedSecondSystem.runningEnergies += energy.value().first;
         selectedSystem.runningEnergies += energy.value().second;
       }
-      std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-      selectedSecondSystem.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaMoveCFCMC += (t2 - t1);
-      selectedSecondSystem.mc_moves_cputime.GibbsSwapLambdaMoveCFCMC += (t2 - t1);
+      zone.end(selectedSecondSystem.components[selectedComponent].mc_moves_cputime.GibbsSwapLambdaMoveCFCMC,
+               selectedSecondSystem.mc_moves_cputime.GibbsSwapLambdaMoveCFCMC);
 
       selectedSecondSystem.components[selectedComponent].mc_moves_count.GibbsSwapLambdaMoveCFCMC++;
       selectedSecondSystem.mc_moves_count.GibbsSwapLambdaMoveCFCMC++;
@@ -791,17 +826,15 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
   {
     selectedSystem.components[selectedComponent].mc_moves_statistics.WidomMove_CBMC.allCounts += 1uz;
 
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("WidomMoveCBMC", "mc");
 
     std::optional<double> RosenbluthWeight = MC_Moves::WidomMove(random, selectedSystem, selectedComponent);
 
     selectedSystem.components[selectedComponent].averageRosenbluthWeights.addWidomSample(
         currentBlock, RosenbluthWeight.value_or(0.0), selectedSystem.weight());
 
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
-
-    selectedSystem.components[selectedComponent].mc_moves_cputime.WidomMoveCBMC += (t2 - t1);
-    selectedSystem.mc_moves_cputime.WidomMoveCBMC += (t2 - t1);
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.WidomMoveCBMC,
+             selectedSystem.mc_moves_cputime.WidomMoveCBMC);
 
     selectedSystem.components[selectedComponent].mc_moves_count.WidomMoveCBMC++;
     selectedSystem.mc_moves_count.WidomMoveCBMC++;
@@ -810,7 +843,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
   {
     selectedSystem.components[selectedComponent].mc_moves_statistics.WidomMove_CFCMC.allCounts += 1uz;
 
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("WidomMoveCFCMC", "mc");
 
     const auto [energyDifference, Pacc] =
         MC_Moves::swapMove_CFCMC(random, selectedSystem, selectedComponent, 0, true, true);
@@ -818,10 +851,9 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
     {
       selectedSystem.runningEnergies += energyDifference.value();
     }
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-    selectedSystem.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMC += (t2 - t1);
-    selectedSystem.mc_moves_cputime.WidomMoveCFCMC += (t2 - t1);
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMC,
+             selectedSystem.mc_moves_cputime.WidomMoveCFCMC);
 
     selectedSystem.components[selectedComponent].mc_moves_count.WidomMoveCFCMC++;
     selectedSystem.mc_moves_count.WidomMoveCFCMC++;
@@ -830,7 +862,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
   {
     selectedSystem.components[selectedComponent].mc_moves_statistics.GibbsSwapMove_CFCMC_CBMC.allCounts += 1uz;
 
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("WidomMoveCBCFCMC", "mc");
 
     const auto [energyDifference, Pacc] =
         MC_Moves::swapMove_CFCMC_CBMC(random, selectedSystem, selectedComponent, 0, true, true);
@@ -839,10 +871,8 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       selectedSystem.runningEnergies += energyDifference.value();
     }
 
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
-
-    selectedSystem.components[selectedComponent].mc_moves_cputime.WidomMoveCBCFCMC += (t2 - t1);
-    selectedSystem.mc_moves_cputime.WidomMoveCBCFCMC += (t2 - t1);
+    zone.end(selectedSystem.components[selectedComponent].mc_moves_cputime.WidomMoveCBCFCMC,
+             selectedSystem.mc_moves_cputime.WidomMoveCBCFCMC);
 
     selectedSystem.components[selectedComponent].mc_moves_count.WidomMoveCBCFCMC++;
     selectedSystem.mc_moves_count.WidomMoveCBCFCMC++;
@@ -851,7 +881,7 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
   {
     selectedSystem.mc_moves_statistics.ParallelTemperingSwap.allCounts += 1uz;
 
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("ParallelTemperingSwap", "mc");
     std::optional<std::pair<RunningEnergy, RunningEnergy>> energy =
         MC_Moves::ParallelTemperingSwap(random, selectedSystem, selectedSecondSystem);
     if (energy)
@@ -859,24 +889,22 @@ void MC_Moves::performRandomMoveProduction(RandomNumber &random, System &selecte
       selectedSystem.runningEnergies = energy.value().first;
       selectedSecondSystem.runningEnergies = energy.value().second;
     }
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-    selectedSystem.mc_moves_cputime.ParallelTemperingSwap += (t2 - t1);
+    zone.end(selectedSystem.mc_moves_cputime.ParallelTemperingSwap);
     selectedSystem.mc_moves_count.ParallelTemperingSwap++;
   }
   else if (randomNumber < mc_moves_probabilities.accumulatedHybridMCProbability)
   {
     selectedSystem.mc_moves_statistics.hybridMC.allCounts += 1uz;
 
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Tracing::Zone zone("hybridMC", "mc");
     std::optional<RunningEnergy> energy = MC_Moves::hybridMCMove(random, selectedSystem);
     if (energy)
     {
       selectedSystem.runningEnergies = energy.value();
     }
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
 
-    selectedSystem.mc_moves_cputime.hybridMC += (t2 - t1);
+    zone.end(selectedSystem.mc_moves_cputime.hybridMC);
     selectedSystem.mc_moves_count.hybridMC++;
   }
 }
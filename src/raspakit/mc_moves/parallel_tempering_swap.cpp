@@ -34,6 +34,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import atom;
 import double3;
@@ -61,7 +62,7 @@ import interactions_external_field;
 std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::ParallelTemperingSwap(RandomNumber &random,
                                                                                        System &systemA, System &systemB)
 {
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   // Update swap move counts for both systems
   systemA.mc_moves_statistics.ParallelTemperingSwap.counts += 1;
@@ -73,23 +74,21 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::ParallelTemperi
 
   if (systemA.forceField != systemB.forceField)
   {
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("ParallelTemperingSwapEnergy", "mc");
 
     // Compute energy of system A using system B's force field
     RunningEnergy systemAHamiltonianB =
         Interactions::computeInterMolecularEnergy(systemB.forceField, systemA.simulationBox, systemA.atomPositions);
 
-    time_end = std::chrono::system_clock::now();
-    systemA.mc_moves_cputime.ParallelTemperingSwapEnergy += (time_end - time_begin);
+    zone.end(systemA.mc_moves_cputime.ParallelTemperingSwapEnergy);
 
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("ParallelTemperingSwapEnergy", "mc");
 
     // Compute energy of system B using system A's force field
     RunningEnergy systemBHamiltonianA =
         Interactions::computeInterMolecularEnergy(systemA.forceField, systemB.simulationBox, systemB.atomPositions);
 
-    time_end = std::chrono::system_clock::now();
-    systemB.mc_moves_cputime.ParallelTemperingSwapEnergy += (time_end - time_begin);
+    zone.end(systemB.mc_moves_cputime.ParallelTemperingSwapEnergy);
 
     // Calculate acceptance probability when force fields differ
     acc = std::exp(-systemA.beta * (systemBHamiltonianA.potentialEnergy() - systemA.runningEnergies.potentialEnergy()) -
@@ -107,15 +106,14 @@ std::optional<std::pair<RunningEnergy, RunningEnergy>> MC_Moves::ParallelTemperi
     /// Ref: "Hyper-parallel tempering Monte Carlo: Application to the Lennard-Jones fluid and the
     /// restricted primitive model",  G. Yan and J.J. de Pablo, JCP, 111(21): 9509-9516, 1999
 
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("ParallelTemperingSwapFugacity", "mc");
 
     // Adjust acceptance probability for pressure differences
     acc *= std::pow(systemB.pressure / systemA.pressure,
                     systemB.loadings.totalNumberOfMolecules - systemA.loadings.totalNumberOfMolecules);
 
-    time_end = std::chrono::system_clock::now();
-    systemA.mc_moves_cputime.ParallelTemperingSwapFugacity += (time_end - time_begin);
-    systemB.mc_moves_cputime.ParallelTemperingSwapFugacity += (time_end - time_begin);
+    zone.end(systemA.mc_moves_cputime.ParallelTemperingSwapFugacity,
+             systemB.mc_moves_cputime.ParallelTemperingSwapFugacity);
   }
 
   // Update constructed move counts for both systems
@@ -0,0 +1,296 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <print>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <vector>
+#endif
+
+module mc_moves_probability_tuning;
+
+#ifndef USE_LEGACY_HEADERS
+import <array>;
+import <cstddef>;
+import <string>;
+import <vector>;
+import <algorithm>;
+import <numeric>;
+import <cmath>;
+import <fstream>;
+import <sstream>;
+import <format>;
+import <print>;
+import <exception>;
+import <source_location>;
+#endif
+
+import archive;
+import json;
+import double3;
+import component;
+import move_statistics;
+import mc_moves_probabilities_particles;
+import mc_moves_statistics_particles;
+import mc_moves_cputime;
+
+MCMoveProbabilityTuning::MCMoveProbabilityTuning(const std::vector<Component> &components, double maximumScaling)
+    : maximumScaling(maximumScaling),
+      efficiency(components.size(), std::vector<double>(numberOfTunableMoves, -1.0)),
+      energyChange(components.size(), std::vector<double>(numberOfTunableMoves)),
+      previousAttempts(components.size(), std::vector<double>(numberOfTunableMoves)),
+      previousCpuTime(components.size(), std::vector<double>(numberOfTunableMoves))
+{
+  for (const Component &component : components)
+  {
+    initialProbabilities.push_back(tunableProbabilities(component.mc_moves_probabilities));
+  }
+}
+
+std::vector<double> MCMoveProbabilityTuning::tunableProbabilities(const MCMoveProbabilitiesParticles &p)
+{
+  return {p.translationProbability,     p.randomTranslationProbability, p.rotationProbability,
+          p.randomRotationProbability,  p.reinsertionCBMCProbability,   p.swapProbability,
+          p.swapCBMCProbability,        p.swapCFCMCProbability,         p.swapCBCFCMCProbability};
+}
+
+void MCMoveProbabilityTuning::setTunableProbabilities(MCMoveProbabilitiesParticles &p,
+                                                      const std::vector<double> &probabilities)
+{
+  p.translationProbability = probabilities[0];
+  p.randomTranslationProbability = probabilities[1];
+  p.rotationProbability = probabilities[2];
+  p.randomRotationProbability = probabilities[3];
+  p.reinsertionCBMCProbability = probabilities[4];
+  p.swapProbability = probabilities[5];
+  p.swapCBMCProbability = probabilities[6];
+  p.swapCFCMCProbability = probabilities[7];
+  p.swapCBCFCMCProbability = probabilities[8];
+  p.normalizeMoveProbabilities();
+}
+
+static double sum(const double3 &v) { return v.x + v.y + v.z; }
+
+std::vector<double> MCMoveProbabilityTuning::attempts(const MCMoveStatisticsParticles &s)
+{
+  return {sum(s.translationMove.totalCounts),
+          sum(s.randomTranslationMove.totalCounts),
+          sum(s.rotationMove.totalCounts),
+          sum(s.randomRotationMove.totalCounts),
+          s.reinsertionMove_CBMC.totalCounts,
+          s.swapInsertionMove.totalCounts + s.swapDeletionMove.totalCounts,
+          s.swapInsertionMove_CBMC.totalCounts + s.swapDeletionMove_CBMC.totalCounts,
+          sum(s.swapMove_CFCMC.totalCounts),
+          sum(s.swapMove_CFCMC_CBMC.totalCounts)};
+}
+
+std::vector<double> MCMoveProbabilityTuning::cpuTime(const MCMoveCpuTime &t)
+{
+  return {t.translationMove.count(),
+          t.randomTranslationMove.count(),
+          t.rotationMove.count(),
+          t.randomRotationMove.count(),
+          t.reinsertionMoveCBMC.count(),
+          t.swapInsertionMove.count() + t.swapDeletionMove.count(),
+          t.swapInsertionMoveCBMC.count() + t.swapDeletionMoveCBMC.count(),
+          t.swapLambdaMoveCFCMC.count(),
+          t.swapLambdaMoveCBCFCMC.count()};
+}
+
+void MCMoveProbabilityTuning::update(std::vector<Component> &components)
+{
+  if (frozen) return;
+
+  for (size_t i = 0; i < components.size(); ++i)
+  {
+    Component &component = components[i];
+
+    std::vector<double> currentAttempts = attempts(component.mc_moves_statistics);
+    std::vector<double> currentCpuTime = cpuTime(component.mc_moves_cputime);
+
+    for (size_t k = 0; k < numberOfTunableMoves; ++k)
+    {
+      // the statistics and timings may have been cleared since the previous update
+      if (currentAttempts[k] < previousAttempts[i][k] || currentCpuTime[k] < previousCpuTime[i][k])
+      {
+        previousAttempts[i][k] = 0.0;
+        previousCpuTime[i][k] = 0.0;
+      }
+
+      double deltaAttempts = currentAttempts[k] - previousAttempts[i][k];
+      double deltaCpuTime = currentCpuTime[k] - previousCpuTime[i][k];
+      if (deltaAttempts >= minimumNumberOfAttempts && deltaCpuTime > 0.0)
+      {
+        efficiency[i][k] = energyChange[i][k] / deltaCpuTime;
+        energyChange[i][k] = 0.0;
+        previousAttempts[i][k] = currentAttempts[k];
+        previousCpuTime[i][k] = currentCpuTime[k];
+      }
+    }
+
+    // geometric mean of the measured efficiencies of the enabled moves as the reference
+    double logSum{0.0};
+    size_t numberOfMeasuredMoves{0};
+    for (size_t k = 0; k < numberOfTunableMoves; ++k)
+    {
+      if (initialProbabilities[i][k] > 0.0 && efficiency[i][k] > 0.0)
+      {
+        logSum += std::log(efficiency[i][k]);
+        ++numberOfMeasuredMoves;
+      }
+    }
+    if (numberOfMeasuredMoves < 2uz) continue;
+    double referenceEfficiency = std::exp(logSum / static_cast<double>(numberOfMeasuredMoves));
+
+    std::vector<double> target(numberOfTunableMoves);
+    for (size_t k = 0; k < numberOfTunableMoves; ++k)
+    {
+      if (initialProbabilities[i][k] <= 0.0) continue;
+
+      double scaling{1.0};
+      if (efficiency[i][k] >= 0.0)
+      {
+        scaling = std::clamp(efficiency[i][k] / referenceEfficiency, 1.0 / maximumScaling, maximumScaling);
+      }
+      target[k] = initialProbabilities[i][k] * scaling;
+    }
+
+    // keep the total probability of the tunable moves, and thereby the share of all other moves, fixed
+    double initialTotal = std::accumulate(initialProbabilities[i].begin(), initialProbabilities[i].end(), 0.0);
+    double targetTotal = std::accumulate(target.begin(), target.end(), 0.0);
+    if (targetTotal <= 0.0) continue;
+
+    std::vector<double> probabilities = tunableProbabilities(component.mc_moves_probabilities);
+    for (size_t k = 0; k < numberOfTunableMoves; ++k)
+    {
+      probabilities[k] = (1.0 - damping) * probabilities[k] + damping * target[k] * initialTotal / targetTotal;
+    }
+    setTunableProbabilities(component.mc_moves_probabilities, probabilities);
+  }
+
+  ++numberOfUpdates;
+}
+
+std::string MCMoveProbabilityTuning::writeStatus(const std::vector<Component> &components) const
+{
+  std::ostringstream stream;
+
+  std::print(stream, "Move-probability tuning ({} updates{})\n", numberOfUpdates,
+             frozen ? ", frozen for production" : "");
+  std::print(stream, "===============================================================================\n\n");
+
+  for (size_t i = 0; i < components.size(); ++i)
+  {
+    std::vector<double> probabilities = tunableProbabilities(components[i].mc_moves_probabilities);
+
+    std::print(stream, "Component {} [{}]\n", i, components[i].name);
+    for (size_t k = 0; k < numberOfTunableMoves; ++k)
+    {
+      if (initialProbabilities[i][k] <= 0.0) continue;
+      std::print(stream, "    {:<20} {:10.6f} -> {:10.6f}", moveNames[k], initialProbabilities[i][k], probabilities[k]);
+      if (efficiency[i][k] >= 0.0)
+      {
+        std::print(stream, " ({:.4e} kT/s)", efficiency[i][k]);
+      }
+      std::print(stream, "\n");
+    }
+    std::print(stream, "\n");
+  }
+
+  return stream.str();
+}
+
+nlohmann::json MCMoveProbabilityTuning::jsonStatus(const std::vector<Component> &components) const
+{
+  nlohmann::json status;
+
+  status["frozen"] = frozen;
+  status["numberOfUpdates"] = numberOfUpdates;
+  status["maximumScaling"] = maximumScaling;
+
+  for (size_t i = 0; i < components.size(); ++i)
+  {
+    std::vector<double> probabilities = tunableProbabilities(components[i].mc_moves_probabilities);
+
+    for (size_t k = 0; k < numberOfTunableMoves; ++k)
+    {
+      if (initialProbabilities[i][k] <= 0.0) continue;
+
+      nlohmann::json move;
+      move["initialProbability"] = initialProbabilities[i][k];
+      move["tunedProbability"] = probabilities[k];
+      if (efficiency[i][k] >= 0.0)
+      {
+        move["energyChangePerSecond"] = efficiency[i][k];
+      }
+      status["components"][components[i].name][moveNames[k]] = move;
+    }
+  }
+
+  return status;
+}
+
+Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const MCMoveProbabilityTuning &t)
+{
+  archive << t.versionNumber;
+
+  archive << t.maximumScaling;
+  archive << t.damping;
+  archive << t.minimumNumberOfAttempts;
+  archive << t.frozen;
+  archive << t.numberOfUpdates;
+  archive << t.initialProbabilities;
+  archive << t.efficiency;
+  archive << t.energyChange;
+  archive << t.previousAttempts;
+  archive << t.previousCpuTime;
+
+  return archive;
+}
+
+Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, MCMoveProbabilityTuning &t)
+{
+  uint64_t versionNumber;
+  archive >> versionNumber;
+  if (versionNumber > t.versionNumber)
+  {
+    const std::source_location &location = std::source_location::current();
+    throw std::runtime_error(std::format("Invalid version reading 'MCMoveProbabilityTuning' at line {} in file {}\n",
+                                         location.line(), location.file_name()));
+  }
+
+  archive >> t.maximumScaling;
+  archive >> t.damping;
+  archive >> t.minimumNumberOfAttempts;
+  archive >> t.frozen;
+  archive >> t.numberOfUpdates;
+  archive >> t.initialProbabilities;
+  archive >> t.efficiency;
+  if (versionNumber >= 2)
+  {
+    archive >> t.energyChange;
+    archive >> t.previousAttempts;
+  }
+  else
+  {
+    // version 1 measured the accepted moves per CPU second; start measuring the energy change afresh
+    constexpr size_t numberOfMoves = MCMoveProbabilityTuning::numberOfTunableMoves;
+    std::vector<std::vector<double>> previousAccepted;
+    archive >> t.previousAttempts;
+    archive >> previousAccepted;
+    t.efficiency.assign(t.initialProbabilities.size(), std::vector<double>(numberOfMoves, -1.0));
+    t.energyChange.assign(t.initialProbabilities.size(), std::vector<double>(numberOfMoves));
+  }
+  archive >> t.previousCpuTime;
+
+  return archive;
+}
@@ -0,0 +1,107 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <array>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#endif
+
+export module mc_moves_probability_tuning;
+
+#ifndef USE_LEGACY_HEADERS
+import <array>;
+import <cstddef>;
+import <string>;
+import <vector>;
+import <fstream>;
+#endif
+
+import archive;
+import json;
+import component;
+import mc_moves_probabilities_particles;
+import mc_moves_statistics_particles;
+import mc_moves_cputime;
+
+/**
+ * \brief Adapts the particle-move probabilities of each component to the sampling efficiency per CPU second.
+ *
+ * During equilibration the efficiency of each particle move (translation, rotation, reinsertion and the swap moves) is
+ * measured as the summed energy change of its accepted moves, in units of kT, per CPU second. Weighting the accepted
+ * moves by the energy change they produce keeps cheap moves with tiny steps, which are accepted often but barely
+ * decorrelate the configuration, from crowding out the moves that do. The probability of each move is then set
+ * proportional to the user-specified probability multiplied by the efficiency relative to the geometric mean of all
+ * moves, clamped to [1/maximumScaling, maximumScaling]. The update is damped and keeps the total probability of the
+ * particle moves fixed, so the remaining moves (volume, Gibbs, Widom, parallel tempering, hybrid MC) keep their share,
+ * and moves with zero probability are never enabled. The learned probabilities are frozen at the start of production,
+ * so detailed balance holds for the production run.
+ */
+export struct MCMoveProbabilityTuning
+{
+  static constexpr size_t numberOfTunableMoves{9};
+  static constexpr std::array<const char *, numberOfTunableMoves> moveNames{
+      "translation", "randomTranslation", "rotation", "randomRotation", "reinsertionCBMC",
+      "swap",        "swapCBMC",          "swapCFCMC", "swapCBCFCMC"};
+
+  MCMoveProbabilityTuning() {};
+
+  /**
+   * \brief Constructs the tuning from the current (user-specified) move probabilities of the components.
+   *
+   * \param components The components of the system.
+   * \param maximumScaling Maximum factor by which a move probability may deviate from the user-specified value.
+   */
+  MCMoveProbabilityTuning(const std::vector<Component> &components, double maximumScaling);
+
+  bool operator==(MCMoveProbabilityTuning const &) const = default;
+
+  uint64_t versionNumber{2};
+
+  double maximumScaling{4.0};
+  double damping{0.5};
+  double minimumNumberOfAttempts{20.0};
+  bool frozen{false};
+  size_t numberOfUpdates{0};
+
+  // per component and per tunable move
+  std::vector<std::vector<double>> initialProbabilities{};
+  std::vector<std::vector<double>> efficiency{};  ///< Energy change (kT) per CPU second, negative when not measured.
+  std::vector<std::vector<double>> energyChange{};  ///< Energy change (kT) of the accepted moves since the measurement.
+  std::vector<std::vector<double>> previousAttempts{};
+  std::vector<std::vector<double>> previousCpuTime{};
+
+  /**
+   * \brief Records the energy change of an accepted move.
+   *
+   * \param component The component of the move.
+   * \param move The index of the move in moveNames.
+   * \param betaEnergyChange The absolute energy change of the move multiplied by beta.
+   */
+  void addEnergyChange(size_t component, size_t move, double betaEnergyChange)
+  {
+    if (!frozen) energyChange[component][move] += betaEnergyChange;
+  }
+
+  /**
+   * \brief Measures the efficiency of the moves since the previous update and adapts the move probabilities.
+   */
+  void update(std::vector<Component> &components);
+
+  /**
+   * \brief Freezes the move probabilities (called at the start of production).
+   */
+  void freeze() { frozen = true; }
+
+  static std::vector<double> tunableProbabilities(const MCMoveProbabilitiesParticles &p);
+  static void setTunableProbabilities(MCMoveProbabilitiesParticles &p, const std::vector<double> &probabilities);
+  static std::vector<double> attempts(const MCMoveStatisticsParticles &s);
+  static std::vector<double> cpuTime(const MCMoveCpuTime &t);
+
+  std::string writeStatus(const std::vector<Component> &components) const;
+  nlohmann::json jsonStatus(const std::vector<Component> &components) const;
+
+  friend Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const MCMoveProbabilityTuning &t);
+  friend Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, MCMoveProbabilityTuning &t);
+};
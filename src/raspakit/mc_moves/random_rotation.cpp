@@ -32,6 +32,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import atom;
 import molecule;
@@ -62,7 +63,7 @@ std::optional<RunningEnergy> MC_Moves::randomRotationMove(RandomNumber &random,
                                                           std::span<Atom> molecule_atoms)
 {
   double3 angle{};
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   std::array<double3, 3> axes{double3(1.0, 0.0, 0.0), double3(0.0, 1.0, 0.0), double3(0.0, 0.0, 1.0)};
   double3 maxAngle = system.components[selectedComponent].mc_moves_statistics.randomRotationMove.maxChange;
@@ -87,41 +88,36 @@ std::optional<RunningEnergy> MC_Moves::randomRotationMove(RandomNumber &random,
   }
 
   // Compute external field energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("randomRotationMoveExternalFieldMolecule", "mc");
   std::optional<RunningEnergy> externalFieldMolecule = Interactions::computeExternalFieldEnergyDifference(
       system.hasExternalField, system.forceField, system.simulationBox, trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.randomRotationMoveExternalFieldMolecule +=
-      (time_end - time_begin);
-  system.mc_moves_cputime.randomRotationMoveExternalFieldMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.randomRotationMoveExternalFieldMolecule,
+           system.mc_moves_cputime.randomRotationMoveExternalFieldMolecule);
   if (!externalFieldMolecule.has_value()) return std::nullopt;
 
   // Compute framework-molecule energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("randomRotationMoveFrameworkMolecule", "mc");
   std::optional<RunningEnergy> frameworkMolecule = Interactions::computeFrameworkMoleculeEnergyDifference(
       system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.randomRotationMoveFrameworkMolecule += (time_end - time_begin);
-  system.mc_moves_cputime.randomRotationMoveFrameworkMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.randomRotationMoveFrameworkMolecule,
+           system.mc_moves_cputime.randomRotationMoveFrameworkMolecule);
   if (!frameworkMolecule.has_value()) return std::nullopt;
 
   // Compute molecule-molecule energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("randomRotationMoveMoleculeMolecule", "mc");
   std::optional<RunningEnergy> interMolecule = Interactions::computeInterMolecularEnergyDifference(
       system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.randomRotationMoveMoleculeMolecule += (time_end - time_begin);
-  system.mc_moves_cputime.randomRotationMoveMoleculeMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.randomRotationMoveMoleculeMolecule,
+           system.mc_moves_cputime.randomRotationMoveMoleculeMolecule);
   if (!interMolecule.has_value()) return std::nullopt;
 
   // Compute Ewald energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("randomRotationMoveEwald", "mc");
   RunningEnergy ewaldFourierEnergy = Interactions::energyDifferenceEwaldFourier(
       system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
       system.simulationBox, trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.randomRotationMoveEwald += (time_end - time_begin);
-  system.mc_moves_cputime.randomRotationMoveEwald += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.randomRotationMoveEwald,
+           system.mc_moves_cputime.randomRotationMoveEwald);
 
   // Get the total difference in energy
   RunningEnergy energyDifference =
@@ -32,6 +32,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import atom;
 import double3;
@@ -61,7 +62,7 @@ std::optional<RunningEnergy> MC_Moves::randomTranslationMove(RandomNumber &rando
                                                              Molecule &molecule, std::span<Atom> molecule_atoms)
 {
   double3 s, displacement{};
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   // Select a random direction (0: x, 1: y, 2: z)
   size_t selectedDirection = size_t(3.0 * random.uniform());
@@ -84,43 +85,36 @@ std::optional<RunningEnergy> MC_Moves::randomTranslationMove(RandomNumber &rando
   }
 
   // Compute external field energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("randomTranslationMoveExternalFieldMolecule", "mc");
   std::optional<RunningEnergy> externalFieldMolecule = Interactions::computeExternalFieldEnergyDifference(
       system.hasExternalField, system.forceField, system.simulationBox, trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.randomTranslationMoveExternalFieldMolecule +=
-      (time_end - time_begin);
-  system.mc_moves_cputime.randomTranslationMoveExternalFieldMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.randomTranslationMoveExternalFieldMolecule,
+           system.mc_moves_cputime.randomTranslationMoveExternalFieldMolecule);
   if (!externalFieldMolecule.has_value()) return std::nullopt;
 
   // Compute framework-molecule energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("randomTranslationMoveFrameworkMolecule", "mc");
   std::optional<RunningEnergy> frameworkMolecule = Interactions::computeFrameworkMoleculeEnergyDifference(
       system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.randomTranslationMoveFrameworkMolecule +=
-      (time_end - time_begin);
-  system.mc_moves_cputime.randomTranslationMoveFrameworkMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.randomTranslationMoveFrameworkMolecule,
+           system.mc_moves_cputime.randomTranslationMoveFrameworkMolecule);
   if (!frameworkMolecule.has_value()) return std::nullopt;
 
   // Compute molecule-molecule energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("randomTranslationMoveMoleculeMolecule", "mc");
   std::optional<RunningEnergy> interMolecule = Interactions::computeInterMolecularEnergyDifference(
       system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.randomTranslationMoveMoleculeMolecule +=
-      (time_end - time_begin);
-  system.mc_moves_cputime.randomTranslationMoveMoleculeMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.randomTranslationMoveMoleculeMolecule,
+           system.mc_moves_cputime.randomTranslationMoveMoleculeMolecule);
   if (!interMolecule.has_value()) return std::nullopt;
 
   // Compute Ewald energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("randomTranslationMoveEwald", "mc");
   RunningEnergy ewaldFourierEnergy = Interactions::energyDifferenceEwaldFourier(
       system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
       system.simulationBox, trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.randomTranslationMoveEwald += (time_end - time_begin);
-  system.mc_moves_cputime.randomTranslationMoveEwald += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.randomTranslationMoveEwald,
+           system.mc_moves_cputime.randomTranslationMoveEwald);
 
   // Get the total difference in energy
   RunningEnergy energyDifference =
@@ -69,8 +69,6 @@ std::optional<RunningEnergy> MC_Moves::reactionMove([[maybe_unused]] RandomNumbe
 
   Component::GrowType growType = system.components[selectedComponent].growType;
 
-  [[maybe_unused]] std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
-
   std::optional<ChainData> growData = CBMC::growMoleculeSwapInsertion(
       random, system.frameworkComponents, system.components[selectedComponent], system.hasExternalField,
       system.components, system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
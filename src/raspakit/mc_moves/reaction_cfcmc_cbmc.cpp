@@ -69,8 +69,6 @@ std::optional<RunningEnergy> MC_Moves::reactionMove_CFCMC_CBMC(
   double cutOffCoulomb = system.forceField.cutOffCoulomb;
   Component::GrowType growType = system.components[selectedComponent].growType;
 
-  [[maybe_unused]] std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
-
   // Fix groupId
   std::optional<ChainData> growData = CBMC::growMoleculeSwapInsertion(
       random, system.frameworkComponents, system.components[selectedComponent], system.hasExternalField,
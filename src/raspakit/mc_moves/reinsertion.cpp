@@ -32,6 +32,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import atom;
 import molecule;
@@ -64,7 +65,7 @@ std::optional<RunningEnergy> MC_Moves::reinsertionMove(RandomNumber &random, Sys
                                                        std::span<Atom> molecule_atoms)
 {
   // Variables to record timing for performance measurement.
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   // Increment move counts for reinsertion CBMC statistics.
   system.components[selectedComponent].mc_moves_statistics.reinsertionMove_CBMC.counts += 1;
@@ -84,17 +85,16 @@ std::optional<RunningEnergy> MC_Moves::reinsertionMove(RandomNumber &random, Sys
   double cutOffCoulomb =
       system.forceField.useDualCutOff ? system.forceField.dualCutOff : system.forceField.cutOffCoulomb;
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("reinsertionMoveCBMCNonEwald", "mc");
   // Attempt to grow the molecule using CBMC reinsertion.
   std::optional<ChainData> growData = CBMC::growMoleculeReinsertion(
       random, system.frameworkComponents, system.components[selectedComponent], system.hasExternalField,
       system.components, system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
       system.spanOfMoleculeAtoms(), system.beta, cutOffFrameworkVDW, cutOffMoleculeVDW, cutOffCoulomb,
       selectedComponent, selectedMolecule, molecule, molecule_atoms, system.numberOfTrialDirections);
-  time_end = std::chrono::system_clock::now();
   // Record CPU time taken for the non-Ewald part of the move.
-  system.components[selectedComponent].mc_moves_cputime.reinsertionMoveCBMCNonEwald += (time_end - time_begin);
-  system.mc_moves_cputime.reinsertionMoveCBMCNonEwald += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.reinsertionMoveCBMCNonEwald,
+           system.mc_moves_cputime.reinsertionMoveCBMCNonEwald);
 
   // If growth was unsuccessful, exit the move.
   if (!growData) return std::nullopt;
@@ -112,27 +112,25 @@ std::optional<RunningEnergy> MC_Moves::reinsertionMove(RandomNumber &random, Sys
   system.components[selectedComponent].mc_moves_statistics.reinsertionMove_CBMC.constructed += 1;
   system.components[selectedComponent].mc_moves_statistics.reinsertionMove_CBMC.totalConstructed += 1;
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("reinsertionMoveCBMCNonEwald", "mc");
   // Retrace the old molecule configuration using CBMC retracing.
   ChainData retraceData = CBMC::retraceMoleculeReinsertion(
       random, system.frameworkComponents, system.components[selectedComponent], system.hasExternalField,
       system.components, system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
       system.spanOfMoleculeAtoms(), system.beta, cutOffFrameworkVDW, cutOffMoleculeVDW, cutOffCoulomb,
       selectedComponent, selectedMolecule, molecule, molecule_atoms, growData->storedR, system.numberOfTrialDirections);
-  time_end = std::chrono::system_clock::now();
   // Record CPU time taken for the retracing step.
-  system.components[selectedComponent].mc_moves_cputime.reinsertionMoveCBMCNonEwald += (time_end - time_begin);
-  system.mc_moves_cputime.reinsertionMoveCBMCNonEwald += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.reinsertionMoveCBMCNonEwald,
+           system.mc_moves_cputime.reinsertionMoveCBMCNonEwald);
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("reinsertionMoveCBMCEwald", "mc");
   // Compute the energy difference in the Fourier space due to Ewald summation.
   RunningEnergy energyFourierDifference = Interactions::energyDifferenceEwaldFourier(
       system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
       system.simulationBox, newMolecule, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
   // Record CPU time taken for the Ewald Fourier part of the move.
-  system.components[selectedComponent].mc_moves_cputime.reinsertionMoveCBMCEwald += (time_end - time_begin);
-  system.mc_moves_cputime.reinsertionMoveCBMCEwald += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.reinsertionMoveCBMCEwald,
+           system.mc_moves_cputime.reinsertionMoveCBMCEwald);
 
   double correctionFactorDualCutOff = 1.0;
   std::optional<RunningEnergy> energyNew;
@@ -32,6 +32,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import atom;
 import molecule;
@@ -61,7 +62,7 @@ std::optional<RunningEnergy> MC_Moves::rotationMove(RandomNumber &random, System
                                                     std::span<Atom> molecule_atoms)
 {
   double3 angle{};
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   std::array<double3, 3> axes{double3(1.0, 0.0, 0.0), double3(0.0, 1.0, 0.0), double3(0.0, 0.0, 1.0)};
   double3 maxAngle = system.components[selectedComponent].mc_moves_statistics.rotationMove.maxChange;
@@ -84,40 +85,36 @@ std::optional<RunningEnergy> MC_Moves::rotationMove(RandomNumber &random, System
   }
 
   // compute external field energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("rotationMoveExternalFieldMolecule", "mc");
   std::optional<RunningEnergy> externalFieldMolecule = Interactions::computeExternalFieldEnergyDifference(
       system.hasExternalField, system.forceField, system.simulationBox, trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.rotationMoveExternalFieldMolecule += (time_end - time_begin);
-  system.mc_moves_cputime.rotationMoveExternalFieldMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.rotationMoveExternalFieldMolecule,
+           system.mc_moves_cputime.rotationMoveExternalFieldMolecule);
   if (!externalFieldMolecule.has_value()) return std::nullopt;
 
   // compute framework-molecule energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("rotationMoveFrameworkMolecule", "mc");
   std::optional<RunningEnergy> frameworkMolecule = Interactions::computeFrameworkMoleculeEnergyDifference(
       system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.rotationMoveFrameworkMolecule += (time_end - time_begin);
-  system.mc_moves_cputime.rotationMoveFrameworkMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.rotationMoveFrameworkMolecule,
+           system.mc_moves_cputime.rotationMoveFrameworkMolecule);
   if (!frameworkMolecule.has_value()) return std::nullopt;
 
   // compute molecule-molecule energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("rotationMoveMoleculeMolecule", "mc");
   std::optional<RunningEnergy> interMolecule = Interactions::computeInterMolecularEnergyDifference(
       system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.rotationMoveMoleculeMolecule += (time_end - time_begin);
-  system.mc_moves_cputime.rotationMoveMoleculeMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.rotationMoveMoleculeMolecule,
+           system.mc_moves_cputime.rotationMoveMoleculeMolecule);
   if (!interMolecule.has_value()) return std::nullopt;
 
   // compute Ewald energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("rotationMoveEwald", "mc");
   RunningEnergy ewaldFourierEnergy = Interactions::energyDifferenceEwaldFourier(
       system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
       system.simulationBox, trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.rotationMoveEwald += (time_end - time_begin);
-  system.mc_moves_cputime.rotationMoveEwald += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.rotationMoveEwald,
+           system.mc_moves_cputime.rotationMoveEwald);
 
   // get the total difference in energy
   RunningEnergy energyDifference =
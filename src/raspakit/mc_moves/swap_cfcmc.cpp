@@ -34,6 +34,7 @@ import <iomanip>;
 import <type_traits>;
 #endif
 
+import tracing;
 import component;
 import molecule;
 import atom;
@@ -64,7 +65,7 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
                                                                           size_t selectedMolecule,
                                                                           bool insertionDisabled, bool deletionDisabled)
 {
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   // Retrieve lambda parameters and select a new lambda bin for the move
   PropertyLambdaProbabilityHistogram& lambda = system.components[selectedComponent].lambdaGC;
@@ -114,13 +115,11 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
     }
 
     // Compute external field energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCFCMCExternalField", "mc");
     std::optional<RunningEnergy> externalFieldDifferenceStep1 = Interactions::computeExternalFieldEnergyDifference(
         system.hasExternalField, system.forceField, system.simulationBox, fractionalMolecule, oldFractionalMolecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCExternalField +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCExternalField += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCExternalField,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCExternalField);
     if (!externalFieldDifferenceStep1.has_value())
     {
       // Reject, set fractional molecule back to old state
@@ -129,14 +128,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
     }
 
     // Compute framework-molecule energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCFCMCFramework", "mc");
     std::optional<RunningEnergy> frameworkDifferenceStep1 = Interactions::computeFrameworkMoleculeEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), fractionalMolecule,
         oldFractionalMolecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCFramework +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCFramework += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCFramework,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCFramework);
     if (!frameworkDifferenceStep1.has_value())
     {
       // Reject, set fractional molecule back to old state
@@ -145,14 +142,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
     }
 
     // Compute molecule-molecule energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCFCMCMolecule", "mc");
     std::optional<RunningEnergy> moleculeDifferenceStep1 = Interactions::computeInterMolecularEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), fractionalMolecule,
         oldFractionalMolecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCMolecule +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCMolecule += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCMolecule,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCMolecule);
     if (!moleculeDifferenceStep1.has_value())
     {
       // Reject, set fractional molecule back to old state
@@ -162,25 +157,23 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
     }
 
     // Compute Ewald energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCFCMCEwald", "mc");
     RunningEnergy EwaldEnergyDifferenceStep1 = Interactions::energyDifferenceEwaldFourier(
         system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
         system.simulationBox, fractionalMolecule, oldFractionalMolecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCEwald += (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCEwald += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCEwald,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCEwald);
 
     // Compute tail-correction energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCFCMCTail", "mc");
     RunningEnergy tailEnergyDifference1 = Interactions::computeInterMolecularTailEnergyDifference(
                                               system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(),
                                               fractionalMolecule, oldFractionalMolecule) +
                                           Interactions::computeFrameworkMoleculeTailEnergyDifference(
                                               system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
                                               fractionalMolecule, oldFractionalMolecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCTail += (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCTail += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCTail,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCTail);
 
     RunningEnergy energyDifferenceStep1 = externalFieldDifferenceStep1.value() + frameworkDifferenceStep1.value() +
                                           moleculeDifferenceStep1.value() + EwaldEnergyDifferenceStep1 +
@@ -217,13 +210,11 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
     }
 
     // Compute external field energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCFCMCExternalField", "mc");
     std::optional<RunningEnergy> externalFieldDifferenceStep2 = Interactions::computeExternalFieldEnergyDifference(
         system.hasExternalField, system.forceField, system.simulationBox, trialMolecule.second, {});
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCExternalField +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCExternalField += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCExternalField,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCExternalField);
     if (!externalFieldDifferenceStep2.has_value())
     {
       // Reject, set fractional molecule back to old state
@@ -232,13 +223,11 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
     }
 
     // Compute framework-molecule energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCFCMCFramework", "mc");
     std::optional<RunningEnergy> frameworkDifferenceStep2 = Interactions::computeFrameworkMoleculeEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialMolecule.second, {});
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCFramework +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCFramework += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCFramework,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCFramework);
     if (!frameworkDifferenceStep2.has_value())
     {
       // Reject, set fractional molecule back to old state
@@ -247,13 +236,11 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
     }
 
     // Compute molecule-molecule energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCFCMCMolecule", "mc");
     std::optional<RunningEnergy> moleculeDifferenceStep2 = Interactions::computeInterMolecularEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialMolecule.second, {});
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCMolecule +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCMolecule += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCMolecule,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCMolecule);
 
     if (!moleculeDifferenceStep2.has_value())
     {
@@ -264,24 +251,22 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
     }
 
     // Compute Ewald energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCFCMCEwald", "mc");
     RunningEnergy EwaldEnergyDifferenceStep2 = Interactions::energyDifferenceEwaldFourier(
         system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.totalEik, system.totalEik, system.forceField,
         system.simulationBox, trialMolecule.second, {});
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCEwald += (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCEwald += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCEwald,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCEwald);
 
     // Compute tail-correction energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCFCMCTail", "mc");
     RunningEnergy tailEnergyDifference2 =
         Interactions::computeInterMolecularTailEnergyDifference(
             system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialMolecule.second, {}) +
         Interactions::computeFrameworkMoleculeTailEnergyDifference(
             system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialMolecule.second, {});
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCTail += (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCTail += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCFCMCTail,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCFCMCTail);
 
     system.components[selectedComponent].mc_moves_statistics.swapMove_CFCMC.constructed[0] += 1;
     system.components[selectedComponent].mc_moves_statistics.swapMove_CFCMC.totalConstructed[0] += 1;
@@ -381,13 +366,11 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
       }
 
       // Compute external field energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCFCMCExternalField", "mc");
       std::optional<RunningEnergy> externalFieldDifferenceStep1 = Interactions::computeExternalFieldEnergyDifference(
           system.hasExternalField, system.forceField, system.simulationBox, fractionalMolecule, oldFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCExternalField +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCExternalField += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCExternalField,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCExternalField);
       if (!externalFieldDifferenceStep1.has_value())
       {
         // Reject, set fractional molecule back to old state
@@ -396,14 +379,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
       }
 
       // Compute framework-molecule energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCFCMCFramework", "mc");
       std::optional<RunningEnergy> frameworkDifferenceStep1 = Interactions::computeFrameworkMoleculeEnergyDifference(
           system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), fractionalMolecule,
           oldFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCFramework +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCFramework += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCFramework,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCFramework);
       if (!frameworkDifferenceStep1.has_value())
       {
         // Reject, set fractional molecule back to old state
@@ -412,14 +393,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
       }
 
       // Compute molecule-molecule energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCFCMCMolecule", "mc");
       std::optional<RunningEnergy> moleculeDifferenceStep1 = Interactions::computeInterMolecularEnergyDifference(
           system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), fractionalMolecule,
           oldFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCMolecule +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCMolecule += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCMolecule,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCMolecule);
       if (!moleculeDifferenceStep1.has_value())
       {
         // Reject, set fractional molecule back to old state
@@ -429,25 +408,23 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
       }
 
       // Compute Ewald energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCFCMCEwald", "mc");
       RunningEnergy EwaldEnergyDifferenceStep1 = Interactions::energyDifferenceEwaldFourier(
           system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
           system.simulationBox, fractionalMolecule, oldFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCEwald += (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCEwald,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCEwald);
 
       // Compute tail-correction energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCFCMCTail", "mc");
       RunningEnergy tailEnergyDifference1 = Interactions::computeInterMolecularTailEnergyDifference(
                                                 system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(),
                                                 fractionalMolecule, oldFractionalMolecule) +
                                             Interactions::computeFrameworkMoleculeTailEnergyDifference(
                                                 system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
                                                 fractionalMolecule, oldFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCTail += (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCTail += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCTail,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCTail);
 
       RunningEnergy energyDifferenceStep1 = externalFieldDifferenceStep1.value() + frameworkDifferenceStep1.value() +
                                             moleculeDifferenceStep1.value() + EwaldEnergyDifferenceStep1 +
@@ -466,14 +443,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
                      { return Atom(a.position, a.charge, newLambda, a.moleculeId, a.type, a.componentId, b.groupId); });
 
       // Compute external field energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCFCMCExternalField", "mc");
       std::optional<RunningEnergy> externalFieldDifferenceStep2 = Interactions::computeExternalFieldEnergyDifference(
           system.hasExternalField, system.forceField, system.simulationBox, newFractionalMolecule,
           savedFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCExternalField +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCExternalField += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCExternalField,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCExternalField);
       if (!externalFieldDifferenceStep2.has_value())
       {
         // Restore molecules and reject
@@ -484,14 +459,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
       }
 
       // Compute framework-molecule energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCFCMCFramework", "mc");
       std::optional<RunningEnergy> frameworkDifferenceStep2 = Interactions::computeFrameworkMoleculeEnergyDifference(
           system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), newFractionalMolecule,
           savedFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCFramework +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCFramework += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCFramework,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCFramework);
       if (!frameworkDifferenceStep2.has_value())
       {
         // Restore molecules and reject
@@ -502,14 +475,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
       }
 
       // Compute molecule-molecule energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCFCMCMolecule", "mc");
       std::optional<RunningEnergy> moleculeDifferenceStep2 = Interactions::computeInterMolecularEnergyDifference(
           system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), newFractionalMolecule,
           savedFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCMolecule +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCMolecule += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCMolecule,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCMolecule);
       if (!moleculeDifferenceStep2.has_value())
       {
         // Restore molecules and reject
@@ -520,16 +491,15 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
       }
 
       // Compute Ewald energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCFCMCEwald", "mc");
       RunningEnergy EwaldEnergyDifferenceStep2 = Interactions::energyDifferenceEwaldFourier(
           system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.totalEik, system.totalEik, system.forceField,
           system.simulationBox, newFractionalMolecule, savedFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCEwald += (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCEwald,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCEwald);
 
       // Compute tail-correction energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCFCMCTail", "mc");
       RunningEnergy tailEnergyDifferenceStep2 =
           Interactions::computeInterMolecularTailEnergyDifference(system.forceField, system.simulationBox,
                                                                   system.spanOfMoleculeAtoms(), newFractionalMolecule,
@@ -537,9 +507,8 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
           Interactions::computeFrameworkMoleculeTailEnergyDifference(system.forceField, system.simulationBox,
                                                                      system.spanOfFrameworkAtoms(),
                                                                      newFractionalMolecule, savedFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCTail += (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCTail += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCFCMCTail,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCFCMCTail);
 
       RunningEnergy energyDifferenceStep2 = externalFieldDifferenceStep2.value() + frameworkDifferenceStep2.value() +
                                             moleculeDifferenceStep2.value() + EwaldEnergyDifferenceStep2 +
@@ -622,93 +591,91 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC(Random
     }
 
     // Compute external field energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin(insertionDisabled || deletionDisabled ? "WidomMoveCFCMCExternalField"
+                                                     : "swapLambdaChangeMoveCFCMCExternalField",
+               "mc");
     std::optional<RunningEnergy> externalFieldEnergyDifference = Interactions::computeExternalFieldEnergyDifference(
         system.hasExternalField, system.forceField, system.simulationBox, trialPositions, molecule);
-    time_end = std::chrono::system_clock::now();
     if (insertionDisabled || deletionDisabled)
     {
-      system.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMCExternalField += (time_end - time_begin);
-      system.mc_moves_cputime.WidomMoveCFCMCExternalField += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMCExternalField,
+               system.mc_moves_cputime.WidomMoveCFCMCExternalField);
     }
     else
     {
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCFCMCExternalField +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaChangeMoveCFCMCExternalField += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCFCMCExternalField,
+               system.mc_moves_cputime.swapLambdaChangeMoveCFCMCExternalField);
     }
     if (!externalFieldEnergyDifference.has_value()) return {std::nullopt, double3(0.0, 1.0, 0.0)};
 
     // Compute framework-molecule energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin(insertionDisabled || deletionDisabled ? "WidomMoveCFCMCFramework"
+                                                     : "swapLambdaChangeMoveCFCMCFramework",
+               "mc");
     std::optional<RunningEnergy> frameworkEnergyDifference = Interactions::computeFrameworkMoleculeEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialPositions, molecule);
-    time_end = std::chrono::system_clock::now();
     if (insertionDisabled || deletionDisabled)
     {
-      system.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMCFramework += (time_end - time_begin);
-      system.mc_moves_cputime.WidomMoveCFCMCFramework += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMCFramework,
+               system.mc_moves_cputime.WidomMoveCFCMCFramework);
     }
     else
     {
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCFCMCFramework +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaChangeMoveCFCMCFramework += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCFCMCFramework,
+               system.mc_moves_cputime.swapLambdaChangeMoveCFCMCFramework);
     }
     if (!frameworkEnergyDifference.has_value()) return {std::nullopt, double3(0.0, 1.0, 0.0)};
 
     // Compute molecule-molecule energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin(insertionDisabled || deletionDisabled ? "WidomMoveCFCMCMolecule"
+                                                     : "swapLambdaChangeMoveCFCMCMolecule",
+               "mc");
     std::optional<RunningEnergy> interEnergyDifference = Interactions::computeInterMolecularEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialPositions, molecule);
-    time_end = std::chrono::system_clock::now();
     if (insertionDisabled || deletionDisabled)
     {
-      system.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMCMolecule += (time_end - time_begin);
-      system.mc_moves_cputime.WidomMoveCFCMCMolecule += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMCMolecule,
+               system.mc_moves_cputime.WidomMoveCFCMCMolecule);
     }
     else
     {
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCFCMCMolecule +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaChangeMoveCFCMCMolecule += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCFCMCMolecule,
+               system.mc_moves_cputime.swapLambdaChangeMoveCFCMCMolecule);
     }
     if (!interEnergyDifference.has_value()) return {std::nullopt, double3(0.0, 1.0, 0.0)};
 
     // Compute Ewald energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin(insertionDisabled || deletionDisabled ? "WidomMoveCFCMCEwald" : "swapLambdaChangeMoveCFCMCEwald", "mc");
     RunningEnergy EwaldFourierDifference = Interactions::energyDifferenceEwaldFourier(
         system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
         system.simulationBox, trialPositions, molecule);
-    time_end = std::chrono::system_clock::now();
     if (insertionDisabled || deletionDisabled)
     {
-      system.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMCEwald += (time_end - time_begin);
-      system.mc_moves_cputime.WidomMoveCFCMCEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMCEwald,
+               system.mc_moves_cputime.WidomMoveCFCMCEwald);
     }
     else
     {
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCFCMCEwald += (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaChangeMoveCFCMCEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCFCMCEwald,
+               system.mc_moves_cputime.swapLambdaChangeMoveCFCMCEwald);
     }
 
     // Compute tail-correction energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin(insertionDisabled || deletionDisabled ? "WidomMoveCFCMCTail" : "swapLambdaChangeMoveCFCMCTail", "mc");
     RunningEnergy tailEnergyDifference =
         Interactions::computeInterMolecularTailEnergyDifference(
             system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialPositions, molecule) +
         Interactions::computeFrameworkMoleculeTailEnergyDifference(
             system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialPositions, molecule);
-    time_end = std::chrono::system_clock::now();
     if (insertionDisabled || deletionDisabled)
     {
-      system.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMCTail += (time_end - time_begin);
-      system.mc_moves_cputime.WidomMoveCFCMCTail += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCFCMCTail,
+               system.mc_moves_cputime.WidomMoveCFCMCTail);
     }
     else
     {
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCFCMCTail += (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaChangeMoveCFCMCTail += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCFCMCTail,
+               system.mc_moves_cputime.swapLambdaChangeMoveCFCMCTail);
     }
 
     RunningEnergy energyDifference = externalFieldEnergyDifference.value() + frameworkEnergyDifference.value() +
@@ -34,6 +34,7 @@ import <iomanip>;
 import <type_traits>;
 #endif
 
+import tracing;
 import component;
 import molecule;
 import atom;
@@ -67,7 +68,7 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
                                                                                bool deletionDisabled)
 {
   // Initialize time points for performance measurement
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   // Reference to the lambda histogram for the selected component
   PropertyLambdaProbabilityHistogram& lambda = system.components[selectedComponent].lambdaGC;
@@ -135,13 +136,11 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
     }
 
     // Compute external field energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCBCFCMCExternalField", "mc");
     std::optional<RunningEnergy> externalFieldDifference = Interactions::computeExternalFieldEnergyDifference(
         system.hasExternalField, system.forceField, system.simulationBox, fractionalMolecule, oldFractionalMolecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCExternalField +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCExternalField += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCExternalField,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCExternalField);
     if (!externalFieldDifference.has_value())
     {
       // Reject move and restore the fractional molecule
@@ -150,14 +149,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
     }
 
     // Compute framework-molecule energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCBCFCMCFramework", "mc");
     std::optional<RunningEnergy> frameworkDifference = Interactions::computeFrameworkMoleculeEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), fractionalMolecule,
         oldFractionalMolecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCFramework +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCFramework += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCFramework,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCFramework);
     if (!frameworkDifference.has_value())
     {
       // Reject move and restore the fractional molecule
@@ -166,14 +163,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
     }
 
     // Compute molecule-molecule energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCBCFCMCMolecule", "mc");
     std::optional<RunningEnergy> moleculeDifference = Interactions::computeInterMolecularEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), fractionalMolecule,
         oldFractionalMolecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCMolecule +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCMolecule += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCMolecule,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCMolecule);
     if (!moleculeDifference.has_value())
     {
       // Reject move and restore the fractional molecule
@@ -183,26 +178,23 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
     }
 
     // Compute Ewald energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCBCFCMCEwald", "mc");
     RunningEnergy EwaldEnergyDifference = Interactions::energyDifferenceEwaldFourier(
         system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
         system.simulationBox, fractionalMolecule, oldFractionalMolecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCEwald +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCEwald += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCEwald,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCEwald);
 
     // Compute tail-correction energy contribution
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCBCFCMCTail", "mc");
     RunningEnergy tailEnergyDifference = Interactions::computeInterMolecularTailEnergyDifference(
                                              system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(),
                                              fractionalMolecule, oldFractionalMolecule) +
                                          Interactions::computeFrameworkMoleculeTailEnergyDifference(
                                              system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
                                              fractionalMolecule, oldFractionalMolecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCTail += (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCTail += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCTail,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCTail);
 
     // Sum up all energy differences
     RunningEnergy energyDifference = externalFieldDifference.value() + frameworkDifference.value() +
@@ -211,17 +203,15 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
     // Grow molecule with newLambda
     size_t newMolecule = system.numberOfMoleculesPerComponent[selectedComponent];
 
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCBCFCMCNonEwald", "mc");
     std::optional<ChainData> growData = CBMC::growMoleculeSwapInsertion(
         random, system.frameworkComponents, system.components[selectedComponent], system.hasExternalField,
         system.components, system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
         system.spanOfMoleculeAtoms(), system.beta, growType, cutOffFrameworkVDW, cutOffMoleculeVDW, cutOffCoulomb,
         selectedComponent, newMolecule, newLambda, static_cast<size_t>(oldFractionalMolecule.front().groupId),
         system.numberOfTrialDirections);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCNonEwald +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCNonEwald += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCNonEwald,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCNonEwald);
 
     if (!growData)
     {
@@ -244,26 +234,23 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
     system.components[selectedComponent].mc_moves_statistics.swapMove_CFCMC_CBMC.totalConstructed[0] += 1;
 
     // Compute Ewald energy contribution for the new molecule
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCBCFCMCEwald", "mc");
     RunningEnergy energyFourierDifference = Interactions::energyDifferenceEwaldFourier(
         system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.totalEik, system.totalEik, system.forceField,
         system.simulationBox, std::span(growData->atom.begin(), growData->atom.end()), {});
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCEwald +=
-        (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCEwald += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCEwald,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCEwald);
 
     // Compute tail-correction energy contribution for the new molecule
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaInsertionMoveCBCFCMCTail", "mc");
     RunningEnergy tailEnergyDifferenceGrow = Interactions::computeInterMolecularTailEnergyDifference(
                                                  system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(),
                                                  std::span(growData->atom.begin(), growData->atom.end()), {}) +
                                              Interactions::computeFrameworkMoleculeTailEnergyDifference(
                                                  system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
                                                  std::span(growData->atom.begin(), growData->atom.end()), {});
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCTail += (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCTail += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCTail,
+             system.mc_moves_cputime.swapLambdaInsertionMoveCBCFCMCTail);
 
     // Calculate correction factor for Ewald summation
     double correctionFactorEwald = std::exp(
@@ -356,38 +343,32 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
       std::vector<Atom> oldNewFractionalMolecule(newFractionalMolecule.begin(), newFractionalMolecule.end());
 
       // Retrace the existing fractional molecule
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCBCFCMCNonEwald", "mc");
       ChainData retraceData = CBMC::retraceMoleculeSwapDeletion(
           random, system.frameworkComponents, system.components[selectedComponent], system.hasExternalField,
           system.components, system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
           system.spanOfMoleculeAtoms(), system.beta, cutOffFrameworkVDW, cutOffMoleculeVDW, cutOffCoulomb,
           selectedComponent, indexFractionalMolecule, fractionalMolecule, oldLambda, system.numberOfTrialDirections);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCNonEwald +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCNonEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCNonEwald,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCNonEwald);
 
       // Compute Ewald energy difference for the retraced molecule
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCBCFCMCEwald", "mc");
       RunningEnergy energyFourierDifference = Interactions::energyDifferenceEwaldFourier(
           system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
           system.simulationBox, {}, fractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCEwald +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCEwald,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCEwald);
 
       // Compute tail-correction energy difference for the retraced molecule
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCBCFCMCTail", "mc");
       RunningEnergy tailEnergyDifferenceRetrace =
           Interactions::computeInterMolecularTailEnergyDifference(
               system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), {}, fractionalMolecule) +
           Interactions::computeFrameworkMoleculeTailEnergyDifference(
               system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), {}, fractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCTail +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCTail += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCTail,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCTail);
 
       // Calculate correction factor for Ewald summation
       double correctionFactorEwald = std::exp(
@@ -424,14 +405,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
       }
 
       // Compute external field energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCBCFCMCExternalField", "mc");
       std::optional<RunningEnergy> externalFieldDifference = Interactions::computeExternalFieldEnergyDifference(
           system.hasExternalField, system.forceField, system.simulationBox, newFractionalMolecule,
           savedFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCExternalField +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCExternalField += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCExternalField,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCExternalField);
       if (!externalFieldDifference.has_value())
       {
         // Restore old molecules
@@ -442,14 +421,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
       }
 
       // Compute framework-molecule energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCBCFCMCFramework", "mc");
       std::optional<RunningEnergy> frameworkDifference = Interactions::computeFrameworkMoleculeEnergyDifference(
           system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), newFractionalMolecule,
           savedFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCFramework +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCFramework += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCFramework,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCFramework);
       if (!frameworkDifference.has_value())
       {
         // Restore old molecules
@@ -460,14 +437,12 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
       }
 
       // Compute molecule-molecule energy contribution
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCBCFCMCMolecule", "mc");
       std::optional<RunningEnergy> moleculeDifference = Interactions::computeInterMolecularEnergyDifference(
           system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), newFractionalMolecule,
           savedFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCMolecule +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCMolecule += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCMolecule,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCMolecule);
       if (!moleculeDifference.has_value())
       {
         // Restore old molecules
@@ -478,27 +453,23 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
       }
 
       // Compute Ewald energy contribution for the new fractional molecule
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCBCFCMCEwald", "mc");
       RunningEnergy EwaldEnergyDifference = Interactions::energyDifferenceEwaldFourier(
           system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.totalEik, system.totalEik, system.forceField,
           system.simulationBox, newFractionalMolecule, savedFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCEwald +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCEwald,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCEwald);
 
       // Compute tail-correction energy contribution for the new fractional molecule
-      time_begin = std::chrono::system_clock::now();
+      zone.begin("swapLambdaDeletionMoveCBCFCMCTail", "mc");
       RunningEnergy tailEnergyDifference = Interactions::computeInterMolecularTailEnergyDifference(
                                                system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(),
                                                newFractionalMolecule, savedFractionalMolecule) +
                                            Interactions::computeFrameworkMoleculeTailEnergyDifference(
                                                system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
                                                newFractionalMolecule, savedFractionalMolecule);
-      time_end = std::chrono::system_clock::now();
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCTail +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCTail += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCTail,
+               system.mc_moves_cputime.swapLambdaDeletionMoveCBCFCMCTail);
 
       // Sum up all energy differences
       RunningEnergy energyDifference = externalFieldDifference.value() + frameworkDifference.value() +
@@ -588,86 +559,86 @@ std::pair<std::optional<RunningEnergy>, double3> MC_Moves::swapMove_CFCMC_CBMC(R
     }
 
     // Compute external field energy difference
-    time_begin = std::chrono::system_clock::now();
+    zone.begin(insertionDisabled || deletionDisabled ? "WidomMoveCBCFCMCNonEwald"
+                                                     : "swapLambdaChangeMoveCBCFCMCExternalField",
+               "mc");
     std::optional<RunningEnergy> externalFieldEnergyDifference = Interactions::computeExternalFieldEnergyDifference(
         system.hasExternalField, system.forceField, system.simulationBox, trialPositions, molecule);
-    time_end = std::chrono::system_clock::now();
     if (insertionDisabled || deletionDisabled)
     {
-      system.components[selectedComponent].mc_moves_cputime.WidomMoveCBCFCMCNonEwald += (time_end - time_begin);
-      system.mc_moves_cputime.WidomMoveCBCFCMCNonEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCBCFCMCNonEwald,
+               system.mc_moves_cputime.WidomMoveCBCFCMCNonEwald);
     }
     else
     {
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCBCFCMCExternalField +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaChangeMoveCBCFCMCExternalField += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCBCFCMCExternalField,
+               system.mc_moves_cputime.swapLambdaChangeMoveCBCFCMCExternalField);
     }
     if (!externalFieldEnergyDifference.has_value()) return {std::nullopt, double3(0.0, 1.0, 0.0)};
 
     // Compute framework-molecule energy difference
-    time_begin = std::chrono::system_clock::now();
+    zone.begin(insertionDisabled || deletionDisabled ? "WidomMoveCBCFCMCNonEwald"
+                                                     : "swapLambdaChangeMoveCBCFCMCFramework",
+               "mc");
     std::optional<RunningEnergy> frameworkEnergyDifference = Interactions::computeFrameworkMoleculeEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialPositions, molecule);
-    time_end = std::chrono::system_clock::now();
     if (insertionDisabled || deletionDisabled)
     {
-      system.components[selectedComponent].mc_moves_cputime.WidomMoveCBCFCMCNonEwald += (time_end - time_begin);
-      system.mc_moves_cputime.WidomMoveCBCFCMCNonEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCBCFCMCNonEwald,
+               system.mc_moves_cputime.WidomMoveCBCFCMCNonEwald);
     }
     else
     {
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCBCFCMCFramework +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaChangeMoveCBCFCMCFramework += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCBCFCMCFramework,
+               system.mc_moves_cputime.swapLambdaChangeMoveCBCFCMCFramework);
     }
     if (!frameworkEnergyDifference.has_value()) return {std::nullopt, double3(0.0, 1.0, 0.0)};
 
     // Compute molecule-molecule energy difference
-    time_begin = std::chrono::system_clock::now();
+    zone.begin(insertionDisabled || deletionDisabled ? "WidomMoveCBCFCMCNonEwald"
+                                                     : "swapLambdaChangeMoveCBCFCMCMolecule",
+               "mc");
     std::optional<RunningEnergy> interEnergyDifference = Interactions::computeInterMolecularEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialPositions, molecule);
-    time_end = std::chrono::system_clock::now();
     if (insertionDisabled || deletionDisabled)
     {
-      system.components[selectedComponent].mc_moves_cputime.WidomMoveCBCFCMCNonEwald += (time_end - time_begin);
-      system.mc_moves_cputime.WidomMoveCBCFCMCNonEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCBCFCMCNonEwald,
+               system.mc_moves_cputime.WidomMoveCBCFCMCNonEwald);
     }
     else
     {
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCBCFCMCMolecule +=
-          (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaChangeMoveCBCFCMCMolecule += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCBCFCMCMolecule,
+               system.mc_moves_cputime.swapLambdaChangeMoveCBCFCMCMolecule);
     }
     if (!interEnergyDifference.has_value()) return {std::nullopt, double3(0.0, 1.0, 0.0)};
 
     // Compute Ewald energy difference
-    time_begin = std::chrono::system_clock::now();
+    zone.begin(insertionDisabled || deletionDisabled ? "WidomMoveCBCFCMCEwald"
+                                                     : "swapLambdaChangeMoveCBCFCMCEwald",
+               "mc");
     RunningEnergy EwaldFourierDifference = Interactions::energyDifferenceEwaldFourier(
         system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
         system.simulationBox, trialPositions, molecule);
-    time_end = std::chrono::system_clock::now();
     if (insertionDisabled || deletionDisabled)
     {
-      system.components[selectedComponent].mc_moves_cputime.WidomMoveCBCFCMCEwald += (time_end - time_begin);
-      system.mc_moves_cputime.WidomMoveCBCFCMCEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCBCFCMCEwald,
+               system.mc_moves_cputime.WidomMoveCBCFCMCEwald);
     }
     else
     {
-      system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCBCFCMCEwald += (time_end - time_begin);
-      system.mc_moves_cputime.swapLambdaChangeMoveCBCFCMCEwald += (time_end - time_begin);
+      zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCBCFCMCEwald,
+               system.mc_moves_cputime.swapLambdaChangeMoveCBCFCMCEwald);
     }
 
     // Compute tail-correction energy difference
-    time_begin = std::chrono::system_clock::now();
+    zone.begin("swapLambdaChangeMoveCBCFCMCTail", "mc");
     [[maybe_unused]] RunningEnergy tailEnergyDifference =
         Interactions::computeInterMolecularTailEnergyDifference(
             system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialPositions, molecule) +
         Interactions::computeFrameworkMoleculeTailEnergyDifference(
             system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialPositions, molecule);
-    time_end = std::chrono::system_clock::now();
-    system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCBCFCMCTail += (time_end - time_begin);
-    system.mc_moves_cputime.swapLambdaChangeMoveCBCFCMCTail += (time_end - time_begin);
+    zone.end(system.components[selectedComponent].mc_moves_cputime.swapLambdaChangeMoveCBCFCMCTail,
+             system.mc_moves_cputime.swapLambdaChangeMoveCBCFCMCTail);
 
     // Sum up all energy differences
     RunningEnergy energyDifference = externalFieldEnergyDifference.value() + frameworkEnergyDifference.value() +
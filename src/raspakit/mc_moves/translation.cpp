@@ -32,6 +32,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import molecule;
 import atom;
@@ -63,7 +64,7 @@ std::optional<RunningEnergy> MC_Moves::translationMove(RandomNumber &random, Sys
                                                        std::span<Atom> molecule_atoms)
 {
   double3 displacement{};
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   // Get the maximum displacement allowed for the selected component
   double3 maxDisplacement = system.components[selectedComponent].mc_moves_statistics.translationMove.maxChange;
@@ -92,16 +93,15 @@ std::optional<RunningEnergy> MC_Moves::translationMove(RandomNumber &random, Sys
   }
 
   // Compute external field energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("translationMoveExternalFieldMolecule", "mc");
   std::optional<RunningEnergy> externalFieldMolecule = Interactions::computeExternalFieldEnergyDifference(
       system.hasExternalField, system.forceField, system.simulationBox, trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.translationMoveExternalFieldMolecule += (time_end - time_begin);
-  system.mc_moves_cputime.translationMoveExternalFieldMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.translationMoveExternalFieldMolecule,
+           system.mc_moves_cputime.translationMoveExternalFieldMolecule);
   if (!externalFieldMolecule.has_value()) return std::nullopt;
 
   // Compute framework-molecule energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("translationMoveFrameworkMolecule", "mc");
   std::optional<RunningEnergy> frameworkMolecule;
   if (system.forceField.computePolarization)
   {
@@ -116,13 +116,12 @@ std::optional<RunningEnergy> MC_Moves::translationMove(RandomNumber &random, Sys
     frameworkMolecule = Interactions::computeFrameworkMoleculeEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(), trialMolecule.second, molecule_atoms);
   }
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.translationMoveFrameworkMolecule += (time_end - time_begin);
-  system.mc_moves_cputime.translationMoveFrameworkMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.translationMoveFrameworkMolecule,
+           system.mc_moves_cputime.translationMoveFrameworkMolecule);
   if (!frameworkMolecule.has_value()) return std::nullopt;
 
   // Compute molecule-molecule energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("translationMoveMoleculeMolecule", "mc");
   std::optional<RunningEnergy> interMolecule;
   if (system.forceField.computePolarization)
   {
@@ -138,19 +137,17 @@ std::optional<RunningEnergy> MC_Moves::translationMove(RandomNumber &random, Sys
     interMolecule = Interactions::computeInterMolecularEnergyDifference(
         system.forceField, system.simulationBox, system.spanOfMoleculeAtoms(), trialMolecule.second, molecule_atoms);
   }
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.translationMoveMoleculeMolecule += (time_end - time_begin);
-  system.mc_moves_cputime.translationMoveMoleculeMolecule += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.translationMoveMoleculeMolecule,
+           system.mc_moves_cputime.translationMoveMoleculeMolecule);
   if (!interMolecule.has_value()) return std::nullopt;
 
   // Compute Ewald energy contribution
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("translationMoveEwald", "mc");
   RunningEnergy ewaldFourierEnergy = Interactions::energyDifferenceEwaldFourier(
       system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
       system.simulationBox, trialMolecule.second, molecule_atoms);
-  time_end = std::chrono::system_clock::now();
-  system.components[selectedComponent].mc_moves_cputime.translationMoveEwald += (time_end - time_begin);
-  system.mc_moves_cputime.translationMoveEwald += (time_end - time_begin);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.translationMoveEwald,
+           system.mc_moves_cputime.translationMoveEwald);
 
   RunningEnergy polarization;
   if (system.forceField.computePolarization)
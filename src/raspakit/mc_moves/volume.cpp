@@ -34,6 +34,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import atom;
 import molecule;
@@ -61,7 +62,7 @@ import interactions_ewald;
 
 std::optional<RunningEnergy> MC_Moves::volumeMove(RandomNumber &random, System &system)
 {
-  std::chrono::system_clock::time_point time_begin, time_end;
+  Tracing::Zone zone;
 
   // Update volume move counts
   system.mc_moves_statistics.volumeMove.counts += 1;
@@ -81,27 +82,24 @@ std::optional<RunningEnergy> MC_Moves::volumeMove(RandomNumber &random, System &
   SimulationBox newBox = system.simulationBox.scaled(scale);
   std::pair<std::vector<Molecule>, std::vector<Atom>> newPositions = system.scaledCenterOfMassPositions(scale);
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("volumeMoveNonEwald", "mc");
   // Compute new intermolecular energy
   RunningEnergy newTotalInterEnergy =
       Interactions::computeInterMolecularEnergy(system.forceField, newBox, newPositions.second);
-  time_end = std::chrono::system_clock::now();
-  system.mc_moves_cputime.volumeMoveNonEwald += (time_end - time_begin);
+  zone.end(system.mc_moves_cputime.volumeMoveNonEwald);
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("volumeMoveTail", "mc");
   // Compute new tail corrections
   RunningEnergy newTotalTailEnergy =
       Interactions::computeInterMolecularTailEnergy(system.forceField, newBox, newPositions.second);
-  time_end = std::chrono::system_clock::now();
-  system.mc_moves_cputime.volumeMoveTail += (time_end - time_begin);
+  zone.end(system.mc_moves_cputime.volumeMoveTail);
 
-  time_begin = std::chrono::system_clock::now();
+  zone.begin("volumeMoveEwald", "mc");
   // Compute new Ewald Fourier energy
   RunningEnergy newTotalEwaldEnergy = Interactions::computeEwaldFourierEnergy(
       system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.fixedFrameworkStoredEik, system.totalEik,
       system.forceField, newBox, system.components, system.numberOfMoleculesPerComponent, newPositions.second);
-  time_end = std::chrono::system_clock::now();
-  system.mc_moves_cputime.volumeMoveEwald += (time_end - time_begin);
+  zone.end(system.mc_moves_cputime.volumeMoveEwald);
 
   // Sum up all energy contributions
   RunningEnergy newTotalEnergy = newTotalInterEnergy + newTotalTailEnergy + newTotalEwaldEnergy;
@@ -32,6 +32,7 @@ import <iostream>;
 import <iomanip>;
 #endif
 
+import tracing;
 import component;
 import atom;
 import double3;
@@ -59,6 +60,8 @@ import interactions_external_field;
 
 std::optional<double> MC_Moves::WidomMove(RandomNumber& random, System& system, size_t selectedComponent)
 {
+  Tracing::Zone zone;
+
   size_t selectedMolecule = system.numberOfMoleculesPerComponent[selectedComponent];
   // Update move statistics for Widom insertion move.
   system.components[selectedComponent].mc_moves_statistics.WidomMove_CBMC.counts += 1;
@@ -70,18 +73,16 @@ std::optional<double> MC_Moves::WidomMove(RandomNumber& random, System& system,
   Component::GrowType growType = system.components[selectedComponent].growType;
 
   // Record the start time for the CBMC molecule growth.
-  std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+  zone.begin("WidomMoveCBMCNonEwald", "mc");
   // Attempt to grow a new molecule using Configurational Bias Monte Carlo (CBMC) insertion.
   std::optional<ChainData> growData = CBMC::growMoleculeSwapInsertion(
       random, system.frameworkComponents, system.components[selectedComponent], system.hasExternalField,
       system.components, system.forceField, system.simulationBox, system.spanOfFrameworkAtoms(),
       system.spanOfMoleculeAtoms(), system.beta, growType, cutOffFrameworkVDW, cutOffMoleculeVDW, cutOffCoulomb,
       selectedComponent, selectedMolecule, 1.0, 0uz, system.numberOfTrialDirections);
-  // Record the end time for the CBMC molecule growth.
-  std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
   // Update CPU time statistics for CBMC non-Ewald calculations.
-  system.components[selectedComponent].mc_moves_cputime.WidomMoveCBMCNonEwald += (t2 - t1);
-  system.mc_moves_cputime.WidomMoveCBMCNonEwald += (t2 - t1);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCBMCNonEwald,
+           system.mc_moves_cputime.WidomMoveCBMCNonEwald);
 
   // If molecule growth failed, terminate the move.
   if (!growData) return std::nullopt;
@@ -99,16 +100,14 @@ std::optional<double> MC_Moves::WidomMove(RandomNumber& random, System& system,
   system.components[selectedComponent].mc_moves_statistics.WidomMove_CBMC.totalConstructed += 1;
 
   // Record start time for Ewald Fourier energy difference calculation.
-  std::chrono::system_clock::time_point u1 = std::chrono::system_clock::now();
+  zone.begin("WidomMoveCBMCEwald", "mc");
   // Compute the energy difference in Ewald Fourier space due to the new molecule.
   RunningEnergy energyFourierDifference = Interactions::energyDifferenceEwaldFourier(
       system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.storedEik, system.totalEik, system.forceField,
       system.simulationBox, newMolecule, {});
-  // Record end time for Ewald Fourier energy difference calculation.
-  std::chrono::system_clock::time_point u2 = std::chrono::system_clock::now();
   // Update CPU time statistics for Ewald calculations.
-  system.components[selectedComponent].mc_moves_cputime.WidomMoveCBMCEwald += (u2 - u1);
-  system.mc_moves_cputime.WidomMoveCBMCEwald += (u2 - u1);
+  zone.end(system.components[selectedComponent].mc_moves_cputime.WidomMoveCBMCEwald,
+           system.mc_moves_cputime.WidomMoveCBMCEwald);
 
   // Compute the tail corrections for the energy due to the new molecule.
   RunningEnergy tailEnergyDifference =
@@ -0,0 +1,105 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <ios>
+#include <ostream>
+#include <print>
+#include <string>
+#include <vector>
+#endif
+
+module minimization;
+
+#ifndef USE_LEGACY_HEADERS
+import <chrono>;
+import <filesystem>;
+import <format>;
+import <fstream>;
+import <ios>;
+import <ostream>;
+import <print>;
+import <string>;
+import <vector>;
+#endif
+
+import hardware_info;
+import units;
+import system;
+import molecule;
+import randomnumbers;
+import input_reader;
+import running_energy;
+import minimizer;
+
+Minimization::Minimization(InputReader& reader) noexcept
+    : printEvery(reader.printEvery),
+      systems(std::move(reader.systems)),
+      random(reader.randomSeed),
+      minimizer(reader.minimizer)
+{
+  minimizer.maximumNumberOfSteps = reader.numberOfCycles;
+}
+
+void Minimization::createOutputFiles()
+{
+  std::filesystem::create_directories("output");
+  for (System& system : systems)
+  {
+    std::string fileNameString =
+        std::format("output/output_{}_{}.s{}.txt", system.temperature, system.input_pressure, system.systemId);
+    streams.emplace_back(fileNameString, std::ios::out);
+  }
+}
+
+void Minimization::run()
+{
+  createOutputFiles();
+
+  for (System& system : systems)
+  {
+    std::ostream stream(streams[system.systemId].rdbuf());
+
+    std::print(stream, "{}", system.writeOutputHeader());
+    std::print(stream, "Random seed: {}\n\n", random.seed);
+    std::print(stream, "{}\n", HardwareInfo::writeInfo());
+    std::print(stream, "{}", Units::printStatus());
+    std::print(stream, "{}", system.writeSystemStatus());
+    std::print(stream, "{}", system.forceField.printPseudoAtomStatus());
+    std::print(stream, "{}", system.forceField.printForceFieldStatus());
+    std::print(stream, "{}", system.writeComponentStatus());
+
+    system.precomputeTotalRigidEnergy();
+    std::print(stream, "{}", system.computeTotalEnergies().printMC("Initial configuration"));
+    std::print(stream, "\n\n");
+
+    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+    Minimizer::Result result = minimizer.minimize(system, stream, printEvery);
+    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
+    totalSimulationTime += (t2 - t1);
+    std::print(stream, "\n");
+
+    system.runningEnergies = system.computeTotalEnergies();
+    std::print(stream, "{}", minimizer.writeResult(result));
+    std::print(stream, "{}", system.runningEnergies.printMC("Minimized configuration (recomputed from scratch)"));
+    std::print(stream, "\n\n");
+
+    std::print(stream, "Minimized molecule positions\n");
+    std::print(stream, "===============================================================================\n\n");
+    std::print(stream, "{:>6s} {:20s} {:>38s} {:>40s}\n", "index", "component", "center of mass [Å]",
+               "orientation (r, ix, iy, iz)");
+    for (size_t i = 0; const Molecule& molecule : system.moleculePositions)
+    {
+      std::print(stream, "{:6d} {:20s} {: 12.6f} {: 12.6f} {: 12.6f} {: .6f} {: .6f} {: .6f} {: .6f}\n", i,
+                 system.components[molecule.componentId].name, molecule.centerOfMassPosition.x,
+                 molecule.centerOfMassPosition.y, molecule.centerOfMassPosition.z, molecule.orientation.r,
+                 molecule.orientation.ix, molecule.orientation.iy, molecule.orientation.iz);
+      ++i;
+    }
+    std::print(stream, "\n");
+    std::print(stream, "Minimization time: {:14f} [s]\n\n", std::chrono::duration<double>(t2 - t1).count());
+  }
+}
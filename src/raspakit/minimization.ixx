@@ -0,0 +1,47 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <chrono>
+#include <fstream>
+#include <vector>
+#endif
+
+export module minimization;
+
+#ifndef USE_LEGACY_HEADERS
+import <vector>;
+import <fstream>;
+import <chrono>;
+#endif
+
+import randomnumbers;
+import system;
+import input_reader;
+import minimizer;
+
+/**
+ * \brief The 'Minimization' simulation type: relaxes the initial configuration of every system to a local minimum.
+ *
+ * The molecules are created as for the other simulation types, then moved as rigid bodies by the 'Minimizer' until
+ * the largest generalized gradient is below the tolerance or 'NumberOfCycles' steps have been taken. The output
+ * lists the energies before and after, and the minimized center-of-mass positions and orientations, which locate the
+ * binding sites when starting from single molecules.
+ */
+export struct Minimization
+{
+  Minimization(InputReader &reader) noexcept;
+
+  size_t printEvery;  ///< Frequency of printing the minimization progress.
+
+  std::vector<System> systems;  ///< Vector of systems to minimize.
+  RandomNumber random;          ///< Random number generator (used to create the initial molecules).
+  Minimizer minimizer;          ///< Method and convergence settings.
+
+  std::vector<std::ofstream> streams;  ///< Output file streams for each system.
+
+  std::chrono::duration<double> totalSimulationTime{0};  ///< Total simulation time.
+
+  void createOutputFiles();
+
+  void run();
+};
@@ -0,0 +1,348 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <format>
+#include <numeric>
+#include <ostream>
+#include <print>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+#endif
+
+module minimizer;
+
+#ifndef USE_LEGACY_HEADERS
+import <algorithm>;
+import <cmath>;
+import <cstddef>;
+import <deque>;
+import <format>;
+import <numeric>;
+import <ostream>;
+import <print>;
+import <span>;
+import <sstream>;
+import <string>;
+import <vector>;
+#endif
+
+import double3;
+import simd_quatd;
+import atom;
+import molecule;
+import running_energy;
+import system;
+import units;
+import integrators_update;
+
+namespace
+{
+constexpr size_t coordinatesPerMolecule = 6;
+
+// FIRE parameters of Bitzek et al., Phys. Rev. Lett. 97, 170201 (2006), with time steps suited to internal units
+constexpr double fireInitialTimeStep = 0.01;
+constexpr double fireMaximumTimeStep = 0.1;
+constexpr size_t fireMinimumPositiveSteps = 5;
+constexpr double fireTimeStepIncrease = 1.1;
+constexpr double fireTimeStepDecrease = 0.5;
+constexpr double fireInitialMixing = 0.1;
+constexpr double fireMixingDecrease = 0.99;
+
+// L-BFGS line search
+constexpr double armijoFactor = 1e-4;
+constexpr size_t maximumNumberOfBacktracks = 20;
+
+double dot(const std::vector<double> &a, const std::vector<double> &b)
+{
+  return std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+}
+
+double maximumAbsolute(const std::vector<double> &a)
+{
+  double maximum = 0.0;
+  for (double value : a)
+  {
+    maximum = std::max(maximum, std::abs(value));
+  }
+  return maximum;
+}
+
+// scales 'step' down so that no coordinate changes more than 'maximum', and returns the applied factor
+double limitStep(std::vector<double> &step, double maximum)
+{
+  double largest = maximumAbsolute(step);
+  if (largest <= maximum) return 1.0;
+  double scale = maximum / largest;
+  for (double &value : step)
+  {
+    value *= scale;
+  }
+  return scale;
+}
+
+// computes the potential energy (internal units) and the generalized gradients of the current molecule positions
+double evaluate(System &system, std::vector<double> &gradient)
+{
+  std::span<Atom> moleculeAtoms = system.spanOfMoleculeAtoms();
+  Integrators::createCartesianPositions(system.moleculePositions, moleculeAtoms, system.components);
+  RunningEnergy energy = Integrators::updateGradients(
+      moleculeAtoms, system.spanOfFrameworkAtoms(), system.forceField, system.simulationBox, system.components,
+      system.eik_x, system.eik_y, system.eik_z, system.eik_xy, system.totalEik, system.fixedFrameworkStoredEik,
+      system.numberOfMoleculesPerComponent);
+
+  size_t index{};
+  for (size_t m = 0; m != system.moleculePositions.size(); ++m)
+  {
+    const Molecule &molecule = system.moleculePositions[m];
+    double3 translation{};
+    double3 rotation{};
+    for (const Atom &atom : moleculeAtoms.subspan(index, molecule.numberOfAtoms))
+    {
+      translation += atom.gradient;
+      rotation += double3::cross(atom.position - molecule.centerOfMassPosition, atom.gradient);
+    }
+
+    double *g = &gradient[coordinatesPerMolecule * m];
+    g[0] = translation.x;
+    g[1] = translation.y;
+    g[2] = translation.z;
+    g[3] = rotation.x;
+    g[4] = rotation.y;
+    g[5] = rotation.z;
+    index += molecule.numberOfAtoms;
+  }
+
+  return energy.potentialEnergy();
+}
+
+// translates the molecules and rotates them about their center of mass by the rotation vectors in 'step'
+void displace(std::vector<Molecule> &molecules, const std::vector<double> &step)
+{
+  for (size_t m = 0; m != molecules.size(); ++m)
+  {
+    const double *s = &step[coordinatesPerMolecule * m];
+    molecules[m].centerOfMassPosition += double3(s[0], s[1], s[2]);
+
+    double3 rotation(s[3], s[4], s[5]);
+    double angle = rotation.length();
+    if (angle > 0.0)
+    {
+      molecules[m].orientation =
+          (simd_quatd::fromAxisAngle(angle, (1.0 / angle) * rotation) * molecules[m].orientation).normalized();
+    }
+  }
+}
+}  // namespace
+
+std::string Minimizer::methodName() const
+{
+  switch (method)
+  {
+    case Method::FIRE:
+      return "FIRE";
+    case Method::LBFGS:
+      return "L-BFGS";
+    default:
+      return "unknown";
+  }
+}
+
+Minimizer::Result Minimizer::minimize(System &system, std::ostream &stream, size_t printEvery) const
+{
+  Result result{};
+  size_t numberOfCoordinates = coordinatesPerMolecule * system.moleculePositions.size();
+  double conv = Units::EnergyToKelvin;
+  double tolerance = gradientTolerance / conv;
+
+  system.precomputeTotalRigidEnergy();
+
+  std::vector<double> gradient(numberOfCoordinates);
+  std::vector<double> step(numberOfCoordinates);
+  double energy = evaluate(system, gradient);
+  result.initialEnergy = conv * energy;
+
+  auto report = [&](size_t currentStep)
+  {
+    if (printEvery > 0uz && currentStep % printEvery == 0uz)
+    {
+      std::print(stream, "{} step {:8d} energy: {: .6e} [K] largest gradient: {: .6e} [K/Å]\n", methodName(),
+                 currentStep, conv * energy, conv * maximumAbsolute(gradient));
+    }
+  };
+
+  size_t currentStep = 0uz;
+  switch (method)
+  {
+    case Method::FIRE:
+    {
+      std::vector<double> velocity(numberOfCoordinates, 0.0);
+      double timeStep = fireInitialTimeStep;
+      double mixing = fireInitialMixing;
+      size_t positiveSteps = 0uz;
+
+      for (; currentStep != maximumNumberOfSteps && maximumAbsolute(gradient) > tolerance; ++currentStep)
+      {
+        report(currentStep);
+
+        // the force is minus the gradient; mix the velocity towards the force while moving downhill
+        double power = -dot(gradient, velocity);
+        if (power > 0.0)
+        {
+          double velocityNorm = std::sqrt(dot(velocity, velocity));
+          double forceNorm = std::sqrt(dot(gradient, gradient));
+          for (size_t i = 0; i != numberOfCoordinates; ++i)
+          {
+            velocity[i] = (1.0 - mixing) * velocity[i] - mixing * velocityNorm * gradient[i] / forceNorm;
+          }
+          if (++positiveSteps > fireMinimumPositiveSteps)
+          {
+            timeStep = std::min(fireTimeStepIncrease * timeStep, fireMaximumTimeStep);
+            mixing *= fireMixingDecrease;
+          }
+        }
+        else
+        {
+          std::fill(velocity.begin(), velocity.end(), 0.0);
+          positiveSteps = 0uz;
+          timeStep *= fireTimeStepDecrease;
+          mixing = fireInitialMixing;
+        }
+
+        for (size_t i = 0; i != numberOfCoordinates; ++i)
+        {
+          velocity[i] -= timeStep * gradient[i];
+          step[i] = timeStep * velocity[i];
+        }
+        double scale = limitStep(step, maximumStepSize);
+        for (double &value : velocity)
+        {
+          value *= scale;
+        }
+
+        displace(system.moleculePositions, step);
+        energy = evaluate(system, gradient);
+      }
+      break;
+    }
+    case Method::LBFGS:
+    {
+      struct Correction
+      {
+        std::vector<double> s;
+        std::vector<double> y;
+        double rho;
+      };
+      std::deque<Correction> history;
+      std::vector<double> alpha(historySize);
+      std::vector<double> newGradient(numberOfCoordinates);
+
+      for (; currentStep != maximumNumberOfSteps && maximumAbsolute(gradient) > tolerance; ++currentStep)
+      {
+        report(currentStep);
+
+        // two-loop recursion for the direction -H g, with the initial Hessian scaled by the latest correction pair
+        std::vector<double> direction = gradient;
+        for (size_t k = history.size(); k-- > 0uz;)
+        {
+          alpha[k] = history[k].rho * dot(history[k].s, direction);
+          for (size_t i = 0; i != numberOfCoordinates; ++i) direction[i] -= alpha[k] * history[k].y[i];
+        }
+        if (!history.empty())
+        {
+          double gamma = dot(history.back().s, history.back().y) / dot(history.back().y, history.back().y);
+          for (double &value : direction) value *= gamma;
+        }
+        for (size_t k = 0; k != history.size(); ++k)
+        {
+          double beta = history[k].rho * dot(history[k].y, direction);
+          for (size_t i = 0; i != numberOfCoordinates; ++i) direction[i] += (alpha[k] - beta) * history[k].s[i];
+        }
+        for (double &value : direction) value = -value;
+
+        // fall back to steepest descent when the curvature information does not give a descent direction
+        if (dot(direction, gradient) >= 0.0)
+        {
+          history.clear();
+          for (size_t i = 0; i != numberOfCoordinates; ++i) direction[i] = -gradient[i];
+        }
+        limitStep(direction, maximumStepSize);
+
+        // backtracking line search on the Armijo condition
+        double slope = dot(direction, gradient);
+        std::vector<Molecule> storedMolecules = system.moleculePositions;
+        double fraction = 1.0;
+        bool accepted = false;
+        double newEnergy = energy;
+        for (size_t trial = 0; trial != maximumNumberOfBacktracks; ++trial)
+        {
+          for (size_t i = 0; i != numberOfCoordinates; ++i) step[i] = fraction * direction[i];
+          displace(system.moleculePositions, step);
+          newEnergy = evaluate(system, newGradient);
+          if (newEnergy <= energy + armijoFactor * fraction * slope)
+          {
+            accepted = true;
+            break;
+          }
+          system.moleculePositions = storedMolecules;
+          fraction *= 0.5;
+        }
+
+        if (!accepted)
+        {
+          // no decrease along steepest descent either: the minimum is reached within numerical precision
+          bool steepestDescent = history.empty();
+          history.clear();
+          energy = evaluate(system, gradient);
+          if (steepestDescent) break;
+          continue;
+        }
+
+        Correction correction{step, std::vector<double>(numberOfCoordinates), 0.0};
+        for (size_t i = 0; i != numberOfCoordinates; ++i) correction.y[i] = newGradient[i] - gradient[i];
+        double sy = dot(correction.s, correction.y);
+        if (sy > 1e-10)
+        {
+          correction.rho = 1.0 / sy;
+          history.push_back(std::move(correction));
+          if (history.size() > historySize) history.pop_front();
+        }
+
+        energy = newEnergy;
+        std::swap(gradient, newGradient);
+      }
+      break;
+    }
+  }
+
+  // leave the atoms at the final molecule positions
+  Integrators::createCartesianPositions(system.moleculePositions, system.spanOfMoleculeAtoms(), system.components);
+
+  result.numberOfSteps = currentStep;
+  result.maximumGradient = conv * maximumAbsolute(gradient);
+  result.converged = maximumAbsolute(gradient) <= tolerance;
+  result.finalEnergy = conv * energy;
+  return result;
+}
+
+std::string Minimizer::writeResult(const Result &result) const
+{
+  std::ostringstream stream;
+
+  std::print(stream, "Energy minimization ({})\n", methodName());
+  std::print(stream, "===============================================================================\n\n");
+  std::print(stream, "{} after {} steps (tolerance {} [K/Å], maximum step size {})\n",
+             result.converged ? "Converged" : "Not converged", result.numberOfSteps, gradientTolerance,
+             maximumStepSize);
+  std::print(stream, "Initial potential energy:  {: .6e} [K]\n", result.initialEnergy);
+  std::print(stream, "Final potential energy:    {: .6e} [K]\n", result.finalEnergy);
+  std::print(stream, "Largest gradient:          {: .6e} [K/Å]\n", result.maximumGradient);
+  std::print(stream, "\n\n");
+
+  return stream.str();
+}
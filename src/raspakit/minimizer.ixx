@@ -0,0 +1,67 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <cstddef>
+#include <ostream>
+#include <string>
+#endif
+
+export module minimizer;
+
+#ifndef USE_LEGACY_HEADERS
+import <cstddef>;
+import <ostream>;
+import <string>;
+#endif
+
+import system;
+
+/**
+ * \brief Energy minimization of the rigid adsorbate molecules over their center-of-mass and orientation.
+ *
+ * Every molecule has six generalized coordinates: its center-of-mass position and a rotation vector that rotates the
+ * molecule about its center of mass in the lab frame. The gradients follow from the atomic gradients of
+ * 'Integrators::updateGradients' (framework-molecule, molecule-molecule and Ewald Fourier): the center-of-mass
+ * gradient is the sum of the atomic gradients, and the rotational gradient is the sum of (r_i - com) x g_i. The
+ * framework is kept fixed.
+ *
+ * Two methods are available:
+ *  - FIRE (fast inertial relaxation engine), robust for the large forces of overlapping configurations;
+ *  - L-BFGS with a backtracking line search, faster close to a minimum.
+ * Every step is limited to 'maximumStepSize' per coordinate ([Å] for translations, [rad] for rotations), so strongly
+ * overlapping molecules are pushed apart gradually. Minimization stops when the largest generalized gradient drops
+ * below 'gradientTolerance' or after 'maximumNumberOfSteps' steps.
+ */
+export struct Minimizer
+{
+  enum class Method : size_t
+  {
+    FIRE = 0,
+    LBFGS = 1
+  };
+
+  struct Result
+  {
+    size_t numberOfSteps{0};
+    bool converged{false};
+    double initialEnergy{0.0};    ///< Potential energy before minimization [K].
+    double finalEnergy{0.0};      ///< Potential energy after minimization [K].
+    double maximumGradient{0.0};  ///< Largest generalized gradient after minimization [K/Å] or [K/rad].
+  };
+
+  Method method{Method::FIRE};
+  size_t maximumNumberOfSteps{10000};
+  double gradientTolerance{1.0};  ///< Convergence criterion on the largest generalized gradient [K/Å].
+  double maximumStepSize{0.1};    ///< Largest change of a coordinate per step [Å] or [rad].
+  size_t historySize{10};         ///< Number of correction pairs kept by L-BFGS.
+
+  /**
+   * \brief Minimizes the energy of the molecules of 'system', updating its molecule and atom positions.
+   *
+   * When 'printEvery' is non-zero the progress is written to 'stream' every 'printEvery' steps.
+   */
+  Result minimize(System &system, std::ostream &stream, size_t printEvery = 0) const;
+
+  std::string methodName() const;
+  std::string writeResult(const Result &result) const;
+};
@@ -93,6 +93,8 @@ import integrators;
 import integrators_compute;
 import integrators_update;
 import integrators_cputime;
+import hardware_counters;
+import minimizer;
 
 MolecularDynamics::MolecularDynamics() : random(std::nullopt) {};
 
@@ -104,10 +106,12 @@ MolecularDynamics::MolecularDynamics(InputReader& reader) noexcept
       writeBinaryRestartEvery(reader.writeBinaryRestartEvery),
       rescaleWangLandauEvery(reader.rescaleWangLandauEvery),
       optimizeMCMovesEvery(reader.optimizeMCMovesEvery),
+      minimizer(reader.minimizer),
       systems(std::move(reader.systems)),
       random(reader.randomSeed),
       estimation(reader.numberOfBlocks, reader.numberOfCycles)
 {
+  minimizer.maximumNumberOfSteps = reader.numberOfMinimizationSteps;
 }
 
 System& MolecularDynamics::randomSystem()
@@ -280,6 +284,14 @@ void MolecularDynamics::equilibrate()
   {
     std::ostream stream(streams[system.systemId].rdbuf());
     Integrators::createCartesianPositions(system.moleculePositions, system.spanOfMoleculeAtoms(), system.components);
+
+    // relax the initial configuration, removing the overlaps that would otherwise blow up the integration
+    if (minimizer.maximumNumberOfSteps > 0uz)
+    {
+      Minimizer::Result result = minimizer.minimize(system, stream, printEvery);
+      std::print(stream, "\n{}", minimizer.writeResult(result));
+    }
+
     Integrators::initializeVelocities(random, system.moleculePositions, system.components, system.temperature);
 
     Integrators::removeCenterOfMassVelocityDrift(system.moleculePositions);
@@ -446,6 +458,7 @@ void MolecularDynamics::production()
   }
 
   numberOfSteps = 0uz;
+  HardwareCounters::clear();
   for (currentCycle = 0uz; currentCycle != numberOfCycles; ++currentCycle)
   {
     t1 = std::chrono::system_clock::now();
@@ -608,8 +621,15 @@ void MolecularDynamics::output()
     std::print(stream, "===============================================================================\n\n");
 
     std::print(stream, "{}", total.writeMCMoveCPUTimeStatistics(totalSimulationTime));
+    std::print(stream, "Production simulation time:     {:14f} [s]\n", totalSimulationTime.count());
+    std::print(stream, "Production number of steps:     {:14d} [-]\n", numberOfCycles);
     std::print(stream, "\n\n");
 
+    if (HardwareCounters::enabled())
+    {
+      std::print(stream, "{}", HardwareCounters::writeStatistics());
+    }
+
     std::print(stream, "{}",
                system.averageEnergies.writeAveragesStatistics(system.hasExternalField, system.frameworkComponents,
                                                               system.components));
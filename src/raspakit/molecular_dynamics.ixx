@@ -27,6 +27,7 @@ import mc_moves;
 import input_reader;
 import energy_status;
 import archive;
+import minimizer;
 
 /**
  * \brief Represents a molecular dynamics simulation.
@@ -83,6 +84,7 @@ export struct MolecularDynamics
   size_t writeBinaryRestartEvery;       ///< Frequency of writing binary restart files.
   size_t rescaleWangLandauEvery;        ///< Frequency of rescaling Wang-Landau factors.
   size_t optimizeMCMovesEvery;          ///< Frequency of optimizing Monte Carlo moves.
+  Minimizer minimizer;                  ///< Relaxation of the initial configuration (no steps: no relaxation).
 
   size_t currentCycle{0};                                           ///< Current simulation cycle.
   SimulationStage simulationStage{SimulationStage::Uninitialized};  ///< Current stage of the simulation.
@@ -12,6 +12,7 @@ module;
 #include <iostream>
 #include <map>
 #include <mdspan>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <print>
@@ -50,11 +51,15 @@ import <exception>;
 import <source_location>;
 import <print>;
 import <mdspan>;
+import <mutex>;
 #endif
 
+import tracing;
+import hardware_counters;
 import stringutils;
 import hardware_info;
 import archive;
+import checkpoint;
 import system;
 import randomnumbers;
 import mc_moves;
@@ -98,6 +103,8 @@ MonteCarlo::MonteCarlo(InputReader& reader) noexcept
       writeBinaryRestartEvery(reader.writeBinaryRestartEvery),
       rescaleWangLandauEvery(reader.rescaleWangLandauEvery),
       optimizeMCMovesEvery(reader.optimizeMCMovesEvery),
+      checkConvergenceEvery(reader.checkConvergenceEvery),
+      checkpoint("restart_data.bin", reader.numberOfBinaryRestartFiles),
       systems(std::move(reader.systems)),
       random(reader.randomSeed),
       outputJsons(systems.size()),
@@ -127,6 +134,9 @@ System& MonteCarlo::randomSystem() { return systems[size_t(random.uniform() * st
 
 void MonteCarlo::run()
 {
+  // a stop requested after the previous run ended must not end this one
+  stopRequested = false;
+
   switch (simulationStage)
   {
     case SimulationStage::Initialization:
@@ -147,24 +157,29 @@ continueProductionStage:
   production();
 
   output();
+
+  checkpoint.wait();
 }
 
 void MonteCarlo::createOutputFiles()
 {
-  std::filesystem::create_directories("output");
+  std::filesystem::create_directories(outputDirectory);
   for (System& system : systems)
   {
-    std::string fileNameString =
-        std::format("output/output_{}_{}.s{}.txt", system.temperature, system.input_pressure, system.systemId);
+    std::string fileNameString = std::format("{}/output_{}_{}.s{}.txt", outputDirectory, system.temperature,
+                                             system.input_pressure, system.systemId);
     streams.emplace_back(fileNameString, std::ios::out);
-    fileNameString =
-        std::format("output/output_{}_{}.s{}.json", system.temperature, system.input_pressure, system.systemId);
+    fileNameString = std::format("{}/output_{}_{}.s{}.json", outputDirectory, system.temperature,
+                                 system.input_pressure, system.systemId);
     outputJsonFileNames.emplace_back(fileNameString);
   }
 }
 
 void MonteCarlo::performCycle()
 {
+  // recorded in the trace only, the moves inside are accumulated in the CPU-time tables
+  Tracing::Zone zone("cycle", "mc");
+
   size_t totalNumberOfMolecules{0uz};
   size_t totalNumberOfComponents{0uz};
   size_t numberOfStepsPerCycle{0uz};
@@ -282,7 +297,11 @@ void MonteCarlo::initialize()
 
   for (System& system : systems)
   {
-    system.precomputeTotalRigidEnergy();
+    // the rigid-framework Fourier terms are computed when the system is created, and copied with it
+    if (system.fixedFrameworkStoredEik.empty())
+    {
+      system.precomputeTotalRigidEnergy();
+    }
     system.runningEnergies = system.computeTotalEnergies();
 
     std::ostream stream(streams[system.systemId].rdbuf());
@@ -290,6 +309,11 @@ void MonteCarlo::initialize()
     std::print(stream, "\n\n\n\n");
 
     system.writeRestartFile();
+
+    if (system.equilibrationDetector.has_value())
+    {
+      system.equilibrationDetector->clear();
+    }
   };
 
   for (currentCycle = 0uz; currentCycle != numberOfInitializationCycles; currentCycle++)
@@ -321,15 +345,8 @@ void MonteCarlo::initialize()
 
     if (currentCycle % writeBinaryRestartEvery == 0uz)
     {
-      // write restart
-      std::ofstream ofile("restart_data.bin_temp", std::ios::binary);
-      Archive<std::ofstream> archive(ofile);
-      archive << *this;
-      ofile.close();
-      if (ofile)
-      {
-        std::filesystem::rename("restart_data.bin_temp", "restart_data.bin");
-      }
+      // snapshot the state and write the restart file in the background
+      checkpoint.write(*this);
     }
 
     t2 = std::chrono::system_clock::now();
@@ -337,8 +354,33 @@ void MonteCarlo::initialize()
     totalInitializationSimulationTime += (t2 - t1);
     totalSimulationTime += (t2 - t1);
 
+    // adaptive equilibration: 'numberOfInitializationCycles' is the upper bound
+    if (detectEquilibration())
+    {
+      for (System& system : systems)
+      {
+        std::ostream stream(streams[system.systemId].rdbuf());
+        std::print(stream, "Initialization: system stationary from cycle {}, stopping after {} cycles\n\n",
+                   system.equilibrationDetector->equilibratedAtCycle.value(), currentCycle + 1uz);
+        std::flush(stream);
+
+        outputJsons[system.systemId]["initialization"]["equilibrationDetection"] =
+            system.equilibrationDetector->jsonStatus(currentCycle + 1uz, numberOfInitializationCycles);
+      }
+      return;
+    }
+
   continueInitializationStage:;
   }
+
+  for (System& system : systems)
+  {
+    if (system.equilibrationDetector.has_value())
+    {
+      outputJsons[system.systemId]["initialization"]["equilibrationDetection"] =
+          system.equilibrationDetector->jsonStatus(numberOfInitializationCycles, numberOfInitializationCycles);
+    }
+  }
 }
 
 void MonteCarlo::equilibrate()
@@ -360,8 +402,22 @@ void MonteCarlo::equilibrate()
                                              system.containsTheFractionalMolecule);
       component.lambdaGC.clear();
     }
+
+    if (system.equilibrationDetector.has_value())
+    {
+      system.equilibrationDetector->clear();
+    }
   };
 
+  // the Wang-Landau biasing factors of CFCMC need the full equilibration stage
+  bool adaptiveEquilibration = std::none_of(systems.begin(), systems.end(),
+                                            [](const System& system)
+                                            {
+                                              return std::any_of(
+                                                  system.components.begin(), system.components.end(),
+                                                  [](const Component& component) { return component.hasFractionalMolecule; });
+                                            });
+
   for (currentCycle = 0uz; currentCycle != numberOfEquilibrationCycles; ++currentCycle)
   {
     t1 = std::chrono::system_clock::now();
@@ -386,6 +442,11 @@ void MonteCarlo::equilibrate()
       for (System& system : systems)
       {
         system.optimizeMCMoves();
+
+        if (system.moveProbabilityTuning.has_value())
+        {
+          system.moveProbabilityTuning->update(system.components);
+        }
       }
     }
 
@@ -404,15 +465,8 @@ void MonteCarlo::equilibrate()
 
     if (currentCycle % writeBinaryRestartEvery == 0uz)
     {
-      // write restart
-      std::ofstream ofile("restart_data.bin_temp", std::ios::binary);
-      Archive<std::ofstream> archive(ofile);
-      archive << *this;
-      ofile.close();
-      if (ofile)
-      {
-        std::filesystem::rename("restart_data.bin_temp", "restart_data.bin");
-      }
+      // snapshot the state and write the restart file in the background
+      checkpoint.write(*this);
     }
 
     t2 = std::chrono::system_clock::now();
@@ -420,8 +474,66 @@ void MonteCarlo::equilibrate()
     totalEquilibrationSimulationTime += (t2 - t1);
     totalSimulationTime += (t2 - t1);
 
+    // adaptive equilibration: 'numberOfEquilibrationCycles' is the upper bound
+    if (adaptiveEquilibration && detectEquilibration())
+    {
+      for (System& system : systems)
+      {
+        std::ostream stream(streams[system.systemId].rdbuf());
+        std::print(stream, "Equilibration: system stationary from cycle {}, stopping after {} cycles\n\n",
+                   system.equilibrationDetector->equilibratedAtCycle.value(), currentCycle + 1uz);
+        std::flush(stream);
+
+        outputJsons[system.systemId]["equilibration"]["equilibrationDetection"] =
+            system.equilibrationDetector->jsonStatus(currentCycle + 1uz, numberOfEquilibrationCycles);
+      }
+      return;
+    }
+
   continueEquilibrationStage:;
   }
+
+  for (System& system : systems)
+  {
+    if (system.equilibrationDetector.has_value())
+    {
+      outputJsons[system.systemId]["equilibration"]["equilibrationDetection"] =
+          system.equilibrationDetector->jsonStatus(numberOfEquilibrationCycles, numberOfEquilibrationCycles);
+    }
+  }
+}
+
+bool MonteCarlo::detectEquilibration()
+{
+  for (System& system : systems)
+  {
+    if (!system.equilibrationDetector.has_value()) return false;
+
+    std::vector<double> observables(system.components.size() + 1uz);
+    for (size_t i = 0; i < system.components.size(); ++i)
+    {
+      observables[i] = static_cast<double>(system.numberOfIntegerMoleculesPerComponent[i]);
+    }
+    observables.back() = system.runningEnergies.potentialEnergy();
+    system.equilibrationDetector->addSample(observables);
+  }
+
+  size_t checkEvery = systems.front().equilibrationDetector->checkEvery;
+  if (checkEvery == 0uz || (currentCycle + 1uz) % checkEvery != 0uz) return false;
+
+  std::vector<size_t> stationaryStart(systems.size());
+  for (size_t i = 0; i < systems.size(); ++i)
+  {
+    std::optional<size_t> start = systems[i].equilibrationDetector->detect();
+    if (!start.has_value()) return false;
+    stationaryStart[i] = start.value();
+  }
+
+  for (size_t i = 0; i < systems.size(); ++i)
+  {
+    systems[i].equilibrationDetector->equilibratedAtCycle = stationaryStart[i];
+  }
+  return true;
 }
 
 void MonteCarlo::production()
@@ -438,6 +550,17 @@ void MonteCarlo::production()
 
     system.runningEnergies = system.computeTotalEnergies();
 
+    // the tuned move probabilities are kept fixed during production to obey detailed balance
+    if (system.moveProbabilityTuning.has_value())
+    {
+      system.moveProbabilityTuning->freeze();
+      std::print(stream, "{}", system.moveProbabilityTuning->writeStatus(system.components));
+      std::flush(stream);
+
+      outputJsons[system.systemId]["equilibration"]["moveProbabilityTuning"] =
+          system.moveProbabilityTuning->jsonStatus(system.components);
+    }
+
     system.clearMoveStatistics();
     system.mc_moves_cputime.clearTimingStatistics();
     system.mc_moves_count.clearCountStatistics();
@@ -472,11 +595,28 @@ void MonteCarlo::production()
     }
   }
 
+  // a run that may stop on convergence starts with short blocks that are merged pairwise whenever they are all
+  // filled, so that the blocks always cover the cycles run so far; the energies are sampled every 10 cycles
+  if (checkConvergenceEvery > 0uz && std::any_of(systems.begin(), systems.end(), [](const System& system)
+                                                  { return system.convergenceMonitor.has_value(); }))
+  {
+    estimation.shrinkBins(10.0);
+  }
+
   numberOfSteps = 0uz;
+  HardwareCounters::clear();
   for (currentCycle = 0uz; currentCycle != numberOfCycles; ++currentCycle)
   {
     t1 = std::chrono::system_clock::now();
 
+    if (estimation.binsAreFilled(currentCycle))
+    {
+      std::vector<size_t> boundaries = estimation.mergeBins();
+      for (System& system : systems)
+      {
+        system.rebinProperties(boundaries);
+      }
+    }
     estimation.setCurrentSample(currentCycle);
 
     performCycle();
@@ -509,6 +649,20 @@ void MonteCarlo::production()
       }
     }
 
+    bool reportPoint = reportCallback && reportEvery > 0uz && currentCycle % reportEvery == 0uz;
+    if (reportPoint || currentCycle % printEvery == 0uz)
+    {
+      nlohmann::json report = jsonStatusReport();
+      {
+        std::scoped_lock lock(statusReportMutex);
+        latestStatusReport = report;
+      }
+      if (reportPoint)
+      {
+        reportCallback(report);
+      }
+    }
+
     if (currentCycle % optimizeMCMovesEvery == 0uz)
     {
       for (System& system : systems)
@@ -549,15 +703,8 @@ void MonteCarlo::production()
 
     if (currentCycle % writeBinaryRestartEvery == 0uz)
     {
-      // write restart
-      std::ofstream ofile("restart_data.bin_temp", std::ios::binary);
-      Archive<std::ofstream> archive(ofile);
-      archive << *this;
-      ofile.close();
-      if (ofile)
-      {
-        std::filesystem::rename("restart_data.bin_temp", "restart_data.bin");
-      }
+      // snapshot the state and write the restart file in the background
+      checkpoint.write(*this);
     }
 
     t2 = std::chrono::system_clock::now();
@@ -577,10 +724,71 @@ void MonteCarlo::production()
     }
     totalSimulationTime += (t2 - t1);
 
+    // stop the production run once all systems with a convergence monitor have reached their targets;
+    // 'numberOfCycles' remains the hard upper bound
+    if (checkConvergenceEvery > 0uz && (currentCycle + 1uz) % checkConvergenceEvery == 0uz &&
+        std::all_of(systems.begin(), systems.end(), [](const System& system)
+                    { return system.convergenceMonitor.has_value() && system.convergenceMonitor->isConverged(); }))
+    {
+      // the blocks after the current one are empty, drop them so that the block averages and their errors only
+      // cover the cycles that were run
+      std::vector<size_t> boundaries = estimation.dropEmptyBins();
+      for (System& system : systems)
+      {
+        system.rebinProperties(boundaries);
+        system.convergenceMonitor->convergedAtCycle = currentCycle + 1uz;
+
+        std::ostream stream(streams[system.systemId].rdbuf());
+        std::print(stream, "Convergence targets reached after {} production cycles, terminating production run\n\n",
+                   currentCycle + 1uz);
+        std::flush(stream);
+      }
+      break;
+    }
+
+    if (stopRequested)
+    {
+      std::vector<size_t> boundaries = estimation.dropEmptyBins();
+      for (System& system : systems)
+      {
+        system.rebinProperties(boundaries);
+
+        std::ostream stream(streams[system.systemId].rdbuf());
+        std::print(stream, "Stop requested after {} production cycles, terminating production run\n\n",
+                   currentCycle + 1uz);
+        std::flush(stream);
+      }
+      stopRequested = false;
+      break;
+    }
+
   continueProductionStage:;
   }
 }
 
+nlohmann::json MonteCarlo::jsonStatusReport() const
+{
+  nlohmann::json report;
+  report["currentCycle"] = currentCycle;
+  report["numberOfCycles"] = numberOfCycles;
+  report["numberOfSteps"] = numberOfSteps;
+  report["productionTime"] = totalProductionSimulationTime.count();
+  report["systems"] = nlohmann::json::array();
+  for (const System& system : systems)
+  {
+    report["systems"].push_back(system.jsonProductionStatusReportMC(currentCycle, numberOfCycles));
+  }
+  return report;
+}
+
+nlohmann::json MonteCarlo::lastStatusReport() const
+{
+  std::scoped_lock lock(statusReportMutex);
+  return latestStatusReport;
+}
+
+void MonteCarlo::requestStop() noexcept { stopRequested = true; }
+
 void MonteCarlo::output()
 {
   MCMoveCpuTime total;
@@ -643,6 +851,11 @@ void MonteCarlo::output()
     std::print(stream, "Total simulation time:          {:14f} [s]\n", totalSimulationTime.count());
     std::print(stream, "\n\n");
 
+    if (HardwareCounters::enabled())
+    {
+      std::print(stream, "{}", HardwareCounters::writeStatistics());
+    }
+
     std::print(stream, "{}",
                system.averageEnergies.writeAveragesStatistics(system.hasExternalField, system.frameworkComponents,
                                                               system.components));
@@ -651,6 +864,10 @@ void MonteCarlo::output()
         stream, "{}",
         system.averageEnthalpiesOfAdsorption.writeAveragesStatistics(system.swappableComponents, system.components));
     std::print(stream, "{}", system.averageLoadings.writeAveragesStatistics(system.components, system.frameworkMass()));
+    if (system.convergenceMonitor.has_value())
+    {
+      std::print(stream, "{}", system.convergenceMonitor->writeStatus(system.components));
+    }
 
     // json statistics
     outputJsons[system.systemId]["output"]["runningEnergies"] = system.runningEnergies.jsonMC();
@@ -667,14 +884,24 @@ void MonteCarlo::output()
     outputJsons[system.systemId]["output"]["cpuTimings"]["equilibration"] = totalEquilibrationSimulationTime.count();
     outputJsons[system.systemId]["output"]["cpuTimings"]["production"] = totalProductionSimulationTime.count();
     outputJsons[system.systemId]["output"]["cpuTimings"]["total"] = totalSimulationTime.count();
+    outputJsons[system.systemId]["output"]["numberOfProductionSteps"] = numberOfSteps;
     outputJsons[system.systemId]["output"]["cpuTimings"]["system"] =
         system.mc_moves_cputime.jsonSystemMCMoveCPUTimeStatistics();
+    if (HardwareCounters::enabled())
+    {
+      outputJsons[system.systemId]["output"]["hardwareCounters"] = HardwareCounters::jsonStatistics();
+    }
 
     outputJsons[system.systemId]["properties"]["averageEnergies"] = system.averageEnergies.jsonAveragesStatistics(
         system.hasExternalField, system.frameworkComponents, system.components);
     outputJsons[system.systemId]["properties"]["averagePressure"] = system.averagePressure.jsonAveragesStatistics();
     outputJsons[system.systemId]["properties"]["averageEnthalpy"] =
         system.averageEnthalpiesOfAdsorption.jsonAveragesStatistics(system.swappableComponents, system.components);
+    if (system.convergenceMonitor.has_value())
+    {
+      outputJsons[system.systemId]["properties"]["convergence"] =
+          system.convergenceMonitor->jsonStatus(system.components);
+    }
 
     for (const Component& component : system.components)
     {
@@ -702,6 +929,7 @@ Archive<std::ofstream>& operator<<(Archive<std::ofstream>& archive, const MonteC
   archive << mc.writeBinaryRestartEvery;
   archive << mc.rescaleWangLandauEvery;
   archive << mc.optimizeMCMovesEvery;
+  archive << mc.checkConvergenceEvery;
 
   archive << mc.currentCycle;
   archive << mc.simulationStage;
@@ -743,6 +971,10 @@ Archive<std::ifstream>& operator>>(Archive<std::ifstream>& archive, MonteCarlo&
   archive >> mc.writeBinaryRestartEvery;
   archive >> mc.rescaleWangLandauEvery;
   archive >> mc.optimizeMCMovesEvery;
+  if (versionNumber >= 2)
+  {
+    archive >> mc.checkConvergenceEvery;
+  }
 
   archive >> mc.currentCycle;
   archive >> mc.simulationStage;
@@ -1,10 +1,14 @@
 module;
 
 #ifdef USE_LEGACY_HEADERS
+#include <atomic>
 #include <chrono>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <optional>
+#include <string>
 #include <vector>
 #endif
 
@@ -14,8 +18,12 @@ export module monte_carlo;
 import <vector>;
 import <iostream>;
 import <fstream>;
+import <functional>;
 import <chrono>;
 import <optional>;
+import <string>;
+import <atomic>;
+import <mutex>;
 #endif
 
 import randomnumbers;
@@ -27,6 +35,7 @@ import mc_moves;
 import input_reader;
 import energy_status;
 import archive;
+import checkpoint;
 import json;
 
 /**
@@ -91,16 +100,32 @@ export struct MonteCarlo
              size_t optimizeMCMovesEvery, std::vector<System> &systems, RandomNumber &randomSeed,
              size_t numberOfBlocks);
 
-  uint64_t versionNumber{1};  ///< Version number for serialization.
-
-  size_t numberOfCycles;                ///< Number of production cycles.
-  size_t numberOfSteps;                 ///< Total number of steps performed.
-  size_t numberOfInitializationCycles;  ///< Number of initialization cycles.
-  size_t numberOfEquilibrationCycles;   ///< Number of equilibration cycles.
-  size_t printEvery;                    ///< Frequency of printing status reports.
-  size_t writeBinaryRestartEvery;       ///< Frequency of writing binary restart files.
-  size_t rescaleWangLandauEvery;        ///< Frequency of rescaling Wang-Landau factors.
-  size_t optimizeMCMovesEvery;          ///< Frequency of optimizing MC moves.
+  uint64_t versionNumber{2};  ///< Version number for serialization.
+
+  size_t numberOfCycles;                  ///< Number of production cycles.
+  size_t numberOfSteps;                   ///< Total number of steps performed.
+  size_t numberOfInitializationCycles;    ///< Number of initialization cycles.
+  size_t numberOfEquilibrationCycles;     ///< Number of equilibration cycles.
+  size_t printEvery;                      ///< Frequency of printing status reports.
+  size_t writeBinaryRestartEvery;         ///< Frequency of writing binary restart files.
+  size_t rescaleWangLandauEvery;          ///< Frequency of rescaling Wang-Landau factors.
+  size_t optimizeMCMovesEvery;            ///< Frequency of optimizing MC moves.
+  size_t checkConvergenceEvery{1000};     ///< Frequency of checking convergence of the production run.
+  Checkpoint checkpoint{};                ///< Asynchronous writer of the binary restart files.
+  std::string outputDirectory{"output"};  ///< Directory of the text and json output files.
+
+  /// Frequency of the in-memory status reports during production; 0 disables them.
+  size_t reportEvery{0};
+  /// Receives the status reports (see 'jsonStatusReport'); called on the simulation thread, an exception thrown by it
+  /// ends the run without writing the final output (use 'requestStop' to end it early with output).
+  std::function<void(const nlohmann::json &)> reportCallback{};
+
+  /// Set by 'requestStop'; production ends after the current cycle.
+  std::atomic<bool> stopRequested{false};
+  /// Set while a stage runs on another thread than its observers; they then read 'lastStatusReport'.
+  std::atomic<bool> running{false};
+  mutable std::mutex statusReportMutex;  ///< Guards 'latestStatusReport'.
+  nlohmann::json latestStatusReport{};   ///< The status report taken at the last print or report point.
 
   size_t currentCycle{0};                                           ///< Current cycle number.
   SimulationStage simulationStage{SimulationStage::Uninitialized};  ///< Current simulation stage.
@@ -164,6 +189,16 @@ export struct MonteCarlo
    */
   void production();
 
+  /**
+   * \brief Samples the equilibration detectors of all systems and tests for stationarity.
+   *
+   * Appends the current loadings and potential energy to the time series of each system, and every
+   * 'checkEvery' cycles tests whether all series have become stationary.
+   *
+   * \return True when adaptive equilibration is enabled and all systems have become stationary.
+   */
+  bool detectEquilibration();
+
   /**
    * \brief Generates the final output of the simulation.
    *
@@ -172,6 +207,27 @@ export struct MonteCarlo
    */
   void output();
 
+  /**
+   * \brief The production status of all systems (loadings, energies and move statistics with their block averages).
+   */
+  nlohmann::json jsonStatusReport() const;
+
+  /**
+   * \brief The status report taken at the last print or report point of the production run.
+   *
+   * Unlike 'jsonStatusReport' it does not read the systems, so it can be called from any thread while the simulation
+   * runs.
+   */
+  nlohmann::json lastStatusReport() const;
+
+  /**
+   * \brief Ends the production run after the current cycle; callable from any thread.
+   *
+   * The block averages are rebinned to the cycles run, and 'run' still writes the final output and restart file. A
+   * stop requested before production ends the run after its first production cycle.
+   */
+  void requestStop() noexcept;
+
   /**
    * \brief Selects a random system from the list of systems.
    *
@@ -8,6 +8,7 @@ module;
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <ios>
 #include <iostream>
 #include <map>
@@ -41,6 +42,7 @@ import <span>;
 import <string>;
 import <optional>;
 import <fstream>;
+import <future>;
 import <sstream>;
 import <filesystem>;
 import <tuple>;
@@ -87,6 +89,7 @@ import property_pressure;
 import transition_matrix;
 import interactions_ewald;
 import equation_of_states;
+import hardware_counters;
 
 MonteCarloTransitionMatrix::MonteCarloTransitionMatrix() : random(std::nullopt) {};
 
@@ -131,6 +134,12 @@ System& MonteCarloTransitionMatrix::randomSystem()
 
 void MonteCarloTransitionMatrix::run()
 {
+  if (systems.size() == 1uz && systems.front().tmmc.numberOfWindows > 1uz)
+  {
+    runWindows();
+    return;
+  }
+
   switch (simulationStage)
   {
     case SimulationStage::Initialization:
@@ -153,16 +162,77 @@ continueProductionStage:
   output();
 }
 
+void MonteCarloTransitionMatrix::runWindows()
+{
+  const TransitionMatrix& tmmc = systems.front().tmmc;
+  std::vector<std::pair<size_t, size_t>> ranges = TransitionMatrix::windowRanges(
+      tmmc.minMacrostate, tmmc.maxMacrostate, tmmc.numberOfWindows, tmmc.windowOverlap);
+
+  std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+
+  // the walkers share nothing but read-only input, so every window runs as a complete simulation on its own thread
+  std::vector<std::future<TransitionMatrix>> futures{};
+  for (size_t k = 0; k != ranges.size(); ++k)
+  {
+    futures.push_back(std::async(std::launch::async, [this, k, &ranges]()
+                                 { return runWindow(k, ranges[k].first, ranges[k].second); }));
+  }
+  std::vector<TransitionMatrix> windows{};
+  for (std::future<TransitionMatrix>& future : futures)
+  {
+    windows.push_back(future.get());
+  }
+
+  std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
+  totalSimulationTime += (t2 - t1);
+
+  systems.front().tmmc = TransitionMatrix::stitch(windows);
+  systems.front().tmmc.writeStatistics(tmmcDirectory);
+}
+
+TransitionMatrix MonteCarloTransitionMatrix::runWindow(size_t window, size_t minMacrostate,
+                                                       size_t maxMacrostate) const
+{
+  std::vector<System> windowSystems{systems.front()};
+  System& system = windowSystems.front();
+  system.tmmc.minMacrostate = minMacrostate;
+  system.tmmc.maxMacrostate = maxMacrostate;
+  system.tmmc.numberOfWindows = 1uz;
+
+  RandomNumber windowRandom(random.seed + window);
+
+  // start inside the window: moves that leave it are rejected, so the walker could not get in by itself
+  for (const Component& component : system.components)
+  {
+    if (component.type == Component::Type::Adsorbate)
+    {
+      size_t numberOfMolecules = system.numberOfIntegerMoleculesPerComponent[component.componentId];
+      system.setNumberOfIntegerMolecules(windowRandom, component.componentId,
+                                         std::clamp(numberOfMolecules, minMacrostate, maxMacrostate));
+    }
+  }
+
+  MonteCarloTransitionMatrix walker(numberOfCycles, numberOfInitializationCycles, numberOfEquilibrationCycles,
+                                    printEvery, writeBinaryRestartEvery, rescaleWangLandauEvery, optimizeMCMovesEvery,
+                                    windowSystems, windowRandom, estimation.numberOfBins);
+  walker.outputDirectory = std::format("{}/window_{}", outputDirectory, window);
+  walker.restartFileName = std::format("{}/{}", walker.outputDirectory, restartFileName);
+  walker.tmmcDirectory = std::format("{}/window_{}", tmmcDirectory, window);
+  walker.run();
+
+  return walker.systems.front().tmmc;
+}
+
 void MonteCarloTransitionMatrix::createOutputFiles()
 {
-  std::filesystem::create_directories("output");
+  std::filesystem::create_directories(outputDirectory);
   for (System& system : systems)
   {
-    std::string fileNameString =
-        std::format("output/output_{}_{}.s{}.txt", system.temperature, system.input_pressure, system.systemId);
+    std::string fileNameString = std::format("{}/output_{}_{}.s{}.txt", outputDirectory, system.temperature,
+                                             system.input_pressure, system.systemId);
     streams.emplace_back(fileNameString, std::ios::out);
-    fileNameString =
-        std::format("output/output_{}_{}.s{}.json", system.temperature, system.input_pressure, system.systemId);
+    fileNameString = std::format("{}/output_{}_{}.s{}.json", outputDirectory, system.temperature,
+                                 system.input_pressure, system.systemId);
     outputJsonFileNames.emplace_back(fileNameString);
   }
 }
@@ -335,13 +405,13 @@ void MonteCarloTransitionMatrix::initialize()
     if (currentCycle % writeBinaryRestartEvery == 0uz)
     {
       // write restart
-      std::ofstream ofile("restart_data.bin_temp", std::ios::binary);
+      std::ofstream ofile(restartFileName + "_temp", std::ios::binary);
       Archive<std::ofstream> archive(ofile);
       archive << *this;
       ofile.close();
       if (ofile)
       {
-        std::filesystem::rename("restart_data.bin_temp", "restart_data.bin");
+        std::filesystem::rename(restartFileName + "_temp", restartFileName);
       }
     }
 
@@ -420,13 +490,13 @@ void MonteCarloTransitionMatrix::equilibrate()
     if (currentCycle % writeBinaryRestartEvery == 0uz)
     {
       // write restart
-      std::ofstream ofile("restart_data.bin_temp", std::ios::binary);
+      std::ofstream ofile(restartFileName + "_temp", std::ios::binary);
       Archive<std::ofstream> archive(ofile);
       archive << *this;
       ofile.close();
       if (ofile)
       {
-        std::filesystem::rename("restart_data.bin_temp", "restart_data.bin");
+        std::filesystem::rename(restartFileName + "_temp", restartFileName);
       }
     }
 
@@ -490,6 +560,7 @@ void MonteCarloTransitionMatrix::production()
   }
 
   numberOfSteps = 0uz;
+  HardwareCounters::clear();
   for (currentCycle = 0uz; currentCycle != numberOfCycles; ++currentCycle)
   {
     t1 = std::chrono::system_clock::now();
@@ -522,13 +593,13 @@ void MonteCarloTransitionMatrix::production()
     if (currentCycle % writeBinaryRestartEvery == 0uz)
     {
       // write restart
-      std::ofstream ofile("restart_data.bin_temp", std::ios::binary);
+      std::ofstream ofile(restartFileName + "_temp", std::ios::binary);
       Archive<std::ofstream> archive(ofile);
       archive << *this;
       ofile.close();
       if (ofile)
       {
-        std::filesystem::rename("restart_data.bin_temp", "restart_data.bin");
+        std::filesystem::rename(restartFileName + "_temp", restartFileName);
       }
     }
 
@@ -543,7 +614,7 @@ void MonteCarloTransitionMatrix::production()
   // Write the collection matrix
   for (System& system : systems)
   {
-    system.tmmc.writeStatistics();
+    system.tmmc.writeStatistics(tmmcDirectory);
   }
 }
 
@@ -609,6 +680,11 @@ void MonteCarloTransitionMatrix::output()
     std::print(stream, "Total simulation time:          {:14f} [s]\n", totalSimulationTime.count());
     std::print(stream, "\n\n");
 
+    if (HardwareCounters::enabled())
+    {
+      std::print(stream, "{}", HardwareCounters::writeStatistics());
+    }
+
     // json statistics
     outputJsons[system.systemId]["output"]["runningEnergies"] = system.runningEnergies.jsonMC();
     outputJsons[system.systemId]["output"]["recomputedEnergies"] = recomputedEnergies.jsonMC();
@@ -624,8 +700,13 @@ void MonteCarloTransitionMatrix::output()
     outputJsons[system.systemId]["output"]["cpuTimings"]["equilibration"] = totalEquilibrationSimulationTime.count();
     outputJsons[system.systemId]["output"]["cpuTimings"]["production"] = totalProductionSimulationTime.count();
     outputJsons[system.systemId]["output"]["cpuTimings"]["total"] = totalSimulationTime.count();
+    outputJsons[system.systemId]["output"]["numberOfProductionSteps"] = numberOfSteps;
     outputJsons[system.systemId]["output"]["cpuTimings"]["system"] =
         system.mc_moves_cputime.jsonSystemMCMoveCPUTimeStatistics();
+    if (HardwareCounters::enabled())
+    {
+      outputJsons[system.systemId]["output"]["hardwareCounters"] = HardwareCounters::jsonStatistics();
+    }
 
     for (const Component& component : system.components)
     {
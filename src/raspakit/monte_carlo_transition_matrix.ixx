@@ -5,6 +5,7 @@ module;
 #include <fstream>
 #include <iostream>
 #include <optional>
+#include <string>
 #include <vector>
 #endif
 
@@ -16,6 +17,7 @@ import <iostream>;
 import <fstream>;
 import <chrono>;
 import <optional>;
+import <string>;
 #endif
 
 import randomnumbers;
@@ -28,6 +30,7 @@ import input_reader;
 import energy_status;
 import archive;
 import json;
+import transition_matrix;
 
 /**
  * \brief Performs Monte Carlo simulations for molecular systems.
@@ -35,6 +38,10 @@ import json;
  * The MonteCarloTransitionMatrix struct orchestrates the execution of Monte Carlo simulations,
  * including initialization, equilibration, and production stages. It manages multiple systems,
  * random number generation, simulation parameters, and output generation.
+ *
+ * When the macrostate range of the system is split into windows ('TransitionMatrix::numberOfWindows' > 1), every
+ * window is sampled by an independent walker on its own thread, restricted to the macrostates of its window. The
+ * collection matrices of the walkers are stitched into ln(pi) of the whole range afterwards.
  */
 export struct MonteCarloTransitionMatrix
 {
@@ -109,6 +116,10 @@ export struct MonteCarloTransitionMatrix
   RandomNumber random;                 ///< Random number generator.
   size_t fractionalMoleculeSystem{0};  // the system where the fractional molecule is located
 
+  std::string outputDirectory{"output"};            ///< Directory of the text and json output files.
+  std::string restartFileName{"restart_data.bin"};  ///< File name of the binary restart file.
+  std::string tmmcDirectory{"tmmc"};                ///< Directory of the transition-matrix statistics.
+
   std::vector<std::ofstream> streams;            ///< Output streams for writing data.
   std::vector<std::string> outputJsonFileNames;  ///< Filenames for output JSON files.
   std::vector<nlohmann::json> outputJsons;       ///< Output data in JSON format.
@@ -133,6 +144,22 @@ export struct MonteCarloTransitionMatrix
    */
   void run();
 
+  /**
+   * \brief Runs the windows of the macrostate range concurrently and stitches their transition matrices.
+   *
+   * Window 'k' writes its output to 'output/window_k' and its statistics to 'tmmc/window_k'; the stitched
+   * statistics of the whole range are written to 'tmmc' and stored in the transition matrix of the system.
+   */
+  void runWindows();
+
+  /**
+   * \brief Runs a walker restricted to the macrostates [minMacrostate, maxMacrostate] and returns its matrix.
+   *
+   * The walker starts from a copy of the system with its number of molecules moved into the window, and uses the
+   * random-number seed of the simulation plus the window index.
+   */
+  TransitionMatrix runWindow(size_t window, size_t minMacrostate, size_t maxMacrostate) const;
+
   /**
    * \brief Performs a single Monte Carlo cycle.
    *
@@ -133,6 +133,28 @@ void PropertyConventionalRadialDistributionFunction::sample(const SimulationBox
   numberOfCounts[block] += 2;
 }
 
+void PropertyConventionalRadialDistributionFunction::rebin(const std::vector<size_t> &boundaries)
+{
+  size_t numberOfPairs = numberOfPseudoAtoms * numberOfPseudoAtoms;
+  std::vector<std::vector<double>> rebinnedSumProperty((boundaries.size() - 1) * numberOfPairs,
+                                                       std::vector<double>(numberOfBins));
+  for (size_t j = 0; j + 1 < boundaries.size(); ++j)
+  {
+    for (size_t i = boundaries[j]; i != boundaries[j + 1]; ++i)
+    {
+      for (size_t k = 0; k != numberOfPairs; ++k)
+      {
+        std::vector<double> &target = rebinnedSumProperty[k + j * numberOfPairs];
+        std::transform(target.begin(), target.end(), sumProperty[k + i * numberOfPairs].begin(), target.begin(),
+                       [](const double &a, const double &b) { return a + b; });
+      }
+    }
+  }
+  sumProperty = std::move(rebinnedSumProperty);
+  numberOfCounts = rebinBlocks(numberOfCounts, boundaries, 0uz, [](size_t a, size_t b) { return a + b; });
+  numberOfBlocks = numberOfCounts.size();
+}
+
 std::vector<double> PropertyConventionalRadialDistributionFunction::averagedProbabilityHistogram(size_t blockIndex,
                                                                                                  size_t atomTypeA,
                                                                                                  size_t atomTypeB) const
@@ -204,7 +226,7 @@ void PropertyConventionalRadialDistributionFunction::writeOutput(
 {
   if (currentCycle % writeEvery != 0uz) return;
 
-  std::filesystem::create_directory("conventional_rdf");
+  std::filesystem::create_directories(outputDirectory);
 
   for (size_t atomTypeA = 0; atomTypeA < numberOfPseudoAtoms; ++atomTypeA)
   {
@@ -212,7 +234,7 @@ void PropertyConventionalRadialDistributionFunction::writeOutput(
     {
       if (pairCount[atomTypeA + atomTypeB * numberOfPseudoAtoms] > 0)
       {
-        std::ofstream stream_rdf_output(std::format("conventional_rdf/rdf_{}_{}.s{}.txt",
+        std::ofstream stream_rdf_output(std::format("{}/rdf_{}_{}.s{}.txt", outputDirectory,
                                                     forceField.pseudoAtoms[atomTypeA].name,
                                                     forceField.pseudoAtoms[atomTypeB].name, systemId));
 
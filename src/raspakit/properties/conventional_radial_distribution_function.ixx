@@ -66,6 +66,7 @@ export struct PropertyConventionalRadialDistributionFunction
   double deltaR;
   size_t sampleEvery;
   size_t writeEvery;
+  std::string outputDirectory{"conventional_rdf"};
   std::vector<std::vector<double>> sumProperty;
   size_t totalNumberOfCounts;
   std::vector<size_t> numberOfCounts;
@@ -73,6 +74,7 @@ export struct PropertyConventionalRadialDistributionFunction
 
   void sample(const SimulationBox &simulationBox, std::span<Atom> frameworkAtoms, std::span<Atom> moleculeAtoms,
               size_t currentCycle, size_t block);
+  void rebin(const std::vector<size_t> &boundaries);
   void writeOutput(const ForceField &forceField, size_t systemId, double volume,
                    std::vector<size_t> &numberOfPseudoAtomsType, size_t currentCycle);
 
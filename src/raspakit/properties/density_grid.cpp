@@ -2,13 +2,18 @@ module;
 
 #ifdef USE_LEGACY_HEADERS
 #include <algorithm>
+#include <atomic>
 #include <complex>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <iterator>
 #include <mdspan>
 #include <numbers>
 #include <print>
@@ -16,6 +21,7 @@ module;
 #include <span>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 #endif
@@ -24,6 +30,8 @@ module property_density_grid;
 
 #ifndef USE_LEGACY_HEADERS
 import <cstddef>;
+import <atomic>;
+import <cstdint>;
 import <string>;
 import <iostream>;
 import <fstream>;
@@ -40,6 +48,10 @@ import <source_location>;
 import <print>;
 import <mdspan>;
 import <filesystem>;
+import <functional>;
+import <future>;
+import <thread>;
+import <iterator>;
 #endif
 
 import archive;
@@ -53,6 +65,8 @@ import averages;
 import stringutils;
 import framework;
 import component;
+import threadpool;
+import hdf5;
 
 // Gaussian cube file are stored row-order (std::layout_right)
 // The grid is arranged with the x axis as the outer loop and the z axis as the inner loop
@@ -62,49 +76,137 @@ void PropertyDensityGrid::sample(const std::vector<Framework> &frameworks, const
 {
   if (currentCycle % sampleEvery != 0uz) return;
 
-  std::mdspan<double, std::dextents<size_t, 4>> data_cell(grid_cell.data(), numberOfComponents, numberOfGridPoints.x,
-                                                          numberOfGridPoints.y, numberOfGridPoints.z);
-  std::mdspan<double, std::dextents<size_t, 5>> data_unitcell(grid_unitcell.data(), numberOfComponents,
-                                                              std::min(1uz, numberOfFrameworks), numberOfGridPoints.x,
-                                                              numberOfGridPoints.y, numberOfGridPoints.z);
+  ++numberOfSamples;
 
-  for (std::span<const Atom>::iterator it = moleculeAtoms.begin(); it != moleculeAtoms.end(); ++it)
+  auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+  const size_t numberOfHelperThreads =
+      pool.getThreadingType() == ThreadPool::ThreadingType::ThreadPool ? pool.getThreadCount() : 0uz;
+
+  if (numberOfHelperThreads == 0uz ||
+      moleculeAtoms.size() < minimumNumberOfAtomsPerThread * (numberOfHelperThreads + 1uz))
+  {
+    binAtoms(frameworks, simulationBox, moleculeAtoms, false);
+    return;
+  }
+
+  // each helper thread bins a contiguous block of atoms into the shared grids, the main thread takes the rest
+  const size_t block_size = moleculeAtoms.size() / (numberOfHelperThreads + 1uz);
+
+  std::vector<std::future<void>> threads(numberOfHelperThreads);
+  for (size_t i = 0; i != numberOfHelperThreads; ++i)
+  {
+    threads[i] = pool.enqueue([this, &frameworks, &simulationBox,
+                               atoms = moleculeAtoms.subspan(i * block_size, block_size)]()
+                              { binAtoms(frameworks, simulationBox, atoms, true); });
+  }
+  binAtoms(frameworks, simulationBox, moleculeAtoms.subspan(numberOfHelperThreads * block_size), true);
+
+  for (std::future<void> &thread : threads)
+  {
+    thread.get();
+  }
+}
+
+void PropertyDensityGrid::binAtoms(const std::vector<Framework> &frameworks, const SimulationBox &simulationBox,
+                                   std::span<const Atom> atoms, bool concurrent)
+{
+  std::mdspan<uint32_t, std::dextents<size_t, 4>> data_cell(grid_cell.data(), numberOfComponents, numberOfGridPoints.x,
+                                                            numberOfGridPoints.y, numberOfGridPoints.z);
+  std::mdspan<uint32_t, std::dextents<size_t, 5>> data_unitcell(grid_unitcell.data(), numberOfComponents,
+                                                                numberOfFrameworks, numberOfGridPoints.x,
+                                                                numberOfGridPoints.y, numberOfGridPoints.z);
+
+  // the counts are independent, so relaxed ordering suffices (the futures synchronize with the writer)
+  auto increment = [concurrent](uint32_t &count)
+  {
+    if (concurrent)
+    {
+      std::atomic_ref<uint32_t>(count).fetch_add(1u, std::memory_order_relaxed);
+    }
+    else
+    {
+      ++count;
+    }
+  };
+
+  for (std::span<const Atom>::iterator it = atoms.begin(); it != atoms.end(); ++it)
   {
     size_t comp = static_cast<size_t>(it->componentId);
     double3 pos = it->position;
     double3 s = (simulationBox.inverseCell * pos).fract();
-    data_cell[comp, static_cast<size_t>(s.x * gridSize.x), static_cast<size_t>(s.y * gridSize.y),
-              static_cast<size_t>(s.z * gridSize.z)]++;
+    increment(data_cell[comp, static_cast<size_t>(s.x * gridSize.x), static_cast<size_t>(s.y * gridSize.y),
+                        static_cast<size_t>(s.z * gridSize.z)]);
 
-    for (size_t k = 0; k != frameworks.size(); ++k)
+    for (size_t k = 0; k != std::min(frameworks.size(), numberOfFrameworks); ++k)
     {
       double3 t = (frameworks[k].simulationBox.inverseCell * pos).fract();
-      data_unitcell[comp, k, static_cast<size_t>(t.x * gridSize.x), static_cast<size_t>(t.y * gridSize.y),
-                    static_cast<size_t>(t.z * gridSize.z)]++;
+      increment(data_unitcell[comp, k, static_cast<size_t>(t.x * gridSize.x), static_cast<size_t>(t.y * gridSize.y),
+                              static_cast<size_t>(t.z * gridSize.z)]);
     }
   }
 }
 
-void PropertyDensityGrid::writeOutput(size_t systemId, [[maybe_unused]] const SimulationBox &simulationBox,
+void PropertyDensityGrid::writeOutput(size_t systemId, const SimulationBox &simulationBox,
                                       const ForceField &forceField, const std::vector<Framework> &frameworkComponents,
                                       const std::vector<Component> &components, size_t currentCycle)
 {
   if (currentCycle % writeEvery != 0uz) return;
 
-  std::filesystem::create_directory("density_grids");
+  std::filesystem::create_directories(outputDirectory);
 
-  std::mdspan<double, std::dextents<size_t, 4>> data_cell(grid_cell.data(), numberOfComponents, numberOfGridPoints.x,
-                                                          numberOfGridPoints.y, numberOfGridPoints.z);
-  std::mdspan<double, std::dextents<size_t, 5>> data_unitcell(grid_unitcell.data(), numberOfComponents,
-                                                              std::min(1uz, numberOfFrameworks), numberOfGridPoints.x,
-                                                              numberOfGridPoints.y, numberOfGridPoints.z);
+  switch (outputFormat)
+  {
+    case OutputFormat::HDF5:
+      writeHDF5Output(systemId, simulationBox, frameworkComponents, components);
+      break;
+    case OutputFormat::Cube:
+    default:
+      writeCubeOutput(systemId, simulationBox, forceField, frameworkComponents, components);
+      break;
+  }
+}
+
+// formats the grid values into a single buffer, which is much faster than printing each value to the stream
+static void printCubeValues(std::ostream &stream, std::span<const uint32_t> values)
+{
+  std::span<const uint32_t>::iterator maximum = std::max_element(values.begin(), values.end());
+  double normalization{1.0};
+  if (maximum != values.end() && *maximum > 0u)
+  {
+    normalization = 1.0 / static_cast<double>(*maximum);
+  }
+
+  std::string buffer;
+  buffer.reserve(12uz * values.size());
+  for (uint32_t value : values)
+  {
+    std::format_to(std::back_inserter(buffer), "{}\n", static_cast<double>(value) * normalization);
+  }
+  stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+void PropertyDensityGrid::writeCubeOutput(size_t systemId, const SimulationBox &simulationBox,
+                                          const ForceField &forceField,
+                                          const std::vector<Framework> &frameworkComponents,
+                                          const std::vector<Component> &components)
+{
+  std::mdspan<uint32_t, std::dextents<size_t, 4>> data_cell(grid_cell.data(), numberOfComponents, numberOfGridPoints.x,
+                                                            numberOfGridPoints.y, numberOfGridPoints.z);
+  std::mdspan<uint32_t, std::dextents<size_t, 5>> data_unitcell(grid_unitcell.data(), numberOfComponents,
+                                                                numberOfFrameworks, numberOfGridPoints.x,
+                                                                numberOfGridPoints.y, numberOfGridPoints.z);
 
   for (size_t i = 0; i < components.size(); ++i)
   {
-    std::ofstream ostream(std::format("density_grids/grid_component_{}.s{}.cube", components[i].name, systemId));
+    std::ofstream ostream(
+        std::format("{}/grid_component_{}.s{}.cube", outputDirectory, components[i].name, systemId));
     const double3x3 cell = simulationBox.cell;
 
-    std::vector<Atom> frameworkAtoms = frameworkComponents.front().atoms;
+    std::vector<Atom> frameworkAtoms{};
+    for (const Framework &framework : frameworkComponents)
+    {
+      frameworkAtoms.insert(frameworkAtoms.end(), framework.atoms.begin(), framework.atoms.end());
+    }
 
     std::print(ostream, "Cube density file\n");
     std::print(ostream, "Written by RASPA-3\n");
@@ -126,32 +228,18 @@ void PropertyDensityGrid::writeOutput(size_t systemId, [[maybe_unused]] const Si
       std::print(ostream, "{} {} {} {} {}\n", atomicNumber, charge, pos.x, pos.y, pos.z);
     }
 
-    std::vector<double>::iterator it_begin =
-        grid_cell.begin() + std::distance(&data_cell[0, 0, 0, 0], &data_cell[i, 0, 0, 0]);
-    std::vector<double>::iterator it_end = it_begin + static_cast<std::vector<double>::difference_type>(totalGridSize);
-
-    std::vector<double>::iterator maximum = std::max_element(it_begin, it_end);
-    double normalization{1.0};
-    if (maximum != it_end)
-    {
-      normalization = static_cast<double>(1.0 / *maximum);
-    }
-
-    for (std::vector<double>::iterator it = it_begin; it != it_end; ++it)
-    {
-      std::print(ostream, "{}\n", *it * normalization);
-    }
+    printCubeValues(ostream, std::span<const uint32_t>(&data_cell[i, 0, 0, 0], totalGridSize));
   }
 
   for (size_t i = 0; i < components.size(); ++i)
   {
-    for (size_t k = 0; k < frameworkComponents.size(); ++k)
+    for (size_t k = 0; k < std::min(frameworkComponents.size(), numberOfFrameworks); ++k)
     {
-      std::ofstream ostream(std::format("density_grids/grid_{}_component_{}.s{}.cube", frameworkComponents[k].name,
-                                        components[i].name, systemId));
+      std::ofstream ostream(std::format("{}/grid_{}_component_{}.s{}.cube", outputDirectory,
+                                        frameworkComponents[k].name, components[i].name, systemId));
 
-      std::vector<Atom> frameworkAtoms = frameworkComponents.front().unitCellAtoms;
-      double3x3 unitCell = frameworkComponents.front().simulationBox.cell;
+      std::vector<Atom> frameworkAtoms = frameworkComponents[k].unitCellAtoms;
+      double3x3 unitCell = frameworkComponents[k].simulationBox.cell;
 
       std::print(ostream, "Cube density file\n");
       std::print(ostream, "Written by RASPA-3\n");
@@ -173,22 +261,61 @@ void PropertyDensityGrid::writeOutput(size_t systemId, [[maybe_unused]] const Si
         std::print(ostream, "{} {} {} {} {}\n", atomicNumber, charge, pos.x, pos.y, pos.z);
       }
 
-      std::vector<double>::iterator it_begin =
-          grid_unitcell.begin() + std::distance(&data_unitcell[0, 0, 0, 0, 0], &data_unitcell[i, k, 0, 0, 0]);
-      std::vector<double>::iterator it_end =
-          it_begin + static_cast<std::vector<double>::difference_type>(totalGridSize);
+      printCubeValues(ostream, std::span<const uint32_t>(&data_unitcell[i, k, 0, 0, 0], totalGridSize));
+    }
+  }
+}
 
-      std::vector<double>::iterator maximum = std::max_element(it_begin, it_end);
-      double normalization{1.0};
-      if (maximum != it_end)
-      {
-        normalization = static_cast<double>(1.0 / *maximum);
-      }
+void PropertyDensityGrid::writeHDF5Output(size_t systemId, const SimulationBox &simulationBox,
+                                          const std::vector<Framework> &frameworkComponents,
+                                          const std::vector<Component> &components)
+{
+  std::mdspan<uint32_t, std::dextents<size_t, 4>> data_cell(grid_cell.data(), numberOfComponents, numberOfGridPoints.x,
+                                                            numberOfGridPoints.y, numberOfGridPoints.z);
+  std::mdspan<uint32_t, std::dextents<size_t, 5>> data_unitcell(grid_unitcell.data(), numberOfComponents,
+                                                                numberOfFrameworks, numberOfGridPoints.x,
+                                                                numberOfGridPoints.y, numberOfGridPoints.z);
+
+  const std::vector<size_t> dimensions{static_cast<size_t>(numberOfGridPoints.x),
+                                       static_cast<size_t>(numberOfGridPoints.y),
+                                       static_cast<size_t>(numberOfGridPoints.z)};
+  const std::vector<size_t> chunkDimensions{std::min(dimensions[0], 32uz), std::min(dimensions[1], 32uz),
+                                            std::min(dimensions[2], 32uz)};
+  const std::vector<std::pair<std::string, std::string>> gridMetadata{
+      {"dimensions", "(x, y, z)"}, {"description", "number of atoms binned per grid cell (row-major, z fastest)"}};
+  const std::vector<std::pair<std::string, std::string>> cellMetadata{
+      {"dimensions", "(3, 3)"}, {"description", "cell vectors a, b and c as rows"}, {"units", "Angstrom"}};
+
+  auto cellMatrix = [](const double3x3 &m) -> std::vector<double>
+  { return {m.ax, m.ay, m.az, m.bx, m.by, m.bz, m.cx, m.cy, m.cz}; };
+
+  HDF5Writer writer(std::format("{}/grid.s{}.h5", outputDirectory, systemId));
+  writer.writeMetaInfo("/", "numberOfSamples", std::format("{}", numberOfSamples));
+
+  writer.createGroup("/simulation_box");
+  writer.createDataset<double>("/simulation_box", "cell", {3, 3}, cellMetadata);
+  writer.writeVector("/simulation_box", "cell", cellMatrix(simulationBox.cell));
+  for (size_t i = 0; i < components.size(); ++i)
+  {
+    writer.createChunkedDataset<uint32_t>("/simulation_box", components[i].name, dimensions, chunkDimensions, 6,
+                                          gridMetadata);
+    writer.writeVector("/simulation_box", components[i].name,
+                       std::vector<uint32_t>(&data_cell[i, 0, 0, 0], &data_cell[i, 0, 0, 0] + totalGridSize));
+  }
 
-      for (std::vector<double>::iterator it = it_begin; it != it_end; ++it)
-      {
-        std::print(ostream, "{}\n", *it * normalization);
-      }
+  for (size_t k = 0; k < std::min(frameworkComponents.size(), numberOfFrameworks); ++k)
+  {
+    std::string groupName = std::format("/{}", frameworkComponents[k].name);
+    writer.createGroup(groupName);
+    writer.createDataset<double>(groupName, "cell", {3, 3}, cellMetadata);
+    writer.writeVector(groupName, "cell", cellMatrix(frameworkComponents[k].simulationBox.cell));
+    for (size_t i = 0; i < components.size(); ++i)
+    {
+      writer.createChunkedDataset<uint32_t>(groupName, components[i].name, dimensions, chunkDimensions, 6,
+                                            gridMetadata);
+      writer.writeVector(groupName, components[i].name,
+                         std::vector<uint32_t>(&data_unitcell[i, k, 0, 0, 0],
+                                               &data_unitcell[i, k, 0, 0, 0] + totalGridSize));
     }
   }
 }
@@ -207,6 +334,9 @@ Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const Proper
 
   archive << temp.sampleEvery;
   archive << temp.writeEvery;
+  archive << temp.densityGridPseudoAtomsList;
+  archive << temp.outputFormat;
+  archive << temp.numberOfSamples;
 
   return archive;
 }
@@ -215,7 +345,8 @@ Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, PropertyDens
 {
   uint64_t versionNumber;
   archive >> versionNumber;
-  if (versionNumber > temp.versionNumber)
+  // version 2 stored a single unit-cell grid shared by all frameworks
+  if (versionNumber != temp.versionNumber)
   {
     const std::source_location &location = std::source_location::current();
     throw std::runtime_error(std::format("Invalid version reading 'PropertyDensityGrid' at line {} in file {}\n",
@@ -232,6 +363,9 @@ Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, PropertyDens
 
   archive >> temp.sampleEvery;
   archive >> temp.writeEvery;
+  archive >> temp.densityGridPseudoAtomsList;
+  archive >> temp.outputFormat;
+  archive >> temp.numberOfSamples;
 
   return archive;
 }
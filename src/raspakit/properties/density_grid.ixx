@@ -3,7 +3,10 @@ module;
 #ifdef USE_LEGACY_HEADERS
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <fstream>
 #include <mdspan>
 #include <optional>
 #include <span>
@@ -16,8 +19,11 @@ export module property_density_grid;
 #ifndef USE_LEGACY_HEADERS
 import <vector>;
 import <array>;
+import <atomic>;
 import <optional>;
 import <cmath>;
+import <cstdint>;
+import <fstream>;
 import <string>;
 import <span>;
 import <algorithm>;
@@ -34,17 +40,35 @@ import forcefield;
 import framework;
 import component;
 
+/**
+ * \brief Histogram of the adsorbate positions on a grid over the simulation box and over the framework unit cell.
+ *
+ * The grids are stored as 32-bit counters, with one unit-cell grid per framework. With the thread pool enabled, the
+ * atoms are binned concurrently into the same grids using relaxed atomic increments, so no extra grid memory is
+ * needed. The output is either a set of Gaussian cube files (normalized to the maximum per grid) or a single chunked
+ * and compressed HDF5 file with the raw counts.
+ */
 export struct PropertyDensityGrid
 {
+  /**
+   * \brief Enumeration of the output formats of the density grids.
+   */
+  enum class OutputFormat : size_t
+  {
+    Cube = 0,  ///< One Gaussian cube file per component and grid.
+    HDF5 = 1   ///< One HDF5 file per system holding all grids.
+  };
+
   PropertyDensityGrid() {}
 
   PropertyDensityGrid(size_t numberOfFrameworks, size_t numberOfComponents, int3 numberOfGridPoints, size_t sampleEvery,
-                      size_t writeEvery, std::vector<size_t> densityGridPseudoAtomsList)
+                      size_t writeEvery, std::vector<size_t> densityGridPseudoAtomsList,
+                      OutputFormat outputFormat = OutputFormat::Cube)
       : numberOfFrameworks(numberOfFrameworks),
         numberOfComponents(numberOfComponents),
         grid_cell(numberOfComponents *
                   static_cast<size_t>(numberOfGridPoints.x * numberOfGridPoints.y * numberOfGridPoints.z)),
-        grid_unitcell(std::min(1uz, numberOfFrameworks) * numberOfComponents *
+        grid_unitcell(numberOfFrameworks * numberOfComponents *
                       static_cast<size_t>(numberOfGridPoints.x * numberOfGridPoints.y * numberOfGridPoints.z)),
         totalGridSize(static_cast<size_t>(numberOfGridPoints.x * numberOfGridPoints.y * numberOfGridPoints.z)),
         numberOfGridPoints(numberOfGridPoints),
@@ -52,28 +76,46 @@ export struct PropertyDensityGrid
                  static_cast<double>(numberOfGridPoints.z)),
         sampleEvery(sampleEvery),
         writeEvery(writeEvery),
-        densityGridPseudoAtomsList(densityGridPseudoAtomsList)
+        densityGridPseudoAtomsList(densityGridPseudoAtomsList),
+        outputFormat(outputFormat)
   {
   }
 
-  uint64_t versionNumber{1};
+  uint64_t versionNumber{3};
 
   size_t numberOfFrameworks;
   size_t numberOfComponents;
-  std::vector<double> grid_cell;
-  std::vector<double> grid_unitcell;
+  std::vector<uint32_t> grid_cell;
+  std::vector<uint32_t> grid_unitcell;
   size_t totalGridSize;
   int3 numberOfGridPoints;
   double3 gridSize;
   size_t sampleEvery;
   size_t writeEvery;
+  std::string outputDirectory{"density_grids"};
   std::vector<size_t> densityGridPseudoAtomsList;
+  OutputFormat outputFormat{OutputFormat::Cube};
+  size_t numberOfSamples{0};
+
+  // below this number of atoms per thread the binning is done serially
+  static constexpr size_t minimumNumberOfAtomsPerThread{256};
 
   void sample(const std::vector<Framework> &frameworks, const SimulationBox &simulationBox,
               std::span<const Atom> moleculeAtoms, size_t currrentCycle);
+
+  /**
+   * \brief Bins the atoms into the grids, using atomic increments when other threads bin into the same grids.
+   */
+  void binAtoms(const std::vector<Framework> &frameworks, const SimulationBox &simulationBox,
+                std::span<const Atom> atoms, bool concurrent);
+
   void writeOutput(size_t systemId, const SimulationBox &simulationBox, const ForceField &forceField,
                    const std::vector<Framework> &frameworkComponents, const std::vector<Component> &components,
                    size_t currentCycle);
+  void writeCubeOutput(size_t systemId, const SimulationBox &simulationBox, const ForceField &forceField,
+                       const std::vector<Framework> &frameworkComponents, const std::vector<Component> &components);
+  void writeHDF5Output(size_t systemId, const SimulationBox &simulationBox,
+                       const std::vector<Framework> &frameworkComponents, const std::vector<Component> &components);
 
   friend Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const PropertyDensityGrid &temp);
   friend Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, PropertyDensityGrid &temp);
@@ -81,6 +81,14 @@ export struct PropertyEnergy
     bookKeepingEnergyStatus[blockIndex].second += weight;
   }
 
+  void rebin(const std::vector<size_t> &boundaries)
+  {
+    bookKeepingEnergyStatus = rebinBlocks(
+        bookKeepingEnergyStatus, boundaries,
+        std::make_pair(EnergyStatus(numberOfExternalFields, numberOfFrameworks, numberOfComponents), 0.0), pair_sum);
+    numberOfBlocks = bookKeepingEnergyStatus.size();
+  }
+
   //====================================================================================================================
 
   EnergyStatus averagedEnergy(size_t blockIndex) const
@@ -7,6 +7,7 @@ module;
 #include <exception>
 #include <filesystem>
 #include <format>
+#include <functional>
 #include <fstream>
 #include <map>
 #include <print>
@@ -30,6 +31,7 @@ import <vector>;
 import <algorithm>;
 import <print>;
 import <format>;
+import <functional>;
 import <filesystem>;
 #endif
 
@@ -72,6 +74,19 @@ void PropertyEnergyHistogram::addSample(size_t blockIndex, size_t currentCycle,
   totalNumberOfCounts += weight;
 }
 
+void PropertyEnergyHistogram::rebin(const std::vector<size_t> &boundaries)
+{
+  bookKeepingEnergyHistogram = rebinBlocks(bookKeepingEnergyHistogram, boundaries, std::vector<double4>(numberOfBins),
+                                           [](std::vector<double4> lhs, const std::vector<double4> &rhs)
+                                           {
+                                             std::transform(lhs.begin(), lhs.end(), rhs.begin(), lhs.begin(),
+                                                            std::plus<>());
+                                             return lhs;
+                                           });
+  numberOfCounts = rebinBlocks(numberOfCounts, boundaries, 0.0, std::plus<>());
+  numberOfBlocks = numberOfCounts.size();
+}
+
 std::vector<double4> PropertyEnergyHistogram::averagedProbabilityHistogram(size_t blockIndex) const
 {
   std::vector<double4> averagedData(numberOfBins);
@@ -140,9 +155,9 @@ void PropertyEnergyHistogram::writeOutput(size_t systemId, size_t currentCycle)
 {
   if (currentCycle % writeEvery != 0uz) return;
 
-  std::filesystem::create_directory("energy_histogram");
+  std::filesystem::create_directories(outputDirectory);
 
-  std::ofstream stream_output(std::format("energy_histogram/energy_histogram.s{}.txt", systemId));
+  std::ofstream stream_output(std::format("{}/energy_histogram.s{}.txt", outputDirectory, systemId));
 
   stream_output << std::format("# energy_histogram, number of counts: {}\n", totalNumberOfCounts);
   stream_output << "# column 1: energy [K]\n";
@@ -65,11 +65,13 @@ export struct PropertyEnergyHistogram
   std::pair<double, double> range;
   size_t sampleEvery;
   size_t writeEvery;
+  std::string outputDirectory{"energy_histogram"};
   std::vector<std::vector<double4>> bookKeepingEnergyHistogram;
   std::vector<double> numberOfCounts;
   double totalNumberOfCounts{0.0};
 
   void addSample(size_t blockIndex, size_t currentCycle, double4 energy, const double &weight);
+  void rebin(const std::vector<size_t> &boundaries);
 
   std::vector<double4> averagedProbabilityHistogram(size_t blockIndex) const;
   std::vector<double4> averagedProbabilityHistogram() const;
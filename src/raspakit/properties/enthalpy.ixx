@@ -74,6 +74,14 @@ export struct PropertyEnthalpy
     bookKeepingEnthalpyOfAdsorptionTerms[blockIndex].second += weight;
   }
 
+  void rebin(const std::vector<size_t> &boundaries)
+  {
+    bookKeepingEnthalpyOfAdsorptionTerms =
+        rebinBlocks(bookKeepingEnthalpyOfAdsorptionTerms, boundaries,
+                    std::make_pair(EnthalpyOfAdsorptionTerms(numberOfComponents), 0.0), pair_sum);
+    numberOfBlocks = bookKeepingEnthalpyOfAdsorptionTerms.size();
+  }
+
   //====================================================================================================================
 
   EnthalpyOfAdsorption averagedEnthalpy(size_t blockIndex) const
@@ -7,6 +7,7 @@ module;
 #include <complex>
 #include <format>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <numbers>
@@ -30,6 +31,7 @@ import <cmath>;
 import <string>;
 import <sstream>;
 import <fstream>;
+import <functional>;
 import <format>;
 import <algorithm>;
 import <numeric>;
@@ -49,6 +51,25 @@ import stringutils;
 import averages;
 import json;
 
+void PropertyLambdaProbabilityHistogram::rebin(const std::vector<size_t> &boundaries)
+{
+  bookKeepingLambda = rebinBlocks(bookKeepingLambda, boundaries, std::vector<double>(numberOfSamplePoints),
+                                  [](std::vector<double> lhs, const std::vector<double> &rhs)
+                                  {
+                                    std::transform(lhs.begin(), lhs.end(), rhs.begin(), lhs.begin(), std::plus<>());
+                                    return lhs;
+                                  });
+  bookKeepingDensity = rebinBlocks(bookKeepingDensity, boundaries, std::make_pair(0.0, 0.0), pair_sum);
+  bookKeepingDUdlambda =
+      rebinBlocks(bookKeepingDUdlambda, boundaries, std::vector<std::pair<double3, double>>(numberOfSamplePoints),
+                  [](std::vector<std::pair<double3, double>> lhs, const std::vector<std::pair<double3, double>> &rhs)
+                  {
+                    std::transform(lhs.begin(), lhs.end(), rhs.begin(), lhs.begin(), pair_sum_double3);
+                    return lhs;
+                  });
+  numberOfBlocks = bookKeepingDensity.size();
+}
+
 void PropertyLambdaProbabilityHistogram::WangLandauIteration(PropertyLambdaProbabilityHistogram::WangLandauPhase phase,
                                                              bool containsTheFractionalMolecule,
                                                              [[maybe_unused]] double value)
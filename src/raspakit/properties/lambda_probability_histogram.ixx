@@ -175,6 +175,8 @@ export struct PropertyLambdaProbabilityHistogram
     bookKeepingDensity[blockIndex].second += w;
   }
 
+  void rebin(const std::vector<size_t> &boundaries);
+
   inline double weight() const { return std::exp(-biasFactor[currentBin]); }
 
   void WangLandauIteration(PropertyLambdaProbabilityHistogram::WangLandauPhase phase,
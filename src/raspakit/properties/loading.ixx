@@ -74,6 +74,13 @@ export struct PropertyLoading
     bookKeepingLoadings[blockIndex].second += weight;
   }
 
+  void rebin(const std::vector<size_t> &boundaries)
+  {
+    bookKeepingLoadings =
+        rebinBlocks(bookKeepingLoadings, boundaries, std::make_pair(Loadings(numberOfComponents), 0.0), pair_sum);
+    numberOfBlocks = bookKeepingLoadings.size();
+  }
+
   //====================================================================================================================
 
   Loadings averagedLoading(size_t blockIndex) const
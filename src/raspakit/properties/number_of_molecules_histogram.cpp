@@ -112,6 +112,21 @@ void PropertyNumberOfMoleculesHistogram::addSample(size_t blockIndex, size_t cur
   totalNumberOfCounts += weight;
 }
 
+void PropertyNumberOfMoleculesHistogram::rebin(const std::vector<size_t> &boundaries)
+{
+  bookKeepingEnergyHistogram =
+      rebinBlocks(bookKeepingEnergyHistogram, boundaries,
+                  std::vector<std::vector<double>>(numberOfBins, std::vector<double>(size)),
+                  [](std::vector<std::vector<double>> lhs, const std::vector<std::vector<double>> &rhs)
+                  {
+                    std::transform(lhs.begin(), lhs.end(), rhs.begin(), lhs.begin(),
+                                   [](const std::vector<double> &a, const std::vector<double> &b) { return a + b; });
+                    return lhs;
+                  });
+  numberOfCounts = rebinBlocks(numberOfCounts, boundaries, 0.0, [](double a, double b) { return a + b; });
+  numberOfBlocks = numberOfCounts.size();
+}
+
 std::vector<std::vector<double>> PropertyNumberOfMoleculesHistogram::averagedProbabilityHistogram(
     size_t blockIndex) const
 {
@@ -187,10 +202,10 @@ void PropertyNumberOfMoleculesHistogram::writeOutput(size_t systemId, std::vecto
 {
   if (currentCycle % writeEvery != 0uz) return;
 
-  std::filesystem::create_directory("number_of_molecules_histogram");
+  std::filesystem::create_directories(outputDirectory);
 
   std::ofstream stream_output(
-      std::format("number_of_molecules_histogram/number_of_molecules_histogram_histogram.s{}.txt", systemId));
+      std::format("{}/number_of_molecules_histogram_histogram.s{}.txt", outputDirectory, systemId));
 
   stream_output << std::format("# number_of_molecules_histogram, number of counts: {}\n", totalNumberOfCounts);
   stream_output << "# column 1: number of molecules [-]\n";
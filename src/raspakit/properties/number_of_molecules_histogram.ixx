@@ -68,12 +68,14 @@ export struct PropertyNumberOfMoleculesHistogram
   size_t size;
   size_t sampleEvery;
   size_t writeEvery;
+  std::string outputDirectory{"number_of_molecules_histogram"};
   std::vector<std::vector<std::vector<double>>> bookKeepingEnergyHistogram;
   std::vector<double> numberOfCounts;
   double totalNumberOfCounts{0.0};
 
   void addSample(size_t blockIndex, size_t currentCycle, std::vector<size_t> numberOfIntegerMoleculesPerComponent,
                  const double &weight);
+  void rebin(const std::vector<size_t> &boundaries);
 
   std::vector<std::vector<double>> averagedProbabilityHistogram(size_t blockIndex) const;
   std::vector<std::vector<double>> averagedProbabilityHistogram() const;
@@ -75,6 +75,16 @@ export struct PropertyPressure
     bookKeepingExcessPressure[blockIndex].second += weight;
   }
 
+  void rebin(const std::vector<size_t> &boundaries)
+  {
+    bookKeepingIdealGasPressure =
+        rebinBlocks(bookKeepingIdealGasPressure, boundaries, std::make_pair(0.0, 0.0), pair_acc_pressure);
+    bookKeepingExcessPressure =
+        rebinBlocks(bookKeepingExcessPressure, boundaries,
+                    std::make_pair(double3x3(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), 0.0), pair_acc_pressure2);
+    numberOfBlocks = bookKeepingExcessPressure.size();
+  }
+
   //====================================================================================================================
 
   double3x3 averagedExcessPressureTensor(size_t blockIndex) const
@@ -68,6 +68,7 @@ export struct PropertyRadialDistributionFunction
   double deltaR;
   size_t sampleEvery;
   size_t writeEvery;
+  std::string outputDirectory{"rdf"};
   std::vector<std::vector<double>> sumProperty;
   size_t totalNumberOfCounts;
   std::vector<size_t> numberOfCounts;
@@ -75,6 +76,7 @@ export struct PropertyRadialDistributionFunction
 
   void sample(const SimulationBox &simulationBox, std::span<Atom> frameworkAtoms,
               const std::vector<Molecule> &molecules, std::span<Atom> moleculeAtoms, size_t currentCycle, size_t block);
+  void rebin(const std::vector<size_t> &boundaries);
   void writeOutput(const ForceField &forceField, size_t systemId, double volume,
                    std::vector<size_t> &numberOfPseudoAtomsType, size_t currentCycle);
 
@@ -9,6 +9,7 @@ module;
 #include <span>
 #include <streambuf>
 #include <string>
+#include <utility>
 #include <vector>
 #endif
 
@@ -16,6 +17,7 @@ module sample_movies;
 
 #ifndef USE_LEGACY_HEADERS
 import <string>;
+import <utility>;
 import <vector>;
 import <span>;
 import <iostream>;
@@ -34,10 +36,11 @@ import forcefield;
 import units;
 import skelement;
 
-SampleMovie::SampleMovie(size_t systemId, size_t sampleEvery) : sampleEvery(sampleEvery)
+SampleMovie::SampleMovie(size_t systemId, size_t sampleEvery, std::string outputDirectory)
+    : sampleEvery(sampleEvery), outputDirectory(std::move(outputDirectory))
 {
-  std::filesystem::create_directory("movies");
-  std::ofstream stream(std::format("movies/movie.s{}.pdb", systemId));
+  std::filesystem::create_directories(this->outputDirectory);
+  std::ofstream stream(std::format("{}/movie.s{}.pdb", this->outputDirectory, systemId));
 }
 
 void SampleMovie::update(const ForceField &forceField, size_t systemId, const SimulationBox simulationBox,
@@ -45,8 +48,8 @@ void SampleMovie::update(const ForceField &forceField, size_t systemId, const Si
 {
   if (currentCycle % sampleEvery == 0)
   {
-    std::filesystem::create_directory("movies");
-    std::ofstream stream(std::format("movies/movie.s{}.pdb", systemId), std::ios_base::app);
+    std::filesystem::create_directories(outputDirectory);
+    std::ofstream stream(std::format("{}/movie.s{}.pdb", outputDirectory, systemId), std::ios_base::app);
 
     std::print(stream, "MODEL {:>4}\n", modelNumber);
     std::print(stream, "CRYST1{:9.3f}{:9.3f}{:9.3f}{:7.2f}{:7.2f}{:7.2f}\n", simulationBox.lengthA,
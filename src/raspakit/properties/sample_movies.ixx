@@ -26,12 +26,13 @@ import forcefield;
 
 export struct SampleMovie
 {
-  SampleMovie(size_t systemId, size_t sampleEvery);
+  SampleMovie(size_t systemId, size_t sampleEvery, std::string outputDirectory = "movies");
 
   void update(const ForceField &forceField, size_t systemId, const SimulationBox simulationBox,
               const std::span<Atom> atomPositions, size_t currentCycle);
 
   size_t sampleEvery{10};
+  std::string outputDirectory{"movies"};
 
   int modelNumber{1};
 };
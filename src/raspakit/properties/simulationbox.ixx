@@ -62,6 +62,13 @@ export struct PropertySimulationBox
     bookKeepingSimulationBox[blockIndex].second += weight;
   }
 
+  void rebin(const std::vector<size_t> &boundaries)
+  {
+    bookKeepingSimulationBox =
+        rebinBlocks(bookKeepingSimulationBox, boundaries, std::make_pair(SimulationBox(), 0.0), pair_sum);
+    numberOfBlocks = bookKeepingSimulationBox.size();
+  }
+
   //====================================================================================================================
 
   SimulationBox averagedSimulationBox(size_t blockIndex) const
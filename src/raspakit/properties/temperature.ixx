@@ -59,6 +59,12 @@ export struct PropertyTemperature
     bookKeepingTemperature[blockIndex].second += weight;
   }
 
+  void rebin(const std::vector<size_t> &boundaries)
+  {
+    bookKeepingTemperature = rebinBlocks(bookKeepingTemperature, boundaries, std::make_pair(0.0, 0.0), pair_sum);
+    numberOfBlocks = bookKeepingTemperature.size();
+  }
+
   //====================================================================================================================
 
   double averagedTemperature(size_t blockIndex) const
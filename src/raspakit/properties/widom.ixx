@@ -71,6 +71,13 @@ export struct PropertyWidom
     bookKeepingDensity[blockIndex].second += weight;
   }
 
+  void rebin(const std::vector<size_t> &boundaries)
+  {
+    bookKeepingWidom = rebinBlocks(bookKeepingWidom, boundaries, std::make_pair(0.0, 0.0), pair_acc_widom);
+    bookKeepingDensity = rebinBlocks(bookKeepingDensity, boundaries, std::make_pair(0.0, 0.0), pair_acc_widom);
+    numberOfBlocks = bookKeepingWidom.size();
+  }
+
   //====================================================================================================================
 
   double averagedRosenbluthWeight(size_t blockIndex) const
@@ -4,16 +4,22 @@ module;
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <mdspan>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <print>
 #include <span>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <vector>
 #endif
@@ -36,6 +42,12 @@ import <chrono>;
 import <type_traits>;
 import <print>;
 import <mdspan>;
+import <exception>;
+import <functional>;
+import <future>;
+import <thread>;
+import <mutex>;
+import <optional>;
 #endif
 
 import stringutils;
@@ -44,12 +56,17 @@ import component;
 import system;
 import simulationbox;
 import mixture_prediction;
+import threadpool;
+import hdf5;
 
 // TODO: move std::span to std::mdarray in C++26
 // TODO: move cachedP0 and cachedPsi to submdspan in C++26
 
 const double R = 8.31446261815324;
 
+// the HDF5-library is in general not built thread-safe, while systems may run concurrently
+static std::mutex hdf5Mutex;
+
 inline double maxVectorDifference(const std::vector<double> &v, const std::vector<double> &w)
 {
   if (v.empty() || w.empty()) return 0.0;
@@ -97,6 +114,12 @@ Breakthrough::Breakthrough(System &system)
       dt(system.columnTimeStep),
       Nsteps(system.columnNumberOfTimeSteps),
       autoSteps(system.columnAutoNumberOfTimeSteps),
+      integrator(system.columnIntegrator),
+      relativeTolerance(system.columnRelativeTolerance),
+      absoluteTolerance(system.columnAbsoluteTolerance),
+      maximumTimeStep(system.columnMaximumTimeStep),
+      convectionScheme(system.columnConvectionScheme),
+      outputFormat(system.columnOutputFormat),
       mixture(system),
       prefactor(Ncomp),
       Yi(Ncomp),
@@ -126,7 +149,19 @@ Breakthrough::Breakthrough(System &system)
       Dqdtnew_vector((Ngrid + 1) * Ncomp),
       Dqdtnew(Dqdtnew_vector.data(), Ngrid + 1, Ncomp),
       cachedP0((Ngrid + 1) * Ncomp * system.maxIsothermTerms),
-      cachedPsi((Ngrid + 1) * system.maxIsothermTerms)
+      cachedPsi((Ngrid + 1) * system.maxIsothermTerms),
+      Perror_vector((Ngrid + 1) * Ncomp),
+      Perror(Perror_vector.data(), Ngrid + 1, Ncomp),
+      Qerror_vector((Ngrid + 1) * Ncomp),
+      Qerror(Qerror_vector.data(), Ngrid + 1, Ncomp),
+      dQeqdP_vector((Ngrid + 1) * Ncomp * Ncomp),
+      dQeqdP(dQeqdP_vector.data(), Ngrid + 1, Ncomp, Ncomp),
+      blockFactors((Ngrid + 1) * 4 * Ncomp * Ncomp),
+      blockPivots((Ngrid + 1) * 2 * Ncomp),
+      lowerCoupling((Ngrid + 1) * Ncomp),
+      upperCoupling((Ngrid + 1) * Ncomp),
+      k1((Ngrid + 1) * 2 * Ncomp),
+      k2((Ngrid + 1) * 2 * Ncomp)
 {
   // precomputed factor for mass transfer
   for (size_t j = 0; j < Ncomp; ++j)
@@ -134,6 +169,17 @@ Breakthrough::Breakthrough(System &system)
     prefactor[j] = R * T * ((1.0 - epsilon) / epsilon) * rho_p * components[j].massTransferCoefficient;
   }
 
+  // one workspace for each thread that computes equilibrium loadings
+  auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+  const size_t numberOfHelperThreads =
+      pool.getThreadingType() == ThreadPool::ThreadingType::ThreadPool ? pool.getThreadCount() : 0;
+  for (size_t i = 0; i < numberOfHelperThreads + 1; ++i)
+  {
+    workspaces.push_back({std::vector<double>(Ncomp), std::vector<double>(Ncomp), std::vector<double>(Ncomp),
+                          std::vector<double>(Ncomp), std::vector<double>(Ncomp * system.maxIsothermTerms),
+                          std::vector<double>(system.maxIsothermTerms), mixture.createWorkspace()});
+  }
+
   // set P and Q to zero
   std::fill(P_vector.begin(), P_vector.end(), 0.0);
   std::fill(Q_vector.begin(), Q_vector.end(), 0.0);
@@ -234,7 +280,39 @@ std::string Breakthrough::writeHeader()
 
   std::print(stream, "Integration details\n");
   std::print(stream, "=======================================================\n");
-  std::print(stream, "Time step:                     {} [s]\n", dt);
+  switch (integrator)
+  {
+    case System::ColumnIntegrator::SSP_RK:
+    default:
+      std::print(stream, "Integrator:                    SSP-RK3 (fixed time step)\n");
+      std::print(stream, "Time step:                     {} [s]\n", dt);
+      break;
+    case System::ColumnIntegrator::AdaptiveSSP_RK:
+    case System::ColumnIntegrator::Rosenbrock:
+      std::print(stream, "Integrator:                    {} (adaptive time step)\n",
+                 integrator == System::ColumnIntegrator::Rosenbrock ? "Rosenbrock ROS2" : "SSP-RK3(2)");
+      std::print(stream, "Initial time step:             {} [s]\n", dt);
+      std::print(stream, "Relative tolerance:            {} [-]\n", relativeTolerance);
+      std::print(stream, "Absolute tolerance:            {} [-]\n", absoluteTolerance);
+      if (maximumTimeStep > 0.0)
+      {
+        std::print(stream, "Maximum time step:             {} [s]\n", maximumTimeStep);
+      }
+      break;
+  }
+  switch (convectionScheme)
+  {
+    case System::ColumnConvectionScheme::Upwind:
+    default:
+      std::print(stream, "Convection scheme:             first-order upwind\n");
+      break;
+    case System::ColumnConvectionScheme::VanLeer:
+      std::print(stream, "Convection scheme:             TVD (van Leer limiter)\n");
+      break;
+    case System::ColumnConvectionScheme::WENO3:
+      std::print(stream, "Convection scheme:             WENO3\n");
+      break;
+  }
   std::print(stream, "Number of column grid points:  {} [-]\n", Ngrid);
   std::print(stream, "Column spacing:                {} [m]\n", dx);
   std::print(stream, "\n\n");
@@ -264,11 +342,130 @@ void Breakthrough::run(std::ostream &stream)
     streams.emplace_back(std::ofstream{fileName});
   }
 
-  std::ofstream movieStream(std::format("Breakthrough/System_{}/column.txt", system.systemId));
+  // the column profiles are written as text (read by the movie scripts), or buffered and appended per chunk of
+  // snapshots to the time x grid x component datasets of an HDF5-file
+  const bool writeHDF5 = outputFormat == System::ColumnOutputFormat::HDF5;
+  const size_t chunkSize = 16;
+  const size_t gridSize = (Ngrid + 1) * Ncomp;
+  const std::string columnGroup = "/column";
+  const std::vector<std::string> gridNames{"Q", "Qeq", "P", "Dpdt", "Dqdt"};
+  std::ofstream movieStream;
+  std::optional<HDF5Writer> columnFile;
+  // the file is closed under the lock as well when the integration throws
+  struct ColumnFileCloser
+  {
+    std::optional<HDF5Writer> &file;
+    ~ColumnFileCloser()
+    {
+      std::lock_guard<std::mutex> lock(hdf5Mutex);
+      file.reset();
+    }
+  } columnFileCloser{columnFile};
+  size_t numberOfBufferedSnapshots = 0;
+  std::vector<double> timeBuffer;
+  std::vector<double> velocityBuffer;
+  std::vector<double> totalPressureBuffer;
+  std::vector<std::vector<double>> gridBuffers(gridNames.size());
+  const std::vector<const std::vector<double> *> gridVectors{&Q_vector, &Qeq_vector, &P_vector, &Dpdt_vector,
+                                                             &Dqdt_vector};
+  auto flushSnapshots = [&]()
+  {
+    if (numberOfBufferedSnapshots == 0) return;
+    std::lock_guard<std::mutex> lock(hdf5Mutex);
+    columnFile->appendSlices(columnGroup, "time", timeBuffer);
+    columnFile->appendSlices(columnGroup, "V", velocityBuffer);
+    columnFile->appendSlices(columnGroup, "Pt", totalPressureBuffer);
+    for (size_t k = 0; k < gridNames.size(); ++k)
+    {
+      columnFile->appendSlices(columnGroup, gridNames[k], gridBuffers[k]);
+      gridBuffers[k].clear();
+    }
+    timeBuffer.clear();
+    velocityBuffer.clear();
+    totalPressureBuffer.clear();
+    numberOfBufferedSnapshots = 0;
+  };
+
+  if (writeHDF5)
+  {
+    std::lock_guard<std::mutex> lock(hdf5Mutex);
+    columnFile.emplace(std::format("Breakthrough/System_{}/column.h5", system.systemId));
+    columnFile->writeMetaInfo("/", "temperature", T);
+    columnFile->writeMetaInfo("/", "columnLength", L);
+    columnFile->writeMetaInfo("/", "totalPressure", p_total);
+    columnFile->writeMetaInfo("/", "entranceVelocity", v_in);
+    columnFile->writeMetaInfo("/", "numberOfGridPoints", Ngrid + 1);
+    columnFile->writeMetaInfo("/", "numberOfComponents", Ncomp);
+
+    columnFile->createGroup(columnGroup);
+    std::vector<double> z(Ngrid + 1);
+    for (size_t i = 0; i < Ngrid + 1; ++i)
+    {
+      z[i] = static_cast<double>(i) * dx;
+    }
+    columnFile->createDataset<double>(columnGroup, "z", {Ngrid + 1},
+                                      {{"about", "column position"}, {"unit", "m"}, {"dimensions", "(grid)"}});
+    columnFile->writeVector(columnGroup, "z", z);
+
+    std::vector<std::string> names;
+    std::vector<double> molFractions;
+    size_t maxLength = 1;
+    for (const Component &component : components)
+    {
+      names.push_back(component.name);
+      molFractions.push_back(component.molFraction);
+      maxLength = std::max(maxLength, component.name.size() + 1);
+    }
+    columnFile->createStringDataset(columnGroup, "components", {Ncomp}, maxLength);
+    columnFile->writeVector(columnGroup, "components", names);
+    columnFile->createDataset<double>(columnGroup, "molFractions", {Ncomp},
+                                      {{"about", "gas-phase mol-fraction at the entrance"}, {"dimensions", "(comp)"}});
+    columnFile->writeVector(columnGroup, "molFractions", molFractions);
+
+    columnFile->createExtendableDataset<double>(columnGroup, "time", {}, chunkSize, 6,
+                                                {{"unit", "s"}, {"dimensions", "(time)"}});
+    columnFile->createExtendableDataset<double>(
+        columnGroup, "V", {Ngrid + 1}, chunkSize, 6,
+        {{"about", "interstitial velocity"}, {"unit", "m/s"}, {"dimensions", "(time, grid)"}});
+    columnFile->createExtendableDataset<double>(
+        columnGroup, "Pt", {Ngrid + 1}, chunkSize, 6,
+        {{"about", "total pressure"}, {"unit", "Pa"}, {"dimensions", "(time, grid)"}});
+    const std::vector<std::pair<std::string, std::string>> gridAbout{{"loading", "mol/kg"},
+                                                                      {"equilibrium loading", "mol/kg"},
+                                                                      {"partial pressure", "Pa"},
+                                                                      {"derivative of P with time", "Pa/s"},
+                                                                      {"derivative of Q with time", "mol/kg/s"}};
+    for (size_t k = 0; k < gridNames.size(); ++k)
+    {
+      columnFile->createExtendableDataset<double>(columnGroup, gridNames[k], {Ngrid + 1, Ncomp}, chunkSize, 6,
+                                                  {{"about", gridAbout[k].first},
+                                                   {"unit", gridAbout[k].second},
+                                                   {"dimensions", "(time, grid, comp)"}});
+    }
+  }
+  else
+  {
+    movieStream.open(std::format("Breakthrough/System_{}/column.txt", system.systemId));
+  }
 
-  for (size_t step = 0; (step < Nsteps || autoSteps); ++step)
+  // the adaptive integrators write and print at the time intervals of the fixed time step
+  const bool adaptive = integrator != System::ColumnIntegrator::SSP_RK;
+  const double writeInterval = static_cast<double>(writeEvery) * dt;
+  const double printInterval = static_cast<double>(printEvery) * dt;
+  double nextWriteTime = 0.0;
+  double nextPrintTime = 0.0;
+  double endTime = static_cast<double>(Nsteps) * dt;
+  double h = dt;
+  double t = 0.0;
+  size_t numberOfRejectedSteps = 0;
+
+  size_t step = 0;
+  for (; (adaptive ? t < endTime : step < Nsteps) || autoSteps; ++step)
   {
-    double t = static_cast<double>(step) * dt;
+    if (!adaptive)
+    {
+      t = static_cast<double>(step) * dt;
+    }
 
     // pulse boundary condition
     if (pulse == true)
@@ -289,8 +486,10 @@ void Breakthrough::run(std::ostream &stream)
       }
     }
 
-    if (step % writeEvery == 0)
+    if (adaptive ? t >= nextWriteTime : step % writeEvery == 0)
     {
+      nextWriteTime = (std::floor(t / writeInterval) + 1.0) * writeInterval;
+
       // write breakthrough output to files
       // column 1: dimensionless time
       // column 2: time [minutes]
@@ -298,44 +497,64 @@ void Breakthrough::run(std::ostream &stream)
       for (size_t j = 0; j < Ncomp; ++j)
       {
         streams[j] << t * v_in / L << " " << t / 60.0 << " "
-                   << P[Ngrid, j] / ((p_total + dptdx * L) * components[j].molFraction) << std::endl;
+                   << P[Ngrid, j] / ((p_total + dptdx * L) * components[j].molFraction) << "\n";
       }
 
-      size_t column_nr = 1;
-      movieStream << "# column " << column_nr++ << ": z  (column position)" << std::endl;
-      movieStream << "# column " << column_nr++ << ": V  (velocity)" << std::endl;
-      movieStream << "# column " << column_nr++ << ": Pt (total pressure)" << std::endl;
-      for (size_t j = 0; j < Ncomp; ++j)
+      if (writeHDF5)
       {
-        movieStream << "# column " << column_nr++ << ": component " << j << " Q     (loading)\n";
-        movieStream << "# column " << column_nr++ << ": component " << j << " Qeq   (equilibrium loading)\n";
-        movieStream << "# column " << column_nr++ << ": component " << j << " P     (partial pressure)\n";
-        movieStream << "# column " << column_nr++ << ": component " << j << " Pnorm (normalized partial pressure)\n";
-        movieStream << "# column " << column_nr++ << ": component " << j << " Dpdt  (derivative P with t)\n";
-        movieStream << "# column " << column_nr++ << ": component " << j << " Dqdt  (derivative Q with t)\n";
+        timeBuffer.push_back(t);
+        velocityBuffer.insert(velocityBuffer.end(), V.begin(), V.end());
+        totalPressureBuffer.insert(totalPressureBuffer.end(), Pt.begin(), Pt.end());
+        for (size_t k = 0; k < gridNames.size(); ++k)
+        {
+          gridBuffers[k].insert(gridBuffers[k].end(), gridVectors[k]->begin(), gridVectors[k]->begin() + gridSize);
+        }
+        if (++numberOfBufferedSnapshots == chunkSize) flushSnapshots();
       }
-
-      for (size_t i = 0; i < Ngrid + 1; ++i)
+      else
       {
-        movieStream << static_cast<double>(i) * dx << " ";
-        movieStream << V[i] << " ";
-        movieStream << Pt[i] << " ";
+        size_t column_nr = 1;
+        movieStream << "# column " << column_nr++ << ": z  (column position)\n";
+        movieStream << "# column " << column_nr++ << ": V  (velocity)\n";
+        movieStream << "# column " << column_nr++ << ": Pt (total pressure)\n";
         for (size_t j = 0; j < Ncomp; ++j)
         {
-          movieStream << Q[i, j] << " " << Qeq[i, j] << " " << P[i, j] << " "
-                      << P[i, j] / (Pt[i] * components[j].molFraction) << " " << Dpdt[i, j] << " " << Dqdt[i, j] << " ";
+          movieStream << "# column " << column_nr++ << ": component " << j << " Q     (loading)\n";
+          movieStream << "# column " << column_nr++ << ": component " << j << " Qeq   (equilibrium loading)\n";
+          movieStream << "# column " << column_nr++ << ": component " << j << " P     (partial pressure)\n";
+          movieStream << "# column " << column_nr++ << ": component " << j << " Pnorm (normalized partial pressure)\n";
+          movieStream << "# column " << column_nr++ << ": component " << j << " Dpdt  (derivative P with t)\n";
+          movieStream << "# column " << column_nr++ << ": component " << j << " Dqdt  (derivative Q with t)\n";
         }
-        movieStream << "\n";
+
+        for (size_t i = 0; i < Ngrid + 1; ++i)
+        {
+          movieStream << static_cast<double>(i) * dx << " ";
+          movieStream << V[i] << " ";
+          movieStream << Pt[i] << " ";
+          for (size_t j = 0; j < Ncomp; ++j)
+          {
+            movieStream << Q[i, j] << " " << Qeq[i, j] << " " << P[i, j] << " "
+                        << P[i, j] / (Pt[i] * components[j].molFraction) << " " << Dpdt[i, j] << " " << Dqdt[i, j]
+                        << " ";
+          }
+          movieStream << "\n";
+        }
+        movieStream << "\n\n";
       }
-      movieStream << "\n\n";
     }
 
-    if (step % printEvery == 0)
+    if (adaptive ? t >= nextPrintTime : step % printEvery == 0)
     {
+      nextPrintTime = (std::floor(t / printInterval) + 1.0) * printInterval;
       std::print(stream, "Timestep {}, time: {} [s]\n", std::to_string(step), std::to_string(t));
       std::print(
           stream, "    Average number of mixture-prediction steps: {}\n",
           std::to_string(static_cast<double>(iastPerformance.first) / static_cast<double>(iastPerformance.second)));
+      if (adaptive)
+      {
+        std::print(stream, "    Time step: {} [s], rejected steps: {}\n", h, numberOfRejectedSteps);
+      }
     }
 
     // check if we can set the expected end-time based on 10% longer time than when all
@@ -355,118 +574,283 @@ void Breakthrough::run(std::ostream &stream)
       {
         std::print(stream, "\nConvergence criteria reached, running 10% longer\n\n");
         Nsteps = static_cast<size_t>(1.1 * static_cast<double>(step));
+        endTime = 1.1 * t;
         autoSteps = false;
       }
     }
 
-    // SSP-RK Step 1
-    // ======================================================================
-
-    // calculate the derivatives Dq/dt and Dp/dt based on Qeq, Q, V, and P
-    computeFirstDerivatives(Dqdt, Dpdt, Qeq, Q, V, P);
-
-    // Dqdt and Dpdt are calculated at old time step
-    // make estimate for the new loadings and new gas phase partial pressures
-    // first iteration is made using the Explicit Euler scheme
-    for (size_t i = 0; i < Ngrid + 1; ++i)
+    switch (integrator)
     {
-      for (size_t j = 0; j < Ncomp; ++j)
+      case System::ColumnIntegrator::SSP_RK:
+      default:
+        computeSSPRKStep(dt);
+        break;
+      case System::ColumnIntegrator::AdaptiveSSP_RK:
+      case System::ColumnIntegrator::Rosenbrock:
       {
-        Qnew[i, j] = Q[i, j] + dt * Dqdt[i, j];
-        Pnew[i, j] = P[i, j] + dt * Dpdt[i, j];
+        // error-per-step control with the embedded lower-order solution:
+        // SSP-RK3 with the embedded SSP-RK2 (Heun) solution, and ROS2 with the embedded first-order solution
+        const double exponent = integrator == System::ColumnIntegrator::Rosenbrock ? 1.0 / 2.0 : 1.0 / 3.0;
+        if (integrator == System::ColumnIntegrator::Rosenbrock)
+        {
+          // f(y_n) and the Jacobian only depend on the current state, so rejected attempts reuse them
+          prepareRosenbrockStep();
+        }
+        while (true)
+        {
+          if (maximumTimeStep > 0.0) h = std::min(h, maximumTimeStep);
+
+          // the last step ends exactly at the end time, like the fixed time step does
+          const bool lastStep = !autoSteps && t + h >= endTime;
+          if (lastStep) h = endTime - t;
+
+          if (integrator == System::ColumnIntegrator::Rosenbrock)
+          {
+            computeRosenbrockStep(h);
+          }
+          else
+          {
+            computeSSPRKStep(h);
+          }
+
+          double error = errorNorm();
+          double factor = error > 0.0 ? std::clamp(0.9 * std::pow(error, -exponent), 0.2, 5.0) : 5.0;
+          if (error <= 1.0 && std::isfinite(error))
+          {
+            t = lastStep ? endTime : t + h;
+            h *= factor;
+            break;
+          }
+
+          ++numberOfRejectedSteps;
+          h *= std::isfinite(error) ? std::min(factor, 0.9) : 0.2;
+          if (h < 1e-12 * dt)
+          {
+            throw std::runtime_error(std::format("Error [Breakthrough]: time step underflow at time {} [s]\n", t));
+          }
+        }
+        break;
       }
     }
 
-    computeEquilibriumLoadings();
+    acceptStep();
+  }
+
+  if (writeHDF5)
+  {
+    flushSnapshots();
+  }
 
-    computeVelocity();
+  std::cout << "Final timestep " + std::to_string(step) +
+                   ", time: " + std::to_string(adaptive ? t : dt * static_cast<double>(step)) + " [s]"
+            << std::endl;
+}
 
-    // SSP-RK Step 2
-    // ======================================================================
+// one step of the third-order strong-stability-preserving Runge-Kutta method (Shu-Osher form)
+// the difference with the embedded second-order solution (Heun) is stored as the local error estimate
+void Breakthrough::computeSSPRKStep(double h)
+{
+  // SSP-RK Step 1
+  // ======================================================================
 
-    // calculate new derivatives at new (current) timestep
-    // calculate the derivatives Dq/dt and Dp/dt based on Qeq, Q, V, and P at new (current) timestep
-    computeFirstDerivatives(Dqdtnew, Dpdtnew, Qeqnew, Qnew, Vnew, Pnew);
+  // calculate the derivatives Dq/dt and Dp/dt based on Qeq, Q, V, and P
+  computeFirstDerivatives(Dqdt, Dpdt, Qeq, Q, V, P);
 
-    for (size_t i = 0; i < Ngrid + 1; ++i)
+  // Dqdt and Dpdt are calculated at old time step
+  // make estimate for the new loadings and new gas phase partial pressures
+  // first iteration is made using the Explicit Euler scheme
+  for (size_t i = 0; i < Ngrid + 1; ++i)
+  {
+    for (size_t j = 0; j < Ncomp; ++j)
     {
-      for (size_t j = 0; j < Ncomp; ++j)
-      {
-        Qnew[i, j] = 0.75 * Q[i, j] + 0.25 * Qnew[i, j] + 0.25 * dt * Dqdtnew[i, j];
-        Pnew[i, j] = 0.75 * P[i, j] + 0.25 * Pnew[i, j] + 0.25 * dt * Dpdtnew[i, j];
-      }
+      Qnew[i, j] = Q[i, j] + h * Dqdt[i, j];
+      Pnew[i, j] = P[i, j] + h * Dpdt[i, j];
     }
+  }
 
-    computeEquilibriumLoadings();
+  computeEquilibriumLoadings();
 
-    computeVelocity();
+  computeVelocity();
 
-    // SSP-RK Step 3
-    // ======================================================================
+  // SSP-RK Step 2
+  // ======================================================================
 
-    // calculate new derivatives at new (current) timestep
-    // calculate the derivatives Dq/dt and Dp/dt based on Qeq, Q, V, and P at new (current) timestep
-    computeFirstDerivatives(Dqdtnew, Dpdtnew, Qeqnew, Qnew, Vnew, Pnew);
+  // calculate new derivatives at new (current) timestep
+  // calculate the derivatives Dq/dt and Dp/dt based on Qeq, Q, V, and P at new (current) timestep
+  computeFirstDerivatives(Dqdtnew, Dpdtnew, Qeqnew, Qnew, Vnew, Pnew);
 
-    for (size_t i = 0; i < Ngrid + 1; ++i)
+  for (size_t i = 0; i < Ngrid + 1; ++i)
+  {
+    for (size_t j = 0; j < Ncomp; ++j)
     {
-      for (size_t j = 0; j < Ncomp; ++j)
-      {
-        Qnew[i, j] = (1.0 / 3.0) * Q[i, j] + (2.0 / 3.0) * Qnew[i, j] + (2.0 / 3.0) * dt * Dqdtnew[i, j];
-        Pnew[i, j] = (1.0 / 3.0) * P[i, j] + (2.0 / 3.0) * Pnew[i, j] + (2.0 / 3.0) * dt * Dpdtnew[i, j];
-      }
+      Qnew[i, j] = 0.75 * Q[i, j] + 0.25 * Qnew[i, j] + 0.25 * h * Dqdtnew[i, j];
+      Pnew[i, j] = 0.75 * P[i, j] + 0.25 * Pnew[i, j] + 0.25 * h * Dpdtnew[i, j];
+
+      // the Heun solution 0.5 * (u + u1 + h f(u1)) equals 2 u2 - u
+      Qerror[i, j] = 2.0 * Qnew[i, j] - Q[i, j];
+      Perror[i, j] = 2.0 * Pnew[i, j] - P[i, j];
     }
+  }
+
+  computeEquilibriumLoadings();
+
+  computeVelocity();
 
-    computeEquilibriumLoadings();
+  // SSP-RK Step 3
+  // ======================================================================
 
-    computeVelocity();
+  // calculate new derivatives at new (current) timestep
+  // calculate the derivatives Dq/dt and Dp/dt based on Qeq, Q, V, and P at new (current) timestep
+  computeFirstDerivatives(Dqdtnew, Dpdtnew, Qeqnew, Qnew, Vnew, Pnew);
 
-    // update to the new time step
-    std::copy(Qnew_vector.begin(), Qnew_vector.end(), Q_vector.begin());
-    std::copy(Pnew_vector.begin(), Pnew_vector.end(), P_vector.begin());
-    std::copy(Qeqnew_vector.begin(), Qeqnew_vector.end(), Qeq_vector.begin());
-    std::copy(Vnew.begin(), Vnew.end(), V.begin());
+  for (size_t i = 0; i < Ngrid + 1; ++i)
+  {
+    for (size_t j = 0; j < Ncomp; ++j)
+    {
+      Qnew[i, j] = (1.0 / 3.0) * Q[i, j] + (2.0 / 3.0) * Qnew[i, j] + (2.0 / 3.0) * h * Dqdtnew[i, j];
+      Pnew[i, j] = (1.0 / 3.0) * P[i, j] + (2.0 / 3.0) * Pnew[i, j] + (2.0 / 3.0) * h * Dpdtnew[i, j];
+
+      Qerror[i, j] = Qnew[i, j] - Qerror[i, j];
+      Perror[i, j] = Pnew[i, j] - Perror[i, j];
+    }
   }
 
-  std::cout << "Final timestep " + std::to_string(Nsteps) +
-                   ", time: " + std::to_string(dt * static_cast<double>(Nsteps)) + " [s]"
-            << std::endl;
+  computeEquilibriumLoadings();
+
+  computeVelocity();
 }
 
-void Breakthrough::computeEquilibriumLoadings()
+// one step of the second-order, L-stable Rosenbrock-W method ROS2
+// J. G. Verwer, E. J. Spee, J. G. Blom, and W. Hundsdorfer, SIAM J. Sci. Comput. 20, 1456-1480 (1999)
+//
+//   (I - gamma h J) k1 = f(y_n)
+//   (I - gamma h J) k2 = f(y_n + h k1) - 2 k1
+//   y_n+1 = y_n + 3/2 h k1 + 1/2 h k2,    gamma = 1 + 1/sqrt(2)
+//
+// The Jacobian J is evaluated at y_n with the velocity profile frozen, which makes it block-tridiagonal (the
+// finite-difference stencil along the column couples neighboring grid points, the mixture prediction couples the
+// components at each grid point). A W-method remains second-order accurate with such an approximate Jacobian.
+//
+// f(y_n) and J are computed once per step by 'prepareRosenbrockStep', only the iteration matrix depends on h.
+void Breakthrough::prepareRosenbrockStep()
 {
-  // calculate new equilibrium loadings Qeqnew corresponding to the new timestep
+  computeFirstDerivatives(Dqdt, Dpdt, Qeq, Q, V, P);
+  computeEquilibriumJacobian();
+}
+
+void Breakthrough::computeRosenbrockStep(double h)
+{
+  const double gamma = 1.0 + 1.0 / std::sqrt(2.0);
+  const size_t m = 2 * Ncomp;
+
+  factorizeIterationMatrix(gamma * h);
+
   for (size_t i = 0; i < Ngrid + 1; ++i)
   {
-    // estimation of total pressure Pt at each grid point from partial pressures
-    Pt[i] = 0.0;
     for (size_t j = 0; j < Ncomp; ++j)
     {
-      Pt[i] += std::max(0.0, Pnew[i, j]);
+      k1[i * m + j] = Dpdt[i, j];
+      k1[i * m + Ncomp + j] = Dqdt[i, j];
     }
+  }
+  solveIterationMatrix(k1);
 
-    // compute gas-phase mol-fractions
-    // force the gas-phase mol-fractions to be positive and normalized
-    double sum = 0.0;
+  // f(y_n + h k1)
+  for (size_t i = 0; i < Ngrid + 1; ++i)
+  {
     for (size_t j = 0; j < Ncomp; ++j)
     {
-      Yi[j] = std::max(Pnew[i, j], 0.0);
-      sum += Yi[j];
+      Pnew[i, j] = P[i, j] + h * k1[i * m + j];
+      Qnew[i, j] = Q[i, j] + h * k1[i * m + Ncomp + j];
     }
+  }
+  computeEquilibriumLoadings();
+  computeVelocity();
+  computeFirstDerivatives(Dqdtnew, Dpdtnew, Qeqnew, Qnew, Vnew, Pnew);
+
+  for (size_t i = 0; i < Ngrid + 1; ++i)
+  {
     for (size_t j = 0; j < Ncomp; ++j)
     {
-      Yi[j] /= sum;
+      k2[i * m + j] = Dpdtnew[i, j] - 2.0 * k1[i * m + j];
+      k2[i * m + Ncomp + j] = Dqdtnew[i, j] - 2.0 * k1[i * m + Ncomp + j];
+    }
+  }
+  solveIterationMatrix(k2);
+
+  // the difference with the embedded first-order solution y_n + h k1 is the local error estimate
+  for (size_t i = 0; i < Ngrid + 1; ++i)
+  {
+    for (size_t j = 0; j < Ncomp; ++j)
+    {
+      Pnew[i, j] = P[i, j] + 1.5 * h * k1[i * m + j] + 0.5 * h * k2[i * m + j];
+      Qnew[i, j] = Q[i, j] + 1.5 * h * k1[i * m + Ncomp + j] + 0.5 * h * k2[i * m + Ncomp + j];
+      Perror[i, j] = 0.5 * h * (k1[i * m + j] + k2[i * m + j]);
+      Qerror[i, j] = 0.5 * h * (k1[i * m + Ncomp + j] + k2[i * m + Ncomp + j]);
     }
+  }
 
-    // use Yi and Pt[i] to compute the loadings in the adsorption mixture via mixture prediction
-    iastPerformance += mixture.predictMixture(Yi, Pt[i], Xi, Ni, &cachedP0[i * Ncomp * system.maxIsothermTerms],
-                                              &cachedPsi[i * system.maxIsothermTerms]);
+  computeEquilibriumLoadings();
+  computeVelocity();
+}
 
+// maximum over the column of the local error relative to the tolerance, a step is accepted when it is at most one
+double Breakthrough::errorNorm() const
+{
+  double maximumLoading = 0.0;
+  for (size_t i = 0; i < Ngrid + 1; ++i)
+  {
     for (size_t j = 0; j < Ncomp; ++j)
     {
-      Qeqnew[i, j] = Ni[j];
+      maximumLoading = std::max({maximumLoading, std::abs(Qeq[i, j]), std::abs(Qeqnew[i, j])});
     }
   }
+  if (maximumLoading <= 0.0) maximumLoading = 1.0;
+
+  double error = 0.0;
+  for (size_t i = 0; i < Ngrid + 1; ++i)
+  {
+    for (size_t j = 0; j < Ncomp; ++j)
+    {
+      double scaleP =
+          absoluteTolerance * p_total + relativeTolerance * std::max(std::abs(P[i, j]), std::abs(Pnew[i, j]));
+      double scaleQ =
+          absoluteTolerance * maximumLoading + relativeTolerance * std::max(std::abs(Q[i, j]), std::abs(Qnew[i, j]));
+      error = std::max({error, std::abs(Perror[i, j]) / scaleP, std::abs(Qerror[i, j]) / scaleQ});
+    }
+  }
+  return error;
+}
+
+// update to the new time step
+void Breakthrough::acceptStep()
+{
+  std::copy(Qnew_vector.begin(), Qnew_vector.end(), Q_vector.begin());
+  std::copy(Pnew_vector.begin(), Pnew_vector.end(), P_vector.begin());
+  std::copy(Qeqnew_vector.begin(), Qeqnew_vector.end(), Qeq_vector.begin());
+  std::copy(Vnew.begin(), Vnew.end(), V.begin());
+}
+
+void Breakthrough::computeEquilibriumLoadings()
+{
+  // calculate new equilibrium loadings Qeqnew corresponding to the new timestep
+  iastPerformance += forEachGridPointBlock(
+      [this](size_t begin, size_t end, GridPointWorkspace &workspace)
+      {
+        std::pair<size_t, size_t> performance{0, 0};
+        for (size_t i = begin; i < end; ++i)
+        {
+          performance += predictLoadings(std::span<const double>(&Pnew[i, 0], Ncomp), Pt[i], workspace,
+                                         &cachedP0[i * Ncomp * system.maxIsothermTerms],
+                                         &cachedPsi[i * system.maxIsothermTerms]);
+
+          for (size_t j = 0; j < Ncomp; ++j)
+          {
+            Qeqnew[i, j] = workspace.Ni[j];
+          }
+        }
+        return performance;
+      });
 
   // check the total pressure at the outlet, it should not be negative
   if (Pt[0] + dptdx * L < 0.0)
@@ -475,6 +859,285 @@ void Breakthrough::computeEquilibriumLoadings()
   }
 }
 
+// derivatives of the equilibrium loadings with respect to the partial pressures at the current time step,
+// by forward differences of the mixture prediction
+void Breakthrough::computeEquilibriumJacobian()
+{
+  forEachGridPointBlock(
+      [this](size_t begin, size_t end, GridPointWorkspace &workspace)
+      {
+        for (size_t i = begin; i < end; ++i)
+        {
+          for (size_t k = 0; k < Ncomp; ++k)
+          {
+            for (size_t j = 0; j < Ncomp; ++j)
+            {
+              workspace.p[j] = P[i, j];
+            }
+            double delta = 1e-6 * std::max(std::abs(P[i, k]), 1e-6 * p_total);
+            workspace.p[k] += delta;
+
+            // the perturbed prediction must not change the warm start of the grid point
+            std::copy_n(&cachedP0[i * Ncomp * system.maxIsothermTerms], workspace.cachedP0.size(),
+                        workspace.cachedP0.begin());
+            std::copy_n(&cachedPsi[i * system.maxIsothermTerms], workspace.cachedPsi.size(),
+                        workspace.cachedPsi.begin());
+
+            double pt{};
+            predictLoadings(workspace.p, pt, workspace, workspace.cachedP0.data(), workspace.cachedPsi.data());
+
+            for (size_t j = 0; j < Ncomp; ++j)
+            {
+              dQeqdP[i, j, k] = (workspace.Ni[j] - Qeq[i, j]) / delta;
+            }
+          }
+        }
+        return std::pair<size_t, size_t>{0, 0};
+      });
+}
+
+// equilibrium loadings (stored in workspace.Ni) for the partial pressures 'p' of a grid point
+std::pair<size_t, size_t> Breakthrough::predictLoadings(std::span<const double> p, double &pt,
+                                                        GridPointWorkspace &workspace, double *p0, double *psi)
+{
+  // estimation of total pressure Pt at each grid point from partial pressures
+  pt = 0.0;
+  for (size_t j = 0; j < Ncomp; ++j)
+  {
+    pt += std::max(0.0, p[j]);
+  }
+
+  // compute gas-phase mol-fractions
+  // force the gas-phase mol-fractions to be positive and normalized
+  double sum = 0.0;
+  for (size_t j = 0; j < Ncomp; ++j)
+  {
+    workspace.Yi[j] = std::max(p[j], 0.0);
+    sum += workspace.Yi[j];
+  }
+  for (size_t j = 0; j < Ncomp; ++j)
+  {
+    workspace.Yi[j] /= sum;
+  }
+
+  // use Yi and Pt[i] to compute the loadings in the adsorption mixture via mixture prediction
+  return mixture.predictMixture(workspace.Yi, pt, workspace.Xi, workspace.Ni, p0, psi, workspace.mixture);
+}
+
+// the grid points are independent (each has its own cached P0 and psi for the warm start of the mixture prediction),
+// so blocks of grid points are computed concurrently, each thread with its own workspace
+std::pair<size_t, size_t> Breakthrough::forEachGridPointBlock(
+    const std::function<std::pair<size_t, size_t>(size_t, size_t, GridPointWorkspace &)> &task)
+{
+  const size_t numberOfHelperThreads = workspaces.size() - 1;
+
+  if (numberOfHelperThreads == 0)
+  {
+    return task(0, Ngrid + 1, workspaces.front());
+  }
+
+  auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+
+  std::vector<std::future<std::pair<size_t, size_t>>> threads(numberOfHelperThreads);
+
+  const size_t block_size = (Ngrid + 1) / (numberOfHelperThreads + 1);
+
+  size_t block_start = 0;
+  for (size_t i = 0; i != numberOfHelperThreads; ++i)
+  {
+    threads[i] = pool.enqueue([this, &task, i](size_t begin, size_t end) { return task(begin, end, workspaces[i]); },
+                              block_start, block_start + block_size);
+    block_start += block_size;
+  }
+
+  // the helper threads use the workspaces of this object, so all of them must finish before an error is passed on
+  std::pair<size_t, size_t> performance{0, 0};
+  std::exception_ptr error{};
+  try
+  {
+    performance += task(block_start, Ngrid + 1, workspaces.back());
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+  for (size_t i = 0; i != numberOfHelperThreads; ++i)
+  {
+    try
+    {
+      performance += threads[i].get();
+    }
+    catch (...)
+    {
+      if (!error) error = std::current_exception();
+    }
+  }
+  if (error) std::rethrow_exception(error);
+
+  return performance;
+}
+
+// LU-decomposition with partial pivoting of the dense m x m matrix 'a' (row-major), in place
+static void factorizeBlock(std::span<double> a, std::span<size_t> pivots, size_t m)
+{
+  for (size_t k = 0; k < m; ++k)
+  {
+    size_t pivot = k;
+    for (size_t r = k + 1; r < m; ++r)
+    {
+      if (std::abs(a[r * m + k]) > std::abs(a[pivot * m + k])) pivot = r;
+    }
+    if (a[pivot * m + k] == 0.0)
+    {
+      throw std::runtime_error("Error [Breakthrough]: singular iteration matrix\n");
+    }
+    pivots[k] = pivot;
+    if (pivot != k)
+    {
+      for (size_t c = 0; c < m; ++c)
+      {
+        std::swap(a[k * m + c], a[pivot * m + c]);
+      }
+    }
+    for (size_t r = k + 1; r < m; ++r)
+    {
+      a[r * m + k] /= a[k * m + k];
+      for (size_t c = k + 1; c < m; ++c)
+      {
+        a[r * m + c] -= a[r * m + k] * a[k * m + c];
+      }
+    }
+  }
+}
+
+// solves the factorized block for the right-hand side 'b', in place
+static void solveBlock(std::span<const double> lu, std::span<const size_t> pivots, std::span<double> b, size_t m)
+{
+  for (size_t k = 0; k < m; ++k)
+  {
+    std::swap(b[k], b[pivots[k]]);
+    for (size_t r = k + 1; r < m; ++r)
+    {
+      b[r] -= lu[r * m + k] * b[k];
+    }
+  }
+  for (size_t k = m; k-- != 0;)
+  {
+    for (size_t c = k + 1; c < m; ++c)
+    {
+      b[k] -= lu[k * m + c] * b[c];
+    }
+    b[k] /= lu[k * m + k];
+  }
+}
+
+// block-tridiagonal iteration matrix I - gamma h J, factorized by block-Gaussian elimination (block Thomas algorithm)
+// the off-diagonal blocks only couple the partial pressure of a component to its neighbors and are diagonal
+void Breakthrough::factorizeIterationMatrix(double gamma_h)
+{
+  const size_t m = 2 * Ncomp;
+  const double idx = 1.0 / dx;
+  const double idx2 = 1.0 / (dx * dx);
+
+  std::vector<double> column(m);
+  for (size_t i = 0; i < Ngrid + 1; ++i)
+  {
+    std::span<double> block(&blockFactors[i * m * m], m * m);
+    std::span<size_t> pivots(&blockPivots[i * m], m);
+
+    // diagonal block of the Jacobian
+    // the convective term is linearized with the upwind scheme for every convection scheme, which keeps the matrix
+    // block-tridiagonal; ROS2 retains its order with an approximate Jacobian
+    std::fill(block.begin(), block.end(), 0.0);
+    for (size_t j = 0; j < Ncomp; ++j)
+    {
+      const double k = components[j].massTransferCoefficient;
+      const double D = components[j].axialDispersionCoefficient;
+
+      // the inlet partial pressures are fixed
+      if (i > 0)
+      {
+        block[j * m + j] = (i < Ngrid) ? -V[i] * idx - 2.0 * D * idx2 : -V[i] * idx - D * idx2;
+        for (size_t l = 0; l < Ncomp; ++l)
+        {
+          block[j * m + l] -= prefactor[j] * dQeqdP[i, j, l];
+        }
+        block[j * m + Ncomp + j] = prefactor[j];
+      }
+
+      for (size_t l = 0; l < Ncomp; ++l)
+      {
+        block[(Ncomp + j) * m + l] = k * dQeqdP[i, j, l];
+      }
+      block[(Ncomp + j) * m + Ncomp + j] = -k;
+
+      lowerCoupling[i * Ncomp + j] = (i > 0) ? -gamma_h * (V[i - 1] * idx + D * idx2) : 0.0;
+      upperCoupling[i * Ncomp + j] = (i > 0 && i < Ngrid) ? -gamma_h * D * idx2 : 0.0;
+    }
+    for (size_t r = 0; r < m; ++r)
+    {
+      for (size_t c = 0; c < m; ++c)
+      {
+        block[r * m + c] = (r == c ? 1.0 : 0.0) - gamma_h * block[r * m + c];
+      }
+    }
+
+    // eliminate the coupling to the previous grid point: D_i = M_i - L_i D_{i-1}^-1 U_{i-1}
+    if (i > 0)
+    {
+      std::span<const double> previousBlock(&blockFactors[(i - 1) * m * m], m * m);
+      std::span<const size_t> previousPivots(&blockPivots[(i - 1) * m], m);
+      for (size_t c = 0; c < Ncomp; ++c)
+      {
+        std::fill(column.begin(), column.end(), 0.0);
+        column[c] = upperCoupling[(i - 1) * Ncomp + c];
+        if (column[c] == 0.0) continue;
+        solveBlock(previousBlock, previousPivots, column, m);
+        for (size_t r = 0; r < Ncomp; ++r)
+        {
+          block[r * m + c] -= lowerCoupling[i * Ncomp + r] * column[r];
+        }
+      }
+    }
+
+    factorizeBlock(block, pivots, m);
+  }
+}
+
+// solves (I - gamma h J) x = b with the factorized iteration matrix, in place
+void Breakthrough::solveIterationMatrix(std::vector<double> &b)
+{
+  const size_t m = 2 * Ncomp;
+
+  // forward elimination
+  std::vector<double> z(m);
+  for (size_t i = 1; i < Ngrid + 1; ++i)
+  {
+    std::copy_n(&b[(i - 1) * m], m, z.begin());
+    solveBlock(std::span<const double>(&blockFactors[(i - 1) * m * m], m * m),
+               std::span<const size_t>(&blockPivots[(i - 1) * m], m), z, m);
+    for (size_t r = 0; r < Ncomp; ++r)
+    {
+      b[i * m + r] -= lowerCoupling[i * Ncomp + r] * z[r];
+    }
+  }
+
+  // back substitution
+  for (size_t i = Ngrid + 1; i-- != 0;)
+  {
+    std::span<double> x(&b[i * m], m);
+    if (i < Ngrid)
+    {
+      for (size_t r = 0; r < Ncomp; ++r)
+      {
+        x[r] -= upperCoupling[i * Ncomp + r] * b[(i + 1) * m + r];
+      }
+    }
+    solveBlock(std::span<const double>(&blockFactors[i * m * m], m * m),
+               std::span<const size_t>(&blockPivots[i * m], m), x, m);
+  }
+}
+
 // calculate the derivatives Dq/dt and Dp/dt along the column
 void Breakthrough::computeFirstDerivatives(std::mdspan<double, std::dextents<size_t, 2>> &dqdt,
                                            std::mdspan<double, std::dextents<size_t, 2>> &dpdt,
@@ -499,7 +1162,7 @@ void Breakthrough::computeFirstDerivatives(std::mdspan<double, std::dextents<siz
     for (size_t j = 0; j < Ncomp; ++j)
     {
       dqdt[i, j] = components[j].massTransferCoefficient * (q_eq[i, j] - q[i, j]);
-      dpdt[i, j] = (v[i - 1] * p[i - 1, j] - v[i] * p[i, j]) * idx +
+      dpdt[i, j] = (convectiveFlux(v, p, i - 1, j) - convectiveFlux(v, p, i, j)) * idx +
                    components[j].axialDispersionCoefficient * (p[i + 1, j] - 2.0 * p[i, j] + p[i - 1, j]) * idx2 -
                    prefactor[j] * (q_eq[i, j] - q[i, j]);
     }
@@ -509,12 +1172,53 @@ void Breakthrough::computeFirstDerivatives(std::mdspan<double, std::dextents<siz
   for (size_t j = 0; j < Ncomp; ++j)
   {
     dqdt[Ngrid, j] = components[j].massTransferCoefficient * (q_eq[Ngrid, j] - q[Ngrid, j]);
-    dpdt[Ngrid, j] = (v[Ngrid - 1] * p[Ngrid - 1, j] - v[Ngrid] * p[Ngrid, j]) * idx +
+    dpdt[Ngrid, j] = (convectiveFlux(v, p, Ngrid - 1, j) - v[Ngrid] * p[Ngrid, j]) * idx +
                      components[j].axialDispersionCoefficient * (p[Ngrid - 1, j] - p[Ngrid, j]) * idx2 -
                      prefactor[j] * (q_eq[Ngrid, j] - q[Ngrid, j]);
   }
 }
 
+// the convective flux v p of component j through the face between grid points i and i + 1, reconstructed from the
+// upwind side (the gas flows in the direction of increasing i)
+//  - Upwind: first order, the flux at grid point i
+//  - VanLeer: second order TVD with the van Leer limiter, first order at extrema
+//  - WENO3: third-order weighted essentially non-oscillatory reconstruction (Jiang and Shu)
+// the point before the inlet is taken equal to the inlet, which reduces the inlet face to first order
+double Breakthrough::convectiveFlux(const std::vector<double> &v,
+                                   const std::mdspan<double, std::dextents<size_t, 2>> &p, size_t i, size_t j) const
+{
+  const double f = v[i] * p[i, j];
+  if (convectionScheme == System::ColumnConvectionScheme::Upwind) return f;
+
+  const double fPrevious = (i > 0) ? v[i - 1] * p[i - 1, j] : f;
+  const double fNext = v[i + 1] * p[i + 1, j];
+  return reconstructFaceFlux(convectionScheme, fPrevious, f, fNext, v_in * p_total);
+}
+
+double Breakthrough::reconstructFaceFlux(System::ColumnConvectionScheme scheme, double fPrevious, double f,
+                                         double fNext, double scale)
+{
+  const double backward = f - fPrevious;
+  const double forward = fNext - f;
+
+  switch (scheme)
+  {
+    case System::ColumnConvectionScheme::Upwind:
+      return f;
+    case System::ColumnConvectionScheme::VanLeer:
+    default:
+      return (backward * forward > 0.0) ? f + backward * forward / (backward + forward) : f;
+    case System::ColumnConvectionScheme::WENO3:
+    {
+      // the small number avoiding division by zero is scaled with the inlet flux
+      const double smallness = 1e-10 * scale * scale;
+      const double alpha0 = (1.0 / 3.0) / ((smallness + backward * backward) * (smallness + backward * backward));
+      const double alpha1 = (2.0 / 3.0) / ((smallness + forward * forward) * (smallness + forward * forward));
+      return (alpha0 * (1.5 * f - 0.5 * fPrevious) + alpha1 * 0.5 * (f + fNext)) / (alpha0 + alpha1);
+    }
+  }
+}
+
 // calculate new velocity Vnew from Qnew, Qeqnew, Pnew, Pt
 void Breakthrough::computeVelocity()
 {
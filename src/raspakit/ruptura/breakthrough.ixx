@@ -2,6 +2,7 @@ module;
 
 #ifdef USE_LEGACY_HEADERS
 #include <fstream>
+#include <functional>
 #include <mdspan>
 #include <span>
 #include <string>
@@ -18,6 +19,7 @@ import <tuple>;
 import <string>;
 import <fstream>;
 import <mdspan>;
+import <functional>;
 #endif
 
 import input_reader;
@@ -38,6 +40,15 @@ export struct Breakthrough
   void createPlotScript();
   void createMovieScripts();
 
+  // the column profiles at the current time, per grid point the values of the components are contiguous
+  std::span<const double> partialPressures() const { return P_vector; }
+  std::span<const double> loadings() const { return Q_vector; }
+
+  // the convective flux through the face after the grid point with flux 'f', reconstructed from the fluxes v p at the
+  // grid point before, at and after the upwind side; 'scale' is the inlet flux v_in p_total
+  static double reconstructFaceFlux(System::ColumnConvectionScheme scheme, double fPrevious, double f, double fNext,
+                                    double scale);
+
  private:
   const System &system;
   const std::string displayName;
@@ -63,6 +74,13 @@ export struct Breakthrough
   bool autoSteps;  // use automatic number of steps
   bool pulse;      // pulsed inlet condition for breakthrough
   double tpulse;   // pulse time
+
+  System::ColumnIntegrator integrator;  // time integration scheme
+  double relativeTolerance;             // relative error tolerance per step of the adaptive integrators
+  double absoluteTolerance;             // absolute error tolerance, relative to the total pressure and maximum loading
+  double maximumTimeStep;               // upper bound of the adaptive time step (no limit when zero)
+  System::ColumnConvectionScheme convectionScheme;  // spatial discretization of the convective term
+  System::ColumnOutputFormat outputFormat;          // format of the column profiles
   MixturePrediction mixture;
   std::pair<size_t, size_t> iastPerformance{0, 0};
 
@@ -101,19 +119,59 @@ export struct Breakthrough
   std::vector<double> cachedP0;   // cached hypothetical pressure
   std::vector<double> cachedPsi;  // cached reduced grand potential over the column
 
-  enum class IntegrationScheme
+  // local error estimate of the adaptive integrators at every grid point for each component
+  std::vector<double> Perror_vector;
+  std::mdspan<double, std::dextents<size_t, 2>> Perror;
+  std::vector<double> Qerror_vector;
+  std::mdspan<double, std::dextents<size_t, 2>> Qerror;
+
+  // Rosenbrock integrator: the unknowns of grid point i are ordered as (P[i, 0..Ncomp-1], Q[i, 0..Ncomp-1])
+  std::vector<double> dQeqdP_vector;  // derivative of the equilibrium loading of component j to partial pressure k
+  std::mdspan<double, std::dextents<size_t, 3>> dQeqdP;
+  std::vector<double> blockFactors;  // LU-factors of the diagonal blocks of the block-tridiagonal system
+  std::vector<size_t> blockPivots;
+  std::vector<double> lowerCoupling;  // coupling of P[i, j] to P[i - 1, j]
+  std::vector<double> upperCoupling;  // coupling of P[i, j] to P[i + 1, j]
+  std::vector<double> k1;
+  std::vector<double> k2;
+
+  // scratch memory for computing the equilibrium loadings of a block of grid points
+  struct GridPointWorkspace
   {
-    SSP_RK = 0,
-    Iterative = 1
+    std::vector<double> Yi;
+    std::vector<double> Xi;
+    std::vector<double> Ni;
+    std::vector<double> p;
+    std::vector<double> cachedP0;
+    std::vector<double> cachedPsi;
+    MixturePrediction::Workspace mixture;
   };
+  std::vector<GridPointWorkspace> workspaces;  // one per thread (the helper threads plus the main thread)
+
+  // time steps
+  void computeSSPRKStep(double h);
+  void prepareRosenbrockStep();
+  void computeRosenbrockStep(double h);
+  void acceptStep();
+  double errorNorm() const;
 
   void computeFirstDerivatives(std::mdspan<double, std::dextents<size_t, 2>> &dqdt,
                                std::mdspan<double, std::dextents<size_t, 2>> &dpdt,
                                const std::mdspan<double, std::dextents<size_t, 2>> &q_eq,
                                const std::mdspan<double, std::dextents<size_t, 2>> &q, const std::vector<double> &v,
                                const std::mdspan<double, std::dextents<size_t, 2>> &p);
+  double convectiveFlux(const std::vector<double> &v, const std::mdspan<double, std::dextents<size_t, 2>> &p,
+                        size_t i, size_t j) const;
 
   void computeEquilibriumLoadings();
+  void computeEquilibriumJacobian();
+  std::pair<size_t, size_t> predictLoadings(std::span<const double> p, double &pt, GridPointWorkspace &workspace,
+                                            double *p0, double *psi);
+  std::pair<size_t, size_t> forEachGridPointBlock(
+      const std::function<std::pair<size_t, size_t>(size_t, size_t, GridPointWorkspace &)> &task);
+
+  void factorizeIterationMatrix(double gamma_h);
+  void solveIterationMatrix(std::vector<double> &b);
 
   void computeVelocity();
 
@@ -5,8 +5,10 @@ module;
 #include <chrono>
 #include <cmath>
 #include <complex>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <numeric>
@@ -36,6 +38,8 @@ import <chrono>;
 import <type_traits>;
 import <complex>;
 import <print>;
+import <exception>;
+import <future>;
 #endif
 
 import stringutils;
@@ -47,7 +51,8 @@ import simulationbox;
 import mixture_prediction;
 import breakthrough;
 
-BreakthroughSimulation::BreakthroughSimulation(InputReader &inputReader) : systems(std::move(inputReader.systems))
+BreakthroughSimulation::BreakthroughSimulation(InputReader &inputReader)
+    : systems(std::move(inputReader.systems)), concurrentSystems(inputReader.concurrentSystems)
 {
   for (System &system : systems)
   {
@@ -59,30 +64,61 @@ BreakthroughSimulation::BreakthroughSimulation(InputReader &inputReader) : syste
 
 void BreakthroughSimulation::run()
 {
+  if (!concurrentSystems)
+  {
+    for (System &system : systems)
+    {
+      runSystem(system);
+    }
+    return;
+  }
+
+  // each system runs on its own thread, not on the thread pool: the systems use the pool themselves
+  std::vector<std::future<void>> tasks{};
   for (System &system : systems)
   {
-    Breakthrough breakthrough(system);
+    tasks.push_back(std::async(std::launch::async, [this, &system]() { runSystem(system); }));
+  }
 
-    std::string fileNameString =
-        std::format("output/system_{}/output_{}_{}.txt", system.systemId, system.temperature, system.input_pressure);
-    std::ofstream fstream(fileNameString, std::ios::out);
-    std::ostream stream(fstream.rdbuf());
-    // std::ostream stream(std::cout.rdbuf());
+  // all systems must finish before an error is passed on
+  std::exception_ptr error{};
+  for (std::future<void> &task : tasks)
+  {
+    try
+    {
+      task.get();
+    }
+    catch (...)
+    {
+      if (!error) error = std::current_exception();
+    }
+  }
+  if (error) std::rethrow_exception(error);
+}
 
-    std::print(stream, "{}", system.writeOutputHeader());
-    std::print(stream, "{}", HardwareInfo::writeInfo());
-    std::print(stream, "{}", breakthrough.writeHeader());
+void BreakthroughSimulation::runSystem(System &system)
+{
+  Breakthrough breakthrough(system);
 
-    breakthrough.createPlotScript();
-    breakthrough.createMovieScripts();
+  std::string fileNameString =
+      std::format("output/system_{}/output_{}_{}.txt", system.systemId, system.temperature, system.input_pressure);
+  std::ofstream fstream(fileNameString, std::ios::out);
+  std::ostream stream(fstream.rdbuf());
+  // std::ostream stream(std::cout.rdbuf());
 
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+  std::print(stream, "{}", system.writeOutputHeader());
+  std::print(stream, "{}", HardwareInfo::writeInfo());
+  std::print(stream, "{}", breakthrough.writeHeader());
 
-    breakthrough.run(stream);
+  breakthrough.createPlotScript();
+  breakthrough.createMovieScripts();
 
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
+  std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
 
-    std::chrono::duration<double> totalSimulationTime = (t2 - t1);
-    std::print(stream, "Breakthrough simulation time: {:14f} [s]\n\n\n", totalSimulationTime.count());
-  }
+  breakthrough.run(stream);
+
+  std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
+
+  std::chrono::duration<double> totalSimulationTime = (t2 - t1);
+  std::print(stream, "Breakthrough simulation time: {:14f} [s]\n\n\n", totalSimulationTime.count());
 }
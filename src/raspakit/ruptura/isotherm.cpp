@@ -1,11 +1,15 @@
 module;
 
 #ifdef USE_LEGACY_HEADERS
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <print>
+#include <span>
 #include <sstream>
+#include <utility>
 #include <vector>
 #endif
 
@@ -18,6 +22,10 @@ import <sstream>;
 import <cmath>;
 import <vector>;
 import <print>;
+import <span>;
+import <array>;
+import <limits>;
+import <utility>;
 #endif
 
 import randomnumbers;
@@ -28,6 +36,488 @@ Isotherm::Isotherm(Isotherm::Type t, const std::vector<double> &values, size_t n
 {
 }
 
+// the parameters are copied into locals, so the compiler can assume they do not alias the output and vectorize
+void Isotherm::accumulateValues(std::span<const double> pressures, std::span<double> loadings) const
+{
+  const size_t n = pressures.size();
+  const double p0 = parameters.size() > 0 ? parameters[0] : 0.0;
+  const double p1 = parameters.size() > 1 ? parameters[1] : 0.0;
+  const double p2 = parameters.size() > 2 ? parameters[2] : 0.0;
+
+  switch (type)
+  {
+    case Isotherm::Type::Langmuir:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = p1 * pressures[i];
+        loadings[i] += p0 * temp / (1.0 + temp);
+      }
+      break;
+    case Isotherm::Type::Anti_Langmuir:
+      for (size_t i = 0; i < n; ++i)
+      {
+        loadings[i] += p0 * pressures[i] / (1.0 - p1 * pressures[i]);
+      }
+      break;
+    case Isotherm::Type::BET:
+      for (size_t i = 0; i < n; ++i)
+      {
+        loadings[i] += p0 * p1 * pressures[i] / ((1.0 - p2 * pressures[i]) * (1.0 - p2 + p1 * pressures[i]));
+      }
+      break;
+    case Isotherm::Type::Henry:
+      for (size_t i = 0; i < n; ++i)
+      {
+        loadings[i] += p0 * pressures[i];
+      }
+      break;
+    case Isotherm::Type::Freundlich:
+      for (size_t i = 0; i < n; ++i)
+      {
+        loadings[i] += p0 * std::pow(pressures[i], 1.0 / p1);
+      }
+      break;
+    case Isotherm::Type::Sips:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = std::pow(p1 * pressures[i], 1.0 / p2);
+        loadings[i] += p0 * temp / (1.0 + temp);
+      }
+      break;
+    case Isotherm::Type::Langmuir_Freundlich:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = p1 * std::pow(pressures[i], p2);
+        loadings[i] += p0 * temp / (1.0 + temp);
+      }
+      break;
+    case Isotherm::Type::Redlich_Peterson:
+      for (size_t i = 0; i < n; ++i)
+      {
+        loadings[i] += p0 * pressures[i] / (1.0 + p1 * std::pow(pressures[i], p2));
+      }
+      break;
+    case Isotherm::Type::Toth:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = p1 * pressures[i];
+        loadings[i] += p0 * temp / std::pow(1.0 + std::pow(temp, p2), 1.0 / p2);
+      }
+      break;
+    case Isotherm::Type::Unilan:
+    {
+      const double prefactor = p0 * (0.5 / p2);
+      const double upper = p1 * std::exp(p2);
+      const double lower = p1 * std::exp(-p2);
+      for (size_t i = 0; i < n; ++i)
+      {
+        loadings[i] += prefactor * std::log((1.0 + upper * pressures[i]) / (1.0 + lower * pressures[i]));
+      }
+      break;
+    }
+    case Isotherm::Type::OBrien_Myers:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp1 = p1 * pressures[i];
+        double temp2 = 1.0 + temp1;
+        loadings[i] += p0 * (temp1 / temp2 + p2 * p2 * temp1 * (1.0 - temp1) / (temp2 * temp2 * temp2));
+      }
+      break;
+    case Isotherm::Type::Quadratic:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp1 = p1 * pressures[i];
+        double temp2 = p2 * pressures[i] * pressures[i];
+        loadings[i] += p0 * (temp1 + 2.0 * temp2) / (1.0 + temp1 + temp2);
+      }
+      break;
+    case Isotherm::Type::Temkin:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = p1 * pressures[i];
+        double temp1 = temp / (1.0 + temp);
+        loadings[i] += p0 * (temp1 + p2 * temp1 * temp1 * (temp1 - 1.0));
+      }
+      break;
+    default:
+      throw std::runtime_error("Error: unkown isotherm type");
+  }
+}
+
+void Isotherm::accumulatePsiForPressures(std::span<const double> pressures, std::span<double> psi) const
+{
+  const size_t n = pressures.size();
+  const double p0 = parameters.size() > 0 ? parameters[0] : 0.0;
+  const double p1 = parameters.size() > 1 ? parameters[1] : 0.0;
+  const double p2 = parameters.size() > 2 ? parameters[2] : 0.0;
+
+  switch (type)
+  {
+    case Isotherm::Type::Langmuir:
+      for (size_t i = 0; i < n; ++i)
+      {
+        psi[i] += p0 * std::log(1.0 + p1 * pressures[i]);
+      }
+      break;
+    case Isotherm::Type::Anti_Langmuir:
+      for (size_t i = 0; i < n; ++i)
+      {
+        psi[i] += -(p0 / p1) * std::log(1.0 - p1 * pressures[i]);
+      }
+      break;
+    case Isotherm::Type::BET:
+    {
+      const double prefactor = p0 * p1 / (p1 + p2 - p2 * p2);
+      for (size_t i = 0; i < n; ++i)
+      {
+        psi[i] += prefactor * std::log((1.0 - p2 + p1 * pressures[i]) / ((1.0 - p2) * (1.0 - p2 * pressures[i])));
+      }
+      break;
+    }
+    case Isotherm::Type::Henry:
+      for (size_t i = 0; i < n; ++i)
+      {
+        psi[i] += p0 * pressures[i];
+      }
+      break;
+    case Isotherm::Type::Freundlich:
+      for (size_t i = 0; i < n; ++i)
+      {
+        psi[i] += p0 * p1 * std::pow(pressures[i], 1.0 / p1);
+      }
+      break;
+    case Isotherm::Type::Sips:
+      for (size_t i = 0; i < n; ++i)
+      {
+        psi[i] += p2 * p0 * std::log(1.0 + std::pow(p1 * pressures[i], 1.0 / p2));
+      }
+      break;
+    case Isotherm::Type::Langmuir_Freundlich:
+      for (size_t i = 0; i < n; ++i)
+      {
+        psi[i] += (p0 / p2) * std::log(1.0 + p1 * std::pow(pressures[i], p2));
+      }
+      break;
+    case Isotherm::Type::OBrien_Myers:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp1 = p1 * pressures[i];
+        double temp2 = 1.0 + temp1;
+        psi[i] += p0 * (std::log(temp2) + 0.5 * p2 * p2 * temp1 / (temp2 * temp2));
+      }
+      break;
+    case Isotherm::Type::Quadratic:
+      for (size_t i = 0; i < n; ++i)
+      {
+        psi[i] += p0 * std::log(1.0 + p1 * pressures[i] + p2 * pressures[i] * pressures[i]);
+      }
+      break;
+    case Isotherm::Type::Temkin:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = p1 * pressures[i];
+        double temp1 = temp / (1.0 + temp);
+        psi[i] += p0 * (std::log(1.0 + temp) - 0.5 * p2 * temp1 * temp1);
+      }
+      break;
+    default:
+      // Redlich-Peterson, Toth and Unilan involve branches and series expansions (hypergeometric, dilogarithm)
+      for (size_t i = 0; i < n; ++i)
+      {
+        psi[i] += psiForPressure(pressures[i]);
+      }
+      break;
+  }
+}
+
+void Isotherm::accumulateDerivatives(std::span<const double> pressures, std::span<double> derivatives) const
+{
+  const size_t n = pressures.size();
+  const double p0 = parameters.size() > 0 ? parameters[0] : 0.0;
+  const double p1 = parameters.size() > 1 ? parameters[1] : 0.0;
+  const double p2 = parameters.size() > 2 ? parameters[2] : 0.0;
+
+  switch (type)
+  {
+    case Isotherm::Type::Langmuir:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = 1.0 + p1 * pressures[i];
+        derivatives[i] += p0 * p1 / (temp * temp);
+      }
+      break;
+    case Isotherm::Type::Anti_Langmuir:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = 1.0 - p1 * pressures[i];
+        derivatives[i] += p0 / (temp * temp);
+      }
+      break;
+    case Isotherm::Type::BET:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp1 = 1.0 - p2 * pressures[i];
+        double temp2 = 1.0 - p2 + p1 * pressures[i];
+        double denominator = temp1 * temp2;
+        double derivativeDenominator = -p2 * temp2 + p1 * temp1;
+        derivatives[i] += p0 * p1 * (denominator - pressures[i] * derivativeDenominator) / (denominator * denominator);
+      }
+      break;
+    case Isotherm::Type::Henry:
+      for (size_t i = 0; i < n; ++i)
+      {
+        derivatives[i] += p0;
+      }
+      break;
+    case Isotherm::Type::Freundlich:
+      for (size_t i = 0; i < n; ++i)
+      {
+        derivatives[i] += (p0 / p1) * std::pow(pressures[i], 1.0 / p1 - 1.0);
+      }
+      break;
+    case Isotherm::Type::Sips:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = std::pow(p1 * pressures[i], 1.0 / p2);
+        double derivativeTemp = (p1 / p2) * std::pow(p1 * pressures[i], 1.0 / p2 - 1.0);
+        derivatives[i] += p0 * derivativeTemp / ((1.0 + temp) * (1.0 + temp));
+      }
+      break;
+    case Isotherm::Type::Langmuir_Freundlich:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = p1 * std::pow(pressures[i], p2);
+        double derivativeTemp = p1 * p2 * std::pow(pressures[i], p2 - 1.0);
+        derivatives[i] += p0 * derivativeTemp / ((1.0 + temp) * (1.0 + temp));
+      }
+      break;
+    case Isotherm::Type::Redlich_Peterson:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = p1 * std::pow(pressures[i], p2);
+        derivatives[i] += p0 * (1.0 + (1.0 - p2) * temp) / ((1.0 + temp) * (1.0 + temp));
+      }
+      break;
+    case Isotherm::Type::Toth:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = p1 * pressures[i];
+        derivatives[i] += p0 * p1 * std::pow(1.0 + std::pow(temp, p2), -1.0 / p2 - 1.0);
+      }
+      break;
+    case Isotherm::Type::Unilan:
+    {
+      const double prefactor = p0 * (0.5 / p2);
+      const double upper = p1 * std::exp(p2);
+      const double lower = p1 * std::exp(-p2);
+      for (size_t i = 0; i < n; ++i)
+      {
+        derivatives[i] += prefactor * (upper / (1.0 + upper * pressures[i]) - lower / (1.0 + lower * pressures[i]));
+      }
+      break;
+    }
+    case Isotherm::Type::OBrien_Myers:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp1 = p1 * pressures[i];
+        double temp2 = 1.0 + temp1;
+        double temp2_squared = temp2 * temp2;
+        derivatives[i] += p0 * p1 *
+                          (1.0 / temp2_squared + p2 * p2 * ((1.0 - 2.0 * temp1) * temp2 - 3.0 * temp1 * (1.0 - temp1)) /
+                                                     (temp2_squared * temp2_squared));
+      }
+      break;
+    case Isotherm::Type::Quadratic:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp1 = p1 * pressures[i];
+        double temp2 = p2 * pressures[i] * pressures[i];
+        double numerator = temp1 + 2.0 * temp2;
+        double denominator = 1.0 + temp1 + temp2;
+        double derivativeNumerator = p1 + 4.0 * p2 * pressures[i];
+        double derivativeDenominator = p1 + 2.0 * p2 * pressures[i];
+        derivatives[i] += p0 * (derivativeNumerator * denominator - numerator * derivativeDenominator) /
+                          (denominator * denominator);
+      }
+      break;
+    case Isotherm::Type::Temkin:
+      for (size_t i = 0; i < n; ++i)
+      {
+        double temp = 1.0 + p1 * pressures[i];
+        double theta = p1 * pressures[i] / temp;
+        double derivativeTheta = p1 / (temp * temp);
+        derivatives[i] += p0 * derivativeTheta * (1.0 + p2 * (3.0 * theta * theta - 2.0 * theta));
+      }
+      break;
+    default:
+      throw std::runtime_error("Error: unkown isotherm type");
+  }
+}
+
+void Isotherm::parameterGradient(double pressure, std::span<double> gradient) const
+{
+  const double p0 = parameters.size() > 0 ? parameters[0] : 0.0;
+  const double p1 = parameters.size() > 1 ? parameters[1] : 0.0;
+  const double p2 = parameters.size() > 2 ? parameters[2] : 0.0;
+
+  switch (type)
+  {
+    case Isotherm::Type::Langmuir:
+    {
+      double temp = p1 * pressure;
+      gradient[0] = temp / (1.0 + temp);
+      gradient[1] = p0 * pressure / ((1.0 + temp) * (1.0 + temp));
+      break;
+    }
+    case Isotherm::Type::Anti_Langmuir:
+    {
+      double temp = 1.0 - p1 * pressure;
+      gradient[0] = pressure / temp;
+      gradient[1] = p0 * pressure * pressure / (temp * temp);
+      break;
+    }
+    case Isotherm::Type::BET:
+    {
+      double temp1 = 1.0 - p2 * pressure;
+      double temp2 = 1.0 - p2 + p1 * pressure;
+      double loading = p0 * p1 * pressure / (temp1 * temp2);
+      gradient[0] = p1 * pressure / (temp1 * temp2);
+      gradient[1] = p0 * pressure * (1.0 - p2) / (temp1 * temp2 * temp2);
+      gradient[2] = loading * (pressure / temp1 + 1.0 / temp2);
+      break;
+    }
+    case Isotherm::Type::Henry:
+    {
+      gradient[0] = pressure;
+      break;
+    }
+    case Isotherm::Type::Freundlich:
+    {
+      double temp = std::pow(pressure, 1.0 / p1);
+      gradient[0] = temp;
+      gradient[1] = -p0 * temp * std::log(pressure) / (p1 * p1);
+      break;
+    }
+    case Isotherm::Type::Sips:
+    {
+      double temp = std::pow(p1 * pressure, 1.0 / p2);
+      double derivativeTemp = p0 / ((1.0 + temp) * (1.0 + temp));
+      gradient[0] = temp / (1.0 + temp);
+      gradient[1] = derivativeTemp * temp / (p2 * p1);
+      gradient[2] = -derivativeTemp * temp * std::log(p1 * pressure) / (p2 * p2);
+      break;
+    }
+    case Isotherm::Type::Langmuir_Freundlich:
+    {
+      double power = std::pow(pressure, p2);
+      double temp = p1 * power;
+      double derivativeTemp = p0 / ((1.0 + temp) * (1.0 + temp));
+      gradient[0] = temp / (1.0 + temp);
+      gradient[1] = derivativeTemp * power;
+      gradient[2] = derivativeTemp * temp * std::log(pressure);
+      break;
+    }
+    case Isotherm::Type::Redlich_Peterson:
+    {
+      double power = std::pow(pressure, p2);
+      double denominator = 1.0 + p1 * power;
+      gradient[0] = pressure / denominator;
+      gradient[1] = -p0 * pressure * power / (denominator * denominator);
+      gradient[2] = -p0 * pressure * p1 * power * std::log(pressure) / (denominator * denominator);
+      break;
+    }
+    case Isotherm::Type::Toth:
+    {
+      double temp = p1 * pressure;
+      double power = std::pow(temp, p2);
+      double denominator = 1.0 + power;
+      double loading = p0 * temp * std::pow(denominator, -1.0 / p2);
+      gradient[0] = temp * std::pow(denominator, -1.0 / p2);
+      gradient[1] = p0 * pressure * std::pow(denominator, -1.0 / p2 - 1.0);
+      gradient[2] = loading * (std::log(denominator) / (p2 * p2) - power * std::log(temp) / (p2 * denominator));
+      break;
+    }
+    case Isotherm::Type::Unilan:
+    {
+      double upper = std::exp(p2) * pressure;
+      double lower = std::exp(-p2) * pressure;
+      double temp1 = 1.0 + p1 * upper;
+      double temp2 = 1.0 + p1 * lower;
+      double logarithm = std::log(temp1 / temp2);
+      gradient[0] = (0.5 / p2) * logarithm;
+      gradient[1] = p0 * (0.5 / p2) * (upper / temp1 - lower / temp2);
+      gradient[2] = -p0 * (0.5 / (p2 * p2)) * logarithm + p0 * (0.5 / p2) * (p1 * upper / temp1 + p1 * lower / temp2);
+      break;
+    }
+    case Isotherm::Type::OBrien_Myers:
+    {
+      double temp1 = p1 * pressure;
+      double temp2 = 1.0 + temp1;
+      double temp2_squared = temp2 * temp2;
+      gradient[0] = temp1 / temp2 + p2 * p2 * temp1 * (1.0 - temp1) / (temp2_squared * temp2);
+      gradient[1] = p0 * pressure *
+                    (1.0 / temp2_squared + p2 * p2 * ((1.0 - 2.0 * temp1) * temp2 - 3.0 * temp1 * (1.0 - temp1)) /
+                                               (temp2_squared * temp2_squared));
+      gradient[2] = 2.0 * p0 * p2 * temp1 * (1.0 - temp1) / (temp2_squared * temp2);
+      break;
+    }
+    case Isotherm::Type::Quadratic:
+    {
+      double numerator = p1 * pressure + 2.0 * p2 * pressure * pressure;
+      double denominator = 1.0 + p1 * pressure + p2 * pressure * pressure;
+      gradient[0] = numerator / denominator;
+      gradient[1] = p0 * pressure * (denominator - numerator) / (denominator * denominator);
+      gradient[2] = p0 * pressure * pressure * (2.0 * denominator - numerator) / (denominator * denominator);
+      break;
+    }
+    case Isotherm::Type::Temkin:
+    {
+      double temp = 1.0 + p1 * pressure;
+      double theta = p1 * pressure / temp;
+      gradient[0] = theta + p2 * theta * theta * (theta - 1.0);
+      gradient[1] = p0 * (1.0 + p2 * (3.0 * theta * theta - 2.0 * theta)) * pressure / (temp * temp);
+      gradient[2] = p0 * theta * theta * (theta - 1.0);
+      break;
+    }
+    default:
+      throw std::runtime_error("Error: unkown isotherm type");
+  }
+}
+
+std::pair<double, double> Isotherm::parameterBounds(size_t index) const
+{
+  const double infinity = std::numeric_limits<double>::infinity();
+
+  switch (type)
+  {
+    case Isotherm::Type::Langmuir:
+    case Isotherm::Type::Anti_Langmuir:
+      return index == 0 ? std::make_pair(0.0, 1.0e20) : std::make_pair(0.0, 1.0e10);
+    case Isotherm::Type::BET:
+      return std::make_pair(-infinity, infinity);
+    case Isotherm::Type::Sips:
+    case Isotherm::Type::Langmuir_Freundlich:
+    {
+      const double lowerBound = (type == Isotherm::Type::Langmuir_Freundlich && index == 0) ? 1.0e-20 : 0.0;
+      const std::array<double, 3> upperBounds{1.0e20, 1.0e10, 100.0};
+      return std::make_pair(lowerBound, upperBounds[index]);
+    }
+    case Isotherm::Type::Redlich_Peterson:
+      return index < 2 ? std::make_pair(0.0, infinity) : std::make_pair(-infinity, infinity);
+    case Isotherm::Type::Toth:
+      return index < 2 ? std::make_pair(0.0, infinity) : std::make_pair(0.0, 100.0);
+    case Isotherm::Type::Henry:
+    case Isotherm::Type::Freundlich:
+    case Isotherm::Type::Unilan:
+    case Isotherm::Type::OBrien_Myers:
+    case Isotherm::Type::Quadratic:
+    case Isotherm::Type::Temkin:
+      return std::make_pair(0.0, infinity);
+    default:
+      throw std::runtime_error("Error: unkown isotherm type\n");
+  }
+}
+
 std::string Isotherm::print() const
 {
   std::ostringstream stream;
@@ -7,7 +7,9 @@ module;
 #include <exception>
 #include <iostream>
 #include <numbers>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 #endif
 
@@ -22,6 +24,8 @@ import <iostream>;
 import <string>;
 import <exception>;
 import <numbers>;
+import <span>;
+import <utility>;
 #endif
 
 import special_functions;
@@ -383,6 +387,37 @@ export struct Isotherm
     }
   }
 
+  /**
+   * \brief Adds the loadings at the given pressures to 'loadings'.
+   *
+   * The type is dispatched once for the whole batch, and each inner loop is a plain element-wise loop that the
+   * compiler can vectorize.
+   */
+  void accumulateValues(std::span<const double> pressures, std::span<double> loadings) const;
+
+  /**
+   * \brief Adds the reduced grand potentials psi at the given pressures to 'psi'.
+   */
+  void accumulatePsiForPressures(std::span<const double> pressures, std::span<double> psi) const;
+
+  /**
+   * \brief Adds the derivatives of the loading with respect to the pressure, dq/dp, to 'derivatives'.
+   */
+  void accumulateDerivatives(std::span<const double> pressures, std::span<double> derivatives) const;
+
+  /**
+   * \brief Computes the derivatives of the loading with respect to the parameters at the given pressure.
+   *
+   * \param pressure The pressure.
+   * \param gradient The derivatives d q / d parameters[k], for k < numberOfParameters.
+   */
+  void parameterGradient(double pressure, std::span<double> gradient) const;
+
+  /**
+   * \brief The range of physical values of a parameter (the same ranges as used by 'isUnphysical').
+   */
+  std::pair<double, double> parameterBounds(size_t index) const;
+
   void randomize(RandomNumber &random, double maximumLoading);
 
   bool isUnphysical() const;
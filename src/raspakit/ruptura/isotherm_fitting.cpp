@@ -11,13 +11,18 @@ module;
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <optional>
 #include <print>
+#include <span>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <unordered_set>
 #include <vector>
 #endif
@@ -44,6 +49,11 @@ import <unordered_set>;
 import <chrono>;
 import <optional>;
 import <print>;
+import <future>;
+import <span>;
+import <thread>;
+import <tuple>;
+import <limits>;
 #endif
 
 import randomnumbers;
@@ -56,10 +66,12 @@ import isotherm;
 import multi_site_isotherm;
 import system;
 import simulationbox;
+import threadpool;
 
-IsothermFitting::IsothermFitting(System &system) noexcept
+IsothermFitting::IsothermFitting(System &system, std::optional<size_t> randomSeed) noexcept
     : system(system),
-      random(std::nullopt),
+      randomSeed(randomSeed),
+      random(randomSeed),
       isotherms(system.components.size()),
       GA_Size(static_cast<size_t>(std::pow(2.0, 12.0))),
       GA_MutationRate(1.0 / 3.0),
@@ -115,22 +127,88 @@ void IsothermFitting::writeComponentIsothermFittingStatus(std::ostream &stream,
 
 void IsothermFitting::run(std::ostream &stream)
 {
+  std::vector<size_t> componentIds{};
+  std::vector<std::future<std::pair<std::string, DNA>>> fits{};
   for (size_t componentId = 0; componentId < system.components.size(); ++componentId)
   {
     if (!system.components[componentId].filename.empty())
     {
-      const std::vector<std::pair<double, double>> rawData = readData(componentId);
-      writeComponentIsothermFittingStatus(stream, rawData);
+      componentIds.push_back(componentId);
+      fits.push_back(std::async(std::launch::async,
+                                [this, componentId]()
+                                {
+                                  IsothermFitting fitting(system, componentSeed(randomSeed, componentId));
+                                  std::ostringstream componentStream;
+                                  DNA optimizedBestCitizen = fitting.fitComponent(componentStream, componentId);
+                                  return std::make_pair(componentStream.str(), optimizedBestCitizen);
+                                }));
+    }
+  }
+
+  for (size_t i = 0; i < fits.size(); ++i)
+  {
+    std::pair<std::string, DNA> result = fits[i].get();
+    std::print(stream, "{}", result.first);
 
-      const DNA bestCitizen = fit(stream, componentId, rawData);
-      const DNA optimizedBestCitizen = simplex(stream, bestCitizen, 1.0, rawData);
-      optimizedBestCitizen.phenotype.print();
+    isotherms[componentIds[i]] = result.second.phenotype;
+    createPlotScript(componentIds[i], result.second);
+  }
+}
 
-      printSolution(stream, componentId, optimizedBestCitizen);
+IsothermFitting::DNA IsothermFitting::fitComponent(std::ostream &stream, size_t componentId)
+{
+  const std::vector<std::pair<double, double>> rawData = readData(componentId);
+  writeComponentIsothermFittingStatus(stream, rawData);
+
+  const DNA bestCitizen = fit(stream, componentId, rawData);
+
+  // gradient-based refinement, started from the best distinct elitists of the final population
+  std::vector<DNA> starts{bestCitizen};
+  for (size_t i = 0; i < GA_Elitists && starts.size() < numberOfRefinementStarts; ++i)
+  {
+    if (std::none_of(starts.begin(), starts.end(), [&](const DNA &start) { return start.hash == parents[i].hash; }))
+    {
+      starts.push_back(parents[i]);
+    }
+  }
 
-      createPlotScript(componentId, optimizedBestCitizen);
+  std::optional<Refinement> bestRefinement{};
+  for (const DNA &start : starts)
+  {
+    Refinement refinement = levenbergMarquardt(start, rawData);
+    if (!bestRefinement.has_value() || refinement.citizen.fitness < bestRefinement->citizen.fitness)
+    {
+      bestRefinement = refinement;
     }
   }
+
+  DNA optimizedBestCitizen{};
+  if (bestRefinement.has_value() && bestRefinement->citizen.fitness <= bestCitizen.fitness)
+  {
+    printRefinement(stream, bestRefinement.value());
+    optimizedBestCitizen = bestRefinement->citizen;
+  }
+  else
+  {
+    // the refinement did not improve on the genetic algorithm (e.g. a singular Jacobian)
+    optimizedBestCitizen = simplex(stream, bestCitizen, 1.0, rawData);
+  }
+  isotherms[componentId] = optimizedBestCitizen.phenotype;
+
+  printSolution(stream, componentId, optimizedBestCitizen);
+
+  return optimizedBestCitizen;
+}
+
+// an independent random-number stream per component (splitmix64 of the seed and the component id)
+std::optional<size_t> IsothermFitting::componentSeed(std::optional<size_t> randomSeed, size_t componentId)
+{
+  if (!randomSeed.has_value()) return std::nullopt;
+
+  uint64_t z = static_cast<uint64_t>(randomSeed.value()) + 0x9e3779b97f4a7c15ull * (componentId + 1);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return static_cast<size_t>(z ^ (z >> 31));
 }
 
 std::vector<std::pair<double, double>> IsothermFitting::readData(size_t componentId)
@@ -187,8 +265,8 @@ std::vector<std::pair<double, double>> IsothermFitting::readData(size_t componen
   return rawData;
 }
 
-// create a new citizen in the Ensemble
-IsothermFitting::DNA IsothermFitting::newCitizen(size_t Id, const std::vector<std::pair<double, double>> &rawData)
+// create a new citizen in the Ensemble (its fitness is computed afterwards, see 'updateCitizens')
+IsothermFitting::DNA IsothermFitting::newCitizen(size_t Id)
 {
   DNA citizen;
 
@@ -208,16 +286,59 @@ IsothermFitting::DNA IsothermFitting::newCitizen(size_t Id, const std::vector<st
   }
 
   citizen.hash = std::hash<MultiSiteIsotherm>{}(citizen.phenotype);
-  citizen.fitness = fitness(citizen.phenotype, rawData);
 
   return citizen;
 }
 
-void IsothermFitting::updateCitizen(DNA &citizen, const std::vector<std::pair<double, double>> &rawData)
+void IsothermFitting::updateCitizen(DNA &citizen, const std::vector<std::pair<double, double>> &rawData) const
 {
   citizen.fitness = fitness(citizen.phenotype, rawData);
 }
 
+void IsothermFitting::updateCitizens(std::span<DNA> citizens,
+                                     const std::vector<std::pair<double, double>> &rawData) const
+{
+  auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+  const size_t numberOfHelperThreads =
+      pool.getThreadingType() == ThreadPool::ThreadingType::ThreadPool ? pool.getThreadCount() : 0;
+
+  const size_t block_size = citizens.size() / (numberOfHelperThreads + 1);
+  if (numberOfHelperThreads == 0 || block_size == 0)
+  {
+    for (DNA &citizen : citizens)
+    {
+      updateCitizen(citizen, rawData);
+    }
+    return;
+  }
+
+  std::vector<std::future<void>> threads(numberOfHelperThreads);
+  size_t block_start = 0;
+  for (size_t i = 0; i != numberOfHelperThreads; ++i)
+  {
+    threads[i] = pool.enqueue(
+        [this, &rawData](std::span<DNA> block)
+        {
+          for (DNA &citizen : block)
+          {
+            updateCitizen(citizen, rawData);
+          }
+        },
+        citizens.subspan(block_start, block_size));
+    block_start += block_size;
+  }
+
+  for (DNA &citizen : citizens.subspan(block_start))
+  {
+    updateCitizen(citizen, rawData);
+  }
+
+  for (std::future<void> &thread : threads)
+  {
+    thread.get();
+  }
+}
+
 // in latest clang, using -ffastmath optimizes isnan away
 inline bool my_isnan(double val)
 {
@@ -229,17 +350,41 @@ inline bool my_isnan(double val)
   return (u.x << 1) > (0x7ff0000000000000u << 1);
 }
 
+// the fitness of the citizens is evaluated concurrently, every thread batches the isotherm evaluations in its own
+// buffers that are reused from call to call
+struct IsothermScratch
+{
+  std::vector<double> pressures;
+  std::vector<double> loadings;
+};
+
+static thread_local IsothermScratch isothermScratch;
+
+static std::span<const double> isothermLoadings(const MultiSiteIsotherm &phenotype,
+                                                const std::vector<std::pair<double, double>> &rawData)
+{
+  isothermScratch.pressures.resize(rawData.size());
+  isothermScratch.loadings.resize(rawData.size());
+  std::transform(rawData.begin(), rawData.end(), isothermScratch.pressures.begin(),
+                 [](const std::pair<double, double> &dataPoint) { return dataPoint.first; });
+  phenotype.values(isothermScratch.pressures, isothermScratch.loadings);
+  return isothermScratch.loadings;
+}
+
 double IsothermFitting::fitness(const MultiSiteIsotherm &phenotype,
-                                const std::vector<std::pair<double, double>> &rawData)
+                                const std::vector<std::pair<double, double>> &rawData) const
 {
   double fitnessValue = phenotype.fitness();
   size_t m = rawData.size();                // number of observations
   size_t p = phenotype.numberOfParameters;  // number of adjustable parameters
-  for (std::pair<double, double> dataPoint : rawData)
+
+  // evaluate the isotherm for all pressures in one batch
+  std::span<const double> loadings = isothermLoadings(phenotype, rawData);
+
+  for (size_t i = 0; i < m; ++i)
   {
-    double pressure = dataPoint.first;
-    double loading = dataPoint.second;
-    double difference = loading - phenotype.value(pressure);
+    double loading = rawData[i].second;
+    double difference = loading - loadings[i];
     double weight = 1.0;
     fitnessValue += weight * difference * difference;
   }
@@ -252,7 +397,7 @@ double IsothermFitting::fitness(const MultiSiteIsotherm &phenotype,
 }
 
 double IsothermFitting::RCorrelation(const MultiSiteIsotherm &phenotype,
-                                     const std::vector<std::pair<double, double>> &rawData)
+                                     const std::vector<std::pair<double, double>> &rawData) const
 {
   double RCorrelationValue = phenotype.fitness();
   size_t m = rawData.size();
@@ -262,21 +407,21 @@ double IsothermFitting::RCorrelation(const MultiSiteIsotherm &phenotype,
   double tmp2 = 0.0;
   double tmp3 = 0.0;
 
-  for (std::pair<double, double> dataPoint : rawData)
+  std::span<const double> loadings = isothermLoadings(phenotype, rawData);
+
+  for (size_t i = 0; i < m; ++i)
   {
-    double pressure = dataPoint.first;
-    double loading = dataPoint.second;
+    double loading = rawData[i].second;
     loading_avg_o += loading / static_cast<double>(m);
-    loading_avg_e += phenotype.value(pressure) / static_cast<double>(m);
+    loading_avg_e += loadings[i] / static_cast<double>(m);
   }
 
-  for (std::pair<double, double> dataPoint : rawData)
+  for (size_t i = 0; i < m; ++i)
   {
-    double pressure = dataPoint.first;
-    double loading = dataPoint.second;
-    tmp1 += (loading - loading_avg_o) * (phenotype.value(pressure) - loading_avg_e);
+    double loading = rawData[i].second;
+    tmp1 += (loading - loading_avg_o) * (loadings[i] - loading_avg_e);
     tmp2 += (loading - loading_avg_o) * (loading - loading_avg_o);
-    tmp3 += (phenotype.value(pressure) - loading_avg_e) * (phenotype.value(pressure) - loading_avg_e);
+    tmp3 += (loadings[i] - loading_avg_e) * (loadings[i] - loading_avg_e);
   }
   RCorrelationValue = tmp1 / sqrt(tmp2 * tmp3);
 
@@ -309,11 +454,11 @@ size_t IsothermFitting::biodiversity([[maybe_unused]] size_t Id, const std::vect
   return biodiversity;
 }
 
-void IsothermFitting::nuclearDisaster(size_t Id, const std::vector<std::pair<double, double>> &rawData)
+void IsothermFitting::nuclearDisaster(size_t Id)
 {
   for (size_t i = 1; i < children.size(); ++i)
   {
-    children[i] = newCitizen(Id, rawData);
+    children[i] = newCitizen(Id);
   }
 }
 
@@ -491,20 +636,24 @@ void IsothermFitting::mate(size_t Id, const std::vector<std::pair<double, double
     {
       mutate(children[i], Id);
     }
-    updateCitizen(children[i], rawData);
   }
 
   // replace the last GA_Elitists (the worst) of the children by new children
   for (size_t i = GA_Size - GA_Elitists; i < GA_Size; ++i)
   {
-    children[i] = newCitizen(Id, rawData);
+    children[i] = newCitizen(Id);
   }
 
   // replace the last (GA_Size - 1) children by new children
+  size_t firstNewChild = GA_Elitists;
   if (random.uniform() < GA_DisasterRate)
   {
-    nuclearDisaster(Id, rawData);
+    nuclearDisaster(Id);
+    firstNewChild = 1;
   }
+
+  // the random numbers have all been drawn in a fixed order, so the fitness can be evaluated in parallel
+  updateCitizens(std::span<DNA>(children).subspan(firstNewChild), rawData);
 }
 
 void IsothermFitting::sortByFitness() { std::sort(parents.begin(), parents.end()); }
@@ -554,9 +703,11 @@ IsothermFitting::DNA IsothermFitting::fit(std::ostream &stream, size_t component
 
   for (size_t i = 0; i < popAlpha.size(); ++i)
   {
-    popAlpha[i] = newCitizen(componentId, rawData);
-    popBeta[i] = newCitizen(componentId, rawData);
+    popAlpha[i] = newCitizen(componentId);
+    popBeta[i] = newCitizen(componentId);
   }
+  updateCitizens(popAlpha, rawData);
+  updateCitizens(popBeta, rawData);
 
   parents = popAlpha;
   children = popBeta;
@@ -901,6 +1052,270 @@ const IsothermFitting::DNA IsothermFitting::simplex(std::ostream &stream, DNA ci
   return citizen;
 }
 
+// Cholesky decomposition A = L L^T of the symmetric n x n matrix 'a' (row-major), in place (lower triangle)
+// returns false when the matrix is not positive definite
+static bool choleskyDecomposition(std::vector<double> &a, size_t n)
+{
+  for (size_t j = 0; j < n; ++j)
+  {
+    double diagonal = a[j * n + j];
+    for (size_t k = 0; k < j; ++k)
+    {
+      diagonal -= a[j * n + k] * a[j * n + k];
+    }
+    if (!(diagonal > 0.0)) return false;
+    a[j * n + j] = std::sqrt(diagonal);
+
+    for (size_t i = j + 1; i < n; ++i)
+    {
+      double sum = a[i * n + j];
+      for (size_t k = 0; k < j; ++k)
+      {
+        sum -= a[i * n + k] * a[j * n + k];
+      }
+      a[i * n + j] = sum / a[j * n + j];
+    }
+  }
+  return true;
+}
+
+// solves L L^T x = b, with the Cholesky factor from 'choleskyDecomposition', in place
+static void choleskySolve(const std::vector<double> &l, std::vector<double> &b, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t k = 0; k < i; ++k)
+    {
+      b[i] -= l[i * n + k] * b[k];
+    }
+    b[i] /= l[i * n + i];
+  }
+  for (size_t i = n; i-- > 0;)
+  {
+    for (size_t k = i + 1; k < n; ++k)
+    {
+      b[i] -= l[k * n + i] * b[k];
+    }
+    b[i] /= l[i * n + i];
+  }
+}
+
+IsothermFitting::Refinement IsothermFitting::levenbergMarquardt(
+    DNA citizen, const std::vector<std::pair<double, double>> &rawData) const
+{
+  const size_t maximumNumberOfIterations{500};
+  const double maximumLambda{1.0e16};
+  const double relativeTolerance{1.0e-12};
+
+  MultiSiteIsotherm &phenotype = citizen.phenotype;
+  const size_t n = phenotype.numberOfParameters;
+  const size_t m = rawData.size();
+
+  std::vector<double> pressures(m);
+  std::vector<double> loadings(m);
+  std::transform(rawData.begin(), rawData.end(), pressures.begin(),
+                 [](const std::pair<double, double> &dataPoint) { return dataPoint.first; });
+
+  std::vector<double> lowerBounds(n);
+  std::vector<double> upperBounds(n);
+  std::vector<double> parameters(n);
+  for (size_t k = 0; k < n; ++k)
+  {
+    std::tie(lowerBounds[k], upperBounds[k]) = phenotype.parameterBounds(k);
+    parameters[k] = std::clamp(phenotype.parameters(k), lowerBounds[k], upperBounds[k]);
+    phenotype.parameters(k) = parameters[k];
+  }
+
+  auto sumOfSquaredResiduals = [&]()
+  {
+    phenotype.values(pressures, loadings);
+    double sum = 0.0;
+    for (size_t i = 0; i < m; ++i)
+    {
+      double residual = rawData[i].second - loadings[i];
+      sum += residual * residual;
+    }
+    return std::isfinite(sum) ? sum : std::numeric_limits<double>::max();
+  };
+
+  // the normal matrix J^T J and the gradient J^T r at the current parameters
+  std::vector<double> gradient(n);
+  std::vector<double> normalMatrix(n * n);
+  std::vector<double> jacobianRow(n);
+  auto computeNormalEquations = [&]()
+  {
+    phenotype.values(pressures, loadings);
+    std::fill(normalMatrix.begin(), normalMatrix.end(), 0.0);
+    std::fill(gradient.begin(), gradient.end(), 0.0);
+    for (size_t i = 0; i < m; ++i)
+    {
+      phenotype.parameterGradient(pressures[i], jacobianRow);
+      double residual = rawData[i].second - loadings[i];
+      for (size_t k = 0; k < n; ++k)
+      {
+        gradient[k] += jacobianRow[k] * residual;
+        for (size_t l = 0; l <= k; ++l)
+        {
+          normalMatrix[k * n + l] += jacobianRow[k] * jacobianRow[l];
+        }
+      }
+    }
+    for (size_t k = 0; k < n; ++k)
+    {
+      for (size_t l = 0; l < k; ++l)
+      {
+        normalMatrix[l * n + k] = normalMatrix[k * n + l];
+      }
+    }
+  };
+
+  Refinement refinement{};
+  double cost = sumOfSquaredResiduals();
+  double lambda{1.0e-3};
+  std::vector<double> dampedMatrix(n * n);
+  std::vector<double> step(n);
+  std::vector<double> trial(n);
+  for (refinement.numberOfIterations = 0; refinement.numberOfIterations < maximumNumberOfIterations;
+       ++refinement.numberOfIterations)
+  {
+    computeNormalEquations();
+
+    // increase the damping until a step lowers the cost
+    bool accepted = false;
+    double trialCost = cost;
+    while (!accepted && lambda < maximumLambda)
+    {
+      dampedMatrix = normalMatrix;
+      for (size_t k = 0; k < n; ++k)
+      {
+        dampedMatrix[k * n + k] += lambda * std::max(normalMatrix[k * n + k], 1.0e-12);
+      }
+      step = gradient;
+      if (choleskyDecomposition(dampedMatrix, n))
+      {
+        choleskySolve(dampedMatrix, step, n);
+
+        // project the step onto the bounds
+        for (size_t k = 0; k < n; ++k)
+        {
+          trial[k] = std::clamp(parameters[k] + step[k], lowerBounds[k], upperBounds[k]);
+          phenotype.parameters(k) = trial[k];
+        }
+        trialCost = sumOfSquaredResiduals();
+        accepted = trialCost < cost;
+      }
+
+      if (!accepted)
+      {
+        lambda *= 10.0;
+      }
+    }
+
+    if (!accepted)
+    {
+      // no step lowers the cost any further: a (bounded) minimum
+      refinement.converged = true;
+      break;
+    }
+
+    double largestRelativeStep = 0.0;
+    for (size_t k = 0; k < n; ++k)
+    {
+      largestRelativeStep =
+          std::max(largestRelativeStep, std::abs(trial[k] - parameters[k]) / (std::abs(parameters[k]) + 1.0e-10));
+    }
+    double relativeDecrease = (cost - trialCost) / std::max(cost, std::numeric_limits<double>::min());
+
+    parameters = trial;
+    cost = trialCost;
+    lambda = std::max(lambda / 10.0, 1.0e-12);
+
+    if (relativeDecrease < relativeTolerance || largestRelativeStep < relativeTolerance)
+    {
+      refinement.converged = true;
+      ++refinement.numberOfIterations;
+      break;
+    }
+  }
+
+  for (size_t k = 0; k < n; ++k)
+  {
+    phenotype.parameters(k) = parameters[k];
+  }
+
+  // covariance s^2 (J^T J)^-1 at the optimum
+  computeNormalEquations();
+  if (m > n && choleskyDecomposition(normalMatrix, n))
+  {
+    double residualVariance = cost / static_cast<double>(m - n);
+    refinement.covariance.resize(n * n);
+    std::vector<double> column(n);
+    for (size_t l = 0; l < n; ++l)
+    {
+      std::fill(column.begin(), column.end(), 0.0);
+      column[l] = 1.0;
+      choleskySolve(normalMatrix, column, n);
+      for (size_t k = 0; k < n; ++k)
+      {
+        refinement.covariance[k * n + l] = residualVariance * column[k];
+      }
+    }
+  }
+
+  citizen.genotype.clear();
+  citizen.genotype.reserve((sizeof(double) * CHAR_BIT) * n);
+  for (size_t k = 0; k < n; ++k)
+  {
+    uint64_t p;
+    std::memcpy(&p, &phenotype.parameters(k), sizeof(double));
+    std::bitset<sizeof(double) * CHAR_BIT> bitset(p);
+    citizen.genotype += bitset.to_string();
+  }
+  citizen.hash = std::hash<MultiSiteIsotherm>{}(phenotype);
+  citizen.fitness = fitness(phenotype, rawData);
+
+  refinement.citizen = citizen;
+  return refinement;
+}
+
+void IsothermFitting::printRefinement(std::ostream &stream, const Refinement &refinement) const
+{
+  const MultiSiteIsotherm &phenotype = refinement.citizen.phenotype;
+  const size_t n = phenotype.numberOfParameters;
+
+  std::print(stream, "\nLevenberg-Marquardt refinement {} after {} iterations\n",
+             refinement.converged ? "converged" : "stopped", refinement.numberOfIterations);
+  std::print(stream, "Fit: {}\n\n", refinement.citizen.fitness);
+
+  std::print(stream, "parameter                  value     standard error\n");
+  for (size_t k = 0; k < n; ++k)
+  {
+    if (refinement.covariance.empty())
+    {
+      std::print(stream, "    {:3d}  {:18.10e}                  -\n", k, phenotype.parameters(k));
+    }
+    else
+    {
+      std::print(stream, "    {:3d}  {:18.10e} {:18.10e}\n", k, phenotype.parameters(k),
+                 std::sqrt(std::max(refinement.covariance[k * n + k], 0.0)));
+    }
+  }
+
+  if (!refinement.covariance.empty())
+  {
+    std::print(stream, "\nCovariance matrix of the parameters:\n");
+    for (size_t k = 0; k < n; ++k)
+    {
+      for (size_t l = 0; l < n; ++l)
+      {
+        std::print(stream, " {:14.6e}", refinement.covariance[k * n + l]);
+      }
+      std::print(stream, "\n");
+    }
+  }
+  std::print(stream, "\n");
+}
+
 void IsothermFitting::printSolution(std::ostream &stream, size_t componentId, const DNA &citizen)
 {
   const Component &component = system.components[componentId];
@@ -2,7 +2,10 @@ module;
 
 #ifdef USE_LEGACY_HEADERS
 #include <array>
+#include <cstddef>
 #include <iostream>
+#include <optional>
+#include <span>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -18,6 +21,9 @@ import <vector>;
 import <string>;
 import <unordered_map>;
 import <iostream>;
+import <cstddef>;
+import <optional>;
+import <span>;
 #endif
 
 import randomnumbers;
@@ -49,13 +55,35 @@ export struct IsothermFitting
     bool operator<(const DNA &other) const { return fitness < other.fitness; }
   };
 
-  IsothermFitting(System &system) noexcept;
+  /**
+   * \brief Result of a Levenberg-Marquardt refinement of a citizen.
+   */
+  struct Refinement
+  {
+    DNA citizen;
+    std::vector<double> covariance;  ///< Covariance of the fitted parameters (row-major), empty when singular.
+    size_t numberOfIterations{0};
+    bool converged{false};
+  };
+
+  IsothermFitting(System &system, std::optional<size_t> randomSeed = std::nullopt) noexcept;
 
   System &system;
+  std::optional<size_t> randomSeed;
   RandomNumber random;
   std::vector<std::pair<double, double>> readData(size_t componentId);
   void printSolution(size_t Id);
+
+  /**
+   * \brief Fits all components that have isotherm data.
+   *
+   * The components are independent, and are fitted concurrently. Each one is fitted by its own IsothermFitting, with
+   * its own populations and a random-number stream derived from the seed and the component id, so the results do not
+   * depend on the number of threads. The output is written in component order.
+   */
   void run(std::ostream &stream);
+  DNA fitComponent(std::ostream &stream, size_t componentId);
+  static std::optional<size_t> componentSeed(std::optional<size_t> randomSeed, size_t componentId);
   void createPlotScript(size_t componentId, const DNA &citizen);
   void createPlotScript();
 
@@ -63,12 +91,20 @@ export struct IsothermFitting
   void writeComponentIsothermFittingStatus(std::ostream &stream,
                                            const std::vector<std::pair<double, double>> &rawData) const;
 
-  DNA newCitizen(size_t Id, const std::vector<std::pair<double, double>> &rawData);
-  void updateCitizen(DNA &citizen, const std::vector<std::pair<double, double>> &rawData);
-  double fitness(const MultiSiteIsotherm &phenotype, const std::vector<std::pair<double, double>> &rawData);
-  double RCorrelation(const MultiSiteIsotherm &phenotype, const std::vector<std::pair<double, double>> &rawData);
+  DNA newCitizen(size_t Id);
+  void updateCitizen(DNA &citizen, const std::vector<std::pair<double, double>> &rawData) const;
+
+  /**
+   * \brief Computes the fitness of a range of citizens, in parallel over the thread pool.
+   *
+   * The fitness only depends on the phenotype, and all random numbers are drawn before, so the result is independent
+   * of the number of threads.
+   */
+  void updateCitizens(std::span<DNA> citizens, const std::vector<std::pair<double, double>> &rawData) const;
+  double fitness(const MultiSiteIsotherm &phenotype, const std::vector<std::pair<double, double>> &rawData) const;
+  double RCorrelation(const MultiSiteIsotherm &phenotype, const std::vector<std::pair<double, double>> &rawData) const;
   size_t biodiversity(size_t Id, const std::vector<DNA> &citizens);
-  void nuclearDisaster(size_t Id, const std::vector<std::pair<double, double>> &rawData);
+  void nuclearDisaster(size_t Id);
   void elitism();
   void mutate(DNA &Mutant, size_t Id);
   void crossover(size_t Id, size_t s1, size_t s2, size_t i1, size_t i2, size_t j1, size_t j2);
@@ -82,6 +118,17 @@ export struct IsothermFitting
                     const std::vector<std::pair<double, double>> &rawData);
   void printSolution(std::ostream &stream, size_t componentId, const DNA &citizen);
 
+  /**
+   * \brief Minimizes the sum of squared residuals with the Levenberg-Marquardt method, using the analytical
+   * derivatives of the isotherm with respect to its parameters.
+   *
+   * The parameters are kept inside their physical bounds by projecting each step onto the bounds. The covariance of
+   * the parameters is estimated as s^2 (J^T J)^-1, with s^2 the residual variance, at the optimum.
+   */
+  Refinement levenbergMarquardt(DNA citizen, const std::vector<std::pair<double, double>> &rawData) const;
+  void printRefinement(std::ostream &stream, const Refinement &refinement) const;
+  size_t numberOfRefinementStarts{4};  ///< Number of distinct elitists the refinement is started from.
+
   std::vector<MultiSiteIsotherm> isotherms;
   double maximumLoading{0.0};
 
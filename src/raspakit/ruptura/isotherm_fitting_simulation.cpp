@@ -10,6 +10,7 @@ module;
 #include <iostream>
 #include <limits>
 #include <numeric>
+#include <optional>
 #include <print>
 #include <span>
 #include <sstream>
@@ -34,6 +35,7 @@ import <sstream>;
 import <chrono>;
 import <complex>;
 import <print>;
+import <optional>;
 #endif
 
 import stringutils;
@@ -45,7 +47,10 @@ import simulationbox;
 import multi_site_isotherm;
 import isotherm_fitting;
 
-IsothermFittingSimulation::IsothermFittingSimulation(InputReader &inputReader) : systems(std::move(inputReader.systems))
+IsothermFittingSimulation::IsothermFittingSimulation(InputReader &inputReader)
+    : systems(std::move(inputReader.systems)),
+      randomSeed(inputReader.randomSeed.has_value() ? std::optional<size_t>(inputReader.randomSeed.value())
+                                                    : std::nullopt)
 {
   for (System &system : systems)
   {
@@ -59,7 +64,7 @@ void IsothermFittingSimulation::run()
 {
   for (System &system : systems)
   {
-    IsothermFitting fitting(system);
+    IsothermFitting fitting(system, randomSeed);
 
     std::string fileNameString =
         std::format("output/system_{}/output_{}_{}.txt", system.systemId, system.temperature, system.input_pressure);
@@ -1,7 +1,9 @@
 module;
 
 #ifdef USE_LEGACY_HEADERS
+#include <cstddef>
 #include <fstream>
+#include <optional>
 #include <span>
 #include <string>
 #include <tuple>
@@ -16,6 +18,8 @@ import <span>;
 import <tuple>;
 import <string>;
 import <fstream>;
+import <cstddef>;
+import <optional>;
 #endif
 
 import input_reader;
@@ -33,4 +37,5 @@ export struct IsothermFittingSimulation
 
  private:
   std::vector<System> systems;
+  std::optional<size_t> randomSeed;
 };
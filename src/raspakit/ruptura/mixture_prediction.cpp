@@ -2,10 +2,13 @@ module;
 
 #ifdef USE_LEGACY_HEADERS
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -15,6 +18,7 @@ module;
 #include <span>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 #endif
 
@@ -36,6 +40,10 @@ import <numeric>;
 import <ostream>;
 import <filesystem>;
 import <print>;
+import <exception>;
+import <future>;
+import <thread>;
+import <atomic>;
 #endif
 
 import stringutils;
@@ -47,6 +55,8 @@ import system;
 import simulationbox;
 import pressure_range;
 import bond_potential;
+import spreading_pressure_table;
+import threadpool;
 
 bool LangmuirLoadingSorter(Component const &lhs, Component const &rhs)
 {
@@ -101,17 +111,14 @@ MixturePrediction::MixturePrediction(const System &system)
       Nsorted(components.size() - system.numberOfCarrierGases),
       predictionMethod(system.mixturePredictionMethod),
       maxIsothermTerms(system.maxIsothermTerms),
-      alpha1(Ncomp),
-      alpha2(Ncomp),
-      alpha_prod(Ncomp),
-      x(Ncomp),
-      pstar(Nsorted),
-      psi(Nsorted),
-      G(Nsorted),
-      delta(Nsorted),
-      Phi(Nsorted * Nsorted),
+      workspace(Ncomp, Nsorted),
       temperature(system.temperature)
 {
+  if (system.useSpreadingPressureTables && (predictionMethod == MultiSiteIsotherm::PredictionMethod::IAST))
+  {
+    createSpreadingPressureTables();
+  }
+
   if (predictionMethod == MultiSiteIsotherm::PredictionMethod::EI)
   {
     std::sort(sortedComponents.begin(), sortedComponents.end(), &LangmuirLoadingSorter);
@@ -141,6 +148,39 @@ MixturePrediction::MixturePrediction(const System &system)
   }
 }
 
+// tables are built for the isotherms that need numerical inversion (multi-site isotherms, Toth, Redlich-Peterson,
+// Unilan, ...), the isotherms with an analytical inverse are cheaper to evaluate than to interpolate
+void MixturePrediction::createSpreadingPressureTables()
+{
+  spreadingPressureTables.resize(Ncomp);
+  for (const Component &component : components)
+  {
+    const MultiSiteIsotherm &isotherm = component.isotherm;
+    if (component.isCarrierGas || isotherm.numberOfSites == 0) continue;
+
+    bool analyticalInverse = false;
+    if (isotherm.numberOfSites == 1)
+    {
+      switch (isotherm.sites[0].type)
+      {
+        case Isotherm::Type::Langmuir:
+        case Isotherm::Type::Anti_Langmuir:
+        case Isotherm::Type::Henry:
+        case Isotherm::Type::Freundlich:
+        case Isotherm::Type::Sips:
+        case Isotherm::Type::Langmuir_Freundlich:
+          analyticalInverse = true;
+          break;
+        default:
+          break;
+      }
+    }
+    if (analyticalInverse) continue;
+
+    spreadingPressureTables[component.componentId] = SpreadingPressureTable::create(isotherm);
+  }
+}
+
 std::string MixturePrediction::writeHeader() const
 {
   std::ostringstream stream;
@@ -177,6 +217,14 @@ std::string MixturePrediction::writeHeader() const
 std::pair<size_t, size_t> MixturePrediction::predictMixture(const std::vector<double> &Yi, const double &P,
                                                             std::vector<double> &Xi, std::vector<double> &Ni,
                                                             double *cachedP0, double *cachedPsi)
+{
+  return predictMixture(Yi, P, Xi, Ni, cachedP0, cachedPsi, workspace);
+}
+
+std::pair<size_t, size_t> MixturePrediction::predictMixture(const std::vector<double> &Yi, const double &P,
+                                                            std::vector<double> &Xi, std::vector<double> &Ni,
+                                                            double *cachedP0, double *cachedPsi,
+                                                            Workspace &workspace) const
 {
   const double tiny = 1.0e-10;
 
@@ -219,7 +267,7 @@ std::pair<size_t, size_t> MixturePrediction::predictMixture(const std::vector<do
       {
         case IASTMethod::FastIAST:
         default:
-          return computeFastIAST(Yi, P, Xi, Ni, cachedP0, cachedPsi);
+          return computeFastIAST(Yi, P, Xi, Ni, cachedP0, cachedPsi, workspace);
         case IASTMethod::NestedLoopBisection:
           return computeIASTNestedLoopBisection(Yi, P, Xi, Ni, cachedP0, cachedPsi);
       }
@@ -228,14 +276,14 @@ std::pair<size_t, size_t> MixturePrediction::predictMixture(const std::vector<do
       {
         case IASTMethod::FastIAST:
         default:
-          return computeFastSIAST(Yi, P, Xi, Ni, cachedP0, cachedPsi);
+          return computeFastSIAST(Yi, P, Xi, Ni, cachedP0, cachedPsi, workspace);
         case IASTMethod::NestedLoopBisection:
           return computeSIASTNestedLoopBisection(Yi, P, Xi, Ni, cachedP0, cachedPsi);
       }
     case MultiSiteIsotherm::PredictionMethod::EI:
-      return computeExplicitIsotherm(Yi, P, Xi, Ni);
+      return computeExplicitIsotherm(Yi, P, Xi, Ni, workspace);
     case MultiSiteIsotherm::PredictionMethod::SEI:
-      return computeSegratedExplicitIsotherm(Yi, P, Xi, Ni);
+      return computeSegratedExplicitIsotherm(Yi, P, Xi, Ni, workspace);
   }
 }
 
@@ -245,8 +293,15 @@ std::pair<size_t, size_t> MixturePrediction::predictMixture(const std::vector<do
 // Ni  = number of adsorbed molecules of component i
 std::pair<size_t, size_t> MixturePrediction::computeFastIAST(const std::vector<double> &Yi, const double &P,
                                                              std::vector<double> &Xi, std::vector<double> &Ni,
-                                                             double *cachedP0, double *cachedPsi)
+                                                             double *cachedP0, double *cachedPsi,
+                                                             Workspace &workspace) const
 {
+  std::vector<double> &pstar = workspace.pstar;
+  std::vector<double> &psi = workspace.psi;
+  std::vector<double> &G = workspace.G;
+  std::vector<double> &delta = workspace.delta;
+  std::vector<double> &Phi = workspace.Phi;
+
   const double tiny = 1.0e-13;
 
   size_t numberOfIASTSteps = 0;
@@ -269,7 +324,7 @@ std::pair<size_t, size_t> MixturePrediction::computeFastIAST(const std::vector<d
     for (size_t i = 0; i < Nsorted; ++i)
     {
       double temp_psi =
-          Yi[sortedComponents[i].get().componentId] * sortedComponents[i].get().isotherm.psiForPressure(P);
+          Yi[sortedComponents[i].get().componentId] * psiForPressure(sortedComponents[i].get(), P);
       initial_psi += temp_psi;
     }
     cachedPsi[0] = initial_psi;
@@ -277,7 +332,7 @@ std::pair<size_t, size_t> MixturePrediction::computeFastIAST(const std::vector<d
     double cachevalue = 0.0;
     for (size_t i = 0; i < Nsorted; ++i)
     {
-      pstar[i] = 1.0 / sortedComponents[i].get().isotherm.inversePressureForPsi(initial_psi, cachevalue);
+      pstar[i] = 1.0 / inversePressureForPsi(sortedComponents[i].get(), initial_psi, cachevalue);
     }
   }
 
@@ -288,8 +343,8 @@ std::pair<size_t, size_t> MixturePrediction::computeFastIAST(const std::vector<d
     // compute G
     for (size_t i = 0; i < Nsorted - 1; ++i)
     {
-      G[i] = sortedComponents[i].get().isotherm.psiForPressure(pstar[i]) -
-             sortedComponents[Nsorted - 1].get().isotherm.psiForPressure(pstar[Nsorted - 1]);
+      G[i] = psiForPressure(sortedComponents[i].get(), pstar[i]) -
+             psiForPressure(sortedComponents[Nsorted - 1].get(), pstar[Nsorted - 1]);
     }
 
     G[Nsorted - 1] = 0.0;
@@ -346,7 +401,7 @@ std::pair<size_t, size_t> MixturePrediction::computeFastIAST(const std::vector<d
     // compute error in psi's
     for (size_t i = 0; i < Nsorted; i++)
     {
-      psi[i] = sortedComponents[i].get().isotherm.psiForPressure(pstar[i]);
+      psi[i] = psiForPressure(sortedComponents[i].get(), pstar[i]);
     }
 
     sum_xi = 0.0;
@@ -413,7 +468,8 @@ std::pair<size_t, size_t> MixturePrediction::computeFastIAST(const std::vector<d
 // Ni  = number of adsorbed molecules of component i
 std::pair<size_t, size_t> MixturePrediction::computeFastSIAST(const std::vector<double> &Yi, const double &P,
                                                               std::vector<double> &Xi, std::vector<double> &Ni,
-                                                              double *cachedP0, double *cachedPsi)
+                                                              double *cachedP0, double *cachedPsi,
+                                                              Workspace &workspace) const
 {
   std::fill(Xi.begin(), Xi.end(), 0.0);
   std::fill(Ni.begin(), Ni.end(), 0.0);
@@ -421,7 +477,7 @@ std::pair<size_t, size_t> MixturePrediction::computeFastSIAST(const std::vector<
   std::pair<size_t, size_t> acc;
   for (size_t i = 0; i < maxIsothermTerms; ++i)
   {
-    acc += computeFastSIAST(i, Yi, P, Xi, Ni, cachedP0, cachedPsi);
+    acc += computeFastSIAST(i, Yi, P, Xi, Ni, cachedP0, cachedPsi, workspace);
   }
 
   double N = 0.0;
@@ -445,8 +501,14 @@ std::pair<size_t, size_t> MixturePrediction::computeFastSIAST(const std::vector<
 std::pair<size_t, size_t> MixturePrediction::computeFastSIAST(size_t site, const std::vector<double> &Yi,
                                                               const double &P, std::vector<double> &Xi,
                                                               std::vector<double> &Ni, double *cachedP0,
-                                                              double *cachedPsi)
+                                                              double *cachedPsi, Workspace &workspace) const
 {
+  std::vector<double> &pstar = workspace.pstar;
+  std::vector<double> &psi = workspace.psi;
+  std::vector<double> &G = workspace.G;
+  std::vector<double> &delta = workspace.delta;
+  std::vector<double> &Phi = workspace.Phi;
+
   const double tiny = 1.0e-13;
 
   size_t numberOfIASTSteps = 0;
@@ -615,14 +677,14 @@ std::pair<size_t, size_t> MixturePrediction::computeFastSIAST(size_t site, const
 std::pair<size_t, size_t> MixturePrediction::computeIASTNestedLoopBisection(const std::vector<double> &Yi,
                                                                             const double &P, std::vector<double> &Xi,
                                                                             std::vector<double> &Ni, double *cachedP0,
-                                                                            double *cachedPsi)
+                                                                            double *cachedPsi) const
 {
   const double tiny = 1.0e-15;
 
   double initial_psi = 0.0;
   for (size_t i = 0; i < Ncomp; ++i)
   {
-    initial_psi += Yi[i] * components[i].isotherm.psiForPressure(P);
+    initial_psi += Yi[i] * psiForPressure(components[i], P);
   }
 
   if (initial_psi < tiny)
@@ -651,7 +713,7 @@ std::pair<size_t, size_t> MixturePrediction::computeIASTNestedLoopBisection(cons
   double sumXi = 0.0;
   for (size_t i = 0; i < Ncomp; ++i)
   {
-    sumXi += Yi[i] * P * components[i].isotherm.inversePressureForPsi(initial_psi, cachedP0[i]);
+    sumXi += Yi[i] * P * inversePressureForPsi(components[i], initial_psi, cachedP0[i]);
   }
 
   // initialize the bisection algorithm
@@ -666,7 +728,7 @@ std::pair<size_t, size_t> MixturePrediction::computeIASTNestedLoopBisection(cons
       sumXi = 0.0;
       for (size_t i = 0; i < Ncomp; ++i)
       {
-        sumXi += Yi[i] * P * components[i].isotherm.inversePressureForPsi(right_bracket, cachedP0[i]);
+        sumXi += Yi[i] * P * inversePressureForPsi(components[i], right_bracket, cachedP0[i]);
       }
       ++nr_steps;
       if (nr_steps > 100000)
@@ -689,7 +751,7 @@ std::pair<size_t, size_t> MixturePrediction::computeIASTNestedLoopBisection(cons
       sumXi = 0.0;
       for (size_t i = 0; i < Ncomp; ++i)
       {
-        sumXi += Yi[i] * P * components[i].isotherm.inversePressureForPsi(left_bracket, cachedP0[i]);
+        sumXi += Yi[i] * P * inversePressureForPsi(components[i], left_bracket, cachedP0[i]);
       }
       ++nr_steps;
       if (nr_steps > 100000)
@@ -711,7 +773,7 @@ std::pair<size_t, size_t> MixturePrediction::computeIASTNestedLoopBisection(cons
     sumXi = 0.0;
     for (size_t i = 0; i < Ncomp; ++i)
     {
-      sumXi += Yi[i] * P * components[i].isotherm.inversePressureForPsi(psi_value, cachedP0[i]);
+      sumXi += Yi[i] * P * inversePressureForPsi(components[i], psi_value, cachedP0[i]);
     }
 
     if (sumXi > 1.0)
@@ -735,7 +797,7 @@ std::pair<size_t, size_t> MixturePrediction::computeIASTNestedLoopBisection(cons
   sumXi = 0.0;
   for (size_t i = 0; i < Ncomp; ++i)
   {
-    sumXi += Yi[i] * P * components[i].isotherm.inversePressureForPsi(psi_value, cachedP0[i]);
+    sumXi += Yi[i] * P * inversePressureForPsi(components[i], psi_value, cachedP0[i]);
   }
 
   // cache the value of psi for subsequent use
@@ -745,7 +807,7 @@ std::pair<size_t, size_t> MixturePrediction::computeIASTNestedLoopBisection(cons
   double inverse_q_total = 0.0;
   for (size_t i = 0; i < Ncomp; ++i)
   {
-    double ip = components[i].isotherm.inversePressureForPsi(psi_value, cachedP0[i]);
+    double ip = inversePressureForPsi(components[i], psi_value, cachedP0[i]);
     Xi[i] = Yi[i] * P * ip / sumXi;
 
     if (Xi[i] > tiny)
@@ -784,7 +846,7 @@ std::pair<size_t, size_t> MixturePrediction::computeIASTNestedLoopBisection(cons
 std::pair<size_t, size_t> MixturePrediction::computeSIASTNestedLoopBisection(const std::vector<double> &Yi,
                                                                              const double &P, std::vector<double> &Xi,
                                                                              std::vector<double> &Ni, double *cachedP0,
-                                                                             double *cachedPsi)
+                                                                             double *cachedPsi) const
 {
   std::fill(Xi.begin(), Xi.end(), 0.0);
   std::fill(Ni.begin(), Ni.end(), 0.0);
@@ -816,7 +878,7 @@ std::pair<size_t, size_t> MixturePrediction::computeSIASTNestedLoopBisection(con
 std::pair<size_t, size_t> MixturePrediction::computeSIASTNestedLoopBisection(size_t site, const std::vector<double> &Yi,
                                                                              const double &P, std::vector<double> &Xi,
                                                                              std::vector<double> &Ni, double *cachedP0,
-                                                                             double *cachedPsi)
+                                                                             double *cachedPsi) const
 {
   const double tiny = 1.0e-15;
 
@@ -974,8 +1036,14 @@ std::pair<size_t, size_t> MixturePrediction::computeSIASTNestedLoopBisection(siz
 // At present, only single site isotherms are considered for pure components
 
 std::pair<size_t, size_t> MixturePrediction::computeExplicitIsotherm(const std::vector<double> &Yi, const double &P,
-                                                                     std::vector<double> &Xi, std::vector<double> &Ni)
+                                                                     std::vector<double> &Xi, std::vector<double> &Ni,
+                                                                     Workspace &workspace) const
 {
+  std::vector<double> &x = workspace.x;
+  std::vector<double> &alpha1 = workspace.alpha1;
+  std::vector<double> &alpha2 = workspace.alpha2;
+  std::vector<double> &alpha_prod = workspace.alpha_prod;
+
   x[0] = 1.0;
   for (size_t i = 1; i < Ncomp; ++i)
   {
@@ -1030,7 +1098,8 @@ std::pair<size_t, size_t> MixturePrediction::computeExplicitIsotherm(const std::
 
 std::pair<size_t, size_t> MixturePrediction::computeSegratedExplicitIsotherm(const std::vector<double> &Yi,
                                                                              const double &P, std::vector<double> &Xi,
-                                                                             std::vector<double> &Ni)
+                                                                             std::vector<double> &Ni,
+                                                                             Workspace &workspace) const
 {
   std::fill(Xi.begin(), Xi.end(), 0.0);
   std::fill(Ni.begin(), Ni.end(), 0.0);
@@ -1038,7 +1107,7 @@ std::pair<size_t, size_t> MixturePrediction::computeSegratedExplicitIsotherm(con
   std::pair<size_t, size_t> acc;
   for (size_t i = 0; i < maxIsothermTerms; ++i)
   {
-    acc += computeSegratedExplicitIsotherm(i, Yi, P, Xi, Ni);
+    acc += computeSegratedExplicitIsotherm(i, Yi, P, Xi, Ni, workspace);
   }
 
   double N = 0.0;
@@ -1056,8 +1125,14 @@ std::pair<size_t, size_t> MixturePrediction::computeSegratedExplicitIsotherm(con
 
 std::pair<size_t, size_t> MixturePrediction::computeSegratedExplicitIsotherm(size_t site, const std::vector<double> &Yi,
                                                                              const double &P, std::vector<double> &Xi,
-                                                                             std::vector<double> &Ni)
+                                                                             std::vector<double> &Ni,
+                                                                             Workspace &workspace) const
 {
+  std::vector<double> &x = workspace.x;
+  std::vector<double> &alpha1 = workspace.alpha1;
+  std::vector<double> &alpha2 = workspace.alpha2;
+  std::vector<double> &alpha_prod = workspace.alpha_prod;
+
   x[0] = 1.0;
   for (size_t i = 1; i < Ncomp; ++i)
   {
@@ -1126,50 +1201,104 @@ void MixturePrediction::print() const
 void MixturePrediction::run(std::ostream &stream)
 {
   std::vector<double> Yi(Ncomp);
-  std::vector<double> Xi(Ncomp);
-  std::vector<double> Ni(Ncomp);
-  std::vector<double> cachedP0(Ncomp * maxIsothermTerms);
-  std::vector<double> cachedPsi(maxIsothermTerms);
-
   for (size_t i = 0; i < Ncomp; ++i)
   {
     Yi[i] = components[i].molFraction;
   }
 
-  // create the output files
-  std::filesystem::create_directory("MixturePrediction");
-  std::filesystem::create_directory(std::format("MixturePrediction/System_{}", system.systemId));
-  std::vector<std::ofstream> streams;
-  for (size_t i = 0; i < Ncomp; i++)
+  const std::vector<double> pressures = system.pressure_range.pressures();
+  const size_t numberOfPressures = pressures.size();
+  std::vector<std::vector<double>> Xi(numberOfPressures, std::vector<double>(Ncomp));
+  std::vector<std::vector<double>> Ni(numberOfPressures, std::vector<double>(Ncomp));
+  std::vector<size_t> iterations(numberOfPressures);
+
+  // the pressure points are independent; each block of consecutive points has its own scratch memory, and uses the
+  // solution at the previous pressure of the block as the starting point. The blocks have a fixed size, so that the
+  // starting points, and therefore the results, do not depend on the number of threads
+  constexpr size_t pressuresPerBlock = 16;
+  const size_t numberOfBlocks = (numberOfPressures + pressuresPerBlock - 1) / pressuresPerBlock;
+  auto computeBlock = [&](size_t block)
   {
-    std::string fileName = std::format("MixturePrediction/System_{}/component_{}_{}.txt", system.systemId,
-                                       std::to_string(i), components[i].name);
-    // FIX TODO
-    // streams.emplace_back(std::ofstream{ fileName });
+    Workspace blockWorkspace = createWorkspace();
+    std::vector<double> cachedP0(Ncomp * maxIsothermTerms);
+    std::vector<double> cachedPsi(maxIsothermTerms);
+    for (size_t k = block * pressuresPerBlock; k < std::min((block + 1) * pressuresPerBlock, numberOfPressures); ++k)
+    {
+      iterations[k] =
+          predictMixture(Yi, pressures[k], Xi[k], Ni[k], cachedP0.data(), cachedPsi.data(), blockWorkspace).first;
+    }
+  };
+
+  // the threads take the next block from a shared counter until all are done
+  std::atomic<size_t> nextBlock{0};
+  auto computeBlocks = [&]()
+  {
+    for (size_t block = nextBlock++; block < numberOfBlocks; block = nextBlock++)
+    {
+      computeBlock(block);
+    }
+  };
+
+  auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+  const size_t numberOfHelperThreads =
+      pool.getThreadingType() == ThreadPool::ThreadingType::ThreadPool ? pool.getThreadCount() : 0;
+  std::vector<std::future<void>> threads{};
+  for (size_t i = 0; i + 1 < std::min(numberOfHelperThreads + 1, numberOfBlocks); ++i)
+  {
+    threads.push_back(pool.enqueue(computeBlocks));
   }
 
-  for (size_t i = 0; i < Ncomp; i++)
+  // the helper threads write into the result vectors of this function, so all of them must finish first
+  std::exception_ptr error{};
+  try
   {
-    streams[i] << "# column 1: total pressure [Pa]\n";
-    streams[i] << "# column 2: pure component isotherm value\n";
-    streams[i] << "# column 3: mixture component isotherm value\n";
-    streams[i] << "# column 4: gas-phase mol-fraction y_i\n";
-    streams[i] << "# column 5: adsorbed phase mol-fraction x_i\n";
-    streams[i] << "# column 6: hypothetical pressure p_i^*\n";
-    streams[i] << "# column 7: reduced grand potential psi_i\n";
-    streams[i] << std::setprecision(14);
+    computeBlocks();
   }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+  for (std::future<void> &thread : threads)
+  {
+    try
+    {
+      thread.get();
+    }
+    catch (...)
+    {
+      if (!error) error = std::current_exception();
+    }
+  }
+  if (error) std::rethrow_exception(error);
 
-  for (const double &pressure : system.pressure_range.pressures())
+  // write the output in the order of the pressures
+  for (size_t k = 0; k < numberOfPressures; ++k)
   {
-    std::pair<double, double> performance = predictMixture(Yi, pressure, Xi, Ni, &cachedP0[0], &cachedPsi[0]);
-    std::print(stream, "Pressure: {:10e}  iterations: {}\n", pressure, performance.first);
+    std::print(stream, "Pressure: {:10e}  iterations: {}\n", pressures[k], iterations[k]);
+  }
 
-    for (size_t j = 0; j < Ncomp; j++)
+  std::filesystem::create_directory("MixturePrediction");
+  std::filesystem::create_directory(std::format("MixturePrediction/System_{}", system.systemId));
+  for (size_t j = 0; j < Ncomp; j++)
+  {
+    std::string fileName = std::format("MixturePrediction/System_{}/component_{}_{}.txt", system.systemId,
+                                       std::to_string(j), components[j].name);
+    std::ofstream componentStream(fileName);
+
+    componentStream << "# column 1: total pressure [Pa]\n";
+    componentStream << "# column 2: pure component isotherm value\n";
+    componentStream << "# column 3: mixture component isotherm value\n";
+    componentStream << "# column 4: gas-phase mol-fraction y_i\n";
+    componentStream << "# column 5: adsorbed phase mol-fraction x_i\n";
+    componentStream << "# column 6: hypothetical pressure p_i^*\n";
+    componentStream << "# column 7: reduced grand potential psi_i\n";
+    componentStream << std::setprecision(14);
+
+    for (size_t k = 0; k < numberOfPressures; ++k)
     {
-      double p_star = Yi[j] * pressure / Xi[j];
-      std::print(streams[j], "{} {} {} {} {} {}\n", pressure, components[j].isotherm.value(pressure), Ni[j], Yi[j],
-                 Xi[j], components[j].isotherm.psiForPressure(p_star));
+      double p_star = Yi[j] * pressures[k] / Xi[k][j];
+      std::print(componentStream, "{} {} {} {} {} {}\n", pressures[k], components[j].isotherm.value(pressures[k]),
+                 Ni[k][j], Yi[j], Xi[k][j], components[j].isotherm.psiForPressure(p_star));
     }
   }
 }
@@ -1349,7 +1478,7 @@ void MixturePrediction::createPlotScript()
 }
 
 void MixturePrediction::printErrorStatus(double psi_value, double sum, double P, const std::vector<double> Yi,
-                                         double cachedP0[])
+                                         double cachedP0[]) const
 {
   std::cout << "psi: " << psi_value << std::endl;
   std::cout << "sum: " << sum << std::endl;
@@ -2,6 +2,7 @@ module;
 
 #ifdef USE_LEGACY_HEADERS
 #include <functional>
+#include <optional>
 #include <ostream>
 #include <span>
 #include <string>
@@ -18,6 +19,7 @@ import <span>;
 import <tuple>;
 import <string>;
 import <ostream>;
+import <optional>;
 #endif
 
 import atom;
@@ -26,6 +28,7 @@ import multi_site_isotherm;
 import component;
 import system;
 import bond_potential;
+import spreading_pressure_table;
 
 export class MixturePrediction
 {
@@ -36,6 +39,39 @@ export class MixturePrediction
     NestedLoopBisection = 1
   };
 
+  /**
+   * \brief Scratch memory of a single mixture prediction.
+   *
+   * A prediction only writes to its workspace and to the caches passed in, so predictions with separate
+   * workspaces (e.g. one per thread) can run concurrently on the same MixturePrediction object.
+   */
+  struct Workspace
+  {
+    Workspace(size_t Ncomp, size_t Nsorted)
+        : alpha1(Ncomp),
+          alpha2(Ncomp),
+          alpha_prod(Ncomp),
+          x(Ncomp),
+          pstar(Nsorted),
+          psi(Nsorted),
+          G(Nsorted),
+          delta(Nsorted),
+          Phi(Nsorted * Nsorted)
+    {
+    }
+
+    std::vector<double> alpha1;
+    std::vector<double> alpha2;
+    std::vector<double> alpha_prod;
+    std::vector<double> x;
+
+    std::vector<double> pstar;
+    std::vector<double> psi;
+    std::vector<double> G;
+    std::vector<double> delta;
+    std::vector<double> Phi;
+  };
+
   MixturePrediction(const System &system);
 
   std::string writeHeader() const;
@@ -54,6 +90,13 @@ export class MixturePrediction
   std::pair<size_t, size_t> predictMixture(const std::vector<double> &Yi, const double &P, std::vector<double> &Xi,
                                            std::vector<double> &Ni, double *cachedP0, double *cachedPsi);
 
+  // reentrant version using the scratch memory of the caller
+  std::pair<size_t, size_t> predictMixture(const std::vector<double> &Yi, const double &P, std::vector<double> &Xi,
+                                           std::vector<double> &Ni, double *cachedP0, double *cachedPsi,
+                                           Workspace &workspace) const;
+
+  Workspace createWorkspace() const { return Workspace(Ncomp, Nsorted); }
+
  private:
   const System &system;
   std::string displayName;
@@ -69,42 +112,62 @@ export class MixturePrediction
   size_t maxIsothermTerms{2};
   std::vector<std::vector<Component>> segregatedSortedComponents;
 
-  std::vector<double> alpha1;
-  std::vector<double> alpha2;
-  std::vector<double> alpha_prod;
-  std::vector<double> x;
+  Workspace workspace;
 
-  std::vector<double> pstar;
-  std::vector<double> psi;
-  std::vector<double> G;
-  std::vector<double> delta;
-  std::vector<double> Phi;
+  // optional tabulated spreading pressures, indexed by component (empty when disabled)
+  std::vector<std::optional<SpreadingPressureTable>> spreadingPressureTables;
 
   double temperature{300.0};
 
   std::pair<size_t, size_t> computeFastIAST(const std::vector<double> &Yi, const double &P, std::vector<double> &Xi,
-                                            std::vector<double> &Ni, double *cachedP0, double *cachedPsi);
+                                            std::vector<double> &Ni, double *cachedP0, double *cachedPsi,
+                                            Workspace &workspace) const;
   std::pair<size_t, size_t> computeFastSIAST(const std::vector<double> &Yi, const double &P, std::vector<double> &Xi,
-                                             std::vector<double> &Ni, double *cachedP0, double *cachedPsi);
+                                             std::vector<double> &Ni, double *cachedP0, double *cachedPsi,
+                                             Workspace &workspace) const;
   std::pair<size_t, size_t> computeFastSIAST(size_t term, const std::vector<double> &Yi, const double &P,
                                              std::vector<double> &Xi, std::vector<double> &Ni, double *cachedP0,
-                                             double *cachedPsi);
+                                             double *cachedPsi, Workspace &workspace) const;
 
   std::pair<size_t, size_t> computeIASTNestedLoopBisection(const std::vector<double> &Yi, const double &P,
                                                            std::vector<double> &Xi, std::vector<double> &Ni,
-                                                           double *cachedP0, double *cachedPsi);
+                                                           double *cachedP0, double *cachedPsi) const;
   std::pair<size_t, size_t> computeSIASTNestedLoopBisection(const std::vector<double> &Yi, const double &P,
                                                             std::vector<double> &Xi, std::vector<double> &Ni,
-                                                            double *cachedP0, double *cachedPsi);
+                                                            double *cachedP0, double *cachedPsi) const;
   std::pair<size_t, size_t> computeSIASTNestedLoopBisection(size_t term, const std::vector<double> &Yi, const double &P,
                                                             std::vector<double> &Xi, std::vector<double> &Ni,
-                                                            double *cachedP0, double *cachedPsi);
+                                                            double *cachedP0, double *cachedPsi) const;
   std::pair<size_t, size_t> computeExplicitIsotherm(const std::vector<double> &Yi, const double &P,
-                                                    std::vector<double> &Xi, std::vector<double> &Ni);
+                                                    std::vector<double> &Xi, std::vector<double> &Ni,
+                                                    Workspace &workspace) const;
   std::pair<size_t, size_t> computeSegratedExplicitIsotherm(const std::vector<double> &Yi, const double &P,
-                                                            std::vector<double> &Xi, std::vector<double> &Ni);
+                                                            std::vector<double> &Xi, std::vector<double> &Ni,
+                                                            Workspace &workspace) const;
   std::pair<size_t, size_t> computeSegratedExplicitIsotherm(size_t site, const std::vector<double> &Yi, const double &P,
-                                                            std::vector<double> &Xi, std::vector<double> &Ni);
+                                                            std::vector<double> &Xi, std::vector<double> &Ni,
+                                                            Workspace &workspace) const;
+
+  inline double psiForPressure(const Component &component, double pressure) const
+  {
+    if (!spreadingPressureTables.empty() && spreadingPressureTables[component.componentId].has_value())
+    {
+      return spreadingPressureTables[component.componentId]->psiForPressure(pressure);
+    }
+    return component.isotherm.psiForPressure(pressure);
+  }
+
+  inline double inversePressureForPsi(const Component &component, double reduced_grand_potential,
+                                      double &cachedP0) const
+  {
+    if (!spreadingPressureTables.empty() && spreadingPressureTables[component.componentId].has_value())
+    {
+      return spreadingPressureTables[component.componentId]->inversePressureForPsi(reduced_grand_potential, cachedP0);
+    }
+    return component.isotherm.inversePressureForPsi(reduced_grand_potential, cachedP0);
+  }
+
+  void createSpreadingPressureTables();
 
-  void printErrorStatus(double psi, double sum, double P, const std::vector<double> Yi, double cachedP0[]);
+  void printErrorStatus(double psi, double sum, double P, const std::vector<double> Yi, double cachedP0[]) const;
 };
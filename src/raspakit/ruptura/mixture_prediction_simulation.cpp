@@ -5,8 +5,10 @@ module;
 #include <chrono>
 #include <cmath>
 #include <complex>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <numeric>
@@ -34,6 +36,8 @@ import <sstream>;
 import <chrono>;
 import <complex>;
 import <print>;
+import <exception>;
+import <future>;
 #endif
 
 import stringutils;
@@ -46,7 +50,7 @@ import multi_site_isotherm;
 import mixture_prediction;
 
 MixturePredictionSimulation::MixturePredictionSimulation(InputReader &inputReader)
-    : systems(std::move(inputReader.systems))
+    : systems(std::move(inputReader.systems)), concurrentSystems(inputReader.concurrentSystems)
 {
   for (System &system : systems)
   {
@@ -58,32 +62,63 @@ MixturePredictionSimulation::MixturePredictionSimulation(InputReader &inputReade
 
 void MixturePredictionSimulation::run()
 {
+  if (!concurrentSystems)
+  {
+    for (System &system : systems)
+    {
+      runSystem(system);
+    }
+    return;
+  }
+
+  // each system runs on its own thread, not on the thread pool: the systems use the pool themselves
+  std::vector<std::future<void>> tasks{};
   for (System &system : systems)
   {
-    MixturePrediction mixture(system);
+    tasks.push_back(std::async(std::launch::async, [this, &system]() { runSystem(system); }));
+  }
 
-    std::string fileNameString =
-        std::format("output/system_{}/output_{}_{}.txt", system.systemId, system.temperature, system.input_pressure);
-    std::ofstream fstream(fileNameString, std::ios::out);
-    std::ostream stream(fstream.rdbuf());
-    // std::ostream stream(std::cout.rdbuf());
+  // all systems must finish before an error is passed on
+  std::exception_ptr error{};
+  for (std::future<void> &task : tasks)
+  {
+    try
+    {
+      task.get();
+    }
+    catch (...)
+    {
+      if (!error) error = std::current_exception();
+    }
+  }
+  if (error) std::rethrow_exception(error);
+}
 
-    std::print(stream, "{}", system.writeOutputHeader());
-    std::print(stream, "{}", HardwareInfo::writeInfo());
-    std::print(stream, "{}", mixture.writeHeader());
+void MixturePredictionSimulation::runSystem(System &system)
+{
+  MixturePrediction mixture(system);
 
-    mixture.createPureComponentsPlotScript();
-    mixture.createMixturePlotScript();
-    mixture.createMixtureAdsorbedMolFractionPlotScript();
-    mixture.createPlotScript();
+  std::string fileNameString =
+      std::format("output/system_{}/output_{}_{}.txt", system.systemId, system.temperature, system.input_pressure);
+  std::ofstream fstream(fileNameString, std::ios::out);
+  std::ostream stream(fstream.rdbuf());
+  // std::ostream stream(std::cout.rdbuf());
 
-    std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
+  std::print(stream, "{}", system.writeOutputHeader());
+  std::print(stream, "{}", HardwareInfo::writeInfo());
+  std::print(stream, "{}", mixture.writeHeader());
 
-    mixture.run(stream);
+  mixture.createPureComponentsPlotScript();
+  mixture.createMixturePlotScript();
+  mixture.createMixtureAdsorbedMolFractionPlotScript();
+  mixture.createPlotScript();
 
-    std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
+  std::chrono::system_clock::time_point t1 = std::chrono::system_clock::now();
 
-    std::chrono::duration<double> totalSimulationTime = (t2 - t1);
-    std::print(stream, "\nMixture prediction simulation time: {:14f} [s]\n\n\n", totalSimulationTime.count());
-  }
+  mixture.run(stream);
+
+  std::chrono::system_clock::time_point t2 = std::chrono::system_clock::now();
+
+  std::chrono::duration<double> totalSimulationTime = (t2 - t1);
+  std::print(stream, "\nMixture prediction simulation time: {:14f} [s]\n\n\n", totalSimulationTime.count());
 }
@@ -29,8 +29,17 @@ export struct MixturePredictionSimulation
  public:
   MixturePredictionSimulation(InputReader &inputreader);
 
+  /**
+   * \brief Runs all systems, one after the other or, with 'ConcurrentSystems', each on its own thread.
+   *
+   * The systems are independent and write to their own output files, so the output does not depend on the order in
+   * which they finish.
+   */
   void run();
 
  private:
   std::vector<System> systems;
+  bool concurrentSystems{false};
+
+  void runSystem(System &system);
 };
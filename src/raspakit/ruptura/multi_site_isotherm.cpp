@@ -1,10 +1,13 @@
 module;
 
 #ifdef USE_LEGACY_HEADERS
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <ostream>
 #include <print>
+#include <span>
 #include <sstream>
 #include <vector>
 #endif
@@ -18,6 +21,9 @@ import <vector>;
 import <iostream>;
 import <ostream>;
 import <print>;
+import <algorithm>;
+import <cstddef>;
+import <span>;
 #endif
 
 import special_functions;
@@ -57,6 +63,41 @@ void MultiSiteIsotherm::add(const Isotherm &isotherm)
   }
 }
 
+void MultiSiteIsotherm::values(std::span<const double> pressures, std::span<double> loadings) const
+{
+  std::fill(loadings.begin(), loadings.begin() + static_cast<std::ptrdiff_t>(pressures.size()), 0.0);
+  for (size_t i = 0; i < numberOfSites; ++i)
+  {
+    sites[i].accumulateValues(pressures, loadings);
+  }
+}
+
+void MultiSiteIsotherm::psiForPressures(std::span<const double> pressures, std::span<double> psi) const
+{
+  std::fill(psi.begin(), psi.begin() + static_cast<std::ptrdiff_t>(pressures.size()), 0.0);
+  for (size_t i = 0; i < numberOfSites; ++i)
+  {
+    sites[i].accumulatePsiForPressures(pressures, psi);
+  }
+}
+
+void MultiSiteIsotherm::derivatives(std::span<const double> pressures, std::span<double> derivatives) const
+{
+  std::fill(derivatives.begin(), derivatives.begin() + static_cast<std::ptrdiff_t>(pressures.size()), 0.0);
+  for (size_t i = 0; i < numberOfSites; ++i)
+  {
+    sites[i].accumulateDerivatives(pressures, derivatives);
+  }
+}
+
+void MultiSiteIsotherm::parameterGradient(double pressure, std::span<double> gradient) const
+{
+  for (size_t i = 0; i < numberOfSites; ++i)
+  {
+    sites[i].parameterGradient(pressure, gradient.subspan(siteParameterIndex[i], sites[i].numberOfParameters));
+  }
+}
+
 // returns the inverse-pressure (1/P) that corresponds to the given reduced_grand_potential psi
 // advantage: for isotherms with zero equilibrium constant the result would be infinite, but the inverse is zero
 double MultiSiteIsotherm::inversePressureForPsi(double reduced_grand_potential, double &cachedP0) const
@@ -4,6 +4,8 @@ module;
 #include <array>
 #include <cstddef>
 #include <iostream>
+#include <span>
+#include <utility>
 #include <vector>
 #endif
 
@@ -14,6 +16,8 @@ import <cstddef>;
 import <array>;
 import <vector>;
 import <iostream>;
+import <span>;
+import <utility>;
 #endif
 
 import hashcombine;
@@ -105,6 +109,32 @@ export struct MultiSiteIsotherm
     return 0.0;
   }
 
+  /**
+   * \brief Computes the loadings at a batch of pressures, summed over the sites.
+   */
+  void values(std::span<const double> pressures, std::span<double> loadings) const;
+
+  /**
+   * \brief Computes the reduced grand potentials psi at a batch of pressures, summed over the sites.
+   */
+  void psiForPressures(std::span<const double> pressures, std::span<double> psi) const;
+
+  /**
+   * \brief Computes the derivatives dq/dp at a batch of pressures, summed over the sites.
+   */
+  void derivatives(std::span<const double> pressures, std::span<double> derivatives) const;
+
+  /**
+   * \brief Computes the derivatives of the loading with respect to all parameters (in the order of 'parameters(i)').
+   */
+  void parameterGradient(double pressure, std::span<double> gradient) const;
+
+  std::pair<double, double> parameterBounds(size_t i) const
+  {
+    std::pair<size_t, size_t> index = parameterIndices[i];
+    return sites[index.first].parameterBounds(index.second);
+  }
+
   double inversePressureForPsi(double reduced_grand_potential, double &cachedP0) const;
 
   double inversePressureForPsi(size_t site, double reduced_grand_potential, double &cachedP0) const
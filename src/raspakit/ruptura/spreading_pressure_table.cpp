@@ -0,0 +1,189 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <vector>
+#endif
+
+module spreading_pressure_table;
+
+#ifndef USE_LEGACY_HEADERS
+import <cstddef>;
+import <initializer_list>;
+import <vector>;
+import <optional>;
+import <cmath>;
+import <algorithm>;
+import <limits>;
+#endif
+
+import multi_site_isotherm;
+
+// cubic Hermite interpolation on [0, 1] with end values y0, y1 and slopes (times the interval width) m0, m1
+static inline double hermite(double t, double y0, double y1, double m0, double m1)
+{
+  double t2 = t * t;
+  double t3 = t2 * t;
+  return (2.0 * t3 - 3.0 * t2 + 1.0) * y0 + (t3 - 2.0 * t2 + t) * m0 + (-2.0 * t3 + 3.0 * t2) * y1 + (t3 - t2) * m1;
+}
+
+// Fritsch-Carlson limiter: restricts the slopes such that the Hermite spline is monotone on each interval
+// the secant of interval k is 'secant(k)'
+template <typename F>
+static void limitSlopes(std::vector<double> &slopes, F secant)
+{
+  for (size_t k = 0; k + 1 < slopes.size(); ++k)
+  {
+    double delta = secant(k);
+    double alpha = slopes[k] / delta;
+    double beta = slopes[k + 1] / delta;
+    double s = alpha * alpha + beta * beta;
+    if (s > 9.0)
+    {
+      double tau = 3.0 / std::sqrt(s);
+      slopes[k] = tau * alpha * delta;
+      slopes[k + 1] = tau * beta * delta;
+    }
+  }
+}
+
+SpreadingPressureTable::SpreadingPressureTable(const MultiSiteIsotherm &isotherm, double minimumPressure,
+                                               double maximumPressure, size_t numberOfPoints)
+    : isotherm(isotherm),
+      lnPressureMinimum(std::log(minimumPressure)),
+      lnPressureMaximum(std::log(maximumPressure)),
+      spacing((lnPressureMaximum - lnPressureMinimum) / static_cast<double>(numberOfPoints - 1)),
+      inverseSpacing(1.0 / spacing),
+      psi(numberOfPoints),
+      slopePsi(numberOfPoints),
+      slopeInverse(numberOfPoints)
+{
+  std::vector<double> pressures(numberOfPoints);
+  for (size_t k = 0; k < numberOfPoints; ++k)
+  {
+    pressures[k] = std::exp(lnPressureMinimum + static_cast<double>(k) * spacing);
+  }
+
+  // d psi / d ln(p) = q(p)
+  isotherm.psiForPressures(pressures, psi);
+  isotherm.values(pressures, slopePsi);
+  for (size_t k = 0; k < numberOfPoints; ++k)
+  {
+    slopeInverse[k] = 1.0 / slopePsi[k];
+  }
+
+  if (!isValid()) return;
+
+  limitSlopes(slopePsi, [&](size_t k) { return (psi[k + 1] - psi[k]) * inverseSpacing; });
+  limitSlopes(slopeInverse, [&](size_t k) { return spacing / (psi[k + 1] - psi[k]); });
+}
+
+std::optional<SpreadingPressureTable> SpreadingPressureTable::create(const MultiSiteIsotherm &isotherm,
+                                                                     double minimumPressure, double maximumPressure,
+                                                                     double tolerance, double acceptedError)
+{
+  const size_t maximumNumberOfPoints = 1uz << 20;
+
+  // start with 8 points per decade, and halve the spacing until the tolerance is met
+  double numberOfDecades = std::log10(maximumPressure / minimumPressure);
+  size_t numberOfPoints = static_cast<size_t>(std::ceil(8.0 * numberOfDecades)) + 1;
+  double previousError = std::numeric_limits<double>::max();
+  while (numberOfPoints <= maximumNumberOfPoints)
+  {
+    SpreadingPressureTable table(isotherm, minimumPressure, maximumPressure, numberOfPoints);
+    if (!table.isValid()) return std::nullopt;
+
+    table.error = table.measureError();
+    if (table.error <= tolerance) return table;
+
+    // the error no longer halves with the spacing: the accuracy of 'psiForPressure' itself is reached (e.g. the
+    // rounding error at low pressure, or the truncated series of the Toth isotherm), and refining does not help;
+    // a table that is then still less accurate than accepted is not used, and the isotherm is evaluated directly
+    if (table.error > 0.5 * previousError)
+    {
+      if (table.error > acceptedError) return std::nullopt;
+      return table;
+    }
+    previousError = table.error;
+
+    numberOfPoints = 2 * (numberOfPoints - 1) + 1;
+  }
+
+  return std::nullopt;
+}
+
+// psi must be finite and strictly increasing, with a positive loading at every grid point
+bool SpreadingPressureTable::isValid() const
+{
+  for (size_t k = 0; k < psi.size(); ++k)
+  {
+    if (!std::isfinite(psi[k]) || !std::isfinite(slopePsi[k]) || slopePsi[k] <= 0.0) return false;
+    if (k > 0 && psi[k] <= psi[k - 1]) return false;
+  }
+  return true;
+}
+
+// maximum relative error of psi and of the inverse pressure at a quarter and three quarters of each interval
+// (at the midpoint, equal errors in the two end slopes cancel)
+double SpreadingPressureTable::measureError() const
+{
+  double maximumError = 0.0;
+  for (size_t k = 0; k + 1 < psi.size(); ++k)
+  {
+    for (double t : {0.25, 0.75})
+    {
+      double lnPressure = lnPressureMinimum + (static_cast<double>(k) + t) * spacing;
+      double exact = isotherm.psiForPressure(std::exp(lnPressure));
+      double interpolated = hermite(t, psi[k], psi[k + 1], spacing * slopePsi[k], spacing * slopePsi[k + 1]);
+      maximumError = std::max(maximumError, std::abs(interpolated - exact) / exact);
+
+      double lnPressureInterpolated = interpolateLnPressure(exact);
+      maximumError = std::max(maximumError, std::abs(std::expm1(lnPressureInterpolated - lnPressure)));
+    }
+  }
+  return maximumError;
+}
+
+double SpreadingPressureTable::psiForPressure(double pressure) const
+{
+  double lnPressure = std::log(pressure);
+  if (!(lnPressure >= lnPressureMinimum && lnPressure < lnPressureMaximum))
+  {
+    return isotherm.psiForPressure(pressure);
+  }
+
+  double x = (lnPressure - lnPressureMinimum) * inverseSpacing;
+  size_t k = std::min(static_cast<size_t>(x), psi.size() - 2);
+  double t = x - static_cast<double>(k);
+  return hermite(t, psi[k], psi[k + 1], spacing * slopePsi[k], spacing * slopePsi[k + 1]);
+}
+
+double SpreadingPressureTable::interpolateLnPressure(double reduced_grand_potential) const
+{
+  std::vector<double>::const_iterator it = std::upper_bound(psi.begin(), psi.end(), reduced_grand_potential);
+  size_t k = static_cast<size_t>(std::max(std::distance(psi.begin(), it) - 1, std::ptrdiff_t{0}));
+  k = std::min(k, psi.size() - 2);
+
+  double width = psi[k + 1] - psi[k];
+  double t = (reduced_grand_potential - psi[k]) / width;
+  double y0 = lnPressureMinimum + static_cast<double>(k) * spacing;
+  return hermite(t, y0, y0 + spacing, width * slopeInverse[k], width * slopeInverse[k + 1]);
+}
+
+// returns the inverse-pressure (1/P) that corresponds to the given reduced_grand_potential psi
+double SpreadingPressureTable::inversePressureForPsi(double reduced_grand_potential, double &cachedP0) const
+{
+  if (!(reduced_grand_potential >= psi.front() && reduced_grand_potential <= psi.back()))
+  {
+    return isotherm.inversePressureForPsi(reduced_grand_potential, cachedP0);
+  }
+
+  double lnPressure = interpolateLnPressure(reduced_grand_potential);
+  cachedP0 = std::exp(lnPressure);
+  return std::exp(-lnPressure);
+}
@@ -0,0 +1,70 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <cstddef>
+#include <optional>
+#include <vector>
+#endif
+
+export module spreading_pressure_table;
+
+#ifndef USE_LEGACY_HEADERS
+import <cstddef>;
+import <vector>;
+import <optional>;
+#endif
+
+import multi_site_isotherm;
+
+/**
+ * \brief Tabulated reduced spreading pressure psi(p) of an isotherm and its inverse.
+ *
+ * The table is built on a grid uniform in ln(p). Since d psi / d ln(p) = q(p), the slopes of psi are known exactly
+ * from the isotherm, and both psi(ln p) and ln p(psi) are interpolated with monotone (Fritsch-Carlson limited) cubic
+ * Hermite splines. The grid is refined until the interpolation error inside the intervals is below the
+ * tolerance, or until it stops decreasing because the accuracy of psi itself is reached; in the latter case the
+ * table is only used when its error is below the accepted error. Outside the tabulated range the isotherm itself is
+ * evaluated.
+ */
+export struct SpreadingPressureTable
+{
+  /**
+   * \brief Builds the table, or returns std::nullopt when psi is not strictly increasing over the pressure range
+   * (e.g. a carrier gas without adsorption, or isotherms with a pole like BET and anti-Langmuir), or when the table
+   * cannot be made more accurate than 'acceptedError'.
+   *
+   * \param isotherm The isotherm to tabulate.
+   * \param minimumPressure Lower bound of the tabulated pressure range.
+   * \param maximumPressure Upper bound of the tabulated pressure range.
+   * \param tolerance Relative interpolation error of psi and of the pressure that the refinement aims for.
+   * \param acceptedError Largest relative error of a table whose refinement stopped short of the tolerance.
+   */
+  static std::optional<SpreadingPressureTable> create(const MultiSiteIsotherm &isotherm, double minimumPressure = 1e-6,
+                                                      double maximumPressure = 1e10, double tolerance = 1e-9,
+                                                      double acceptedError = 1e-6);
+
+  double psiForPressure(double pressure) const;
+  double inversePressureForPsi(double reduced_grand_potential, double &cachedP0) const;
+
+  size_t size() const { return psi.size(); }
+  double maximumError() const { return error; }
+
+ private:
+  SpreadingPressureTable(const MultiSiteIsotherm &isotherm, double minimumPressure, double maximumPressure,
+                         size_t numberOfPoints);
+
+  MultiSiteIsotherm isotherm;
+  double lnPressureMinimum;
+  double lnPressureMaximum;
+  double spacing;
+  double inverseSpacing;
+  double error{0.0};
+
+  std::vector<double> psi;           // psi at the grid points
+  std::vector<double> slopePsi;      // d psi / d ln(p), limited
+  std::vector<double> slopeInverse;  // d ln(p) / d psi, limited
+
+  bool isValid() const;
+  double measureError() const;
+  double interpolateLnPressure(double reduced_grand_potential) const;
+};
@@ -0,0 +1,308 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#endif
+
+module screening;
+
+#ifndef USE_LEGACY_HEADERS
+import <algorithm>;
+import <atomic>;
+import <chrono>;
+import <cstddef>;
+import <exception>;
+import <filesystem>;
+import <format>;
+import <fstream>;
+import <optional>;
+import <print>;
+import <sstream>;
+import <string>;
+import <thread>;
+import <utility>;
+import <vector>;
+#endif
+
+import units;
+import randomnumbers;
+import checkpoint;
+import component;
+import loadings;
+import energy_status;
+import system;
+import input_reader;
+import monte_carlo;
+import sample_movies;
+import json;
+
+Screening::Screening(InputReader& reader) noexcept
+    : numberOfCycles(reader.numberOfCycles),
+      numberOfInitializationCycles(reader.numberOfInitializationCycles),
+      numberOfEquilibrationCycles(reader.numberOfEquilibrationCycles),
+      printEvery(reader.printEvery),
+      writeBinaryRestartEvery(reader.writeBinaryRestartEvery),
+      numberOfBinaryRestartFiles(reader.numberOfBinaryRestartFiles),
+      rescaleWangLandauEvery(reader.rescaleWangLandauEvery),
+      optimizeMCMovesEvery(reader.optimizeMCMovesEvery),
+      checkConvergenceEvery(reader.checkConvergenceEvery),
+      numberOfBlocks(reader.numberOfBlocks),
+      numberOfThreads(std::max(reader.numberOfThreads, 1uz)),
+      randomSeed(reader.randomSeed),
+      prototypes(std::move(reader.systems)),
+      jobs(std::move(reader.screeningJobs))
+{
+  // computed once per framework; the jobs copy the result and 'MonteCarlo::initialize' does not recompute it
+  for (System& prototype : prototypes)
+  {
+    if (prototype.fixedFrameworkStoredEik.empty())
+    {
+      prototype.precomputeTotalRigidEnergy();
+    }
+  }
+}
+
+Screening::Result Screening::describeJob(size_t jobIndex) const
+{
+  const InputReader::ScreeningJob& job = jobs[jobIndex];
+  const System& prototype = prototypes[job.systemId];
+
+  Result result{};
+  result.jobIndex = jobIndex;
+  result.systemId = job.systemId;
+  result.frameworkName = prototype.frameworkComponents.empty() ? "box" : prototype.frameworkComponents.front().name;
+  result.temperature = job.temperature;
+  result.pressure = job.pressure.value_or(0.0);
+  for (const Component& component : prototype.components)
+  {
+    result.componentNames.push_back(component.name);
+  }
+  return result;
+}
+
+Screening::Result Screening::runJob(size_t jobIndex) const
+{
+  Result result = describeJob(jobIndex);
+  const InputReader::ScreeningJob& job = jobs[jobIndex];
+
+  // the copy shares the framework atoms and the precomputed rigid-framework Fourier terms of the prototype; it is the
+  // only system of its 'MonteCarlo', which indexes its output streams by the system id
+  const System& prototype = prototypes[job.systemId];
+  std::vector<System> systems{prototype};
+  System& system = systems.front();
+  system.systemId = 0;
+  system.setExternalConditions(job.temperature, job.pressure);
+
+  RandomNumber random(randomSeed.has_value() ? std::optional<size_t>(randomSeed.value() + jobIndex) : std::nullopt);
+
+  // the initial molecules of the prototype were grown at its temperature, regrow them at the one of the job
+  if (job.temperature != prototype.temperature)
+  {
+    for (size_t componentId = 0; componentId != system.components.size(); ++componentId)
+    {
+      size_t numberOfMolecules = system.initialNumberOfMolecules[componentId];
+      system.setNumberOfIntegerMolecules(random, componentId, 0uz);
+      system.setNumberOfIntegerMolecules(random, componentId, numberOfMolecules);
+    }
+  }
+
+  // the samplers name their files by the system id, which is the same for all jobs, so they write into the job
+  // directory
+  std::string outputDirectory = std::format("output/screening/job_{}", jobIndex);
+  if (system.samplePDBMovie.has_value())
+  {
+    system.samplePDBMovie =
+        SampleMovie(system.systemId, system.samplePDBMovie->sampleEvery, outputDirectory + "/movies");
+  }
+  if (system.propertyConventionalRadialDistributionFunction.has_value())
+  {
+    system.propertyConventionalRadialDistributionFunction->outputDirectory = outputDirectory + "/conventional_rdf";
+  }
+  if (system.propertyRadialDistributionFunction.has_value())
+  {
+    system.propertyRadialDistributionFunction->outputDirectory = outputDirectory + "/rdf";
+  }
+  if (system.propertyDensityGrid.has_value())
+  {
+    system.propertyDensityGrid->outputDirectory = outputDirectory + "/density_grids";
+  }
+  if (system.averageEnergyHistogram.has_value())
+  {
+    system.averageEnergyHistogram->outputDirectory = outputDirectory + "/energy_histogram";
+  }
+  if (system.averageNumberOfMoleculesHistogram.has_value())
+  {
+    system.averageNumberOfMoleculesHistogram->outputDirectory = outputDirectory + "/number_of_molecules_histogram";
+  }
+
+  MonteCarlo mc(numberOfCycles, numberOfInitializationCycles, numberOfEquilibrationCycles, printEvery,
+                writeBinaryRestartEvery, rescaleWangLandauEvery, optimizeMCMovesEvery, systems, random,
+                numberOfBlocks);
+  mc.checkConvergenceEvery = checkConvergenceEvery;
+  mc.outputDirectory = outputDirectory;
+  mc.checkpoint = Checkpoint(mc.outputDirectory + "/restart_data.bin", numberOfBinaryRestartFiles);
+
+  std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+  mc.run();
+  std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+  result.simulationTime = std::chrono::duration<double>(t2 - t1).count();
+
+  const System& finalSystem = mc.systems.front();
+  std::pair<Loadings, Loadings> loadingData = finalSystem.averageLoadings.averageLoading();
+  for (size_t i = 0; i != finalSystem.components.size(); ++i)
+  {
+    result.loadings.emplace_back(loadingData.first.numberOfMolecules[i], loadingData.second.numberOfMolecules[i]);
+  }
+  std::optional<double> frameworkMass = finalSystem.frameworkMass();
+  if (frameworkMass.has_value())
+  {
+    result.toMolePerKg = 1000.0 / frameworkMass.value();
+  }
+  std::pair<EnergyStatus, EnergyStatus> energyData = finalSystem.averageEnergies.averageEnergy();
+  result.energy = {Units::EnergyToKelvin * energyData.first.totalEnergy.energy,
+                   Units::EnergyToKelvin * energyData.second.totalEnergy.energy};
+
+  return result;
+}
+
+void Screening::run()
+{
+  std::filesystem::create_directories("output/screening");
+  results = std::vector<Result>(jobs.size());
+
+  // every thread takes the next job from the shared counter until all are done; a failed job does not stop the rest
+  std::atomic<size_t> nextJob{0};
+  auto worker = [this, &nextJob]()
+  {
+    for (size_t jobIndex = nextJob++; jobIndex < jobs.size(); jobIndex = nextJob++)
+    {
+      try
+      {
+        results[jobIndex] = runJob(jobIndex);
+      }
+      catch (const std::exception& e)
+      {
+        results[jobIndex] = describeJob(jobIndex);
+        results[jobIndex].error = e.what();
+      }
+      catch (...)
+      {
+        results[jobIndex] = describeJob(jobIndex);
+        results[jobIndex].error = "unknown error";
+      }
+    }
+  };
+
+  std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+  {
+    std::vector<std::jthread> threads{};
+    for (size_t i = 1; i < std::min(numberOfThreads, jobs.size()); ++i)
+    {
+      threads.emplace_back(worker);
+    }
+    worker();
+  }
+  std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+  totalSimulationTime = t2 - t1;
+
+  std::ofstream textFile("output/screening.txt", std::ios::out);
+  std::print(textFile, "{}", writeResults());
+
+  std::ofstream jsonFile("output/screening.json", std::ios::out);
+  jsonFile << jsonResults().dump(4);
+}
+
+std::string Screening::writeResults() const
+{
+  std::ostringstream stream;
+
+  std::print(stream, "Screening results\n");
+  std::print(stream, "===============================================================================\n\n");
+  std::print(stream, "Number of jobs:     {}\n", jobs.size());
+  std::print(stream, "Number of threads:  {}\n", numberOfThreads);
+  std::print(stream, "Total time:         {:14f} [s]\n\n", totalSimulationTime.count());
+
+  std::print(stream, "{:>5s} {:24s} {:>10s} {:>12s} {:16s} {:>29s} {:>29s} {:>29s} {:>10s}\n", "job", "framework",
+             "T [K]", "p [Pa]", "component", "loading [molecules/cell]", "loading [mol/kg]", "energy [K]",
+             "time [s]");
+  for (const Result& result : results)
+  {
+    if (result.error.has_value())
+    {
+      std::print(stream, "{:>5d} {:24s} {:10.3f} {:12.5e} failed: {}\n", result.jobIndex, result.frameworkName,
+                 result.temperature, result.pressure, result.error.value());
+      continue;
+    }
+    for (size_t i = 0; i != result.loadings.size(); ++i)
+    {
+      std::string molePerKg =
+          result.toMolePerKg.has_value()
+              ? std::format("{: .6e} +/- {:.6e}", result.toMolePerKg.value() * result.loadings[i].first,
+                            result.toMolePerKg.value() * result.loadings[i].second)
+              : "-";
+      std::print(stream, "{:>5d} {:24s} {:10.3f} {:12.5e} {:16s} {: .6e} +/- {:.6e} {:>29s} {: .6e} +/- {:.6e} ",
+                 result.jobIndex, result.frameworkName, result.temperature, result.pressure,
+                 result.componentNames[i], result.loadings[i].first, result.loadings[i].second, molePerKg,
+                 result.energy.first, result.energy.second);
+      std::print(stream, "{:10.2f}\n", result.simulationTime);
+    }
+  }
+  std::print(stream, "\n\n");
+
+  return stream.str();
+}
+
+nlohmann::json Screening::jsonResults() const
+{
+  nlohmann::json status;
+  status["numberOfJobs"] = jobs.size();
+  status["numberOfThreads"] = numberOfThreads;
+  status["totalTime"] = totalSimulationTime.count();
+  status["jobs"] = nlohmann::json::array();
+
+  for (const Result& result : results)
+  {
+    nlohmann::json job;
+    job["job"] = result.jobIndex;
+    job["system"] = result.systemId;
+    job["framework"] = result.frameworkName;
+    job["temperature"] = result.temperature;
+    job["pressure"] = result.pressure;
+    if (result.error.has_value())
+    {
+      job["error"] = result.error.value();
+      status["jobs"].push_back(job);
+      continue;
+    }
+    for (size_t i = 0; i != result.loadings.size(); ++i)
+    {
+      const std::string& name = result.componentNames[i];
+      job["loadings"][name]["moleculesPerCell"] = {{"average", result.loadings[i].first},
+                                                   {"error", result.loadings[i].second}};
+      if (result.toMolePerKg.has_value())
+      {
+        job["loadings"][name]["molePerKg"] = {{"average", result.toMolePerKg.value() * result.loadings[i].first},
+                                              {"error", result.toMolePerKg.value() * result.loadings[i].second}};
+      }
+    }
+    job["energy"] = {{"average", result.energy.first}, {"error", result.energy.second}};
+    job["time"] = result.simulationTime;
+    status["jobs"].push_back(job);
+  }
+
+  return status;
+}
@@ -0,0 +1,96 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#endif
+
+export module screening;
+
+#ifndef USE_LEGACY_HEADERS
+import <chrono>;
+import <cstddef>;
+import <optional>;
+import <string>;
+import <utility>;
+import <vector>;
+#endif
+
+import system;
+import input_reader;
+import json;
+
+/**
+ * \brief The 'Screening' simulation type: Monte Carlo runs of many frameworks at many state points in one process.
+ *
+ * The input reader reads the force field, the components and every framework once. Each system of the input is the
+ * prototype of all jobs on its framework. It holds the expanded framework atoms, the Ewald setup and the precomputed
+ * Fourier terms of the rigid framework ('fixedFrameworkStoredEik'). A job copies its prototype, sets the external
+ * temperature and pressure, regrows the initial molecules when the temperature differs from the prototype's, and runs
+ * a 'MonteCarlo' simulation that writes all its output, including that of the samplers, to
+ * 'output/screening/job_<index>'. Component data given in the input for one temperature (fugacity coefficients,
+ * ideal-gas Rosenbluth weights) is used unchanged by every job.
+ *
+ * 'NumberOfThreads' threads take the jobs from a shared queue, one complete simulation at a time. A job that fails
+ * is reported in the result table without stopping the others. All results are collected in 'output/screening.txt'
+ * and 'output/screening.json'.
+ */
+export struct Screening
+{
+  struct Result
+  {
+    size_t jobIndex{0};
+    size_t systemId{0};
+    std::string frameworkName{};
+    double temperature{0.0};                            ///< External temperature [K].
+    double pressure{0.0};                               ///< External pressure [Pa].
+    std::vector<std::string> componentNames{};          ///< Names of the components.
+    std::vector<std::pair<double, double>> loadings{};  ///< Absolute loadings and errors [molecules/cell].
+    std::optional<double> toMolePerKg{};                ///< Conversion of the loadings to [mol/kg] for frameworks.
+    std::pair<double, double> energy{};                 ///< Average potential energy and error [K].
+    double simulationTime{0.0};                         ///< Wall time of the job [s].
+    std::optional<std::string> error{};                 ///< The error message of a failed job.
+  };
+
+  Screening(InputReader &reader) noexcept;
+
+  size_t numberOfCycles;                ///< Number of production cycles per job.
+  size_t numberOfInitializationCycles;  ///< Number of initialization cycles per job.
+  size_t numberOfEquilibrationCycles;   ///< Number of equilibration cycles per job.
+  size_t printEvery;                    ///< Frequency of printing status reports.
+  size_t writeBinaryRestartEvery;       ///< Frequency of writing binary restart files.
+  size_t numberOfBinaryRestartFiles;    ///< Number of rotated binary restart files to keep.
+  size_t rescaleWangLandauEvery;        ///< Frequency of rescaling Wang-Landau factors.
+  size_t optimizeMCMovesEvery;          ///< Frequency of optimizing MC moves.
+  size_t checkConvergenceEvery;         ///< Frequency of checking convergence of the production run.
+  size_t numberOfBlocks;                ///< Number of blocks for error estimation.
+  size_t numberOfThreads;               ///< Number of jobs that run concurrently.
+
+  std::optional<unsigned long long> randomSeed;  ///< Seed of the first job; job 'i' uses 'seed + i'.
+
+  std::vector<System> prototypes;               ///< One system per framework, copied by every job on it.
+  std::vector<InputReader::ScreeningJob> jobs;  ///< The jobs in the order they are scheduled.
+  std::vector<Result> results;                  ///< The results, in the order of the jobs.
+
+  std::chrono::duration<double> totalSimulationTime{0};  ///< Wall time of all jobs.
+
+  /**
+   * \brief Runs all jobs and writes the consolidated result table.
+   */
+  void run();
+
+  /**
+   * \brief Runs a single job: a Monte Carlo simulation of a copy of its prototype at the state point of the job.
+   */
+  Result runJob(size_t jobIndex) const;
+
+  std::string writeResults() const;
+  nlohmann::json jsonResults() const;
+
+ private:
+  Result describeJob(size_t jobIndex) const;
+};
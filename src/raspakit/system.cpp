@@ -246,6 +246,18 @@ void System::createFrameworks()
   }
 }
 
+void System::setExternalConditions(double T, std::optional<double> P)
+{
+  temperature = T;
+  pressure = P.value_or(0.0) / Units::PressureConversionFactor;
+  input_pressure = P.value_or(0.0);
+  beta = 1.0 / (Units::KB * T);
+
+  equationOfState =
+      EquationOfState(EquationOfState::Type::PengRobinson, EquationOfState::MultiComponentMixingRules::VanDerWaals, T,
+                      P.value_or(0.0), simulationBox, heliumVoidFraction, components);
+}
+
 std::optional<double> System::frameworkMass() const
 {
   if (frameworkComponents.empty()) return std::nullopt;
@@ -286,6 +298,7 @@ void System::insertFractionalMolecule(size_t selectedComponent, [[maybe_unused]]
   }
   std::vector<Atom>::const_iterator iterator = iteratorForMolecule(selectedComponent, 0);
   atomPositions.insert(iterator, atoms.begin(), atoms.end());
+  ++atomPositionsVersion;
 
   std::vector<Molecule>::iterator moleculeIterator = indexForMolecule(selectedComponent, 0);
   moleculePositions.insert(moleculeIterator, molecule);
@@ -333,6 +346,7 @@ void System::insertMolecule(size_t selectedComponent, [[maybe_unused]] const Mol
   std::vector<Atom>::const_iterator iterator =
       iteratorForMolecule(selectedComponent, numberOfMoleculesPerComponent[selectedComponent]);
   atomPositions.insert(iterator, atoms.begin(), atoms.end());
+  ++atomPositionsVersion;
 
   std::vector<Molecule>::iterator moleculeIterator =
       indexForMolecule(selectedComponent, numberOfMoleculesPerComponent[selectedComponent]);
@@ -386,6 +400,7 @@ void System::deleteMolecule(size_t selectedComponent, size_t selectedMolecule, c
 
   std::vector<Atom>::const_iterator iterator = iteratorForMolecule(selectedComponent, selectedMolecule);
   atomPositions.erase(iterator, iterator + static_cast<std::vector<Atom>::difference_type>(molecule.size()));
+  ++atomPositionsVersion;
 
   std::vector<Molecule>::iterator moleculeIterator = indexForMolecule(selectedComponent, selectedMolecule);
   moleculePositions.erase(moleculeIterator, moleculeIterator + 1);
@@ -498,30 +513,50 @@ void System::createInitialMolecules([[maybe_unused]] RandomNumber& random)
 
     for (size_t i = 0; i < initialNumberOfMolecules[componentId]; ++i)
     {
-      std::optional<ChainData> growData = std::nullopt;
-      bool inside_blocked_pocket{false};
-      do
-      {
-        do
-        {
-          Component::GrowType growType = components[componentId].growType;
-          growData = CBMC::growMoleculeSwapInsertion(
-              random, frameworkComponents, components[componentId], hasExternalField, components, forceField,
-              simulationBox, spanOfFrameworkAtoms(), spanOfMoleculeAtoms(), beta, growType,
-              forceField.cutOffFrameworkVDW, forceField.cutOffMoleculeVDW, forceField.cutOffCoulomb, componentId,
-              numberOfMoleculesPerComponent[componentId], 1.0, 0uz, numberOfTrialDirections);
+      growMolecule(random, componentId);
+    }
+    componentId++;
+  }
+}
 
-        } while (!growData || growData->energies.potentialEnergy() > forceField.overlapCriteria);
+void System::growMolecule(RandomNumber& random, size_t componentId)
+{
+  std::optional<ChainData> growData = std::nullopt;
+  bool inside_blocked_pocket{false};
+  do
+  {
+    do
+    {
+      Component::GrowType growType = components[componentId].growType;
+      growData = CBMC::growMoleculeSwapInsertion(
+          random, frameworkComponents, components[componentId], hasExternalField, components, forceField,
+          simulationBox, spanOfFrameworkAtoms(), spanOfMoleculeAtoms(), beta, growType, forceField.cutOffFrameworkVDW,
+          forceField.cutOffMoleculeVDW, forceField.cutOffCoulomb, componentId,
+          numberOfMoleculesPerComponent[componentId], 1.0, 0uz, numberOfTrialDirections);
 
-        std::span<const Atom> newMolecule = std::span(growData->atom.begin(), growData->atom.end());
-        inside_blocked_pocket = insideBlockedPockets(components[componentId], newMolecule);
+    } while (!growData || growData->energies.potentialEnergy() > forceField.overlapCriteria);
 
-      } while (inside_blocked_pocket);
+    std::span<const Atom> newMolecule = std::span(growData->atom.begin(), growData->atom.end());
+    inside_blocked_pocket = insideBlockedPockets(components[componentId], newMolecule);
 
-      insertMolecule(componentId, growData->molecule, growData->atom);
-    }
-    componentId++;
+  } while (inside_blocked_pocket);
+
+  insertMolecule(componentId, growData->molecule, growData->atom);
+}
+
+void System::setNumberOfIntegerMolecules(RandomNumber& random, size_t componentId, size_t numberOfMolecules)
+{
+  while (numberOfIntegerMoleculesPerComponent[componentId] < numberOfMolecules)
+  {
+    growMolecule(random, componentId);
   }
+  while (numberOfIntegerMoleculesPerComponent[componentId] > numberOfMolecules)
+  {
+    // the integer molecules are stored after the fractional ones, so the last molecule is always an integer one
+    size_t lastMolecule = numberOfMoleculesPerComponent[componentId] - 1;
+    deleteMolecule(componentId, lastMolecule, spanOfMolecule(componentId, lastMolecule));
+  }
+  initialNumberOfMolecules[componentId] = numberOfMolecules;
 }
 
 bool System::insideBlockedPockets(const Component& component, std::span<const Atom> molecule_atoms) const
@@ -1437,6 +1472,68 @@ nlohmann::json System::jsonSystemStatus() const
   return system;
 }
 
+// the in-memory counterpart of 'writeProductionStatusReportMC': current values with the block averages and their
+// confidence errors, energies in [K] and pressures in [bar]
+nlohmann::json System::jsonProductionStatusReportMC(size_t currentCycle, size_t numberOfCycles) const
+{
+  nlohmann::json status;
+  status["currentCycle"] = currentCycle;
+  status["numberOfCycles"] = numberOfCycles;
+  status["system"] = jsonSystemStatus();
+
+  Loadings currentLoadings(components.size(), numberOfIntegerMoleculesPerComponent, simulationBox);
+  std::pair<Loadings, Loadings> loadingData = averageLoadings.averageLoading();
+  for (const Component& c : components)
+  {
+    status["loadings"][c.name]["current"] = currentLoadings.numberOfMolecules[c.componentId];
+    status["loadings"][c.name]["average"] = loadingData.first.numberOfMolecules[c.componentId];
+    status["loadings"][c.name]["error"] = loadingData.second.numberOfMolecules[c.componentId];
+  }
+
+  double conv = Units::EnergyToKelvin;
+  std::pair<EnergyStatus, EnergyStatus> energyData = averageEnergies.averageEnergy();
+  auto energy = [conv](double current, double average, double error)
+  { return nlohmann::json{{"current", conv * current}, {"average", conv * average}, {"error", conv * error}}; };
+  status["energies"]["total"] = energy(currentEnergyStatus.totalEnergy.energy, energyData.first.totalEnergy.energy,
+                                       energyData.second.totalEnergy.energy);
+  status["energies"]["frameworkMoleculeVDW"] =
+      energy(currentEnergyStatus.frameworkMoleculeEnergy.VanDerWaals.energy,
+             energyData.first.frameworkMoleculeEnergy.VanDerWaals.energy,
+             energyData.second.frameworkMoleculeEnergy.VanDerWaals.energy);
+  status["energies"]["frameworkMoleculeCoulombicReal"] =
+      energy(currentEnergyStatus.frameworkMoleculeEnergy.CoulombicReal.energy,
+             energyData.first.frameworkMoleculeEnergy.CoulombicReal.energy,
+             energyData.second.frameworkMoleculeEnergy.CoulombicReal.energy);
+  status["energies"]["frameworkMoleculeCoulombicFourier"] =
+      energy(currentEnergyStatus.frameworkMoleculeEnergy.CoulombicFourier.energy,
+             energyData.first.frameworkMoleculeEnergy.CoulombicFourier.energy,
+             energyData.second.frameworkMoleculeEnergy.CoulombicFourier.energy);
+  status["energies"]["moleculeMoleculeVDW"] =
+      energy(currentEnergyStatus.interEnergy.VanDerWaals.energy, energyData.first.interEnergy.VanDerWaals.energy,
+             energyData.second.interEnergy.VanDerWaals.energy);
+  status["energies"]["moleculeMoleculeCoulombicReal"] =
+      energy(currentEnergyStatus.interEnergy.CoulombicReal.energy, energyData.first.interEnergy.CoulombicReal.energy,
+             energyData.second.interEnergy.CoulombicReal.energy);
+  status["energies"]["moleculeMoleculeCoulombicFourier"] =
+      energy(currentEnergyStatus.interEnergy.CoulombicFourier.energy,
+             energyData.first.interEnergy.CoulombicFourier.energy,
+             energyData.second.interEnergy.CoulombicFourier.energy);
+
+  // the excess part is the one of the last pressure computation, the ideal-gas part that of the current loading
+  size_t numberOfMolecules =
+      std::reduce(numberOfIntegerMoleculesPerComponent.begin(), numberOfIntegerMoleculesPerComponent.end());
+  double currentIdealPressure = static_cast<double>(numberOfMolecules) / (beta * simulationBox.volume);
+  double currentPressure = currentIdealPressure + currentExcessPressureTensor.trace() / 3.0;
+  std::pair<double, double> p = averagePressure.averagePressure();
+  status["pressure"]["current"] = 1e-5 * Units::PressureConversionFactor * currentPressure;
+  status["pressure"]["average"] = 1e-5 * Units::PressureConversionFactor * p.first;
+  status["pressure"]["error"] = 1e-5 * Units::PressureConversionFactor * p.second;
+
+  status["MCMoveStatistics"] = jsonMCMoveStatistics();
+
+  return status;
+}
+
 std::string System::writeComponentStatus() const
 {
   std::ostringstream stream;
@@ -1521,6 +1618,11 @@ void System::sampleProperties(size_t currentBlock, size_t currentCycle)
       swappableComponents, numberOfIntegerMoleculesPerComponent, runningEnergies.potentialEnergy(), temperature);
   averageEnthalpiesOfAdsorption.addSample(currentBlock, enthalpyTerms, w);
 
+  if (convergenceMonitor.has_value())
+  {
+    convergenceMonitor->addSample(loadings, runningEnergies.potentialEnergy(), enthalpyTerms, w);
+  }
+
   size_t numberOfMolecules =
       std::reduce(numberOfIntegerMoleculesPerComponent.begin(), numberOfIntegerMoleculesPerComponent.end());
   double currentIdealPressure = static_cast<double>(numberOfMolecules) / (beta * simulationBox.volume);
@@ -1594,6 +1696,42 @@ void System::sampleProperties(size_t currentBlock, size_t currentCycle)
   mc_moves_cputime.propertySampling += (t2 - t1);
 }
 
+void System::rebinProperties(const std::vector<size_t>& boundaries)
+{
+  averageEnergies.rebin(boundaries);
+  averageLoadings.rebin(boundaries);
+  averageEnthalpiesOfAdsorption.rebin(boundaries);
+  averageTemperature.rebin(boundaries);
+  averageTranslationalTemperature.rebin(boundaries);
+  averageRotationalTemperature.rebin(boundaries);
+  averagePressure.rebin(boundaries);
+  averageSimulationBox.rebin(boundaries);
+
+  for (Component& component : components)
+  {
+    component.lambdaGC.rebin(boundaries);
+    component.lambdaGibbs.rebin(boundaries);
+    component.averageRosenbluthWeights.rebin(boundaries);
+  }
+
+  if (propertyConventionalRadialDistributionFunction.has_value())
+  {
+    propertyConventionalRadialDistributionFunction->rebin(boundaries);
+  }
+  if (propertyRadialDistributionFunction.has_value())
+  {
+    propertyRadialDistributionFunction->rebin(boundaries);
+  }
+  if (averageEnergyHistogram.has_value())
+  {
+    averageEnergyHistogram->rebin(boundaries);
+  }
+  if (averageNumberOfMoleculesHistogram.has_value())
+  {
+    averageNumberOfMoleculesHistogram->rebin(boundaries);
+  }
+}
+
 void System::writeCPUTimeStatistics(std::ostream& stream) const
 {
   std::print(stream, "Sampling properties:        {:14f} [s]\n", mc_moves_cputime.propertySampling.count());
@@ -2066,6 +2204,13 @@ Archive<std::ofstream>& operator<<(Archive<std::ofstream>& archive, const System
   archive << s.columnTimeStep;
   archive << s.columnNumberOfTimeSteps;
   archive << s.columnAutoNumberOfTimeSteps;
+  archive << s.columnIntegrator;
+  archive << s.columnRelativeTolerance;
+  archive << s.columnAbsoluteTolerance;
+  archive << s.columnMaximumTimeStep;
+  archive << s.columnConvectionScheme;
+  archive << s.columnOutputFormat;
+  archive << s.useSpreadingPressureTables;
   archive << s.mixturePredictionMethod;
   archive << s.pressure_range;
   archive << s.numberOfCarrierGases;
@@ -2084,6 +2229,9 @@ Archive<std::ofstream>& operator<<(Archive<std::ofstream>& archive, const System
   archive << s.propertyConventionalRadialDistributionFunction;
   // archive << s.propertyRadialDistributionFunction;
   // archive << s.propertyDensityGrid;
+  archive << s.convergenceMonitor;
+  archive << s.equilibrationDetector;
+  archive << s.moveProbabilityTuning;
 
   return archive;
 }
@@ -2172,6 +2320,25 @@ Archive<std::ifstream>& operator>>(Archive<std::ifstream>& archive, System& s)
   archive >> s.columnTimeStep;
   archive >> s.columnNumberOfTimeSteps;
   archive >> s.columnAutoNumberOfTimeSteps;
+  if (versionNumber >= 5)
+  {
+    archive >> s.columnIntegrator;
+    archive >> s.columnRelativeTolerance;
+    archive >> s.columnAbsoluteTolerance;
+    archive >> s.columnMaximumTimeStep;
+  }
+  if (versionNumber >= 7)
+  {
+    archive >> s.columnConvectionScheme;
+  }
+  if (versionNumber >= 8)
+  {
+    archive >> s.columnOutputFormat;
+  }
+  if (versionNumber >= 6)
+  {
+    archive >> s.useSpreadingPressureTables;
+  }
   archive >> s.mixturePredictionMethod;
   archive >> s.pressure_range;
   archive >> s.numberOfCarrierGases;
@@ -2190,6 +2357,18 @@ Archive<std::ifstream>& operator>>(Archive<std::ifstream>& archive, System& s)
   archive >> s.propertyConventionalRadialDistributionFunction;
   // archive >> s.propertyRadialDistributionFunction;
   // archive >> s.propertyDensityGrid;
+  if (versionNumber >= 2)
+  {
+    archive >> s.convergenceMonitor;
+  }
+  if (versionNumber >= 3)
+  {
+    archive >> s.equilibrationDetector;
+  }
+  if (versionNumber >= 4)
+  {
+    archive >> s.moveProbabilityTuning;
+  }
 
   return archive;
 }
@@ -2212,6 +2391,7 @@ void System::readRestartFile()
 
   simulationBox = j["simulationBox"];
   atomPositions = j["atomPositions"];
+  ++atomPositionsVersion;
   moleculePositions = j["moleculePositions"];
 }
 
@@ -73,6 +73,9 @@ import property_energy_histogram;
 import property_number_of_molecules_histogram;
 import property_msd;
 import property_vacf;
+import convergence_monitor;
+import equilibration_detection;
+import mc_moves_probability_tuning;
 import multi_site_isotherm;
 import pressure_range;
 import units;
@@ -135,7 +138,7 @@ export struct System
   System(size_t id, double T, std::optional<double> P, double heliumVoidFraction,
          std::vector<Framework> frameworkComponents, std::vector<Component> components);
 
-  uint64_t versionNumber{1};
+  uint64_t versionNumber{8};
 
   size_t systemId{};
 
@@ -204,6 +207,8 @@ export struct System
   // The atoms-order is defined as increasing per component and molecule.
   // Because the number of atoms is fixed per component it is easy to access the n-th molecule
   std::vector<Atom> atomPositions;
+  // Bumped whenever 'atomPositions' is resized, so that views on its memory can detect a reallocation
+  size_t atomPositionsVersion{0};
   std::vector<Molecule> moleculePositions;
   std::vector<double> electricPotential;
   std::vector<double3> electricField;
@@ -253,6 +258,30 @@ export struct System
   double columnTimeStep{0.0005};
   size_t columnNumberOfTimeSteps{0};
   bool columnAutoNumberOfTimeSteps{true};
+  enum class ColumnIntegrator : size_t
+  {
+    SSP_RK = 0,
+    AdaptiveSSP_RK = 1,
+    Rosenbrock = 2
+  };
+  ColumnIntegrator columnIntegrator{ColumnIntegrator::SSP_RK};
+  double columnRelativeTolerance{1e-4};
+  double columnAbsoluteTolerance{1e-6};
+  double columnMaximumTimeStep{0.0};  // no limit when zero
+  enum class ColumnConvectionScheme : size_t
+  {
+    Upwind = 0,
+    VanLeer = 1,
+    WENO3 = 2
+  };
+  ColumnConvectionScheme columnConvectionScheme{ColumnConvectionScheme::Upwind};
+  enum class ColumnOutputFormat : size_t
+  {
+    Text = 0,
+    HDF5 = 1
+  };
+  ColumnOutputFormat columnOutputFormat{ColumnOutputFormat::Text};
+  bool useSpreadingPressureTables{false};
   MultiSiteIsotherm::PredictionMethod mixturePredictionMethod{MultiSiteIsotherm::PredictionMethod::IAST};
   PressureRange pressure_range;
   size_t numberOfCarrierGases{0};
@@ -278,6 +307,9 @@ export struct System
   std::optional<PropertyNumberOfMoleculesHistogram> averageNumberOfMoleculesHistogram;
   std::optional<PropertyMeanSquaredDisplacement> propertyMSD;
   std::optional<PropertyVelocityAutoCorrelationFunction> propertyVACF;
+  std::optional<ConvergenceMonitor> convergenceMonitor;
+  std::optional<EquilibrationDetector> equilibrationDetector;
+  std::optional<MCMoveProbabilityTuning> moveProbabilityTuning;
 
   /// The fractional molecule for grand-canonical is stored first
   inline size_t indexOfGCFractionalMoleculesPerComponent_CFCMC([[maybe_unused]] size_t selectedComponent) { return 0; }
@@ -299,10 +331,30 @@ export struct System
 
   void createFrameworks();
   void createInitialMolecules(RandomNumber &random);
+
+  /**
+   * \brief Grows a molecule of the component with CBMC, avoiding overlaps and blocked pockets, and inserts it.
+   */
+  void growMolecule(RandomNumber &random, size_t componentId);
+
+  /**
+   * \brief Grows or deletes integer molecules of the component until it holds 'numberOfMolecules' of them.
+   *
+   * The running energies are not updated and need to be recomputed afterwards.
+   */
+  void setNumberOfIntegerMolecules(RandomNumber &random, size_t componentId, size_t numberOfMolecules);
   void determineSimulationBox();
 
   void checkCartesianPositions();
 
+  /**
+   * \brief Changes the external temperature and pressure, updating beta and the fluid properties of the components.
+   *
+   * Fugacity coefficients that have a value are kept; reset them to std::nullopt to have them recomputed from the
+   * equation of state at the new conditions.
+   */
+  void setExternalConditions(double T, std::optional<double> P);
+
   void precomputeTotalRigidEnergy() noexcept;
   void precomputeTotalGradients() noexcept;
   RunningEnergy computeTotalEnergies() noexcept;
@@ -386,6 +438,7 @@ export struct System
   nlohmann::json jsonSystemStatus() const;
   nlohmann::json jsonComponentStatus() const;
   nlohmann::json jsonMCMoveStatistics() const;
+  nlohmann::json jsonProductionStatusReportMC(size_t currentCycle, size_t numberOfCycles) const;
 
   void insertMolecule(size_t selectedComponent, const Molecule &molecule, std::vector<Atom> atoms);
   void insertFractionalMolecule(size_t selectedComponent, const Molecule &molecule, std::vector<Atom> atoms,
@@ -400,6 +453,9 @@ export struct System
 
   void sampleProperties(size_t currentBlock, size_t currentCycle);
 
+  /// Combines the blocks of all block-averaged properties after the bins of the block error estimation changed.
+  void rebinProperties(const std::vector<size_t> &boundaries);
+
   void writeCPUTimeStatistics(std::ostream &stream) const;
 
   [[nodiscard]] std::pair<EnergyStatus, double3x3> computeMolecularPressure() noexcept;
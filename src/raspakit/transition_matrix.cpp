@@ -16,6 +16,7 @@ module;
 #include <numeric>
 #include <print>
 #include <source_location>
+#include <string>
 #include <utility>
 #include <vector>
 #endif
@@ -40,6 +41,7 @@ import <exception>;
 import <source_location>;
 import <complex>;
 import <print>;
+import <string>;
 #endif
 
 import archive;
@@ -88,6 +90,9 @@ double TransitionMatrix::biasFactor(size_t newN, size_t oldN)
 {
   if (!doTMMC || !useBias || !useTMBias) return 1.0;
 
+  // moves out of the macrostate range are rejected by the caller
+  if ((newN > maxMacrostate) || (newN < minMacrostate)) return 1.0;
+
   double TMMCBias = bias[newN - minMacrostate] - bias[oldN - minMacrostate];
   return std::exp(TMMCBias);
 };
@@ -101,6 +106,13 @@ void TransitionMatrix::adjustBias()
 
   numberOfUpdates++;
 
+  computeLnpi();
+};
+
+void TransitionMatrix::computeLnpi()
+{
+  if (std::all_of(histogram.begin(), histogram.end(), [](const size_t &i) { return i == 0; })) return;
+
   // get the lowest and highest visited states in terms of loading
   size_t minVisitedN = static_cast<size_t>(std::distance(
       histogram.begin(), std::find_if(histogram.begin(), histogram.end(), [](const size_t &i) { return i; })));
@@ -174,13 +186,86 @@ void TransitionMatrix::clearCMatrix()
   std::fill(bias.begin(), bias.end(), 1.0);
 };
 
-void TransitionMatrix::writeStatistics()
+std::vector<std::pair<size_t, size_t>> TransitionMatrix::windowRanges(size_t minMacrostate, size_t maxMacrostate,
+                                                                      size_t numberOfWindows, size_t overlap)
+{
+  size_t numberOfMacrostates = maxMacrostate - minMacrostate + 1;
+  if (numberOfWindows == 0 || numberOfWindows > numberOfMacrostates)
+  {
+    throw std::runtime_error(std::format("Error: cannot split the TMMC macrostate range ({}-{}) into {} windows\n",
+                                         minMacrostate, maxMacrostate, numberOfWindows));
+  }
+  overlap = std::max(overlap, 1uz);
+
+  // split the range into adjacent blocks, and widen every block by half the overlap on both sides
+  std::vector<std::pair<size_t, size_t>> ranges{};
+  for (size_t k = 0; k != numberOfWindows; ++k)
+  {
+    size_t begin = minMacrostate + k * numberOfMacrostates / numberOfWindows;
+    size_t end = minMacrostate + (k + 1) * numberOfMacrostates / numberOfWindows;
+    size_t lower = begin - std::min(overlap / 2, begin - minMacrostate);
+    size_t upper = std::min(end - 1 + (overlap - overlap / 2), maxMacrostate);
+    ranges.emplace_back(lower, upper);
+  }
+  return ranges;
+}
+
+TransitionMatrix TransitionMatrix::stitch(const std::vector<TransitionMatrix> &windows)
+{
+  if (windows.empty())
+  {
+    throw std::runtime_error("Error: no TMMC windows to stitch\n");
+  }
+
+  TransitionMatrix stitched = windows.front();
+  for (const TransitionMatrix &window : windows)
+  {
+    stitched.minMacrostate = std::min(stitched.minMacrostate, window.minMacrostate);
+    stitched.maxMacrostate = std::max(stitched.maxMacrostate, window.maxMacrostate);
+  }
+  size_t numberOfMacrostates = stitched.maxMacrostate - stitched.minMacrostate + 1;
+
+  stitched.numberOfSteps = 0;
+  stitched.numberOfUpdates = 0;
+  stitched.numberOfWindows = windows.size();
+  stitched.cmatrix.assign(numberOfMacrostates, double3(0.0, 0.0, 0.0));
+  stitched.histogram.assign(numberOfMacrostates, 0);
+  stitched.bias.assign(numberOfMacrostates, 1.0);
+  stitched.lnpi.assign(numberOfMacrostates, 0.0);
+  stitched.forward_lnpi.assign(numberOfMacrostates, 0.0);
+  stitched.reverse_lnpi.assign(numberOfMacrostates, 0.0);
+
+  std::vector<bool> covered(numberOfMacrostates, false);
+  for (const TransitionMatrix &window : windows)
+  {
+    for (size_t N = window.minMacrostate; N <= window.maxMacrostate; ++N)
+    {
+      stitched.cmatrix[N - stitched.minMacrostate] += window.cmatrix[N - window.minMacrostate];
+      stitched.histogram[N - stitched.minMacrostate] += window.histogram[N - window.minMacrostate];
+      covered[N - stitched.minMacrostate] = true;
+    }
+    stitched.numberOfSteps += window.numberOfSteps;
+    stitched.numberOfUpdates += window.numberOfUpdates;
+  }
+
+  std::vector<bool>::iterator gap = std::find(covered.begin(), covered.end(), false);
+  if (gap != covered.end())
+  {
+    throw std::runtime_error(std::format("Error: macrostate {} is not covered by any TMMC window\n",
+                                         stitched.minMacrostate + std::distance(covered.begin(), gap)));
+  }
+
+  stitched.computeLnpi();
+  return stitched;
+}
+
+void TransitionMatrix::writeStatistics(const std::string &directory)
 {
   std::ofstream textTMMCFile{};
   std::filesystem::path cwd = std::filesystem::current_path();
 
-  std::string dirname = "tmmc/";
-  std::string fname = dirname + "/" + "tmmc_statistics.txt";
+  std::string dirname = directory + "/";
+  std::string fname = dirname + "tmmc_statistics.txt";
 
   std::filesystem::path directoryName = cwd / dirname;
   std::filesystem::path fileName = cwd / fname;
@@ -228,6 +313,8 @@ Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const Transi
   archive << m.maxMacrostate;
   archive << m.updateTMEvery;
   archive << m.numberOfUpdates;
+  archive << m.numberOfWindows;
+  archive << m.windowOverlap;
 
   archive << m.doTMMC;
   archive << m.useBias;
@@ -261,6 +348,8 @@ Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, TransitionMa
   archive >> m.maxMacrostate;
   archive >> m.updateTMEvery;
   archive >> m.numberOfUpdates;
+  archive >> m.numberOfWindows;
+  archive >> m.windowOverlap;
 
   archive >> m.doTMMC;
   archive >> m.useBias;
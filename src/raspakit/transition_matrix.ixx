@@ -4,6 +4,8 @@ module;
 #include <cmath>
 #include <cstddef>
 #include <fstream>
+#include <string>
+#include <utility>
 #include <vector>
 #endif
 
@@ -14,6 +16,8 @@ import <cmath>;
 import <cstddef>;
 import <vector>;
 import <fstream>;
+import <string>;
+import <utility>;
 #endif
 
 import archive;
@@ -31,7 +35,7 @@ import double3;
  */
 export struct TransitionMatrix
 {
-  uint64_t versionNumber{1};  ///< Version number for serialization compatibility.
+  uint64_t versionNumber{2};  ///< Version number for serialization compatibility.
 
   bool operator==(TransitionMatrix const &) const = default;
 
@@ -47,6 +51,8 @@ export struct TransitionMatrix
   size_t maxMacrostate = {100};      ///< Maximum macrostate value.
   size_t updateTMEvery = {1000000};  ///< Number of steps between bias updates.
   size_t numberOfUpdates = {0};      ///< Number of times the bias has been updated.
+  size_t numberOfWindows = {1};      ///< Number of windows the macrostate range is split into.
+  size_t windowOverlap = {1};        ///< Number of macrostates shared by neighbouring windows.
 
   bool doTMMC = {false};                     ///< Flag indicating whether to perform TMMC simulation.
   bool useBias = {false};                    ///< Flag indicating whether to use bias for changing macrostates.
@@ -108,6 +114,15 @@ export struct TransitionMatrix
    */
   void adjustBias();
 
+  /**
+   * \brief Computes ln(pi) and the bias from the collection matrix over the visited macrostates.
+   *
+   * Neighbouring macrostates are linked by detailed balance, ln pi(N+1) - ln pi(N) = ln P(N -> N+1) - ln P(N+1 -> N),
+   * with the transition probabilities estimated from the rows of the collection matrix. Unvisited macrostates get
+   * the value of the nearest visited one. The result is normalized and the bias is set to -ln(pi).
+   */
+  void computeLnpi();
+
   /**
    * \brief Clears the collection matrix and resets counters.
    *
@@ -122,7 +137,28 @@ export struct TransitionMatrix
    * Outputs the current state of the collection matrix, bias factors, probability
    * distributions, and histogram data to a text file for analysis and debugging.
    */
-  void writeStatistics();
+  void writeStatistics(const std::string &directory = "tmmc");
+
+  /**
+   * \brief Splits the macrostate range into windows of near-equal size.
+   *
+   * Neighbouring windows share 'overlap' macrostates (at least one), so the windows together cover
+   * [minMacrostate, maxMacrostate] without gaps.
+   *
+   * \return The lowest and highest macrostate of every window, in increasing order.
+   */
+  static std::vector<std::pair<size_t, size_t>> windowRanges(size_t minMacrostate, size_t maxMacrostate,
+                                                             size_t numberOfWindows, size_t overlap);
+
+  /**
+   * \brief Combines the transition matrices of the windows into one over their joint macrostate range.
+   *
+   * The rows of a collection matrix hold the acceptance probabilities of attempted transitions, which do not depend
+   * on the bias or on how often a macrostate is visited. The collection matrices and histograms of the windows are
+   * therefore summed macrostate by macrostate, and ln(pi) of the whole range follows from the summed matrix with
+   * 'computeLnpi'. The windows must cover the range without gaps.
+   */
+  static TransitionMatrix stitch(const std::vector<TransitionMatrix> &windows);
 
   friend Archive<std::ofstream> &operator<<(Archive<std::ofstream> &archive, const TransitionMatrix &m);
   friend Archive<std::ifstream> &operator>>(Archive<std::ifstream> &archive, TransitionMatrix &m);
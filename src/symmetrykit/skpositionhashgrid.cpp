@@ -0,0 +1,149 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <tuple>
+#include <vector>
+#endif
+
+module skpositionhashgrid;
+
+#ifndef USE_LEGACY_HEADERS
+import <algorithm>;
+import <array>;
+import <cmath>;
+import <cstddef>;
+import <numeric>;
+import <tuple>;
+import <vector>;
+#endif
+
+import double3;
+import double3x3;
+
+SKPositionHashGrid::SKPositionHashGrid(const std::vector<std::tuple<double3, size_t, double>>& atoms,
+                                       double3x3 unitCell, bool allowPartialOccupancies, double precision)
+    : _unitCell(unitCell), _allowPartialOccupancies(allowPartialOccupancies), _squaredPrecision(precision * precision)
+{
+  if (!allowPartialOccupancies)
+  {
+    for (const std::tuple<double3, size_t, double>& atom : atoms)
+    {
+      _types.push_back(std::get<1>(atom));
+    }
+    std::sort(_types.begin(), _types.end());
+    _types.erase(std::unique(_types.begin(), _types.end()), _types.end());
+  }
+  size_t numberOfBuckets = std::max(_types.size(), size_t{1});
+
+  // a position within the precision differs at most 'precision' times the norm of a row of the inverse cell in
+  // the corresponding fractional coordinate; the cells are no smaller than twice that, and about one atom wide
+  double3x3 inverseCell = unitCell.inverse();
+  std::array<double, 3> window{precision * double3(inverseCell[0][0], inverseCell[1][0], inverseCell[2][0]).length(),
+                               precision * double3(inverseCell[0][1], inverseCell[1][1], inverseCell[2][1]).length(),
+                               precision * double3(inverseCell[0][2], inverseCell[1][2], inverseCell[2][2]).length()};
+  size_t maximumNumberOfCells = std::max(size_t{1}, static_cast<size_t>(std::cbrt(static_cast<double>(atoms.size()))));
+  for (size_t d = 0; d != 3; ++d)
+  {
+    double largest = window[d] > 0.0 ? std::floor(0.5 / window[d]) : static_cast<double>(maximumNumberOfCells);
+    _numberOfCells[d] = std::clamp(static_cast<size_t>(std::min(largest, static_cast<double>(maximumNumberOfCells))),
+                                   size_t{1}, maximumNumberOfCells);
+    _reach[d] = static_cast<size_t>(std::ceil(window[d] * static_cast<double>(_numberOfCells[d])));
+  }
+
+  // sort the atoms by bucket and cell, with the offsets of every (bucket, cell) pair
+  size_t numberOfCells = _numberOfCells[0] * _numberOfCells[1] * _numberOfCells[2];
+  std::vector<size_t> keys(atoms.size());
+  _cellOffsets.assign(numberOfBuckets * numberOfCells + 1, 0);
+  for (size_t i = 0; i != atoms.size(); ++i)
+  {
+    std::array<size_t, 3> cell = cellIndex(std::get<0>(atoms[i]));
+    keys[i] = (bucket(std::get<1>(atoms[i])) * _numberOfCells[0] + cell[0]) * _numberOfCells[1] * _numberOfCells[2] +
+              cell[1] * _numberOfCells[2] + cell[2];
+    ++_cellOffsets[keys[i] + 1];
+  }
+  std::partial_sum(_cellOffsets.begin(), _cellOffsets.end(), _cellOffsets.begin());
+
+  std::vector<size_t> next(_cellOffsets.begin(), _cellOffsets.end() - 1);
+  _positions.resize(atoms.size());
+  for (size_t i = 0; i != atoms.size(); ++i)
+  {
+    _positions[next[keys[i]]++] = std::get<0>(atoms[i]);
+  }
+}
+
+std::array<size_t, 3> SKPositionHashGrid::cellIndex(double3 position) const
+{
+  double3 s = double3::fract(position);
+  return {std::min(_numberOfCells[0] - 1, static_cast<size_t>(s.x * static_cast<double>(_numberOfCells[0]))),
+          std::min(_numberOfCells[1] - 1, static_cast<size_t>(s.y * static_cast<double>(_numberOfCells[1]))),
+          std::min(_numberOfCells[2] - 1, static_cast<size_t>(s.z * static_cast<double>(_numberOfCells[2])))};
+}
+
+size_t SKPositionHashGrid::bucket(size_t type) const
+{
+  if (_allowPartialOccupancies) return 0;
+  return static_cast<size_t>(std::lower_bound(_types.begin(), _types.end(), type) - _types.begin());
+}
+
+bool SKPositionHashGrid::contains(double3 position, size_t type) const
+{
+  if (!_allowPartialOccupancies && !std::binary_search(_types.begin(), _types.end(), type)) return false;
+
+  std::array<size_t, 3> cell = cellIndex(position);
+  size_t firstCell = bucket(type) * _numberOfCells[0] * _numberOfCells[1] * _numberOfCells[2];
+
+  // the neighbouring cells along each direction, every cell once when the window wraps around the unit cell; the
+  // cells are at least twice the window wide, so the reach is at most one cell and three cells suffice per direction
+  std::array<std::array<size_t, 3>, 3> neighbours{};
+  std::array<size_t, 3> numberOfNeighbours{};
+  for (size_t d = 0; d != 3; ++d)
+  {
+    if (2 * _reach[d] + 1 >= _numberOfCells[d])
+    {
+      numberOfNeighbours[d] = _numberOfCells[d];
+      for (size_t offset = 0; offset != _numberOfCells[d]; ++offset)
+      {
+        neighbours[d][offset] = offset;
+      }
+    }
+    else
+    {
+      numberOfNeighbours[d] = 2 * _reach[d] + 1;
+      for (size_t offset = 0; offset != numberOfNeighbours[d]; ++offset)
+      {
+        neighbours[d][offset] = (cell[d] + _numberOfCells[d] + offset - _reach[d]) % _numberOfCells[d];
+      }
+    }
+  }
+
+  for (size_t a = 0; a != numberOfNeighbours[0]; ++a)
+  {
+    size_t i = neighbours[0][a];
+    for (size_t b = 0; b != numberOfNeighbours[1]; ++b)
+    {
+      size_t j = neighbours[1][b];
+      for (size_t c = 0; c != numberOfNeighbours[2]; ++c)
+      {
+        size_t k = neighbours[2][c];
+        size_t key = firstCell + (i * _numberOfCells[1] + j) * _numberOfCells[2] + k;
+        for (size_t index = _cellOffsets[key]; index != _cellOffsets[key + 1]; ++index)
+        {
+          double3 dr = position - _positions[index];
+          dr.x -= rint(dr.x);
+          dr.y -= rint(dr.y);
+          dr.z -= rint(dr.z);
+          if ((_unitCell * dr).length_squared() < _squaredPrecision)
+          {
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
@@ -0,0 +1,51 @@
+module;
+
+#ifdef USE_LEGACY_HEADERS
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+#endif
+
+export module skpositionhashgrid;
+
+#ifndef USE_LEGACY_HEADERS
+import <array>;
+import <cstddef>;
+import <tuple>;
+import <vector>;
+#endif
+
+import double3;
+import double3x3;
+
+/// A grid over fractional coordinates that finds the atoms overlapping a position in constant time.
+///
+/// The atoms are bucketed by type (a single bucket when partial occupancies are allowed) and by the grid cell of their
+/// fractional position wrapped into the unit cell. A query only visits the grid cells within the symmetry precision
+/// of the position, and applies the same overlap criterion as the all-pairs search to the atoms found there, so a
+/// symmetry operation on N atoms is checked in O(N) instead of O(N^2). The grid is built once per atom set and reused
+/// for all candidate operations.
+export class SKPositionHashGrid
+{
+ public:
+  SKPositionHashGrid(const std::vector<std::tuple<double3, size_t, double>>& atoms, double3x3 unitCell,
+                     bool allowPartialOccupancies, double precision);
+
+  /// Returns whether an atom of type 'type' (or of any type when partial occupancies are allowed) lies within the
+  /// precision of the fractional position 'position', modulo lattice translations.
+  bool contains(double3 position, size_t type) const;
+
+ private:
+  double3x3 _unitCell;
+  bool _allowPartialOccupancies;
+  double _squaredPrecision;
+  std::array<size_t, 3> _numberOfCells{1, 1, 1};
+  std::array<size_t, 3> _reach{0, 0, 0};
+  std::vector<size_t> _types{};
+  std::vector<size_t> _cellOffsets{};
+  std::vector<double3> _positions{};
+
+  std::array<size_t, 3> cellIndex(double3 position) const;
+  size_t bucket(size_t type) const;
+};
@@ -38,6 +38,7 @@ import skseitzmatrix;
 import skpointsymmetryset;
 import sksymmetryoperationset;
 import sksymmetrycell;
+import skpositionhashgrid;
 import skintegerchangeofbasis;
 import skpointgroup;
 import skspacegroupdatabase;
@@ -201,10 +202,13 @@ SKSymmetryOperationSet SKSpaceGroup::findSpaceGroupSymmetry(
 {
   std::vector<SKSeitzMatrix> spaceGroupSymmetries{};
 
+  // the grid of the atoms is shared by all lattice rotations
+  SKPositionHashGrid grid(atoms, unitCell, allowPartialOccupancies, symmetryPrecision);
+
   for (const SKRotationMatrix& rotationMatrix : latticeSymmetries.rotations())
   {
-    std::vector<double3> translations = SKSymmetryCell::primitiveTranslationVectors(
-        unitCell, reducedAtoms, atoms, rotationMatrix, allowPartialOccupancies, symmetryPrecision);
+    std::vector<double3> translations =
+        SKSymmetryCell::primitiveTranslationVectors(reducedAtoms, atoms, rotationMatrix, grid);
 
     for (const double3& translation : translations)
     {
@@ -40,6 +40,7 @@ import skdefinitions;
 import skrotationmatrix;
 import skpointgroup;
 import skpointsymmetryset;
+import skpositionhashgrid;
 import sktransformationmatrix;
 
 SKSymmetryCell::SKSymmetryCell() {}
@@ -192,22 +193,23 @@ bool SKSymmetryCell::isOverlap(double3 a, double3 b, double3x3 lattice, double s
   return false;
 }
 
-double3x3 SKSymmetryCell::findSmallestPrimitiveCell(std::vector<std::tuple<double3, size_t, double>> reducedAtoms,
-                                                    std::vector<std::tuple<double3, size_t, double>> atoms,
-                                                    double3x3 unitCell, bool allowPartialOccupancies,
-                                                    double symmetryPrecision = 1e-2)
+double3x3 SKSymmetryCell::findSmallestPrimitiveCell(
+    const std::vector<std::tuple<double3, size_t, double>>& reducedAtoms,
+    const std::vector<std::tuple<double3, size_t, double>>& atoms, double3x3 unitCell, bool allowPartialOccupancies,
+    double symmetryPrecision = 1e-2)
 {
   std::vector<double3> translationVectors{};
 
   if (reducedAtoms.size() > 0)
   {
     double3 origin = std::get<0>(reducedAtoms[0]);
+    SKPositionHashGrid grid(atoms, unitCell, allowPartialOccupancies, symmetryPrecision);
 
     for (size_t i = 1; i < reducedAtoms.size(); i++)
     {
       double3 vec = std::get<0>(reducedAtoms[i]) - origin;
 
-      if (SKSymmetryCell::testTranslationalSymmetry(vec, atoms, unitCell, allowPartialOccupancies, symmetryPrecision))
+      if (SKSymmetryCell::testTranslationalSymmetry(vec, atoms, grid))
       {
         double3 a = double3(vec.x - rint(vec.x), vec.y - rint(vec.y), vec.z - rint(vec.z));
         if (a.x < 0.0 - 1e-10)
@@ -272,35 +274,22 @@ double3x3 SKSymmetryCell::findSmallestPrimitiveCell(std::vector<std::tuple<doubl
 }
 
 bool SKSymmetryCell::testTranslationalSymmetry(double3 translationVector,
-                                               std::vector<std::tuple<double3, size_t, double>> atoms,
+                                               const std::vector<std::tuple<double3, size_t, double>>& atoms,
                                                double3x3 unitCell, bool allowPartialOccupancies,
                                                double precision = 1e-2)
 {
-  double squared_precision = precision * precision;
+  return testTranslationalSymmetry(translationVector, atoms,
+                                   SKPositionHashGrid(atoms, unitCell, allowPartialOccupancies, precision));
+}
 
-  for (size_t i = 0; i < atoms.size(); i++)
+bool SKSymmetryCell::testTranslationalSymmetry(double3 translationVector,
+                                               const std::vector<std::tuple<double3, size_t, double>>& atoms,
+                                               const SKPositionHashGrid& grid)
+{
+  for (const std::tuple<double3, size_t, double>& atom : atoms)
   {
-    double3 translatedPosition = std::get<0>(atoms[i]) + translationVector;
-
-    bool isFound = false;
-    for (size_t j = 0; j < atoms.size(); j++)
-    {
-      if (allowPartialOccupancies || std::get<1>(atoms[i]) == std::get<1>(atoms[j]))
-      {
-        double3 dr = translatedPosition - std::get<0>(atoms[j]);
-        dr.x -= rint(dr.x);
-        dr.y -= rint(dr.y);
-        dr.z -= rint(dr.z);
-        if ((unitCell * dr).length_squared() < squared_precision)
-        {
-          isFound = true;
-          break;
-        }
-      }
-    }
-
     // if no overlap is found then we can immediately return 'false'
-    if (!isFound)
+    if (!grid.contains(std::get<0>(atom) + translationVector, std::get<1>(atom)))
     {
       return false;
     }
@@ -309,32 +298,21 @@ bool SKSymmetryCell::testTranslationalSymmetry(double3 translationVector,
 }
 
 bool SKSymmetryCell::testSymmetry(double3 translationVector, SKRotationMatrix rotationMatrix,
-                                  std::vector<std::tuple<double3, size_t, double>> atoms, double3x3 unitCell,
+                                  const std::vector<std::tuple<double3, size_t, double>>& atoms, double3x3 unitCell,
                                   bool allowPartialOccupancies, double precision = 1e-2)
 {
-  for (size_t i = 0; i < atoms.size(); i++)
-  {
-    double3 rotatedAndTranslatedPosition = rotationMatrix * std::get<0>(atoms[i]) + translationVector;
-
-    bool isFound = false;
-    for (size_t j = 0; j < atoms.size(); j++)
-    {
-      if (allowPartialOccupancies || std::get<1>(atoms[i]) == std::get<1>(atoms[j]))
-      {
-        double3 dr = rotatedAndTranslatedPosition - std::get<0>(atoms[j]);
-        dr.x -= rint(dr.x);
-        dr.y -= rint(dr.y);
-        dr.z -= rint(dr.z);
-        if ((unitCell * dr).length_squared() < precision * precision)
-        {
-          isFound = true;
-          break;
-        }
-      }
-    }
+  return testSymmetry(translationVector, rotationMatrix, atoms,
+                      SKPositionHashGrid(atoms, unitCell, allowPartialOccupancies, precision));
+}
 
+bool SKSymmetryCell::testSymmetry(double3 translationVector, SKRotationMatrix rotationMatrix,
+                                  const std::vector<std::tuple<double3, size_t, double>>& atoms,
+                                  const SKPositionHashGrid& grid)
+{
+  for (const std::tuple<double3, size_t, double>& atom : atoms)
+  {
     // if no overlap is found then we can immediately return 'false'
-    if (!isFound)
+    if (!grid.contains(rotationMatrix * std::get<0>(atom) + translationVector, std::get<1>(atom)))
     {
       return false;
     }
@@ -351,9 +329,20 @@ bool SKSymmetryCell::testSymmetry(double3 translationVector, SKRotationMatrix ro
 ///
 /// - returns: the list of translation vectors, including (0,0,0)
 std::vector<double3> SKSymmetryCell::primitiveTranslationVectors(
-    double3x3 unitCell, std::vector<std::tuple<double3, size_t, double>> reducedAtoms,
-    std::vector<std::tuple<double3, size_t, double>> atoms, SKRotationMatrix rotationMatrix,
+    double3x3 unitCell, const std::vector<std::tuple<double3, size_t, double>>& reducedAtoms,
+    const std::vector<std::tuple<double3, size_t, double>>& atoms, SKRotationMatrix rotationMatrix,
     bool allowPartialOccupancies, double symmetryPrecision = 1e-2)
+{
+  return primitiveTranslationVectors(reducedAtoms, atoms, rotationMatrix,
+                                     SKPositionHashGrid(atoms, unitCell, allowPartialOccupancies, symmetryPrecision));
+}
+
+/// Computes translation vectors for symmetry operations, using a grid of 'atoms' that can be shared between the
+/// rotations
+std::vector<double3> SKSymmetryCell::primitiveTranslationVectors(
+    const std::vector<std::tuple<double3, size_t, double>>& reducedAtoms,
+    const std::vector<std::tuple<double3, size_t, double>>& atoms, SKRotationMatrix rotationMatrix,
+    const SKPositionHashGrid& grid)
 {
   std::vector<double3> translationVectors{};
 
@@ -365,8 +354,7 @@ std::vector<double3> SKSymmetryCell::primitiveTranslationVectors(
     {
       double3 vec = std::get<0>(reducedAtoms[i]) - origin;
 
-      if (SKSymmetryCell::testSymmetry(vec, rotationMatrix, atoms, unitCell, allowPartialOccupancies,
-                                       symmetryPrecision))
+      if (SKSymmetryCell::testSymmetry(vec, rotationMatrix, atoms, grid))
       {
         translationVectors.push_back(vec);
       }
@@ -26,6 +26,7 @@ import skdefinitions;
 import skrotationmatrix;
 import sktransformationmatrix;
 import skpointsymmetryset;
+import skpositionhashgrid;
 
 export class SKSymmetryCell
 {
@@ -38,20 +39,30 @@ export class SKSymmetryCell
   double3x3 unitCell() const;
   double3x3 metricTensor();
   double volume();
-  static double3x3 findSmallestPrimitiveCell(std::vector<std::tuple<double3, size_t, double>> reducedAtoms,
-                                             std::vector<std::tuple<double3, size_t, double>> atoms, double3x3 unitCell,
-                                             bool allowPartialOccupancies, double symmetryPrecision);
+  static double3x3 findSmallestPrimitiveCell(const std::vector<std::tuple<double3, size_t, double>>& reducedAtoms,
+                                             const std::vector<std::tuple<double3, size_t, double>>& atoms,
+                                             double3x3 unitCell, bool allowPartialOccupancies,
+                                             double symmetryPrecision);
   static bool testTranslationalSymmetry(double3 translationVector,
-                                        std::vector<std::tuple<double3, size_t, double>> atoms, double3x3 unitCell,
-                                        bool allowPartialOccupancies, double precision);
+                                        const std::vector<std::tuple<double3, size_t, double>>& atoms,
+                                        double3x3 unitCell, bool allowPartialOccupancies, double precision);
+  static bool testTranslationalSymmetry(double3 translationVector,
+                                        const std::vector<std::tuple<double3, size_t, double>>& atoms,
+                                        const SKPositionHashGrid& grid);
   static bool testSymmetry(double3 translationVector, SKRotationMatrix rotationMatrix,
-                           std::vector<std::tuple<double3, size_t, double>> atoms, double3x3 unitCell,
+                           const std::vector<std::tuple<double3, size_t, double>>& atoms, double3x3 unitCell,
                            bool allowPartialOccupancies, double precision);
-  static std::vector<double3> primitiveTranslationVectors(double3x3 unitCell,
-                                                          std::vector<std::tuple<double3, size_t, double>> reducedAtoms,
-                                                          std::vector<std::tuple<double3, size_t, double>> atoms,
-                                                          SKRotationMatrix rotationMatrix, bool allowPartialOccupancies,
-                                                          double symmetryPrecision);
+  static bool testSymmetry(double3 translationVector, SKRotationMatrix rotationMatrix,
+                           const std::vector<std::tuple<double3, size_t, double>>& atoms,
+                           const SKPositionHashGrid& grid);
+  static std::vector<double3> primitiveTranslationVectors(
+      double3x3 unitCell, const std::vector<std::tuple<double3, size_t, double>>& reducedAtoms,
+      const std::vector<std::tuple<double3, size_t, double>>& atoms, SKRotationMatrix rotationMatrix,
+      bool allowPartialOccupancies, double symmetryPrecision);
+  static std::vector<double3> primitiveTranslationVectors(
+      const std::vector<std::tuple<double3, size_t, double>>& reducedAtoms,
+      const std::vector<std::tuple<double3, size_t, double>>& atoms, SKRotationMatrix rotationMatrix,
+      const SKPositionHashGrid& grid);
   static std::optional<double3x3> computeDelaunayReducedCell(double3x3 unitCell, double symmetryPrecision);
   static std::optional<double3x3> computeDelaunayReducedCell2D(double3x3 unitCell, double symmetryPrecision);
   static SKPointSymmetrySet findLatticeSymmetry(double3x3 reducedLattice, double symmetryPrecision);
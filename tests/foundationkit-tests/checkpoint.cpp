@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+import archive;
+import checkpoint;
+
+TEST(checkpoint, write_and_read_back)
+{
+  std::string fileName = (std::filesystem::temp_directory_path() / "checkpoint_test_1.bin").string();
+
+  std::vector<double> data{1.0, 2.0, 3.0, 4.0};
+  {
+    Checkpoint checkpoint(fileName, 1);
+    checkpoint.write(data);
+    checkpoint.wait();
+  }
+
+  std::ifstream ifile = Checkpoint::open(fileName, 1);
+  Archive<std::ifstream> archive(ifile);
+  std::vector<double> restored{};
+  archive >> restored;
+
+  EXPECT_EQ(data, restored);
+}
+
+TEST(checkpoint, rotation_and_fallback_on_corruption)
+{
+  std::string fileName = (std::filesystem::temp_directory_path() / "checkpoint_test_2.bin").string();
+
+  Checkpoint checkpoint(fileName, 3);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    checkpoint.write(std::vector<size_t>{i, i + 1, i + 2});
+  }
+  checkpoint.wait();
+
+  EXPECT_TRUE(std::filesystem::exists(Checkpoint::rotatedFileName(fileName, 1)));
+  EXPECT_TRUE(std::filesystem::exists(Checkpoint::rotatedFileName(fileName, 2)));
+  EXPECT_FALSE(std::filesystem::exists(Checkpoint::rotatedFileName(fileName, 3)));
+
+  // flip a byte in the payload of the newest checkpoint
+  {
+    std::fstream file(fileName, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(Checkpoint::headerSize + 10);
+    file.put('\x7f');
+  }
+
+  std::ifstream ifile = Checkpoint::open(fileName, 3);
+  Archive<std::ifstream> archive(ifile);
+  std::vector<size_t> restored{};
+  archive >> restored;
+
+  EXPECT_EQ(restored, (std::vector<size_t>{2, 3, 4}));
+}
+
+TEST(checkpoint, truncated_newest_falls_back_to_older_checkpoint)
+{
+  std::string fileName = (std::filesystem::temp_directory_path() / "checkpoint_test_3.bin").string();
+
+  Checkpoint checkpoint(fileName, 2);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    checkpoint.write(std::vector<size_t>{i, i + 1, i + 2});
+  }
+  checkpoint.wait();
+
+  // an interrupted write: empty, and cut off inside the header
+  for (size_t length : {0uz, 5uz})
+  {
+    std::filesystem::resize_file(fileName, length);
+
+    std::ifstream ifile = Checkpoint::open(fileName, 2);
+    Archive<std::ifstream> archive(ifile);
+    std::vector<size_t> restored{};
+    archive >> restored;
+
+    EXPECT_EQ(restored, (std::vector<size_t>{0, 1, 2})) << length;
+  }
+}
+
+TEST(checkpoint, headerless_newest_is_not_read_when_a_valid_checkpoint_exists)
+{
+  std::string fileName = (std::filesystem::temp_directory_path() / "checkpoint_test_4.bin").string();
+
+  Checkpoint checkpoint(fileName, 2);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    checkpoint.write(std::vector<size_t>{i, i + 1, i + 2});
+  }
+  checkpoint.wait();
+
+  // overwrite the magic string of the newest checkpoint
+  {
+    std::fstream file(fileName, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(0);
+    file.put('\x7f');
+  }
+
+  std::ifstream ifile = Checkpoint::open(fileName, 2);
+  Archive<std::ifstream> archive(ifile);
+  std::vector<size_t> restored{};
+  archive >> restored;
+
+  EXPECT_EQ(restored, (std::vector<size_t>{0, 1, 2}));
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+import hardware_counters;
+import tracing;
+
+TEST(hardware_counters, difference_is_clamped_at_zero)
+{
+  HardwareCounters::Values a{};
+  HardwareCounters::Values b{};
+  a.value[0] = 10;
+  b.value[0] = 4;
+  b.value[1] = 7;
+
+  HardwareCounters::Values difference = a - b;
+  EXPECT_EQ(difference[HardwareCounters::Counter::Cycles], 6u);
+  EXPECT_EQ(difference[HardwareCounters::Counter::Instructions], 0u);
+}
+
+TEST(hardware_counters, multiplexed_counts_are_extrapolated)
+{
+  HardwareCounters::Values begin{};
+  HardwareCounters::Values end{};
+  end.value[0] = 1000;
+  end.value[1] = 3000;
+  begin.timeEnabled = 100;
+  begin.timeRunning = 100;
+  end.timeEnabled = 500;
+  end.timeRunning = 300;
+
+  // counting during half of the enabled time of the interval
+  HardwareCounters::Values difference = end - begin;
+  EXPECT_EQ(difference.timeEnabled, 400u);
+  EXPECT_EQ(difference.timeRunning, 200u);
+
+  HardwareCounters::Values scaled = difference.scaled();
+  EXPECT_EQ(scaled[HardwareCounters::Counter::Cycles], 2000u);
+  EXPECT_EQ(scaled[HardwareCounters::Counter::Instructions], 6000u);
+
+  // counters that ran the whole time are not changed
+  difference.timeRunning = difference.timeEnabled;
+  EXPECT_EQ(difference.scaled()[HardwareCounters::Counter::Cycles], 1000u);
+}
+
+TEST(hardware_counters, zones_are_summed_per_name_or_skipped_when_unavailable)
+{
+  if (!HardwareCounters::enable())
+  {
+    EXPECT_FALSE(HardwareCounters::enabled());
+    EXPECT_EQ(HardwareCounters::jsonStatistics()["available"], false);
+    GTEST_SKIP();
+  }
+
+  HardwareCounters::clear();
+  for (size_t i = 0; i != 3; ++i)
+  {
+    Tracing::Zone zone("counted", "test");
+    volatile double sum = 0.0;
+    for (size_t j = 0; j != 10000; ++j) sum = sum + static_cast<double>(j);
+  }
+  HardwareCounters::disable();
+
+  std::map<std::string, HardwareCounters::Totals> totals = HardwareCounters::totals();
+  ASSERT_TRUE(totals.contains("counted"));
+  EXPECT_LE(totals["counted"].counters.timeRunning, totals["counted"].counters.timeEnabled);
+  EXPECT_EQ(totals["counted"].calls, 3uz);
+  if (HardwareCounters::available(HardwareCounters::Counter::Instructions))
+  {
+    EXPECT_GT(totals["counted"].counters[HardwareCounters::Counter::Instructions], 0u);
+  }
+}
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+import threadpool;
+
+TEST(threadpool, init_with_a_different_thread_count_restarts_the_pool)
+{
+  auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+
+  pool.init(3, ThreadPool::ThreadingType::ThreadPool);
+  EXPECT_EQ(pool.getThreadCount(), 2uz);
+  EXPECT_EQ(pool.size(), 2uz);
+
+  pool.init(5, ThreadPool::ThreadingType::ThreadPool);
+  EXPECT_EQ(pool.getThreadCount(), 4uz);
+  EXPECT_EQ(pool.size(), 4uz);
+
+  std::vector<std::future<size_t>> results;
+  for (size_t i = 0; i != 16uz; ++i)
+  {
+    results.push_back(pool.enqueue([i]() { return i * i; }));
+  }
+  for (size_t i = 0; i != 16uz; ++i)
+  {
+    EXPECT_EQ(results[i].get(), i * i);
+  }
+
+  // switching to serial execution keeps the worker threads
+  pool.init(1, ThreadPool::ThreadingType::Serial);
+  EXPECT_EQ(pool.size(), 4uz);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+import tracing;
+
+TEST(tracing, zone_adds_the_same_interval_to_all_accumulators)
+{
+  std::chrono::duration<double> a{1.0};
+  std::chrono::duration<double> b{0.0};
+
+  Tracing::Zone zone("test", "test");
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  std::chrono::duration<double> elapsed = zone.end(a, b);
+
+  EXPECT_GE(elapsed.count(), 0.002);
+  EXPECT_DOUBLE_EQ(a.count(), 1.0 + elapsed.count());
+  EXPECT_DOUBLE_EQ(b.count(), elapsed.count());
+}
+
+TEST(tracing, ring_buffer_keeps_the_most_recent_events_per_thread)
+{
+  if (!Tracing::compiledIn) GTEST_SKIP();
+  static const char *names[] = {"z0", "z1", "z2", "z3", "z4", "z5", "z6", "z7", "z8", "z9"};
+
+  Tracing::enable(4);
+  std::thread worker(
+      []()
+      {
+        for (const char *name : names)
+        {
+          Tracing::Zone zone(name, "test");
+        }
+      });
+  worker.join();
+  Tracing::disable();
+
+  bool found = false;
+  for (const Tracing::ThreadEvents &thread : Tracing::events())
+  {
+    if (thread.events.size() == 4 && std::string(thread.events.front().category) == "test")
+    {
+      found = true;
+      for (size_t i = 0; i < 4; ++i)
+      {
+        EXPECT_EQ(std::string(thread.events[i].name), std::string(names[6 + i]));
+        EXPECT_LE(thread.events[i].begin, thread.events[i].end);
+      }
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST(tracing, chrome_trace_contains_the_recorded_zones)
+{
+  if (!Tracing::compiledIn) GTEST_SKIP();
+  std::string fileName = (std::filesystem::temp_directory_path() / "tracing_test.json").string();
+
+  Tracing::enable(16);
+  Tracing::clear();
+  {
+    Tracing::Zone zone("translationMove", "mc");
+  }
+  Tracing::disable();
+  Tracing::writeChromeTrace(fileName);
+
+  std::ifstream file(fileName);
+  std::stringstream content;
+  content << file.rdbuf();
+  std::string trace = content.str();
+
+  EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"translationMove\",\"cat\":\"mc\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_EQ(trace.back(), '\n');
+}
@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+import int3;
+import double3;
+
+import atom;
+import pseudo_atom;
+import vdwparameters;
+import forcefield;
+import component;
+import system;
+import simulationbox;
+import isotherm;
+import multi_site_isotherm;
+import breakthrough;
+import threadpool;
+
+namespace
+{
+// helium as carrier gas and a weakly adsorbing component with a Langmuir isotherm, after 5 seconds the front is
+// halfway the column
+System breakthroughSystem(System::ColumnIntegrator integrator)
+{
+  ForceField forceField({PseudoAtom("He", false, 4.002602, 0.0, 0.0, 2, false),
+                         PseudoAtom("CH4", false, 16.04246, 0.0, 0.0, 6, false)},
+                        {VDWParameters(10.9, 2.64), VDWParameters(158.5, 3.72)},
+                        ForceField::MixingRule::Lorentz_Berthelot, 12.0, 12.0, 12.0, true, false, true);
+  Component helium(0, forceField, "helium", 5.2, 228000.0, -0.39, {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 0, 0, 0)},
+                   5, 21);
+  Component methane(1, forceField, "methane", 190.564, 45599200, 0.01142,
+                    {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 1, 1, 0)}, 5, 21);
+
+  System system(0, forceField, SimulationBox(30.0, 30.0, 30.0), 300.0, 1e5, 1.0, {}, {helium, methane}, {0, 0}, 5);
+
+  system.components[0].isCarrierGas = true;
+  system.components[0].molFraction = 0.5;
+  system.components[0].isotherm.add(Isotherm(Isotherm::Type::Langmuir, {1.0, 0.0}, 2));
+  system.components[0].isotherm.numberOfSites = 1;
+
+  system.components[1].molFraction = 0.5;
+  system.components[1].massTransferCoefficient = 1.0;
+  system.components[1].isotherm.add(Isotherm(Isotherm::Type::Langmuir, {1.0, 1e-6}, 2));
+  system.components[1].isotherm.numberOfSites = 1;
+
+  system.carrierGasComponent = 0;
+  system.numberOfCarrierGases = 1;
+  system.maxIsothermTerms = 1;
+
+  system.columnNumberOfGridPoints = 50;
+  system.columnTimeStep = 0.0005;
+  system.columnNumberOfTimeSteps = 10000;
+  system.columnAutoNumberOfTimeSteps = false;
+  system.columnIntegrator = integrator;
+
+  return system;
+}
+
+// helium as carrier gas with two competing components, so that every grid point needs a full IAST solution
+System mixtureSystem()
+{
+  ForceField forceField({PseudoAtom("He", false, 4.002602, 0.0, 0.0, 2, false),
+                         PseudoAtom("CH4", false, 16.04246, 0.0, 0.0, 6, false),
+                         PseudoAtom("C2H6", false, 30.06904, 0.0, 0.0, 6, false)},
+                        {VDWParameters(10.9, 2.64), VDWParameters(158.5, 3.72), VDWParameters(230.0, 3.95)},
+                        ForceField::MixingRule::Lorentz_Berthelot, 12.0, 12.0, 12.0, true, false, true);
+  Component helium(0, forceField, "helium", 5.2, 228000.0, -0.39, {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 0, 0, 0)},
+                   5, 21);
+  Component methane(1, forceField, "methane", 190.564, 45599200, 0.01142,
+                    {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 1, 1, 0)}, 5, 21);
+  Component ethane(2, forceField, "ethane", 305.32, 4872000, 0.0995,
+                   {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 2, 2, 0)}, 5, 21);
+
+  System system(0, forceField, SimulationBox(30.0, 30.0, 30.0), 300.0, 1e5, 1.0, {}, {helium, methane, ethane},
+                {0, 0, 0}, 5);
+
+  system.components[0].isCarrierGas = true;
+  system.components[0].molFraction = 0.4;
+  system.components[0].isotherm.add(Isotherm(Isotherm::Type::Langmuir, {1.0, 0.0}, 2));
+  system.components[0].isotherm.numberOfSites = 1;
+
+  system.components[1].molFraction = 0.3;
+  system.components[1].massTransferCoefficient = 1.0;
+  system.components[1].isotherm.add(Isotherm(Isotherm::Type::Langmuir, {4.0, 2e-6}, 2));
+  system.components[1].isotherm.numberOfSites = 1;
+
+  system.components[2].molFraction = 0.3;
+  system.components[2].massTransferCoefficient = 1.0;
+  system.components[2].isotherm.add(Isotherm(Isotherm::Type::Langmuir, {2.0, 2e-5}, 2));
+  system.components[2].isotherm.numberOfSites = 1;
+
+  system.carrierGasComponent = 0;
+  system.numberOfCarrierGases = 1;
+  system.maxIsothermTerms = 1;
+
+  system.columnNumberOfGridPoints = 64;
+  system.columnTimeStep = 0.0005;
+  system.columnNumberOfTimeSteps = 2000;
+  system.columnAutoNumberOfTimeSteps = false;
+
+  return system;
+}
+
+// the face fluxes of a profile of grid-point fluxes, with the point before the inlet equal to the inlet
+std::vector<double> faceFluxes(System::ColumnConvectionScheme scheme, const std::vector<double> &f)
+{
+  std::vector<double> faces(f.size() - 1);
+  for (size_t i = 0; i + 1 < f.size(); ++i)
+  {
+    faces[i] = Breakthrough::reconstructFaceFlux(scheme, i > 0 ? f[i - 1] : f[i], f[i], f[i + 1], 1.0);
+  }
+  return faces;
+}
+
+std::vector<double> partialPressureProfile(System::ColumnIntegrator integrator)
+{
+  System system = breakthroughSystem(integrator);
+  Breakthrough breakthrough(system);
+  std::ostringstream stream;
+  breakthrough.run(stream);
+  std::span<const double> pressures = breakthrough.partialPressures();
+  return std::vector<double>(pressures.begin(), pressures.end());
+}
+}  // namespace
+
+TEST(breakthrough, adaptive_integrators_reproduce_fixed_step_profile)
+{
+  std::vector<double> reference = partialPressureProfile(System::ColumnIntegrator::SSP_RK);
+
+  // the front must be inside the column for the comparison to be meaningful
+  const double inletPressure = 0.5 * 1e5;
+  ASSERT_GT(reference[25 * 2 + 1], 0.05 * inletPressure);
+  ASSERT_LT(reference[50 * 2 + 1], 0.05 * inletPressure);
+
+  for (System::ColumnIntegrator integrator :
+       {System::ColumnIntegrator::AdaptiveSSP_RK, System::ColumnIntegrator::Rosenbrock})
+  {
+    std::vector<double> profile = partialPressureProfile(integrator);
+    ASSERT_EQ(profile.size(), reference.size());
+    for (size_t i = 0; i < profile.size(); ++i)
+    {
+      EXPECT_NEAR(profile[i] / inletPressure, reference[i] / inletPressure, 1e-3);
+    }
+  }
+}
+
+TEST(breakthrough, parallel_equilibrium_loadings_match_serial)
+{
+  auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+
+  // the workspaces are sized from the thread pool when the breakthrough is constructed
+  auto run = [](std::vector<double> &loadings, std::vector<double> &pressures)
+  {
+    System system = mixtureSystem();
+    Breakthrough breakthrough(system);
+    std::ostringstream stream;
+    breakthrough.run(stream);
+    loadings.assign(breakthrough.loadings().begin(), breakthrough.loadings().end());
+    pressures.assign(breakthrough.partialPressures().begin(), breakthrough.partialPressures().end());
+  };
+
+  std::vector<double> serialLoadings, serialPressures;
+  pool.init(1, ThreadPool::ThreadingType::Serial);
+  run(serialLoadings, serialPressures);
+
+  std::vector<double> parallelLoadings, parallelPressures;
+  pool.init(4, ThreadPool::ThreadingType::ThreadPool);
+  run(parallelLoadings, parallelPressures);
+  pool.init(1, ThreadPool::ThreadingType::Serial);
+
+  // the grid points are independent, each one is solved with its own warm start
+  EXPECT_EQ(serialLoadings, parallelLoadings);
+  EXPECT_EQ(serialPressures, parallelPressures);
+
+  // ethane has entered the column
+  ASSERT_EQ(parallelLoadings.size(), 65uz * 3uz);
+  EXPECT_GT(parallelLoadings[1 * 3 + 2], 0.0);
+}
+
+TEST(breakthrough, convective_flux_transports_constant_and_linear_profiles_exactly)
+{
+  for (System::ColumnConvectionScheme scheme :
+       {System::ColumnConvectionScheme::Upwind, System::ColumnConvectionScheme::VanLeer,
+        System::ColumnConvectionScheme::WENO3})
+  {
+    std::vector<double> constant(20, 0.7);
+    for (double face : faceFluxes(scheme, constant))
+    {
+      EXPECT_NEAR(face, 0.7, 1e-14);
+    }
+  }
+
+  // the second-order schemes reconstruct the face value of a linear profile exactly, so the flux difference over
+  // every interior grid point equals the slope
+  for (System::ColumnConvectionScheme scheme :
+       {System::ColumnConvectionScheme::VanLeer, System::ColumnConvectionScheme::WENO3})
+  {
+    for (double slope : {0.05, -0.03})
+    {
+      std::vector<double> linear(20);
+      for (size_t i = 0; i < linear.size(); ++i)
+      {
+        linear[i] = 1.0 + slope * static_cast<double>(i);
+      }
+      std::vector<double> faces = faceFluxes(scheme, linear);
+      for (size_t i = 1; i < faces.size(); ++i)
+      {
+        EXPECT_NEAR(faces[i], 1.0 + slope * (static_cast<double>(i) + 0.5), 1e-14);
+        EXPECT_NEAR(faces[i] - faces[i - 1], slope, 1e-14);
+      }
+    }
+  }
+}
+
+TEST(breakthrough, convective_flux_of_a_step_creates_no_new_extrema)
+{
+  for (System::ColumnConvectionScheme scheme :
+       {System::ColumnConvectionScheme::Upwind, System::ColumnConvectionScheme::VanLeer,
+        System::ColumnConvectionScheme::WENO3})
+  {
+    for (bool rising : {false, true})
+    {
+      std::vector<double> step(40);
+      for (size_t i = 0; i < step.size(); ++i)
+      {
+        step[i] = ((i < 10) != rising) ? 1.0 : 0.0;
+      }
+      std::vector<double> faces = faceFluxes(scheme, step);
+
+      // every face value lies between the values of the grid points it separates
+      for (size_t i = 0; i < faces.size(); ++i)
+      {
+        EXPECT_GE(faces[i], std::min(step[i], step[i + 1]) - 1e-12);
+        EXPECT_LE(faces[i], std::max(step[i], step[i + 1]) + 1e-12);
+      }
+
+      // and an explicit update at a Courant number of one half stays within the range of the step
+      for (size_t i = 1; i < step.size() - 1; ++i)
+      {
+        double updated = step[i] + 0.5 * (faces[i - 1] - faces[i]);
+        EXPECT_GE(updated, -1e-12);
+        EXPECT_LE(updated, 1.0 + 1e-12);
+      }
+    }
+  }
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+import int3;
+import double3;
+
+import atom;
+import pseudo_atom;
+import vdwparameters;
+import forcefield;
+import framework;
+import simulationbox;
+import charge_equilibration_wilmer_snurr;
+
+static ForceField siliconOxygenForceField()
+{
+  return ForceField({PseudoAtom("Si", true, 28.0855, 2.05, 0.0, 14, false),
+                     PseudoAtom("O", true, 15.999, -1.025, 0.0, 8, false)},
+                    {VDWParameters(22.0, 2.30), VDWParameters(53.0, 3.3)}, ForceField::MixingRule::Lorentz_Berthelot,
+                    12.0, 12.0, 12.0, true, false, true);
+}
+
+// the 72 atoms of the unit cell of ITQ-29
+static Framework itq29(const ForceField &forceField)
+{
+  return Framework(
+      0, forceField, "ITQ-29", SimulationBox(11.8671, 11.8671, 11.8671), 517,
+      {Atom(double3(0.3683, 0.1847, 0), 2.05, 1.0, 0, 0, 0, 0), Atom(double3(0.5, 0.2179, 0), -1.025, 1.0, 0, 1, 0, 0),
+       Atom(double3(0.2939, 0.2939, 0), -1.025, 1.0, 0, 1, 0, 0),
+       Atom(double3(0.3429, 0.1098, 0.1098), -1.025, 1.0, 0, 1, 0, 0)},
+      int3(1, 1, 1));
+}
+
+static double totalCharge(const std::vector<Atom> &atoms)
+{
+  return std::accumulate(atoms.begin(), atoms.end(), 0.0,
+                         [](double sum, const Atom &atom) { return sum + atom.charge; });
+}
+
+TEST(charge_equilibration, iterative_matches_dense_for_direct_sums)
+{
+  ForceField forceField = siliconOxygenForceField();
+  Framework framework = itq29(forceField);
+
+  for (ChargeEquilibration::Type type : {ChargeEquilibration::Type::NonPeriodic, ChargeEquilibration::Type::Periodic})
+  {
+    std::vector<Atom> dense = framework.unitCellAtoms;
+    ChargeEquilibration::computeChargeEquilibration(forceField, framework.simulationBox, dense, type,
+                                                    ChargeEquilibration::Solver::Dense);
+    std::vector<Atom> iterative = framework.unitCellAtoms;
+    ChargeEquilibration::computeChargeEquilibration(forceField, framework.simulationBox, iterative, type,
+                                                    ChargeEquilibration::Solver::Iterative);
+
+    EXPECT_NEAR(totalCharge(iterative), 0.0, 1e-10);
+    for (size_t i = 0; i != dense.size(); ++i)
+    {
+      EXPECT_NEAR(iterative[i].charge, dense[i].charge, 1e-6) << "atom " << i;
+    }
+  }
+}
+
+TEST(charge_equilibration, iterative_matches_dense_for_Ewald_sum)
+{
+  ForceField forceField = siliconOxygenForceField();
+  Framework framework = itq29(forceField);
+
+  std::vector<Atom> dense = framework.unitCellAtoms;
+  ChargeEquilibration::computeChargeEquilibration(forceField, framework.simulationBox, dense,
+                                                  ChargeEquilibration::Type::PeriodicEwaldSum,
+                                                  ChargeEquilibration::Solver::Dense);
+  std::vector<Atom> iterative = framework.unitCellAtoms;
+  ChargeEquilibration::computeChargeEquilibration(forceField, framework.simulationBox, iterative,
+                                                  ChargeEquilibration::Type::PeriodicEwaldSum,
+                                                  ChargeEquilibration::Solver::Iterative);
+
+  EXPECT_NEAR(totalCharge(iterative), 0.0, 1e-10);
+  for (size_t i = 0; i != dense.size(); ++i)
+  {
+    EXPECT_NEAR(iterative[i].charge, dense[i].charge, 1e-3) << "atom " << i;
+  }
+}
+
+TEST(charge_equilibration, iterative_Ewald_sum_is_independent_of_splitting)
+{
+  ForceField forceField = siliconOxygenForceField();
+  Framework framework = itq29(forceField);
+
+  std::vector<Atom> longCutOff = framework.unitCellAtoms;
+  ChargeEquilibration::computeChargeEquilibration(forceField, framework.simulationBox, longCutOff,
+                                                  ChargeEquilibration::Type::PeriodicEwaldSum,
+                                                  ChargeEquilibration::Solver::Iterative);
+
+  // a shorter real-space cut-off moves the Ewald splitting towards reciprocal space
+  forceField.cutOffCoulomb = 7.0;
+  std::vector<Atom> shortCutOff = framework.unitCellAtoms;
+  ChargeEquilibration::computeChargeEquilibration(forceField, framework.simulationBox, shortCutOff,
+                                                  ChargeEquilibration::Type::PeriodicEwaldSum,
+                                                  ChargeEquilibration::Solver::Iterative);
+
+  for (size_t i = 0; i != longCutOff.size(); ++i)
+  {
+    EXPECT_NEAR(shortCutOff[i].charge, longCutOff[i].charge, 1e-4) << "atom " << i;
+  }
+
+  // all silicon atoms of ITQ-29 are equivalent by symmetry
+  std::vector<double> siliconCharges{};
+  for (const Atom &atom : longCutOff)
+  {
+    if (atom.type == 0) siliconCharges.push_back(atom.charge);
+  }
+  ASSERT_EQ(siliconCharges.size(), 24uz);
+  for (double charge : siliconCharges)
+  {
+    EXPECT_NEAR(charge, siliconCharges.front(), 1e-6);
+  }
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+import double3x3;
+
+import averages;
+import loadings;
+import enthalpy_of_adsorption;
+import convergence_monitor;
+import property_loading;
+import property_pressure;
+
+namespace
+{
+// samples an uncorrelated loading and pressure for the cycles [first, last), merging the blocks like a production run
+// that checks for convergence
+void sampleCycles(BlockErrorEstimation &estimation, PropertyLoading &loading, PropertyPressure &pressure,
+                  std::mt19937_64 &generator, size_t first, size_t last)
+{
+  std::normal_distribution<double> loadingDistribution(10.0, 1.0);
+  std::normal_distribution<double> pressureDistribution(1e-3, 1e-4);
+  Loadings sample(1);
+  for (size_t cycle = first; cycle != last; ++cycle)
+  {
+    if (estimation.binsAreFilled(cycle))
+    {
+      std::vector<size_t> boundaries = estimation.mergeBins();
+      loading.rebin(boundaries);
+      pressure.rebin(boundaries);
+    }
+    estimation.setCurrentSample(cycle);
+
+    sample.numberOfMolecules[0] = loadingDistribution(generator);
+    loading.addSample(estimation.currentBin, sample, 1.0);
+    pressure.addSample(estimation.currentBin, pressureDistribution(generator),
+                       double3x3(pressureDistribution(generator), pressureDistribution(generator),
+                                 pressureDistribution(generator)),
+                       1.0);
+  }
+}
+}  // namespace
+
+TEST(convergence, uncorrelated_samples_converge)
+{
+  std::mt19937_64 generator(42);
+  std::normal_distribution<double> loadingDistribution(10.0, 1.0);
+  std::normal_distribution<double> energyDistribution(-5000.0, 50.0);
+
+  ConvergenceMonitor monitor(1, {}, 0.01, 0.01, std::nullopt, 1000);
+
+  Loadings loadings(1);
+  EnthalpyOfAdsorptionTerms enthalpyTerms(0);
+  for (size_t i = 0; i != 999; ++i)
+  {
+    loadings.numberOfMolecules[0] = loadingDistribution(generator);
+    monitor.addSample(loadings, energyDistribution(generator), enthalpyTerms, 1.0);
+  }
+
+  // not allowed to converge before the minimum number of samples
+  EXPECT_FALSE(monitor.isConverged());
+
+  for (size_t i = 0; i != 99001; ++i)
+  {
+    loadings.numberOfMolecules[0] = loadingDistribution(generator);
+    monitor.addSample(loadings, energyDistribution(generator), enthalpyTerms, 1.0);
+  }
+
+  ConvergenceMonitor::Estimate loading = monitor.loadingEstimate(0);
+  EXPECT_NEAR(loading.mean, 10.0, 0.05);
+  EXPECT_NEAR(loading.statisticalInefficiency, 1.0, 0.75);
+  EXPECT_TRUE(loading.reliable);
+  EXPECT_LT(loading.relativeError, 0.01);
+
+  ConvergenceMonitor::Estimate energy = monitor.energyEstimate();
+  EXPECT_NEAR(energy.mean, -5000.0, 5.0);
+  EXPECT_TRUE(energy.reliable);
+
+  EXPECT_TRUE(monitor.isConverged());
+}
+
+TEST(convergence, correlated_samples_have_large_statistical_inefficiency)
+{
+  std::mt19937_64 generator(7);
+  std::normal_distribution<double> noise(0.0, 1.0);
+
+  ConvergenceMonitor monitor(1, {}, 0.01, std::nullopt, std::nullopt);
+
+  // AR(1)-process with correlation time 1/(1-phi) = 100
+  const double phi = 0.99;
+  double value = 0.0;
+  Loadings loadings(1);
+  EnthalpyOfAdsorptionTerms enthalpyTerms(0);
+  for (size_t i = 0; i != 200000; ++i)
+  {
+    value = phi * value + noise(generator);
+    loadings.numberOfMolecules[0] = 50.0 + value;
+    monitor.addSample(loadings, 0.0, enthalpyTerms, 1.0);
+  }
+
+  // the statistical inefficiency of an AR(1)-process is (1 + phi) / (1 - phi)
+  ConvergenceMonitor::Estimate loading = monitor.loadingEstimate(0);
+  EXPECT_GT(loading.statisticalInefficiency, 80.0);
+  EXPECT_LT(loading.statisticalInefficiency, 350.0);
+}
+
+TEST(convergence, no_targets_never_converge)
+{
+  ConvergenceMonitor monitor(1, {}, std::nullopt, std::nullopt, std::nullopt);
+
+  Loadings loadings(1);
+  EnthalpyOfAdsorptionTerms enthalpyTerms(0);
+  for (size_t i = 0; i != 10000; ++i)
+  {
+    loadings.numberOfMolecules[0] = 1.0;
+    monitor.addSample(loadings, 0.0, enthalpyTerms, 1.0);
+  }
+
+  EXPECT_FALSE(monitor.isConverged());
+}
+
+TEST(convergence, early_stop_reports_block_errors_over_the_cycles_run)
+{
+  std::mt19937_64 generator(42);
+
+  // a run of at most 100000 cycles that stops after 3000; with the fixed layout all samples would be in the first of
+  // the 5 blocks and the error bars would be zero
+  BlockErrorEstimation estimation(5, 100000);
+  estimation.shrinkBins(10.0);
+  PropertyLoading loading(5, 1);
+  PropertyPressure pressure(5);
+  sampleCycles(estimation, loading, pressure, generator, 0, 3000);
+
+  std::vector<size_t> boundaries = estimation.dropEmptyBins();
+  loading.rebin(boundaries);
+  pressure.rebin(boundaries);
+
+  ASSERT_GE(loading.numberOfBlocks, 3uz);
+  EXPECT_EQ(pressure.numberOfBlocks, loading.numberOfBlocks);
+  double numberOfSamples = 0.0;
+  for (size_t i = 0; i != loading.numberOfBlocks; ++i)
+  {
+    EXPECT_GT(loading.bookKeepingLoadings[i].second, 0.0);
+    EXPECT_TRUE(std::isfinite(loading.averagedLoading(i).numberOfMolecules[0]));
+    numberOfSamples += loading.bookKeepingLoadings[i].second;
+  }
+  EXPECT_EQ(numberOfSamples, 3000.0);
+
+  std::pair<Loadings, Loadings> averageLoading = loading.averageLoading();
+  EXPECT_NEAR(averageLoading.first.numberOfMolecules[0], 10.0, 0.1);
+  EXPECT_GT(averageLoading.second.numberOfMolecules[0], 0.0);
+  EXPECT_TRUE(std::isfinite(averageLoading.second.numberOfMolecules[0]));
+
+  std::pair<double, double> averagePressure = pressure.averagePressure();
+  EXPECT_GT(averagePressure.second, 0.0);
+  EXPECT_TRUE(std::isfinite(averagePressure.second));
+}
+
+TEST(convergence, merged_blocks_of_a_full_run_equal_the_fixed_layout)
+{
+  std::mt19937_64 merged(7);
+  BlockErrorEstimation shrunkEstimation(5, 1234);
+  shrunkEstimation.shrinkBins(10.0);
+  PropertyLoading shrunkLoading(5, 1);
+  PropertyPressure shrunkPressure(5);
+  sampleCycles(shrunkEstimation, shrunkLoading, shrunkPressure, merged, 0, 1234);
+
+  std::mt19937_64 fixed(7);
+  BlockErrorEstimation estimation(5, 1234);
+  PropertyLoading loading(5, 1);
+  PropertyPressure pressure(5);
+  sampleCycles(estimation, loading, pressure, fixed, 0, 1234);
+
+  EXPECT_EQ(shrunkEstimation.nextBin, estimation.nextBin);
+  ASSERT_EQ(shrunkLoading.numberOfBlocks, 5uz);
+  for (size_t i = 0; i != 5; ++i)
+  {
+    EXPECT_EQ(shrunkLoading.bookKeepingLoadings[i].second, loading.bookKeepingLoadings[i].second);
+    EXPECT_NEAR(shrunkLoading.averagedLoading(i).numberOfMolecules[0], loading.averagedLoading(i).numberOfMolecules[0],
+                1e-12);
+  }
+  EXPECT_NEAR(shrunkPressure.averagePressure().second, pressure.averagePressure().second, 1e-15);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "H5Cpp.h"
+
+import int3;
+import double3;
+
+import atom;
+import pseudo_atom;
+import vdwparameters;
+import forcefield;
+import framework;
+import component;
+import simulationbox;
+import property_density_grid;
+import threadpool;
+
+namespace
+{
+ForceField densityGridForceField()
+{
+  return ForceField({PseudoAtom("Si", true, 28.0855, 0.0, 0.0, 14, false),
+                     PseudoAtom("CH4", false, 16.04246, 0.0, 0.0, 6, false)},
+                    {VDWParameters(22.0, 2.30), VDWParameters(158.5, 3.72)}, ForceField::MixingRule::Lorentz_Berthelot,
+                    12.0, 12.0, 12.0, true, false, true);
+}
+
+// two frameworks with different unit cells, so each framework needs its own unit-cell grid
+std::vector<Framework> densityGridFrameworks(const ForceField &forceField)
+{
+  return {Framework(0, forceField, "small", SimulationBox(10.0, 10.0, 10.0), 1,
+                    {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 0, 0, 0)}, int3(1, 1, 1)),
+          Framework(1, forceField, "large", SimulationBox(15.0, 20.0, 25.0), 1,
+                    {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 0, 0, 0)}, int3(1, 1, 1))};
+}
+
+std::vector<Component> densityGridComponents(const ForceField &forceField)
+{
+  return {Component(0, forceField, "methane", 190.564, 45599200, 0.01142,
+                    {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 1, 0, 0)}, 5, 21),
+          Component(1, forceField, "methane_2", 190.564, 45599200, 0.01142,
+                    {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 1, 1, 0)}, 5, 21)};
+}
+
+std::vector<Atom> randomAtoms(size_t numberOfAtoms, size_t numberOfComponents, double boxSize)
+{
+  std::mt19937_64 generator(12345);
+  std::uniform_real_distribution<double> position(0.0, boxSize);
+  std::vector<Atom> atoms;
+  atoms.reserve(numberOfAtoms);
+  for (size_t i = 0; i < numberOfAtoms; ++i)
+  {
+    atoms.push_back(Atom(double3(position(generator), position(generator), position(generator)), 0.0, 1.0,
+                         static_cast<uint32_t>(i), 1, static_cast<uint8_t>(i % numberOfComponents), 0));
+  }
+  return atoms;
+}
+
+uint64_t sum(std::span<const uint32_t> values) { return std::accumulate(values.begin(), values.end(), uint64_t{0}); }
+}  // namespace
+
+TEST(density_grid, parallel_binning_matches_serial_binning)
+{
+  ForceField forceField = densityGridForceField();
+  std::vector<Framework> frameworks = densityGridFrameworks(forceField);
+  SimulationBox simulationBox(30.0, 30.0, 30.0);
+  std::vector<Atom> atoms = randomAtoms(8192, 2, 30.0);
+
+  PropertyDensityGrid serial(2, 2, int3(8, 8, 8), 1, 1, {}, PropertyDensityGrid::OutputFormat::HDF5);
+  PropertyDensityGrid parallel(serial);
+
+  auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+  pool.init(1, ThreadPool::ThreadingType::Serial);
+  serial.sample(frameworks, simulationBox, atoms, 0);
+
+  // enough atoms per thread to take the concurrent path
+  pool.init(4, ThreadPool::ThreadingType::ThreadPool);
+  parallel.sample(frameworks, simulationBox, atoms, 0);
+  pool.init(1, ThreadPool::ThreadingType::Serial);
+
+  EXPECT_EQ(serial.grid_cell, parallel.grid_cell);
+  EXPECT_EQ(serial.grid_unitcell, parallel.grid_unitcell);
+
+  // every atom is counted once in the box grid and once in the unit-cell grid of each framework
+  ASSERT_EQ(parallel.grid_unitcell.size(), 2uz * parallel.grid_cell.size());
+  EXPECT_EQ(sum(parallel.grid_cell), atoms.size());
+  EXPECT_EQ(sum(parallel.grid_unitcell), 2uz * atoms.size());
+}
+
+TEST(density_grid, hdf5_output_round_trip)
+{
+  ForceField forceField = densityGridForceField();
+  std::vector<Framework> frameworks = densityGridFrameworks(forceField);
+  std::vector<Component> components = densityGridComponents(forceField);
+  SimulationBox simulationBox(30.0, 30.0, 30.0);
+  std::vector<Atom> atoms = randomAtoms(1000, 2, 30.0);
+
+  PropertyDensityGrid grid(2, 2, int3(4, 5, 6), 1, 1, {}, PropertyDensityGrid::OutputFormat::HDF5);
+  grid.sample(frameworks, simulationBox, atoms, 0);
+  grid.sample(frameworks, simulationBox, atoms, 1);
+  grid.writeOutput(7, simulationBox, forceField, frameworks, components, 0);
+
+  H5::H5File file("density_grids/grid.s7.h5", H5F_ACC_RDONLY);
+
+  std::string numberOfSamples;
+  H5::Attribute attribute = file.openGroup("/").openAttribute("numberOfSamples");
+  attribute.read(attribute.getStrType(), numberOfSamples);
+  EXPECT_EQ(numberOfSamples, "2");
+
+  auto readCounts = [&file](const std::string &path) -> std::vector<uint32_t>
+  {
+    H5::DataSet dataset = file.openDataSet(path);
+    std::vector<uint32_t> values(static_cast<size_t>(dataset.getSpace().getSimpleExtentNpoints()));
+    dataset.read(values.data(), H5::PredType::NATIVE_UINT32);
+    return values;
+  };
+  auto readCell = [&file](const std::string &path) -> std::vector<double>
+  {
+    std::vector<double> values(9);
+    file.openDataSet(path).read(values.data(), H5::PredType::NATIVE_DOUBLE);
+    return values;
+  };
+
+  // the grids are laid out as [component][framework][x][y][z]
+  const size_t totalGridSize = 4uz * 5uz * 6uz;
+  auto slice = [totalGridSize](const std::vector<uint32_t> &grid, size_t index) -> std::vector<uint32_t>
+  {
+    std::span<const uint32_t> values = std::span<const uint32_t>(grid).subspan(index * totalGridSize, totalGridSize);
+    return std::vector<uint32_t>(values.begin(), values.end());
+  };
+
+  for (size_t i = 0; i < components.size(); ++i)
+  {
+    std::vector<uint32_t> cell = readCounts("/simulation_box/" + components[i].name);
+    EXPECT_EQ(cell, slice(grid.grid_cell, i));
+
+    for (size_t k = 0; k < frameworks.size(); ++k)
+    {
+      std::vector<uint32_t> unitcell = readCounts("/" + frameworks[k].name + "/" + components[i].name);
+      EXPECT_EQ(unitcell, slice(grid.grid_unitcell, i * frameworks.size() + k));
+      EXPECT_EQ(sum(unitcell), 2uz * atoms.size() / components.size());
+    }
+  }
+
+  // each framework group carries its own unit cell
+  std::vector<double> smallCell = readCell("/small/cell");
+  std::vector<double> largeCell = readCell("/large/cell");
+  EXPECT_NEAR(smallCell[0], 10.0, 1e-10);
+  EXPECT_NEAR(largeCell[0], 15.0, 1e-10);
+  EXPECT_NEAR(largeCell[4], 20.0, 1e-10);
+  EXPECT_NEAR(largeCell[8], 25.0, 1e-10);
+
+  file.close();
+  std::filesystem::remove("density_grids/grid.s7.h5");
+}
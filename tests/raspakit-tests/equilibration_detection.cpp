@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+import equilibration_detection;
+
+namespace
+{
+// uniform noise with zero mean and unit variance, built from the raw output of the generator so that the series is
+// the same for every standard library
+std::vector<double> noise(uint64_t seed, size_t length)
+{
+  std::mt19937_64 generator(seed);
+  std::vector<double> series(length);
+  for (double &value : series)
+  {
+    double uniform = static_cast<double>(generator() >> 11) * 0x1.0p-53;
+    value = (2.0 * uniform - 1.0) * std::sqrt(3.0);
+  }
+  return series;
+}
+
+// a transient that decays with a relaxation time of 'tau' cycles on top of the noise
+std::vector<double> decay(uint64_t seed, size_t length, double amplitude, double tau)
+{
+  std::vector<double> series = noise(seed, length);
+  for (size_t i = 0; i < length; ++i)
+  {
+    series[i] += amplitude * std::exp(-static_cast<double>(i) / tau);
+  }
+  return series;
+}
+
+constexpr std::array<EquilibrationDetector::Method, 2> methods = {
+    EquilibrationDetector::Method::MaximumEffectiveSamples, EquilibrationDetector::Method::MSER};
+}  // namespace
+
+TEST(equilibration_detection, exponential_decay_is_cut_after_the_transient)
+{
+  // the transient is twice the noise level at cycle 80 and negligible after cycle 300
+  std::vector<double> series = decay(2024, 1000, 10.0, 50.0);
+
+  for (EquilibrationDetector::Method method : methods)
+  {
+    EquilibrationDetector detector(method, 1, 100, 500);
+    size_t start = detector.stationaryStart(series);
+    EXPECT_GE(start, 80uz);
+    EXPECT_LE(start, 300uz);
+
+    for (double value : series)
+    {
+      detector.addSample(std::array<double, 1>{value});
+    }
+    std::optional<size_t> detected = detector.detect();
+    ASSERT_TRUE(detected.has_value());
+    EXPECT_EQ(detected.value(), start);
+  }
+}
+
+TEST(equilibration_detection, stationary_series_starts_at_zero)
+{
+  std::vector<double> loading = noise(2024, 1000);
+  std::vector<double> energy = noise(7, 1000);
+
+  for (EquilibrationDetector::Method method : methods)
+  {
+    EquilibrationDetector detector(method, 2, 100, 500);
+    for (size_t i = 0; i < loading.size(); ++i)
+    {
+      detector.addSample(std::array<double, 2>{loading[i], energy[i]});
+    }
+    std::optional<size_t> detected = detector.detect();
+    ASSERT_TRUE(detected.has_value());
+    EXPECT_EQ(detected.value(), 0uz);
+  }
+}
+
+TEST(equilibration_detection, drifting_series_is_not_stationary)
+{
+  // the relaxation time is longer than the series, the detected start lies in the second half
+  std::vector<double> series = decay(2024, 1000, 1000.0, 2000.0);
+
+  for (EquilibrationDetector::Method method : methods)
+  {
+    EquilibrationDetector detector(method, 1, 100, 500);
+    for (double value : series)
+    {
+      detector.addSample(std::array<double, 1>{value});
+    }
+    EXPECT_FALSE(detector.detect().has_value());
+  }
+}
+
+TEST(equilibration_detection, too_few_cycles_are_not_tested)
+{
+  std::vector<double> series = noise(2024, 400);
+
+  EquilibrationDetector detector(EquilibrationDetector::Method::MSER, 1, 100, 500);
+  for (double value : series)
+  {
+    detector.addSample(std::array<double, 1>{value});
+  }
+  EXPECT_FALSE(detector.detect().has_value());
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+import double3;
+
+import atom;
+import pseudo_atom;
+import vdwparameters;
+import forcefield;
+import component;
+import system;
+import simulationbox;
+import isotherm;
+import multi_site_isotherm;
+import isotherm_fitting;
+import threadpool;
+
+namespace
+{
+// a Langmuir isotherm with a little deterministic scatter, written in the two-column format of the input data
+void writeIsothermData(const std::string &fileName, double saturationLoading, double equilibriumConstant)
+{
+  std::ofstream stream(fileName);
+  std::print(stream, "# pressure loading\n");
+  size_t i = 0;
+  for (double pressure = 1e2; pressure < 1e7; pressure *= 2.0, ++i)
+  {
+    double loading = saturationLoading * equilibriumConstant * pressure / (1.0 + equilibriumConstant * pressure);
+    std::print(stream, "{:.8e} {:.8e}\n", pressure, loading * (1.0 + 0.01 * std::sin(static_cast<double>(i))));
+  }
+}
+
+System isothermFittingSystem()
+{
+  ForceField forceField({PseudoAtom("CH4", false, 16.04246, 0.0, 0.0, 6, false)}, {VDWParameters(158.5, 3.72)},
+                        ForceField::MixingRule::Lorentz_Berthelot, 12.0, 12.0, 12.0, true, false, true);
+  Component methane(0, forceField, "methane", 190.564, 45599200, 0.01142,
+                    {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 0, 0, 0)}, 5, 21);
+  Component ethane(1, forceField, "ethane", 305.32, 4872000, 0.0995,
+                   {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 0, 1, 0)}, 5, 21);
+
+  System system(0, forceField, SimulationBox(30.0, 30.0, 30.0), 300.0, 1e5, 1.0, {}, {methane, ethane}, {0, 0}, 5);
+
+  const std::vector<std::string> fileNames{"isotherm_fitting_methane.data", "isotherm_fitting_ethane.data"};
+  writeIsothermData(fileNames[0], 5.0, 1e-5);
+  writeIsothermData(fileNames[1], 3.0, 1e-4);
+  for (size_t i = 0; i < system.components.size(); ++i)
+  {
+    system.components[i].filename = fileNames[i];
+    system.components[i].isotherm.add(Isotherm(Isotherm::Type::Langmuir, {1.0, 1e-5}, 2));
+    system.components[i].isotherm.numberOfSites = 1;
+  }
+
+  return system;
+}
+
+std::vector<MultiSiteIsotherm> fittedIsotherms(System &system)
+{
+  IsothermFitting fitting(system, 42);
+  std::ostringstream stream;
+  fitting.run(stream);
+  return fitting.isotherms;
+}
+}  // namespace
+
+TEST(isotherm_fitting, fit_is_independent_of_the_number_of_threads)
+{
+  System system = isothermFittingSystem();
+
+  auto &pool = ThreadPool::ThreadPool<ThreadPool::details::default_function_type, std::jthread>::instance();
+  pool.init(1, ThreadPool::ThreadingType::Serial);
+  std::vector<MultiSiteIsotherm> serial = fittedIsotherms(system);
+
+  pool.init(4, ThreadPool::ThreadingType::ThreadPool);
+  std::vector<MultiSiteIsotherm> parallel = fittedIsotherms(system);
+  pool.init(1, ThreadPool::ThreadingType::Serial);
+
+  // the same seed gives bit-identical parameters
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (size_t i = 0; i < serial.size(); ++i)
+  {
+    ASSERT_EQ(serial[i].numberOfParameters, parallel[i].numberOfParameters);
+    for (size_t j = 0; j < serial[i].numberOfParameters; ++j)
+    {
+      EXPECT_EQ(serial[i].parameters(j), parallel[i].parameters(j)) << "component " << i << " parameter " << j;
+    }
+  }
+
+  // and the fit is meaningful: the saturation loadings are recovered
+  EXPECT_NEAR(parallel[0].parameters(0), 5.0, 0.1);
+  EXPECT_NEAR(parallel[1].parameters(0), 3.0, 0.1);
+
+  std::filesystem::remove_all("IsothermFitting");
+  for (const Component &component : system.components)
+  {
+    std::filesystem::remove(component.filename);
+  }
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+import isotherm;
+import multi_site_isotherm;
+
+static std::vector<Isotherm> testIsotherms()
+{
+  return {Isotherm(Isotherm::Type::Langmuir, {2.5, 0.3}, 2),
+          Isotherm(Isotherm::Type::Anti_Langmuir, {2.0, 0.01}, 2),
+          Isotherm(Isotherm::Type::BET, {2.0, 0.3, 0.01}, 3),
+          Isotherm(Isotherm::Type::Henry, {0.7}, 1),
+          Isotherm(Isotherm::Type::Freundlich, {2.0, 1.7}, 2),
+          Isotherm(Isotherm::Type::Sips, {2.0, 0.3, 1.4}, 3),
+          Isotherm(Isotherm::Type::Langmuir_Freundlich, {2.0, 0.3, 0.7}, 3),
+          Isotherm(Isotherm::Type::Redlich_Peterson, {2.0, 0.3, 0.8}, 3),
+          Isotherm(Isotherm::Type::Toth, {2.0, 0.3, 0.6}, 3),
+          Isotherm(Isotherm::Type::Unilan, {2.0, 0.3, 1.2}, 3),
+          Isotherm(Isotherm::Type::OBrien_Myers, {2.0, 0.3, 0.4}, 3),
+          Isotherm(Isotherm::Type::Quadratic, {2.0, 0.3, 0.05}, 3),
+          Isotherm(Isotherm::Type::Temkin, {2.0, 0.3, 0.4}, 3)};
+}
+
+TEST(isotherms, batch_evaluation_matches_single_pressure)
+{
+  std::vector<double> pressures{};
+  for (double pressure = 0.01; pressure < 50.0; pressure *= 1.3)
+  {
+    pressures.push_back(pressure);
+  }
+
+  for (const Isotherm &isotherm : testIsotherms())
+  {
+    MultiSiteIsotherm multiSiteIsotherm{};
+    multiSiteIsotherm.add(isotherm);
+    multiSiteIsotherm.add(Isotherm(Isotherm::Type::Langmuir, {1.2, 0.05}, 2));
+    multiSiteIsotherm.numberOfSites = 2;
+
+    std::vector<double> loadings(pressures.size());
+    std::vector<double> psi(pressures.size());
+    std::vector<double> derivatives(pressures.size());
+    multiSiteIsotherm.values(pressures, loadings);
+    multiSiteIsotherm.psiForPressures(pressures, psi);
+    multiSiteIsotherm.derivatives(pressures, derivatives);
+
+    for (size_t i = 0; i < pressures.size(); ++i)
+    {
+      double pressure = pressures[i];
+      EXPECT_NEAR(loadings[i], multiSiteIsotherm.value(pressure), 1e-12 * std::abs(loadings[i]));
+      EXPECT_NEAR(psi[i], multiSiteIsotherm.psiForPressure(pressure), 1e-12 * std::abs(psi[i]));
+
+      double delta = 1e-6 * pressure;
+      double numericalDerivative =
+          (multiSiteIsotherm.value(pressure + delta) - multiSiteIsotherm.value(pressure - delta)) / (2.0 * delta);
+      EXPECT_NEAR(derivatives[i], numericalDerivative, 1e-6 * std::abs(numericalDerivative));
+    }
+  }
+}
+
+TEST(isotherms, parameter_gradient_matches_finite_differences)
+{
+  for (const Isotherm &isotherm : testIsotherms())
+  {
+    MultiSiteIsotherm multiSiteIsotherm{};
+    multiSiteIsotherm.add(Isotherm(Isotherm::Type::Langmuir, {1.2, 0.05}, 2));
+    multiSiteIsotherm.add(isotherm);
+    multiSiteIsotherm.numberOfSites = 2;
+
+    std::vector<double> gradient(multiSiteIsotherm.numberOfParameters);
+    for (double pressure : {0.05, 0.7, 3.0, 20.0})
+    {
+      multiSiteIsotherm.parameterGradient(pressure, gradient);
+
+      for (size_t k = 0; k < multiSiteIsotherm.numberOfParameters; ++k)
+      {
+        MultiSiteIsotherm forward = multiSiteIsotherm;
+        MultiSiteIsotherm backward = multiSiteIsotherm;
+        double delta = 1e-6 * std::abs(multiSiteIsotherm.parameters(k));
+        forward.parameters(k) += delta;
+        backward.parameters(k) -= delta;
+        double numericalDerivative = (forward.value(pressure) - backward.value(pressure)) / (2.0 * delta);
+
+        EXPECT_NEAR(gradient[k], numericalDerivative, 1e-6 * std::max(std::abs(numericalDerivative), 1e-6))
+            << "isotherm type " << static_cast<int>(isotherm.type) << " parameter " << k;
+      }
+    }
+  }
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <vector>
+
+import int3;
+import double3;
+import simd_quatd;
+
+import atom;
+import pseudo_atom;
+import vdwparameters;
+import forcefield;
+import framework;
+import component;
+import system;
+import simulationbox;
+import molecule;
+import minimizer;
+
+// two CO2 molecules in neighbouring positions of a cage of ITQ-29, one of them tilted
+static System twoCO2InITQ29()
+{
+  ForceField forceField = ForceField(
+      {
+          PseudoAtom("Si", true, 28.0855, 2.05, 0.0, 14, false),
+          PseudoAtom("O", true, 15.999, -1.025, 0.0, 8, false),
+          PseudoAtom("CH4", false, 16.04246, 0.0, 0.0, 6, false),
+          PseudoAtom("C_co2", false, 12.0, 0.6512, 0.0, 6, false),
+          PseudoAtom("O_co2", false, 15.9994, -0.3256, 0.0, 8, false),
+      },
+      {VDWParameters(22.0, 2.30), VDWParameters(53.0, 3.3), VDWParameters(158.5, 3.72), VDWParameters(29.933, 2.745),
+       VDWParameters(85.671, 3.017)},
+      ForceField::MixingRule::Lorentz_Berthelot, 11.8, 11.8, 11.8, true, false, true);
+
+  forceField.automaticEwald = false;
+  forceField.EwaldAlpha = 0.25;
+  forceField.numberOfWaveVectors = int3(8, 8, 8);
+  Framework f = Framework(
+      0, forceField, "ITQ-29", SimulationBox(11.8671, 11.8671, 11.8671), 517,
+      {Atom(double3(0.3683, 0.1847, 0), 2.05, 1.0, 0, 0, 0, 0), Atom(double3(0.5, 0.2179, 0), -1.025, 1.0, 0, 1, 0, 0),
+       Atom(double3(0.2939, 0.2939, 0), -1.025, 1.0, 0, 1, 0, 0),
+       Atom(double3(0.3429, 0.1098, 0.1098), -1.025, 1.0, 0, 1, 0, 0)},
+      int3(2, 2, 2));
+  Component c = Component(
+      0, forceField, "CO2", 304.1282, 7377300.0, 0.22394,
+      {Atom(double3(0.0, 0.0, 1.149), -0.3256, 1.0, 0, 4, 1, 0), Atom(double3(0.0, 0.0, 0.0), 0.6512, 1.0, 0, 3, 1, 0),
+       Atom(double3(0.0, 0.0, -1.149), -0.3256, 1.0, 0, 4, 1, 0)},
+      5, 21);
+
+  System system = System(0, forceField, std::nullopt, 300.0, 1e4, 1.0, {f}, {c}, {2}, 5);
+
+  system.moleculePositions[0].centerOfMassPosition = double3(5.93355, 7.93355, 5.93355);
+  system.moleculePositions[0].orientation = simd_quatd(0.0, 0.0, 0.0, 1.0);
+  system.moleculePositions[1].centerOfMassPosition = double3(5.93355, 3.93355, 5.93355);
+  system.moleculePositions[1].orientation = simd_quatd::fromAxisAngle(0.5, double3(1.0, 0.0, 0.0));
+
+  return system;
+}
+
+static void checkRigidAtoms(System &system)
+{
+  std::span<const Atom> atoms = system.spanOfMoleculeAtoms();
+  for (size_t m = 0; m != system.moleculePositions.size(); ++m)
+  {
+    const Molecule &molecule = system.moleculePositions[m];
+    for (size_t i = 0; i != molecule.numberOfAtoms; ++i)
+    {
+      double3 expected = molecule.centerOfMassPosition + molecule.orientation * system.components[0].atoms[i].position;
+      EXPECT_NEAR(atoms[3 * m + i].position.x, expected.x, 1e-8);
+      EXPECT_NEAR(atoms[3 * m + i].position.y, expected.y, 1e-8);
+      EXPECT_NEAR(atoms[3 * m + i].position.z, expected.z, 1e-8);
+    }
+  }
+}
+
+TEST(minimization, FIRE_relaxes_two_CO2_in_ITQ_29)
+{
+  System system = twoCO2InITQ29();
+
+  Minimizer minimizer{};
+  minimizer.method = Minimizer::Method::FIRE;
+  minimizer.maximumNumberOfSteps = 20000;
+  std::ostringstream stream;
+  Minimizer::Result result = minimizer.minimize(system, stream);
+
+  EXPECT_TRUE(result.converged);
+  EXPECT_LT(result.finalEnergy, result.initialEnergy);
+  EXPECT_LE(result.maximumGradient, minimizer.gradientTolerance);
+  checkRigidAtoms(system);
+}
+
+TEST(minimization, LBFGS_relaxes_two_CO2_in_ITQ_29)
+{
+  System system = twoCO2InITQ29();
+
+  Minimizer minimizer{};
+  minimizer.method = Minimizer::Method::LBFGS;
+  minimizer.maximumNumberOfSteps = 5000;
+  std::ostringstream stream;
+  Minimizer::Result result = minimizer.minimize(system, stream);
+
+  EXPECT_TRUE(result.converged);
+  EXPECT_LT(result.finalEnergy, result.initialEnergy);
+  EXPECT_LE(result.maximumGradient, minimizer.gradientTolerance);
+  checkRigidAtoms(system);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+import double3;
+
+import atom;
+import pseudo_atom;
+import vdwparameters;
+import forcefield;
+import component;
+import mc_moves_probabilities_particles;
+import mc_moves_probability_tuning;
+
+namespace
+{
+// translation, reinsertion and swap (CBMC) in the ratio 1:1:2, and Widom as a move that is not tuned
+std::vector<Component> tuningComponents()
+{
+  ForceField forceField({PseudoAtom("CH4", false, 16.04246, 0.0, 0.0, 6, false)}, {VDWParameters(158.5, 3.72)},
+                        ForceField::MixingRule::Lorentz_Berthelot, 12.0, 12.0, 12.0, true, false, true);
+  MCMoveProbabilitiesParticles probabilities(1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+                                             0.0, 1.0);
+  return {Component(0, forceField, "methane", 190.564, 45599200, 0.01142,
+                    {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 0, 0, 0)}, 5, 21, probabilities)};
+}
+
+// adds 'cycles' times a fixed batch of statistics and timings: 500 accepted translations, 100 accepted reinsertions
+// and 20 accepted swaps per CPU second, with the given energy change (in kT) per accepted move
+void addStatistics(Component &component, MCMoveProbabilityTuning &tuning, double cycles,
+                   double translationEnergyChange = 1.0, double reinsertionEnergyChange = 1.0,
+                   double swapEnergyChange = 1.0)
+{
+  component.mc_moves_statistics.translationMove.totalCounts += cycles * double3(300.0, 300.0, 400.0);
+  component.mc_moves_statistics.translationMove.totalAccepted += cycles * double3(150.0, 150.0, 200.0);
+  component.mc_moves_cputime.translationMove += std::chrono::duration<double>(cycles * 1.0);
+  tuning.addEnergyChange(0, 0, cycles * 500.0 * translationEnergyChange);
+
+  component.mc_moves_statistics.reinsertionMove_CBMC.totalCounts += cycles * 1000.0;
+  component.mc_moves_statistics.reinsertionMove_CBMC.totalAccepted += cycles * 100.0;
+  component.mc_moves_cputime.reinsertionMoveCBMC += std::chrono::duration<double>(cycles * 1.0);
+  tuning.addEnergyChange(0, 4, cycles * 100.0 * reinsertionEnergyChange);
+
+  component.mc_moves_statistics.swapInsertionMove_CBMC.totalCounts += cycles * 500.0;
+  component.mc_moves_statistics.swapInsertionMove_CBMC.totalAccepted += cycles * 10.0;
+  component.mc_moves_statistics.swapDeletionMove_CBMC.totalCounts += cycles * 500.0;
+  component.mc_moves_statistics.swapDeletionMove_CBMC.totalAccepted += cycles * 10.0;
+  component.mc_moves_cputime.swapInsertionMoveCBMC += std::chrono::duration<double>(cycles * 0.5);
+  component.mc_moves_cputime.swapDeletionMoveCBMC += std::chrono::duration<double>(cycles * 0.5);
+  tuning.addEnergyChange(0, 6, cycles * 20.0 * swapEnergyChange);
+}
+
+double tunableTotal(const Component &component)
+{
+  std::vector<double> p = MCMoveProbabilityTuning::tunableProbabilities(component.mc_moves_probabilities);
+  return std::accumulate(p.begin(), p.end(), 0.0);
+}
+}  // namespace
+
+TEST(probability_tuning, efficiency_is_energy_change_per_cpu_second)
+{
+  std::vector<Component> components = tuningComponents();
+  MCMoveProbabilityTuning tuning(components, 4.0);
+
+  addStatistics(components[0], tuning, 2.0);
+  tuning.update(components);
+
+  EXPECT_NEAR(tuning.efficiency[0][0], 500.0, 1e-10);
+  EXPECT_NEAR(tuning.efficiency[0][4], 100.0, 1e-10);
+  EXPECT_NEAR(tuning.efficiency[0][6], 20.0, 1e-10);
+
+  // moves without attempts are not measured
+  EXPECT_LT(tuning.efficiency[0][2], 0.0);
+  EXPECT_LT(tuning.efficiency[0][5], 0.0);
+
+  // relative to the geometric mean of 100 kT per second the weights are 5, 1 and 0.2, clamped to [1/4, 4]; the targets
+  // 0.2 * 4, 0.2 * 1 and 0.4 * 0.25 are rescaled to the initial total of 0.8 and averaged with the initial values
+  const MCMoveProbabilitiesParticles &p = components[0].mc_moves_probabilities;
+  EXPECT_NEAR(p.translationProbability, 0.5 * 0.2 + 0.5 * 0.8 * 0.8 / 1.1, 1e-12);
+  EXPECT_NEAR(p.reinsertionCBMCProbability, 0.5 * 0.2 + 0.5 * 0.2 * 0.8 / 1.1, 1e-12);
+  EXPECT_NEAR(p.swapCBMCProbability, 0.5 * 0.4 + 0.5 * 0.1 * 0.8 / 1.1, 1e-12);
+  EXPECT_EQ(tuning.numberOfUpdates, 1uz);
+}
+
+TEST(probability_tuning, small_accepted_steps_do_not_outweigh_large_ones)
+{
+  std::vector<Component> components = tuningComponents();
+  MCMoveProbabilityTuning tuning(components, 4.0);
+
+  // the translations are accepted most often but change the energy least: all moves change 100 kT per second
+  addStatistics(components[0], tuning, 1.0, 0.2, 1.0, 5.0);
+  tuning.update(components);
+
+  EXPECT_NEAR(tuning.efficiency[0][0], 100.0, 1e-10);
+  EXPECT_NEAR(tuning.efficiency[0][4], 100.0, 1e-10);
+  EXPECT_NEAR(tuning.efficiency[0][6], 100.0, 1e-10);
+
+  const MCMoveProbabilitiesParticles &p = components[0].mc_moves_probabilities;
+  EXPECT_NEAR(p.translationProbability, 0.2, 1e-12);
+  EXPECT_NEAR(p.reinsertionCBMCProbability, 0.2, 1e-12);
+  EXPECT_NEAR(p.swapCBMCProbability, 0.4, 1e-12);
+
+  // the energy change is counted from the measurement on
+  EXPECT_EQ(tuning.energyChange[0][0], 0.0);
+}
+
+TEST(probability_tuning, probabilities_stay_normalized)
+{
+  std::vector<Component> components = tuningComponents();
+  MCMoveProbabilityTuning tuning(components, 4.0);
+
+  for (size_t i = 0; i < 50; ++i)
+  {
+    addStatistics(components[0], tuning, 1.0);
+    tuning.update(components);
+
+    const MCMoveProbabilitiesParticles &p = components[0].mc_moves_probabilities;
+
+    // the tuned moves keep their total, and the other moves their share
+    EXPECT_NEAR(tunableTotal(components[0]), 0.8, 1e-12);
+    EXPECT_NEAR(p.widomProbability, 0.2, 1e-12);
+
+    // disabled moves stay disabled
+    EXPECT_EQ(p.randomTranslationProbability, 0.0);
+    EXPECT_EQ(p.rotationProbability, 0.0);
+    EXPECT_EQ(p.swapProbability, 0.0);
+  }
+
+  // with constant efficiencies the damped updates converge to the clamped target
+  const MCMoveProbabilitiesParticles &p = components[0].mc_moves_probabilities;
+  EXPECT_NEAR(p.translationProbability, 0.8 * 0.8 / 1.1, 1e-10);
+  EXPECT_NEAR(p.reinsertionCBMCProbability, 0.2 * 0.8 / 1.1, 1e-10);
+  EXPECT_NEAR(p.swapCBMCProbability, 0.1 * 0.8 / 1.1, 1e-10);
+}
+
+TEST(probability_tuning, frozen_at_production)
+{
+  std::vector<Component> components = tuningComponents();
+  MCMoveProbabilityTuning tuning(components, 4.0);
+
+  addStatistics(components[0], tuning, 1.0);
+  tuning.update(components);
+  MCMoveProbabilitiesParticles tuned = components[0].mc_moves_probabilities;
+
+  tuning.freeze();
+
+  // very different statistics during production do not change the frozen probabilities
+  tuning.addEnergyChange(0, 4, 1e6);
+  addStatistics(components[0], tuning, 10.0);
+  tuning.update(components);
+
+  EXPECT_EQ(components[0].mc_moves_probabilities, tuned);
+  EXPECT_EQ(tuning.numberOfUpdates, 1uz);
+}
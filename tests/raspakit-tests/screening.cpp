@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+import int3;
+import double3;
+
+import units;
+import atom;
+import pseudo_atom;
+import vdwparameters;
+import forcefield;
+import framework;
+import component;
+import system;
+import simulationbox;
+import mc_moves_probabilities_particles;
+import input_reader;
+import json;
+
+namespace
+{
+ForceField screeningForceField()
+{
+  return ForceField({PseudoAtom("Si", true, 28.0855, 0.0, 0.0, 14, false),
+                     PseudoAtom("CH4", false, 16.04246, 0.0, 0.0, 6, false)},
+                    {VDWParameters(22.0, 2.30), VDWParameters(158.5, 3.72)}, ForceField::MixingRule::Lorentz_Berthelot,
+                    12.0, 12.0, 12.0, true, false, true);
+}
+
+Component methane(const ForceField &forceField)
+{
+  // swap moves make the component swappable, so its fluid properties follow from the equation of state
+  return Component(0, forceField, "methane", 190.564, 45599200, 0.01142,
+                   {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 1, 0, 0)}, 5, 21,
+                   MCMoveProbabilitiesParticles(1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0));
+}
+
+std::vector<System> screeningSystems()
+{
+  ForceField forceField = screeningForceField();
+  Framework framework = Framework(0, forceField, "TEST_FRAMEWORK", SimulationBox(25.0, 25.0, 25.0), 1,
+                                  {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 0, 0, 0)}, int3(1, 1, 1));
+  return {System(0, forceField, std::nullopt, 300.0, 1e4, 1.0, {framework}, {methane(forceField)}, {0}, 5),
+          System(1, forceField, SimulationBox(30.0, 30.0, 30.0), 250.0, 2e4, 1.0, {}, {methane(forceField)}, {0}, 5)};
+}
+}  // namespace
+
+TEST(screening, explicit_jobs_refer_to_index_or_framework_name)
+{
+  std::vector<System> systems = screeningSystems();
+  nlohmann::basic_json<nlohmann::raspa_map> screening = nlohmann::basic_json<nlohmann::raspa_map>::parse(R"({
+    "Jobs" : [
+      { "System" : "test_framework", "ExternalPressure" : 1e5 },
+      { "System" : 1, "ExternalTemperature" : 350.0 }
+    ]
+  })");
+
+  std::vector<InputReader::ScreeningJob> jobs = InputReader::parseScreeningJobs(screening, systems);
+
+  ASSERT_EQ(jobs.size(), 2uz);
+  EXPECT_EQ(jobs[0].systemId, 0uz);
+  EXPECT_DOUBLE_EQ(jobs[0].temperature, 300.0);
+  EXPECT_DOUBLE_EQ(jobs[0].pressure.value(), 1e5);
+  EXPECT_EQ(jobs[1].systemId, 1uz);
+  EXPECT_DOUBLE_EQ(jobs[1].temperature, 350.0);
+  EXPECT_DOUBLE_EQ(jobs[1].pressure.value(), 2e4);
+}
+
+TEST(screening, state_points_are_combined_per_system)
+{
+  std::vector<System> systems = screeningSystems();
+  nlohmann::basic_json<nlohmann::raspa_map> screening = nlohmann::basic_json<nlohmann::raspa_map>::parse(R"({
+    "ExternalTemperatures" : [280.0, 320.0],
+    "ExternalPressures" : [1e3, 1e4, 1e5]
+  })");
+
+  std::vector<InputReader::ScreeningJob> jobs = InputReader::parseScreeningJobs(screening, systems);
+
+  // ordered by system, then temperature, then pressure
+  ASSERT_EQ(jobs.size(), 12uz);
+  for (size_t i = 0; i != jobs.size(); ++i)
+  {
+    EXPECT_EQ(jobs[i].systemId, i / 6);
+    EXPECT_DOUBLE_EQ(jobs[i].temperature, (i / 3) % 2 == 0 ? 280.0 : 320.0);
+    EXPECT_DOUBLE_EQ(jobs[i].pressure.value(), std::pow(10.0, 3.0 + static_cast<double>(i % 3)));
+  }
+
+  // without state points every system runs at its own conditions
+  jobs = InputReader::parseScreeningJobs(nlohmann::basic_json<nlohmann::raspa_map>::object(), systems);
+  ASSERT_EQ(jobs.size(), 2uz);
+  EXPECT_DOUBLE_EQ(jobs[1].temperature, 250.0);
+  EXPECT_DOUBLE_EQ(jobs[1].pressure.value(), 2e4);
+}
+
+TEST(screening, invalid_manifests_are_rejected)
+{
+  std::vector<System> systems = screeningSystems();
+  using Json = nlohmann::basic_json<nlohmann::raspa_map>;
+
+  EXPECT_THROW(InputReader::parseScreeningJobs(Json::parse(R"({ "Jobs" : [ { "System" : 2 } ] })"), systems),
+               std::runtime_error);
+  EXPECT_THROW(InputReader::parseScreeningJobs(Json::parse(R"({ "Jobs" : [ { "System" : "MFI" } ] })"), systems),
+               std::runtime_error);
+  EXPECT_THROW(
+      InputReader::parseScreeningJobs(Json::parse(R"({ "Jobs" : [ { "ExternalPressure" : 1e5 } ] })"), systems),
+      std::runtime_error);
+  EXPECT_THROW(InputReader::parseScreeningJobs(Json::parse(R"({ "ExternalPressures" : [] })"), systems),
+               std::runtime_error);
+  EXPECT_THROW(InputReader::parseScreeningJobs(Json::parse(R"({ "Pressures" : [1e5] })"), systems),
+               std::runtime_error);
+}
+
+TEST(screening, external_conditions_match_a_system_created_at_them)
+{
+  ForceField forceField = screeningForceField();
+  System system =
+      System(0, forceField, SimulationBox(30.0, 30.0, 30.0), 300.0, 1e4, 1.0, {}, {methane(forceField)}, {0}, 5);
+  System reference =
+      System(0, forceField, SimulationBox(30.0, 30.0, 30.0), 200.0, 5e6, 1.0, {}, {methane(forceField)}, {0}, 5);
+
+  // as in a screening run, the fugacity coefficient is recomputed at the new conditions
+  system.components[0].fugacityCoefficient = std::nullopt;
+  system.setExternalConditions(200.0, 5e6);
+
+  EXPECT_DOUBLE_EQ(system.temperature, 200.0);
+  EXPECT_DOUBLE_EQ(system.input_pressure, 5e6);
+  EXPECT_DOUBLE_EQ(system.pressure, reference.pressure);
+  EXPECT_DOUBLE_EQ(system.beta, 1.0 / (Units::KB * 200.0));
+  EXPECT_DOUBLE_EQ(system.beta, reference.beta);
+
+  ASSERT_TRUE(system.components[0].fugacityCoefficient.has_value());
+  EXPECT_NEAR(system.components[0].fugacityCoefficient.value(), reference.components[0].fugacityCoefficient.value(),
+              1e-12);
+  EXPECT_LT(system.components[0].fugacityCoefficient.value(), 1.0);
+  EXPECT_NEAR(system.components[0].compressibility, reference.components[0].compressibility, 1e-12);
+  EXPECT_NEAR(system.components[0].bulkFluidDensity, reference.components[0].bulkFluidDensity, 1e-12);
+  EXPECT_NEAR(system.components[0].amountOfExcessMolecules, reference.components[0].amountOfExcessMolecules, 1e-9);
+
+  // a fugacity coefficient that has a value is kept
+  system.components[0].fugacityCoefficient = 0.5;
+  system.setExternalConditions(300.0, 1e4);
+  EXPECT_DOUBLE_EQ(system.components[0].fugacityCoefficient.value(), 0.5);
+}
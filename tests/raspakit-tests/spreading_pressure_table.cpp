@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+import isotherm;
+import multi_site_isotherm;
+import spreading_pressure_table;
+
+TEST(spreading_pressure_table, dual_site_toth_langmuir)
+{
+  MultiSiteIsotherm isotherm{};
+  isotherm.add(Isotherm(Isotherm::Type::Toth, {3.5, 2.0e-5, 0.6}, 3));
+  isotherm.add(Isotherm(Isotherm::Type::Langmuir, {1.2, 4.0e-4}, 2));
+  isotherm.numberOfSites = 2;
+
+  // the table is refined towards 1e-9, but the accuracy of psi itself (the series of the Toth isotherm, the rounding of
+  // ln(1 + b p) at low pressure) limits it to the documented 1e-6
+  std::optional<SpreadingPressureTable> table = SpreadingPressureTable::create(isotherm, 1e-6, 1e10, 1e-9);
+  ASSERT_TRUE(table.has_value());
+  EXPECT_LE(table->maximumError(), 1e-6);
+
+  for (double pressure = 1e-3; pressure < 1e9; pressure *= 1.7)
+  {
+    double exact = isotherm.psiForPressure(pressure);
+    EXPECT_NEAR(table->psiForPressure(pressure), exact, 1e-6 * exact);
+
+    double cachedP0 = 0.0;
+    double inversePressure = table->inversePressureForPsi(exact, cachedP0);
+    EXPECT_NEAR(1.0 / inversePressure, pressure, 1e-6 * pressure);
+  }
+}
+
+TEST(spreading_pressure_table, no_table_when_refinement_stops_above_the_accepted_error)
+{
+  MultiSiteIsotherm isotherm{};
+  isotherm.add(Isotherm(Isotherm::Type::Toth, {3.5, 2.0e-5, 0.6}, 3));
+  isotherm.add(Isotherm(Isotherm::Type::Langmuir, {1.2, 4.0e-4}, 2));
+  isotherm.numberOfSites = 2;
+
+  // the accuracy of psi of the Toth isotherm stops the refinement well above 1e-12
+  EXPECT_FALSE(SpreadingPressureTable::create(isotherm, 1e-6, 1e10, 1e-12, 1e-12).has_value());
+}
+
+TEST(spreading_pressure_table, no_table_without_adsorption)
+{
+  MultiSiteIsotherm isotherm{};
+  isotherm.add(Isotherm(Isotherm::Type::Langmuir, {0.0, 0.0}, 2));
+  isotherm.numberOfSites = 1;
+
+  EXPECT_FALSE(SpreadingPressureTable::create(isotherm).has_value());
+}
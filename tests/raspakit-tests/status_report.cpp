@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+import int3;
+import double3;
+import double3x3;
+
+import units;
+import atom;
+import pseudo_atom;
+import vdwparameters;
+import forcefield;
+import component;
+import system;
+import simulationbox;
+import randomnumbers;
+import monte_carlo;
+import json;
+
+TEST(status_report, json_status_report_has_current_average_and_error)
+{
+  ForceField forceField = ForceField({PseudoAtom("CH4", false, 16.04246, 0.0, 0.0, 6, false)},
+                                     {VDWParameters(158.5, 3.72)}, ForceField::MixingRule::Lorentz_Berthelot, 12.0,
+                                     12.0, 12.0, true, false, true);
+  Component methane = Component(0, forceField, "methane", 190.564, 45599200, 0.01142,
+                                {Atom(double3(0.0, 0.0, 0.0), 0.0, 1.0, 0, 0, 0, 0)}, 5, 21);
+  System system = System(0, forceField, SimulationBox(30.0, 30.0, 30.0), 300.0, 1e4, 1.0, {}, {methane}, {10}, 5);
+
+  // the excess part of the current pressure is the one of the last pressure computation
+  system.currentExcessPressureTensor = double3x3(1e-3, 2e-3, 3e-3);
+
+  std::vector<System> systems{system};
+  RandomNumber random(42);
+  MonteCarlo mc(100, 0, 0, 100, 1000, 1000, 1000, systems, random, 5);
+
+  nlohmann::json report = mc.jsonStatusReport();
+  EXPECT_EQ(report["numberOfCycles"].get<size_t>(), 100uz);
+  ASSERT_EQ(report["systems"].size(), 1uz);
+
+  const nlohmann::json &status = report["systems"][0];
+  for (const std::string key : {"current", "average", "error"})
+  {
+    EXPECT_TRUE(status["loadings"]["methane"].contains(key)) << key;
+    EXPECT_TRUE(status["energies"]["total"].contains(key)) << key;
+    EXPECT_TRUE(status["pressure"].contains(key)) << key;
+  }
+  EXPECT_EQ(status["loadings"]["methane"]["current"].get<double>(), 10.0);
+  EXPECT_TRUE(status.contains("MCMoveStatistics"));
+
+  const System &s = mc.systems.front();
+  double idealGasPressure = 10.0 / (s.beta * s.simulationBox.volume);
+  double expectedPressure = 1e-5 * Units::PressureConversionFactor * (idealGasPressure + 2e-3);
+  EXPECT_NEAR(status["pressure"]["current"].get<double>(), expectedPressure, 1e-10 * expectedPressure);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+import double3;
+import transition_matrix;
+
+namespace
+{
+// transition probabilities of a model with a known ln(pi): ln pi(N+1) - ln pi(N) = ln insertion(N) - ln deletion(N+1)
+double insertion(size_t N) { return 0.4 * std::exp(-0.05 * static_cast<double>(N)); }
+double deletion(size_t N) { return N == 0 ? 0.0 : 0.1 + 0.005 * static_cast<double>(N); }
+
+// fills the collection matrix as if every macrostate of the range was sampled 'weight' times
+TransitionMatrix sampledMatrix(size_t minMacrostate, size_t maxMacrostate, double weight)
+{
+  TransitionMatrix tmmc{};
+  tmmc.doTMMC = true;
+  tmmc.minMacrostate = minMacrostate;
+  tmmc.maxMacrostate = maxMacrostate;
+  tmmc.initialize();
+  for (size_t N = minMacrostate; N <= maxMacrostate; ++N)
+  {
+    double3 Pacc(deletion(N), 1.0 - deletion(N) - insertion(N), insertion(N));
+    tmmc.cmatrix[N - minMacrostate] = weight * Pacc;
+    tmmc.histogram[N - minMacrostate] = static_cast<size_t>(weight);
+  }
+  return tmmc;
+}
+}  // namespace
+
+TEST(transition_matrix, window_ranges_overlap_and_cover)
+{
+  std::vector<std::pair<size_t, size_t>> ranges = TransitionMatrix::windowRanges(5, 150, 4, 3);
+
+  ASSERT_EQ(ranges.size(), 4uz);
+  EXPECT_EQ(ranges.front().first, 5uz);
+  EXPECT_EQ(ranges.back().second, 150uz);
+  for (size_t k = 0; k + 1 < ranges.size(); ++k)
+  {
+    EXPECT_LT(ranges[k].first, ranges[k].second);
+    EXPECT_EQ(ranges[k].second - ranges[k + 1].first + 1, 3uz);
+  }
+
+  EXPECT_THROW(TransitionMatrix::windowRanges(0, 2, 4, 1), std::runtime_error);
+}
+
+TEST(transition_matrix, stitched_windows_reproduce_single_walker)
+{
+  TransitionMatrix reference = sampledMatrix(0, 60, 1000.0);
+  reference.computeLnpi();
+
+  // windows sampled with different amounts of statistics
+  std::vector<TransitionMatrix> windows{};
+  std::vector<std::pair<size_t, size_t>> ranges = TransitionMatrix::windowRanges(0, 60, 5, 2);
+  for (size_t k = 0; k != ranges.size(); ++k)
+  {
+    windows.push_back(sampledMatrix(ranges[k].first, ranges[k].second, 1000.0 * static_cast<double>(k + 1)));
+  }
+  TransitionMatrix stitched = TransitionMatrix::stitch(windows);
+
+  ASSERT_EQ(stitched.minMacrostate, 0uz);
+  ASSERT_EQ(stitched.maxMacrostate, 60uz);
+  ASSERT_EQ(stitched.numberOfWindows, 5uz);
+  double sum{};
+  for (size_t N = 0; N <= 60; ++N)
+  {
+    EXPECT_NEAR(stitched.lnpi[N], reference.lnpi[N], 1e-10);
+    EXPECT_NEAR(stitched.bias[N], -stitched.lnpi[N], 1e-12);
+    sum += std::exp(stitched.lnpi[N]);
+  }
+  EXPECT_NEAR(sum, 1.0, 1e-10);
+
+  for (size_t N = 0; N < 60; ++N)
+  {
+    EXPECT_NEAR(stitched.lnpi[N + 1] - stitched.lnpi[N], std::log(insertion(N)) - std::log(deletion(N + 1)), 1e-10);
+  }
+}
+
+TEST(transition_matrix, stitching_requires_covered_range)
+{
+  std::vector<TransitionMatrix> windows{sampledMatrix(0, 10, 100.0), sampledMatrix(12, 20, 100.0)};
+  EXPECT_THROW(TransitionMatrix::stitch(windows), std::runtime_error);
+}
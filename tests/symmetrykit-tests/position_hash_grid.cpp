@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <tuple>
+#include <vector>
+
+import double3;
+import double3x3;
+
+import skrotationmatrix;
+import sksymmetrycell;
+import skpositionhashgrid;
+
+// a 3x3x3 supercell of a random motif of two atom types in a triclinic cell
+static std::vector<std::tuple<double3, size_t, double>> randomSupercell(std::mt19937_64 &mt)
+{
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  std::vector<std::tuple<double3, size_t, double>> atoms{};
+  for (size_t m = 0; m != 20; ++m)
+  {
+    double3 position(dist(mt), dist(mt), dist(mt));
+    size_t type = m % 2 == 0 ? 6 : 8;
+    for (int i = 0; i != 3; ++i)
+    {
+      for (int j = 0; j != 3; ++j)
+      {
+        for (int k = 0; k != 3; ++k)
+        {
+          atoms.emplace_back(double3((position.x + i) / 3.0, (position.y + j) / 3.0, (position.z + k) / 3.0), type,
+                             1.0);
+        }
+      }
+    }
+  }
+  return atoms;
+}
+
+TEST(PositionHashGrid, MatchesAllPairsSearch)
+{
+  std::mt19937_64 mt(12345);
+  std::uniform_real_distribution<double> dist(-1.0, 2.0);
+  double3x3 unitCell(double3(30.0, 0.0, 0.0), double3(5.0, 28.0, 0.0), double3(-4.0, 3.0, 26.0));
+  std::vector<std::tuple<double3, size_t, double>> atoms = randomSupercell(mt);
+  double precision = 0.5;
+
+  for (bool allowPartialOccupancies : {false, true})
+  {
+    SKPositionHashGrid grid(atoms, unitCell, allowPartialOccupancies, precision);
+    for (size_t n = 0; n != 2000; ++n)
+    {
+      // half of the queries are close to an atom
+      double3 position(dist(mt), dist(mt), dist(mt));
+      if (n % 2 == 0)
+      {
+        position = std::get<0>(atoms[n % atoms.size()]) + double3(0.01 * dist(mt), 0.01 * dist(mt), 0.01 * dist(mt));
+      }
+      size_t type = n % 3 == 0 ? 6 : 8;
+
+      bool expected = false;
+      for (const std::tuple<double3, size_t, double> &atom : atoms)
+      {
+        double3 dr = position - std::get<0>(atom);
+        dr.x -= std::rint(dr.x);
+        dr.y -= std::rint(dr.y);
+        dr.z -= std::rint(dr.z);
+        if ((allowPartialOccupancies || std::get<1>(atom) == type) &&
+            (unitCell * dr).length_squared() < precision * precision)
+        {
+          expected = true;
+          break;
+        }
+      }
+      EXPECT_EQ(grid.contains(position, type), expected);
+    }
+  }
+}
+
+TEST(PositionHashGrid, TranslationalSymmetryOfSupercell)
+{
+  std::mt19937_64 mt(54321);
+  double3x3 unitCell(double3(30.0, 0.0, 0.0), double3(5.0, 28.0, 0.0), double3(-4.0, 3.0, 26.0));
+  std::vector<std::tuple<double3, size_t, double>> atoms = randomSupercell(mt);
+  SKPositionHashGrid grid(atoms, unitCell, false, 1e-3);
+
+  EXPECT_TRUE(SKSymmetryCell::testTranslationalSymmetry(double3(1.0 / 3.0, 0.0, 0.0), atoms, grid));
+  EXPECT_TRUE(SKSymmetryCell::testTranslationalSymmetry(double3(1.0 / 3.0, 2.0 / 3.0, -1.0 / 3.0), atoms, grid));
+  EXPECT_FALSE(SKSymmetryCell::testTranslationalSymmetry(double3(0.5, 0.0, 0.0), atoms, grid));
+  EXPECT_TRUE(SKSymmetryCell::testSymmetry(double3(0.0, 1.0 / 3.0, 0.0), SKRotationMatrix::identity, atoms, grid));
+
+  std::vector<std::tuple<double3, size_t, double>> reducedAtoms(atoms.begin(), atoms.begin() + 27);
+  std::vector<double3> translations =
+      SKSymmetryCell::primitiveTranslationVectors(reducedAtoms, atoms, SKRotationMatrix::identity, grid);
+  EXPECT_EQ(translations.size(), 27uz);
+}